@@ -0,0 +1,55 @@
+//===- benchmarks/ASTContextBench.cpp - Type uniquing benchmarks ----------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "ClangBench.h"
+#include "clang/AST/ASTContext.h"
+#include "clang/Frontend/ASTUnit.h"
+#include "clang/Tooling/Tooling.h"
+#include "benchmark/benchmark.h"
+
+using namespace clang;
+
+/// Rebuilds a State.range(0) levels deep pointer type, which only hits the
+/// uniquing tables after the first iteration.
+static void BM_getPointerType(benchmark::State &State) {
+  std::unique_ptr<ASTUnit> AST = tooling::buildASTFromCode("");
+  ASTContext &Ctx = AST->getASTContext();
+  for (auto _ : State) {
+    QualType T = Ctx.IntTy;
+    for (int64_t I = 0; I < State.range(0); ++I)
+      T = Ctx.getPointerType(T);
+    benchmark::DoNotOptimize(T.getAsOpaquePtr());
+  }
+  State.SetItemsProcessed(State.iterations() * State.range(0));
+}
+BENCHMARK(BM_getPointerType)->Arg(16);
+
+/// Looks up the prototypes taking every prefix of a list of parameters.
+static void BM_getFunctionType(benchmark::State &State) {
+  std::unique_ptr<ASTUnit> AST = tooling::buildASTFromCode("");
+  ASTContext &Ctx = AST->getASTContext();
+  QualType Params[] = {Ctx.IntTy,
+                       Ctx.CharTy,
+                       Ctx.DoubleTy,
+                       Ctx.getPointerType(Ctx.CharTy),
+                       Ctx.UnsignedIntTy,
+                       Ctx.LongLongTy,
+                       Ctx.BoolTy,
+                       Ctx.getPointerType(Ctx.VoidTy)};
+  FunctionProtoType::ExtProtoInfo EPI;
+  for (auto _ : State) {
+    for (unsigned I = 0; I <= llvm::array_lengthof(Params); ++I) {
+      QualType T = Ctx.getFunctionType(Ctx.VoidTy,
+                                       llvm::makeArrayRef(Params, I), EPI);
+      benchmark::DoNotOptimize(T.getAsOpaquePtr());
+    }
+  }
+  State.SetItemsProcessed(State.iterations() *
+                          (llvm::array_lengthof(Params) + 1));
+}
+BENCHMARK(BM_getFunctionType);
@@ -0,0 +1,41 @@
+//===- benchmarks/ASTDiffBench.cpp - ASTDiff benchmarks -------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "ClangBench.h"
+#include "clang/Frontend/ASTUnit.h"
+#include "clang/Tooling/ASTDiff/ASTDiff.h"
+#include "clang/Tooling/Tooling.h"
+#include "benchmark/benchmark.h"
+
+using namespace clang;
+
+/// Matches the synthetic source against a copy where every other function
+/// had its seed changed, as after a large refactoring.
+static void BM_ASTDiff(benchmark::State &State) {
+  std::string Src = bench::makeSyntheticSource(State.range(0));
+  std::string Dst = Src;
+  bool Change = false;
+  for (size_t Pos = Dst.find("0x1234abcdUL"); Pos != std::string::npos;
+       Pos = Dst.find("0x1234abcdUL", Pos + 1)) {
+    if (Change)
+      Dst[Pos + 2] = '4';
+    Change = !Change;
+  }
+
+  std::unique_ptr<ASTUnit> SrcAST = tooling::buildASTFromCode(Src);
+  std::unique_ptr<ASTUnit> DstAST = tooling::buildASTFromCode(Dst);
+  diff::SyntaxTree SrcTree(SrcAST->getASTContext());
+  diff::SyntaxTree DstTree(DstAST->getASTContext());
+  diff::ComparisonOptions Options;
+  for (auto _ : State) {
+    diff::ASTDiff Diff(SrcTree, DstTree, Options);
+    benchmark::DoNotOptimize(Diff.getMapped(SrcTree, SrcTree.getRootId()));
+  }
+  State.SetItemsProcessed(int64_t(State.iterations()) * SrcTree.getSize());
+}
+BENCHMARK(BM_ASTDiff)->Arg(16)->Arg(256);
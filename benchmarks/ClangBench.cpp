@@ -0,0 +1,35 @@
+//===- benchmarks/ClangBench.cpp - Frontend microbenchmarks ---------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// clang-bench times the frontend hot paths on synthetic inputs. Arguments that
+// are not Google Benchmark flags name source files that are lexed as well, so
+// results can be compared on real code. Use --benchmark_format=json or
+// --benchmark_out=<file> to get machine readable results.
+//
+//===----------------------------------------------------------------------===//
+
+#include "ClangBench.h"
+#include "llvm/Support/raw_ostream.h"
+#include "benchmark/benchmark.h"
+
+using namespace clang;
+
+int main(int argc, char **argv) {
+  benchmark::Initialize(&argc, argv);
+  for (int I = 1; I < argc; ++I) {
+    auto BufOrErr = llvm::MemoryBuffer::getFile(argv[I]);
+    if (!BufOrErr) {
+      llvm::errs() << "error: cannot read '" << argv[I]
+                   << "': " << BufOrErr.getError().message() << "\n";
+      return 1;
+    }
+    bench::registerLexerInput(argv[I], std::move(*BufOrErr));
+  }
+  benchmark::RunSpecifiedBenchmarks();
+  return 0;
+}
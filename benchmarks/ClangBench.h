@@ -0,0 +1,31 @@
+//===- benchmarks/ClangBench.h - Shared benchmark helpers -------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_CLANG_BENCHMARKS_CLANGBENCH_H
+#define LLVM_CLANG_BENCHMARKS_CLANGBENCH_H
+
+#include "clang/Basic/LLVM.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include <memory>
+#include <string>
+
+namespace clang {
+namespace bench {
+
+/// Returns a synthetic C++ source made of \p Functions copies of a small
+/// function exercising the usual mix of tokens.
+std::string makeSyntheticSource(unsigned Functions);
+
+/// Registers the lexer benchmarks for an input file read from disk.
+void registerLexerInput(StringRef Name,
+                        std::shared_ptr<llvm::MemoryBuffer> Input);
+
+} // namespace bench
+} // namespace clang
+
+#endif // LLVM_CLANG_BENCHMARKS_CLANGBENCH_H
@@ -0,0 +1,69 @@
+//===- benchmarks/LexerBench.cpp - Lexer benchmarks -----------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "ClangBench.h"
+#include "clang/Basic/LangOptions.h"
+#include "clang/Lex/Lexer.h"
+#include "clang/Lex/Token.h"
+#include "llvm/ADT/Twine.h"
+#include "benchmark/benchmark.h"
+
+using namespace clang;
+
+std::string bench::makeSyntheticSource(unsigned Functions) {
+  std::string Source;
+  for (unsigned I = 0; I < Functions; ++I) {
+    std::string N = std::to_string(I);
+    Source += "// Computes the checksum of block " + N + ".\n"
+              "static unsigned long checksum" + N +
+              "(const char *Data, unsigned Size) {\n"
+              "  unsigned long Sum = 0x1234abcdUL;\n"
+              "  for (unsigned I = 0; I < Size; ++I) {\n"
+              "    Sum = (Sum << 5) + Sum + Data[I]; /* djb2 */\n"
+              "    if (Sum >= 1.5e9 && Data[I] != '\\n')\n"
+              "      Sum ^= sizeof(\"block " + N + "\");\n"
+              "  }\n"
+              "  return Sum;\n"
+              "}\n\n";
+  }
+  return Source;
+}
+
+/// Lexes the whole of \p Buffer in raw mode once per iteration.
+static void lexBuffer(benchmark::State &State,
+                      const llvm::MemoryBuffer &Buffer) {
+  LangOptions LangOpts;
+  LangOpts.CPlusPlus = LangOpts.CPlusPlus11 = LangOpts.CPlusPlus14 = true;
+  const char *Start = Buffer.getBufferStart();
+  int64_t Tokens = 0;
+  for (auto _ : State) {
+    Lexer L(SourceLocation(), LangOpts, Start, Start, Buffer.getBufferEnd());
+    Token Tok;
+    while (!L.LexFromRawLexer(Tok))
+      ++Tokens;
+    benchmark::DoNotOptimize(Tok.getLength());
+  }
+  State.SetItemsProcessed(Tokens);
+  State.SetBytesProcessed(int64_t(State.iterations()) * Buffer.getBufferSize());
+}
+
+static void BM_RawLex(benchmark::State &State) {
+  std::unique_ptr<llvm::MemoryBuffer> Buffer =
+      llvm::MemoryBuffer::getMemBufferCopy(
+          bench::makeSyntheticSource(State.range(0)));
+  lexBuffer(State, *Buffer);
+}
+BENCHMARK(BM_RawLex)->Arg(16)->Arg(1024);
+
+void bench::registerLexerInput(StringRef Name,
+                               std::shared_ptr<llvm::MemoryBuffer> Input) {
+  benchmark::RegisterBenchmark(("BM_RawLex/" + Name).str().c_str(),
+                               [Input](benchmark::State &State) {
+                                 lexBuffer(State, *Input);
+                               });
+}
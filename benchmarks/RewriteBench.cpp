@@ -0,0 +1,50 @@
+//===- benchmarks/RewriteBench.cpp - RewriteBuffer benchmarks -------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "ClangBench.h"
+#include "clang/Rewrite/Core/RewriteBuffer.h"
+#include "llvm/ADT/SmallVector.h"
+#include "benchmark/benchmark.h"
+
+using namespace clang;
+
+/// Returns the edits renaming every occurrence of "Sum" in \p Source.
+static SmallVector<RewriteBuffer::TextEdit, 0> renameSums(StringRef Source) {
+  SmallVector<RewriteBuffer::TextEdit, 0> Edits;
+  for (size_t Pos = Source.find("Sum"); Pos != StringRef::npos;
+       Pos = Source.find("Sum", Pos + 3))
+    Edits.push_back({unsigned(Pos), 3, "Accumulator"});
+  return Edits;
+}
+
+static void BM_ReplaceText(benchmark::State &State) {
+  std::string Source = bench::makeSyntheticSource(State.range(0));
+  auto Edits = renameSums(Source);
+  for (auto _ : State) {
+    RewriteBuffer Buf;
+    Buf.Initialize(Source);
+    for (const RewriteBuffer::TextEdit &Edit : Edits)
+      Buf.ReplaceText(Edit.OrigOffset, Edit.OrigLength, Edit.NewStr);
+    benchmark::DoNotOptimize(Buf.size());
+  }
+  State.SetItemsProcessed(int64_t(State.iterations()) * Edits.size());
+}
+BENCHMARK(BM_ReplaceText)->Arg(16)->Arg(1024);
+
+static void BM_ReplaceTexts(benchmark::State &State) {
+  std::string Source = bench::makeSyntheticSource(State.range(0));
+  auto Edits = renameSums(Source);
+  for (auto _ : State) {
+    RewriteBuffer Buf;
+    Buf.Initialize(Source);
+    Buf.ReplaceTexts(Edits);
+    benchmark::DoNotOptimize(Buf.size());
+  }
+  State.SetItemsProcessed(int64_t(State.iterations()) * Edits.size());
+}
+BENCHMARK(BM_ReplaceTexts)->Arg(16)->Arg(1024);
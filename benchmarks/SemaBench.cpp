@@ -0,0 +1,49 @@
+//===- benchmarks/SemaBench.cpp - Sema benchmarks -------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "ClangBench.h"
+#include "clang/AST/ASTContext.h"
+#include "clang/AST/DeclTemplate.h"
+#include "clang/Frontend/ASTUnit.h"
+#include "clang/Sema/Sema.h"
+#include "clang/Sema/TemplateDeduction.h"
+#include "clang/Tooling/Tooling.h"
+#include "benchmark/benchmark.h"
+
+using namespace clang;
+
+/// Deduces the arguments of a function template from the type of the function
+/// it is converted to, as when taking its address.
+static void BM_DeduceTemplateArguments(benchmark::State &State) {
+  std::unique_ptr<ASTUnit> AST = tooling::buildASTFromCode(
+      "template <typename T, typename U> T *pick(T *, const U &, int);");
+  ASTContext &Ctx = AST->getASTContext();
+  Sema &S = AST->getSema();
+  auto Found = Ctx.getTranslationUnitDecl()->lookup(&Ctx.Idents.get("pick"));
+  auto *FTD = cast<FunctionTemplateDecl>(Found.front());
+
+  QualType Params[] = {Ctx.getPointerType(Ctx.DoubleTy),
+                       Ctx.getLValueReferenceType(Ctx.CharTy.withConst()),
+                       Ctx.IntTy};
+  QualType ArgFunctionType = Ctx.getFunctionType(
+      Params[0], Params, FunctionProtoType::ExtProtoInfo());
+
+  for (auto _ : State) {
+    FunctionDecl *Specialization = nullptr;
+    sema::TemplateDeductionInfo Info((SourceLocation()));
+    if (S.DeduceTemplateArguments(FTD, /*ExplicitTemplateArgs=*/nullptr,
+                                  ArgFunctionType, Specialization,
+                                  Info) != Sema::TDK_Success) {
+      State.SkipWithError("template argument deduction failed");
+      break;
+    }
+    benchmark::DoNotOptimize(Specialization);
+  }
+  State.SetItemsProcessed(State.iterations());
+}
+BENCHMARK(BM_DeduceTemplateArguments);
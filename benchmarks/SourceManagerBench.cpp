@@ -0,0 +1,48 @@
+//===- benchmarks/SourceManagerBench.cpp - SourceManager benchmarks -------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "ClangBench.h"
+#include "clang/Basic/Diagnostic.h"
+#include "clang/Basic/DiagnosticOptions.h"
+#include "clang/Basic/FileManager.h"
+#include "clang/Basic/SourceManager.h"
+#include "benchmark/benchmark.h"
+#include <vector>
+
+using namespace clang;
+
+/// Looks up locations spread over a chain of State.range(0) nested includes,
+/// in an order that defeats the last lookup cache of getFileID.
+static void BM_getFileID(benchmark::State &State) {
+  FileSystemOptions FileMgrOpts;
+  FileManager FileMgr(FileMgrOpts);
+  DiagnosticsEngine Diags(new DiagnosticIDs, new DiagnosticOptions,
+                          new IgnoringDiagConsumer);
+  SourceManager SourceMgr(Diags, FileMgr);
+
+  std::string Contents = bench::makeSyntheticSource(4);
+  std::vector<SourceLocation> Locs;
+  SourceLocation IncludeLoc;
+  for (int64_t I = 0; I < State.range(0); ++I) {
+    FileID FID = SourceMgr.createFileID(
+        llvm::MemoryBuffer::getMemBuffer(Contents, "header.h"),
+        SrcMgr::C_User, /*LoadedID=*/0, /*LoadedOffset=*/0, IncludeLoc);
+    SourceLocation Start = SourceMgr.getLocForStartOfFile(FID);
+    for (unsigned Offset = 0; Offset < Contents.size(); Offset += 64)
+      Locs.push_back(Start.getLocWithOffset(Offset));
+    IncludeLoc = Start.getLocWithOffset(Contents.size() / 2);
+  }
+
+  size_t Next = 0;
+  for (auto _ : State) {
+    Next = (Next + 7919) % Locs.size();
+    benchmark::DoNotOptimize(SourceMgr.getFileID(Locs[Next]));
+  }
+  State.SetItemsProcessed(State.iterations());
+}
+BENCHMARK(BM_getFileID)->Arg(8)->Arg(512);
@@ -139,6 +139,14 @@ class FullComment;
 
 } // namespace comments
 
+namespace interp {
+
+class Context;
+
+} // namespace interp
+
+class ConstexprCallCache;
+
 struct TypeInfo {
   uint64_t Width = 0;
   unsigned Align = 0;
@@ -220,6 +228,25 @@ private:
   llvm::FoldingSet<AttributedType> AttributedTypes;
   mutable llvm::FoldingSet<PipeType> PipeTypes;
 
+  /// The number of lookups in the uniquing tables of the most common type
+  /// classes, and how many of them found an existing type. Only counted when
+  /// CollectTypeLookupStats is set, reported by PrintStats().
+  mutable unsigned NumTypeLookups[Type::TypeLast + 1] = {};
+  mutable unsigned NumTypeLookupHits[Type::TypeLast + 1] = {};
+
+  template <typename SetT>
+  auto findUniquedType(SetT &Set, const llvm::FoldingSetNodeID &ID,
+                       void *&InsertPos, Type::TypeClass TC) const
+      -> decltype(Set.FindNodeOrInsertPos(ID, InsertPos)) {
+    auto *T = Set.FindNodeOrInsertPos(ID, InsertPos);
+    if (CollectTypeLookupStats) {
+      ++NumTypeLookups[TC];
+      if (T)
+        ++NumTypeLookupHits[TC];
+    }
+    return T;
+  }
+
   mutable llvm::FoldingSet<QualifiedTemplateName> QualifiedTemplateNames;
   mutable llvm::FoldingSet<DependentTemplateName> DependentTemplateNames;
   mutable llvm::FoldingSet<SubstTemplateTemplateParmStorage>
@@ -255,6 +282,13 @@ private:
   /// A cache mapping from CXXRecordDecls to key functions.
   llvm::DenseMap<const CXXRecordDecl*, LazyDeclPtr> KeyFunctions;
 
+  /// A cache of CXXRecordDecl::isDerivedFrom results, keyed by the canonical
+  /// declarations of the derived and base classes. Only completed classes
+  /// are cached, as their bases can no longer change.
+  mutable llvm::DenseMap<
+      std::pair<const CXXRecordDecl *, const CXXRecordDecl *>, bool>
+      DerivedFromCache;
+
   /// Mapping from ObjCContainers to their ObjCImplementations.
   llvm::DenseMap<ObjCContainerDecl*, ObjCImplDecl*> ObjCImpls;
 
@@ -1098,6 +1132,10 @@ public:
   void PrintStats() const;
   const SmallVectorImpl<Type *>& getTypes() const { return Types; }
 
+  /// Whether the lookups in the type uniquing tables are counted for
+  /// PrintStats(), set with -print-stats.
+  bool CollectTypeLookupStats = false;
+
   BuiltinTemplateDecl *buildBuiltinTemplateDecl(BuiltinTemplateKind BTK,
                                                 const IdentifierInfo *II) const;
 
@@ -2251,6 +2289,13 @@ public:
 
   VTableContextBase *getVTableContext();
 
+  /// Returns the bytecode interpreter for constant expressions, creating it
+  /// on first use.
+  interp::Context &getInterpContext();
+
+  /// Returns the cache of constexpr call results, creating it on first use.
+  ConstexprCallCache &getConstexprCallCache();
+
   /// If \p T is null pointer, assume the target in ASTContext.
   MangleContext *createMangleContext(const TargetInfo *T = nullptr);
 
@@ -2997,6 +3042,10 @@ private:
 
   std::unique_ptr<VTableContextBase> VTContext;
 
+  std::unique_ptr<interp::Context> InterpContext;
+
+  std::unique_ptr<ConstexprCallCache> ConstexprCalls;
+
   void ReleaseDeclContextMaps();
 
 public:
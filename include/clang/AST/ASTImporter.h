@@ -276,6 +276,10 @@ class TypeSourceInfo;
     /// (which we have already complained about).
     NonEquivalentDeclSet NonEquivalentDecls;
 
+    /// Declaration (from, to) pairs that are known to be equivalent, so
+    /// repeated structural matches during a large import are not redone.
+    NonEquivalentDeclSet EquivalentDecls;
+
     using FoundDeclsTy = SmallVector<NamedDecl *, 2>;
     FoundDeclsTy findDeclsInToCtx(DeclContext *DC, DeclarationName Name);
 
@@ -531,6 +535,9 @@ class TypeSourceInfo;
     /// Return the set of declarations that we know are not equivalent.
     NonEquivalentDeclSet &getNonEquivalentDecls() { return NonEquivalentDecls; }
 
+    /// Return the set of declarations that we know are equivalent.
+    NonEquivalentDeclSet &getEquivalentDecls() { return EquivalentDecls; }
+
     /// Called for ObjCInterfaceDecl, ObjCProtocolDecl, and TagDecl.
     /// Mark the Decl as complete, filling it in as much as possible.
     ///
@@ -55,6 +55,12 @@ struct StructuralEquivalenceContext {
   /// (which we have already complained about).
   llvm::DenseSet<std::pair<Decl *, Decl *>> &NonEquivalentDecls;
 
+  /// Declaration (from, to) pairs that are known to be equivalent, or null if
+  /// equivalences are not remembered across checks. Only pairs of complete
+  /// declarations are recorded, since completing a declaration later could
+  /// make the pair inequivalent.
+  llvm::DenseSet<std::pair<Decl *, Decl *>> *EquivalentDecls = nullptr;
+
   StructuralEquivalenceKind EqKind;
 
   /// Whether we're being strict about the spelling of types when
@@ -122,6 +128,9 @@ private:
   /// false if equivalence was detected.
   bool Finish();
 
+  /// Record the verified tentative equivalences in \c EquivalentDecls.
+  void rememberEquivalences();
+
   /// Check for common properties at Finish.
   /// \returns true if D1 and D2 may be equivalent,
   /// false if they are for sure not.
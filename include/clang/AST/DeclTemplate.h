@@ -848,7 +848,11 @@ protected:
     return SpecIterator<EntryType>(isEnd ? Specs.end() : Specs.begin());
   }
 
-  void loadLazySpecializationsImpl() const;
+  void loadLazySpecializationsImpl(bool OnlyPartial = false) const;
+
+  /// Load the lazily-loaded specializations whose template arguments may be
+  /// \p Args, leaving the others on disk.
+  void loadLazySpecializationsImpl(ArrayRef<TemplateArgument> Args) const;
 
   template <class EntryType> typename SpecEntryTraits<EntryType>::DeclType*
   findSpecializationImpl(llvm::FoldingSetVector<EntryType> &Specs,
@@ -858,6 +862,19 @@ protected:
   void addSpecializationImpl(llvm::FoldingSetVector<EntryType> &Specs,
                              EntryType *Entry, void *InsertPos);
 
+  /// A specialization known only by its external declaration ID.
+  struct LazySpecializationInfo {
+    /// The external declaration ID, or 0 once it has been loaded.
+    uint32_t DeclID;
+
+    /// The hash of the specialization's template arguments, see
+    /// computeSpecializationHash().
+    unsigned ArgsHash;
+
+    /// Whether this is a partial specialization.
+    bool IsPartial;
+  };
+
   struct CommonBase {
     CommonBase() : InstantiatedFromMember(nullptr, false) {}
 
@@ -872,9 +889,9 @@ protected:
     /// If non-null, points to an array of specializations (including
     /// partial specializations) known only by their external declaration IDs.
     ///
-    /// The first value in the array is the number of specializations/partial
-    /// specializations that follow.
-    uint32_t *LazySpecializations = nullptr;
+    /// The DeclID of the first element in the array is the number of
+    /// specializations/partial specializations that follow.
+    LazySpecializationInfo *LazySpecializations = nullptr;
   };
 
   /// Pointer to the common data shared by all declarations of this
@@ -915,6 +932,14 @@ public:
     return getFirstDecl();
   }
 
+  /// Compute the hash under which a specialization with the template
+  /// arguments \p Args is stored when it is only known by its external
+  /// declaration ID.
+  ///
+  /// Equal argument lists hash equally, whichever AST file they come from.
+  /// Different ones may collide, which only costs loading extra declarations.
+  static unsigned computeSpecializationHash(ArrayRef<TemplateArgument> Args);
+
   /// Determines whether this template was a specialization of a
   /// member template.
   ///
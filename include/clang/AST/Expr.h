@@ -673,6 +673,14 @@ public:
                              const VarDecl *VD,
                              SmallVectorImpl<PartialDiagnosticAt> &Notes) const;
 
+  /// EvaluateAsRelaxedInitializer - Like EvaluateAsInitializer, but also
+  /// allows calls to non-constexpr functions whose bodies are available, as
+  /// long as the evaluation has no side effects outside the initialized
+  /// object. C++ [basic.start.static]p3 permits such an initializer to be
+  /// performed statically.
+  bool EvaluateAsRelaxedInitializer(APValue &Result, const ASTContext &Ctx,
+                                    const VarDecl *VD) const;
+
   /// EvaluateWithSubstitution - Evaluate an expression as if from the context
   /// of a call to the given function with the given arguments, inside an
   /// unevaluated context. Returns true if the expression could be folded to a
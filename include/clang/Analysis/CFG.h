@@ -902,6 +902,12 @@ public:
   /// Adds a (potentially unreachable) successor block to the current block.
   void addSuccessor(AdjacentBlock Succ, BumpVectorContext &C);
 
+  /// Makes room for \p N successors, so adding them does not grow the
+  /// successor list repeatedly.
+  void reserveSuccessors(unsigned N, BumpVectorContext &C) {
+    Succs.reserve(C, N);
+  }
+
   void appendStmt(Stmt *statement, BumpVectorContext &C) {
     Elements.push_back(CFGStmt(statement), C);
   }
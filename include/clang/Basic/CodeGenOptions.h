@@ -179,11 +179,23 @@ public:
     bool Internalize = false;
     /// Bitwise combination of llvm::Linker::Flags, passed to the LLVM linker.
     unsigned LinkFlags = 0;
+    /// If true, the file is searched like a library, after all the other
+    /// files, for the symbols that are still undefined.
+    bool LinkAsLibrary = false;
   };
 
   /// The files specified here are linked in to the module before optimizations.
   std::vector<BitcodeFileToLink> LinkBitcodeFiles;
 
+  /// Names of the Cheerp passes to run, in order, on the linked module before
+  /// optimizations. Only used when the whole program is compiled in a single
+  /// process.
+  std::vector<std::string> CheerpLinkTimePasses;
+
+  /// If not empty, the directory where the optimized module of an IR input is
+  /// cached, to be reused by later identical invocations.
+  std::string CheerpLTOCacheDir;
+
   /// The user provided name for the "main file", if non-empty. This is useful
   /// in situations where the input file name does not match the original input
   /// file, for example with -save-temps.
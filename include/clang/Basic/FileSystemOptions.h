@@ -24,6 +24,10 @@ public:
   /// If set, paths are resolved as if the working directory was
   /// set to the value of WorkingDir.
   std::string WorkingDir;
+
+  /// If set, the failed 'stat' calls of header search are cached in this file
+  /// across compiler invocations.
+  std::string StatCachePath;
 };
 
 } // end namespace clang
@@ -17,7 +17,9 @@
 #include "clang/Basic/LLVM.h"
 #include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringRef.h"
+#include "llvm/ADT/StringSet.h"
 #include "llvm/Support/Allocator.h"
+#include "llvm/Support/Chrono.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/VirtualFileSystem.h"
 #include <cstdint>
@@ -83,6 +85,59 @@ public:
                           llvm::vfs::FileSystem &FS) override;
 };
 
+/// A stat cache that remembers, across compiler invocations, which entries of
+/// a directory are known not to exist.
+///
+/// Header search probes every include path for every header, so most of the
+/// 'stat' calls of a compilation fail, and they fail the same way in every
+/// compilation that uses the same include paths.  The failed lookups are
+/// recorded per directory together with the directory's modification time;
+/// they are only trusted while the modification time on disk still matches,
+/// which costs one 'stat' per directory instead of one per lookup.
+class PersistentStatCache : public FileSystemStatCache {
+public:
+  /// Load the cache from \p CachePath.  A missing or malformed file yields
+  /// an empty cache.
+  explicit PersistentStatCache(StringRef CachePath);
+
+  std::error_code getStat(StringRef Path, llvm::vfs::Status &Status,
+                          bool isFile,
+                          std::unique_ptr<llvm::vfs::File> *F,
+                          llvm::vfs::FileSystem &FS) override;
+
+  /// Write the cache back to its file if this invocation learned anything
+  /// new, merging in what concurrent invocations have written meanwhile.
+  ///
+  /// \returns an error code if the cache could not be written.
+  std::error_code save();
+
+private:
+  struct DirectoryInfo {
+    /// The modification time the missing entries were recorded against.
+    llvm::sys::TimePoint<> ModTime;
+
+    /// Whether the directory has been checked against the file system by
+    /// this invocation, and what the result was.
+    enum { Unchecked, Valid, Unusable } State = Unchecked;
+
+    /// The names that are known not to exist in the directory.
+    llvm::StringSet<> Missing;
+  };
+
+  /// Return the directory information for \p Dir if its missing entries can
+  /// be used and extended, or null otherwise.
+  DirectoryInfo *getValidDirectory(StringRef Dir, llvm::vfs::FileSystem &FS);
+
+  /// Parse the contents of a cache file into \p Directories.
+  static void parse(StringRef Buffer,
+                    llvm::StringMap<DirectoryInfo> &Directories);
+
+  std::string CachePath;
+  llvm::StringMap<DirectoryInfo> Directories;
+  /// Whether new missing entries were recorded since the cache was loaded.
+  bool Modified = false;
+};
+
 } // namespace clang
 
 #endif // LLVM_CLANG_BASIC_FILESYSTEMSTATCACHE_H
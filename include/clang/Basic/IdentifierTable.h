@@ -574,6 +574,13 @@ public:
     return *II;
   }
 
+  /// Return the IdentifierInfo for the given name if one has already been
+  /// created, without consulting external sources.
+  IdentifierInfo *find(StringRef Name) const {
+    auto I = HashTable.find(Name);
+    return I == HashTable.end() ? nullptr : I->getValue();
+  }
+
   using iterator = HashTableTy::const_iterator;
   using const_iterator = HashTableTy::const_iterator;
 
@@ -18,6 +18,7 @@ namespace llvm {
   template <typename T> class Expected;
   class Module;
   class MemoryBufferRef;
+  class PassRegistry;
 }
 
 namespace clang {
@@ -50,6 +51,10 @@ namespace clang {
   FindThinLTOModule(llvm::MemoryBufferRef MBRef);
   llvm::BitcodeModule *
   FindThinLTOModule(llvm::MutableArrayRef<llvm::BitcodeModule> BMs);
+
+  /// Register the passes clang adds to the Cheerp pipeline, so that they can
+  /// be named by options such as -print-after.
+  void initializeCheerpPasses(llvm::PassRegistry &Registry);
 }
 
 #endif
@@ -29,12 +29,19 @@ public:
 	{
 	}
 	void addFreeFunctionJsExportMetadata(llvm::Function* F);
+	void addBatchJsExportMetadata(llvm::Function* F);
 	void addRecordJsExportMetadata(const clang::CXXMethodDecl *method, llvm::Function* F, const llvm::StringRef className);
+	// Attach the TypeScript types of the return value and of the parameters
+	void addJsExportTypesMetadata(const clang::FunctionDecl* FD, llvm::Function* F);
 private:
 	llvm::Module& module;
 	llvm::LLVMContext& context;
 	llvm::IntegerType* intType;
 };
 
+// Collect the functions recorded in the jsexport metadata of the module, as
+// added by JsExportContext
+void collectJsExportedFunctions(const llvm::Module& module, llvm::SmallVectorImpl<llvm::Function*>& functions);
+
 }  //end namespace cheerp
 #endif //_CHEERP_CODEGEN_CHEERP_H
@@ -19,6 +19,7 @@
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Option/Option.h"
 #include <cassert>
+#include <chrono>
 #include <iterator>
 #include <map>
 #include <memory>
@@ -124,6 +125,24 @@ class Compilation {
   /// Whether to keep temporary files regardless of -save-temps.
   bool ForceKeepTempFiles = false;
 
+public:
+  /// The wall-clock interval in which a job was executed.
+  struct JobTime {
+    const Command *Job;
+    std::chrono::steady_clock::time_point Start;
+    std::chrono::steady_clock::time_point End;
+  };
+
+private:
+  /// Whether to record the execution time of each job in JobTimes.
+  bool RecordJobTimes = false;
+
+  /// The execution times of the jobs run so far, in execution order.
+  mutable std::vector<JobTime> JobTimes;
+
+  /// How many jobs ExecuteJobs may run at the same time.
+  unsigned ParallelJobs = 1;
+
 public:
   Compilation(const Driver &D, const ToolChain &DefaultToolChain,
               llvm::opt::InputArgList *Args,
@@ -212,6 +231,12 @@ public:
     return FailureResultFiles;
   }
 
+  void setRecordJobTimes(bool Value) { RecordJobTimes = Value; }
+
+  void setParallelJobs(unsigned Value) { ParallelJobs = Value; }
+
+  ArrayRef<JobTime> getJobTimes() const { return JobTimes; }
+
   /// Returns the sysroot path.
   StringRef getSysRoot() const;
 
@@ -286,6 +311,23 @@ public:
       const JobList &Jobs,
       SmallVectorImpl<std::pair<int, const Command *>> &FailingCommands) const;
 
+private:
+  /// Print the command line of \p C if requested by -v or CC_PRINT_OPTIONS.
+  /// \return false if the CC_PRINT_OPTIONS file could not be opened.
+  bool PrintCommand(const Command &C) const;
+
+  /// ExecuteJobsInParallel - Execute the jobs with up to \p Threads of them
+  /// running at the same time, for -fparallel-jobs=. A job only starts once
+  /// the jobs producing its inputs are done, and is skipped if one of them
+  /// failed, as in ExecuteJobs. The output of each job is replayed in job
+  /// order.
+  void ExecuteJobsInParallel(
+      const JobList &Jobs,
+      SmallVectorImpl<std::pair<int, const Command *>> &FailingCommands,
+      unsigned Threads) const;
+
+public:
+
   /// initCompilationForDiagnostics - Remove stale state and suppress output
   /// so compilation can be reexecuted to generate additional diagnostic
   /// information (e.g., preprocessed source(s)).
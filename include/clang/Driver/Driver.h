@@ -231,6 +231,13 @@ public:
   /// or when using the -gen-reproducer driver flag.
   unsigned GenReproducer : 1;
 
+  /// The entry point of the -cc1 integrated tools, if the driver runs in the
+  /// clang executable. It is passed the full command line, including the
+  /// executable and -cc1. With -fintegrated-cc1, compile jobs call it instead
+  /// of starting a new process.
+  typedef int (*CC1ToolFunc)(ArrayRef<const char *> Argv);
+  CC1ToolFunc CC1Main = nullptr;
+
 private:
   /// Certain options suppress the 'no input files' warning.
   unsigned SuppressMissingInputWarning : 1;
@@ -130,6 +130,29 @@ public:
 
   /// Set whether to print the input filenames when executing.
   void setPrintInputFilenames(bool P) { PrintInputFilenames = P; }
+
+protected:
+  /// Print the input filenames, if requested by setPrintInputFilenames.
+  void PrintFileNames() const;
+
+  /// Whether the process needs its own environment, see setEnvironment.
+  bool hasEnvironment() const { return !Environment.empty(); }
+};
+
+/// Like Command, but runs the -cc1 invocation in the driver process, through
+/// Driver::CC1Main, instead of starting a new process.
+class CC1Command : public Command {
+public:
+  CC1Command(const Action &Source_, const Tool &Creator_,
+             const char *Executable_,
+             const llvm::opt::ArgStringList &Arguments_,
+             ArrayRef<InputInfo> Inputs);
+
+  void Print(llvm::raw_ostream &OS, const char *Terminator, bool Quote,
+             CrashReportInfo *CrashInfo = nullptr) const override;
+
+  int Execute(ArrayRef<Optional<StringRef>> Redirects, std::string *ErrMsg,
+              bool *ExecutionFailed) const override;
 };
 
 /// Like Command, but with a fallback which is executed in case
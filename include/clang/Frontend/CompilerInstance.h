@@ -46,6 +46,7 @@ class FileManager;
 class FrontendAction;
 class InMemoryModuleCache;
 class Module;
+class PersistentStatCache;
 class Preprocessor;
 class Sema;
 class SourceManager;
@@ -85,6 +86,10 @@ class CompilerInstance : public ModuleLoader {
   /// The file manager.
   IntrusiveRefCntPtr<FileManager> FileMgr;
 
+  /// The on-disk cache of failed header lookups installed in \c FileMgr, if
+  /// any.  It is owned by the file manager.
+  PersistentStatCache *HeaderLookupCache = nullptr;
+
   /// The source manager.
   IntrusiveRefCntPtr<SourceManager> SourceMgr;
 
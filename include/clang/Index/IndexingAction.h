@@ -13,6 +13,7 @@
 #include "clang/Lex/PPCallbacks.h"
 #include "clang/Lex/Preprocessor.h"
 #include "llvm/ADT/ArrayRef.h"
+#include <functional>
 #include <memory>
 
 namespace clang {
@@ -47,6 +48,10 @@ struct IndexingOptions {
   // Has no effect if IndexFunctionLocals are false.
   bool IndexParametersInDeclarations = false;
   bool IndexTemplateParameters = false;
+  // If set, top-level declarations in files for which this returns false are
+  // skipped. It is called once per file, which lets clients skip headers they
+  // already indexed from another translation unit.
+  std::function<bool(FileID)> ShouldIndexFile;
 };
 
 /// Creates a frontend action that indexes all symbols (macros and AST decls).
@@ -57,6 +57,10 @@ private:
   /// Look up the specified string in the string table.  If the string index is
   /// not valid, return None.
   Optional<StringRef> getString(unsigned StrTabIdx) const;
+
+  /// Check whether the string at the specified string table index is equal to
+  /// \p Filename, ignoring case. Invalid indices compare unequal.
+  bool keyEquals(unsigned StrTabIdx, StringRef Filename) const;
 };
 
 /// This class represents an Apple concept known as a 'header map'.  To the
@@ -234,6 +234,11 @@ class HeaderSearch {
   /// Describes whether a given directory has a module map in it.
   llvm::DenseMap<const DirectoryEntry *, bool> DirectoryHasModuleMap;
 
+  /// The directories found to contain no module map file, so that we do not
+  /// probe them again. Bit 0 is set if the directory was searched as a normal
+  /// directory and bit 1 if it was searched as a framework.
+  llvm::DenseMap<const DirectoryEntry *, unsigned> DirectoryLacksModuleMap;
+
   /// Set of module map files we've already loaded, and a flag indicating
   /// whether they were valid or not.
   llvm::DenseMap<const FileEntry *, bool> LoadedModuleMaps;
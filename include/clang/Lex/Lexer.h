@@ -247,6 +247,11 @@ public:
   /// uninterpreted string.  This switches the lexer out of directive mode.
   void ReadToEndOfLine(SmallVectorImpl<char> *Result = nullptr);
 
+  /// SkipExcludedLines - Quickly skip over the lines of an excluded
+  /// conditional block that cannot start a preprocessor directive, leaving the
+  /// lexer at the start of the first line that might.
+  void SkipExcludedLines();
+
 
   /// Diag - Forwarding function for diagnostics.  This translate a source
   /// position in the current buffer into a SourceLocation object for rendering.
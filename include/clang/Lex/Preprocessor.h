@@ -793,6 +793,10 @@ private:
   unsigned NumFastTokenPaste = 0;
   unsigned NumSkipped = 0;
 
+  /// The number of times each macro was expanded, only recorded with
+  /// -fmacro-expansion-stats.
+  llvm::DenseMap<const IdentifierInfo *, unsigned> MacroExpansionCounts;
+
   /// The predefined macros that preprocessor should use from the
   /// command line etc.
   std::string Predefines;
@@ -1820,6 +1824,10 @@ public:
 
   void PrintStats();
 
+  /// Print the macros recorded with -fmacro-expansion-stats, the most
+  /// frequently expanded first.
+  void PrintMacroExpansionStats();
+
   size_t getTotalMemory() const;
 
   /// When the macro expander pastes together a comment (/##/) in Microsoft
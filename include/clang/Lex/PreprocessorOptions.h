@@ -53,6 +53,10 @@ public:
   /// definitions and expansions.
   bool DetailedRecord = false;
 
+  /// Whether to count the expansions of each macro and print the counts at
+  /// the end of the translation unit.
+  bool MacroExpansionStats = false;
+
   /// When true, we are creating or using a PCH where a #pragma hdrstop is
   /// expected to indicate the beginning or end of the PCH.
   bool PCHWithHdrStop = false;
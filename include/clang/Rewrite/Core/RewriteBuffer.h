@@ -12,6 +12,7 @@
 #include "clang/Basic/LLVM.h"
 #include "clang/Rewrite/Core/DeltaTree.h"
 #include "clang/Rewrite/Core/RewriteRope.h"
+#include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/StringRef.h"
 
 namespace clang {
@@ -88,6 +89,19 @@ public:
   void ReplaceText(unsigned OrigOffset, unsigned OrigLength,
                    StringRef NewStr);
 
+  /// A replacement of \c OrigLength characters at \c OrigOffset, relative to
+  /// the original SourceBuffer, by \c NewStr.
+  struct TextEdit {
+    unsigned OrigOffset;
+    unsigned OrigLength;
+    StringRef NewStr;
+  };
+
+  /// ReplaceTexts - Apply a list of replacements sorted by offset that don't
+  /// overlap. This has the same effect as calling ReplaceText for each of them
+  /// in order, but rebuilds the buffer in a single pass.
+  void ReplaceTexts(ArrayRef<TextEdit> Edits);
+
 private:
   /// getMappedOffset - Given an offset into the original SourceBuffer that this
   /// RewriteBuffer is based on, map it into the offset space of the
@@ -688,6 +688,11 @@ public:
       LateParsedTemplateMapT;
   LateParsedTemplateMapT LateParsedTemplateMap;
 
+  /// With -fdelayed-inline-method-parsing, the late-parsed inline member
+  /// functions that were odr-used and are parsed at the end of the
+  /// translation unit.
+  llvm::SetVector<FunctionDecl *> UsedLateParsedInlineMethods;
+
   /// Callback to the parser to parse templated functions when needed.
   typedef void LateTemplateParserCB(void *P, LateParsedTemplate &LPT);
   typedef void LateTemplateParserCleanupCB(void *P);
@@ -1164,6 +1169,10 @@ public:
   /// The number of SFINAE diagnostics that have been trapped.
   unsigned NumSFINAEErrors;
 
+  /// Whether the last warning suppressed in a SFINAE context was ignored at
+  /// its location and therefore not kept, so its notes can be dropped too.
+  bool LastSuppressedDiagnosticIgnored = false;
+
   typedef llvm::DenseMap<ParmVarDecl *, llvm::TinyPtrVector<ParmVarDecl *>>
     UnparsedDefaultArgInstantiationsMap;
 
@@ -6144,6 +6153,10 @@ public:
   void UnmarkAsLateParsedTemplate(FunctionDecl *FD);
   bool IsInsideALocalClassWithinATemplateFunction();
 
+  /// Parse the bodies of the late-parsed inline member functions that were
+  /// odr-used, including the ones that become used while doing so.
+  void ParseUsedLateParsedInlineMethods();
+
   Decl *ActOnStaticAssertDeclaration(SourceLocation StaticAssertLoc,
                                      Expr *AssertExpr,
                                      Expr *AssertMessageExpr,
@@ -12,7 +12,7 @@
 #ifndef _CHEERP_SEMA_CHEERP_H
 #define _CHEERP_SEMA_CHEERP_H
 
-#include <map>
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/iterator_range.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Cheerp/DeterministicUnorderedSet.h"
@@ -36,6 +36,10 @@ void checkCouldBeParameterOfJsExported(const clang::QualType& Ty, const clang::D
 
 void checkParameters(const clang::FunctionDecl* Method, clang::Sema& sema);
 
+void checkCouldBeJsExportBatched(const clang::FunctionDecl* FD, clang::Sema& sema);
+
+void checkCouldBeStructOfArrays(const clang::CXXRecordDecl* Record, clang::Sema& sema);
+
 void checkDestructor(const clang::CXXRecordDecl* Record, clang::Sema& sema, bool& shouldContinue);
 void checkFunction(clang::FunctionDecl* FD, clang::Sema& sema);
 
@@ -94,12 +98,15 @@ public:
 		return sema;
 	}
 	void checkFunctionToBeJsExported(const clang::FunctionDecl* FD, bool isMethod);
+	TypeKind classifyType(const clang::QualType& Qy) const;
 private:
 	void addMethod(clang::CXXMethodDecl* method, const bool isJsExport);
 	void checkTopLevelName(const clang::NamedDecl* FD);
 
 	cheerp::DeterministicUnorderedMap<const clang::CXXRecordDecl*, CheerpSemaClassData, RestrictionsLifted::NoErasure | RestrictionsLifted::NoDeterminism> classData;
-	std::map<std::pair<const clang::DeclContext*, std::string>, const clang::NamedDecl*> namedDecl;
+	llvm::DenseMap<std::pair<const clang::DeclContext*, const clang::IdentifierInfo*>, const clang::NamedDecl*> namedDecl;
+	//Classification of canonical types, shared by all the jsexported functions and records
+	mutable llvm::DenseMap<const clang::Type*, TypeKind> typeKinds;
 	clang::Sema& sema;
 };
 
@@ -635,6 +635,15 @@ private:
   /// global identifier ID to produce a local ID.
   GlobalIdentifierMapType GlobalIdentifierMap;
 
+  /// The hashes of the interesting identifiers of C++ modules that had no
+  /// IdentifierInfo yet when their module was loaded.
+  ///
+  /// Instead of being created up front, these identifiers are created out of
+  /// date by \c get() when they are first used, so that loading a module
+  /// doesn't build an IdentifierInfo for each of its macros.  A hash collision
+  /// only costs a redundant lookup.
+  llvm::DenseSet<unsigned> DeferredInterestingIdentifiers;
+
   /// A vector containing macros that have already been
   /// loaded.
   ///
@@ -976,6 +985,10 @@ private:
   /// The number of lookups into identifier tables that succeed.
   unsigned NumIdentifierLookupHits = 0;
 
+  /// The number of interesting identifiers whose creation was deferred until
+  /// their first use.
+  unsigned NumDeferredInterestingIdentifiers = 0;
+
   /// The number of selectors that have been read.
   unsigned NumSelectorsRead = 0;
 
@@ -1138,6 +1151,12 @@ private:
   /// when merging implicit instantiations of class templates across modules.
   llvm::DenseMap<DeclContext *, DeclContext *> MergedDeclContexts;
 
+  /// The keys of MergedDeclContexts whose ODR hash matched the hash of the
+  /// definition they were merged into. The hash covers their members, so we
+  /// do not need to check that each member has a counterpart in the merged
+  /// definition.
+  llvm::SmallPtrSet<DeclContext *, 16> ODRHashMatchedDeclContexts;
+
   /// A mapping from canonical declarations of enums to their canonical
   /// definitions. Only populated when using modules in C++.
   llvm::DenseMap<EnumDecl *, EnumDecl *> EnumDefinitions;
@@ -1945,6 +1964,22 @@ public:
   /// the ASTConsumer.
   void StartTranslationUnit(ASTConsumer *Consumer) override;
 
+  /// Counts of the entities of the loaded AST files that have actually been
+  /// materialized, against the number of entities that are available.
+  struct MaterializationStats {
+    unsigned IdentifiersLoaded = 0, TotalIdentifiers = 0;
+    unsigned MacrosLoaded = 0, TotalMacros = 0;
+    unsigned DeclsLoaded = 0, TotalDecls = 0;
+    unsigned TypesLoaded = 0, TotalTypes = 0;
+    unsigned SelectorsLoaded = 0, TotalSelectors = 0;
+    /// The interesting identifiers whose creation was deferred when their
+    /// module was loaded.
+    unsigned DeferredIdentifiers = 0;
+  };
+
+  /// Report how much of the loaded AST files has been materialized so far.
+  MaterializationStats getMaterializationStats() const;
+
   /// Print some statistics about AST usage.
   void PrintStats() override;
 
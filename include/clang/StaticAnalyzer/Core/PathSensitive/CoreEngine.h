@@ -100,6 +100,10 @@ private:
   /// is happening. This field is the allocator for such tags.
   NoteTag::Factory NoteTags;
 
+  /// The memory, in bytes, the graph and its states may use before the
+  /// analysis of the function is stopped, or 0 for no limit.
+  size_t MaxGraphMemory;
+
   void generateNode(const ProgramPoint &Loc,
                     ProgramStateRef State,
                     ExplodedNode *Pred);
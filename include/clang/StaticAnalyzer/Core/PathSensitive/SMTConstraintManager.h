@@ -145,7 +145,7 @@ public:
       Solver->addConstraint(NotExp);
 
       Optional<bool> isNotSat = Solver->check();
-      if (!isSat.hasValue() || isNotSat.getValue())
+      if (!isNotSat.hasValue() || isNotSat.getValue())
         return nullptr;
 
       // This is the only solution, store it
@@ -328,11 +328,10 @@ protected:
     ProgramStateRef NewState =
         State->add<ConstraintSMT>(std::make_pair(Sym, Exp));
 
-    llvm::FoldingSetNodeID ID;
-    NewState->get<ConstraintSMT>().Profile(ID);
-
-    unsigned hash = ID.ComputeHash();
-    auto I = Cached.find(hash);
+    // Constraint sets are canonicalized, so equal sets share their root.
+    ConstraintSMTType Constraints = NewState->get<ConstraintSMT>();
+    const void *Key = Constraints.getRootWithoutRetain();
+    auto I = Cached.find(Key);
     if (I != Cached.end())
       return I->second;
 
@@ -340,17 +339,18 @@ protected:
     addStateConstraints(NewState);
 
     Optional<bool> res = Solver->check();
-    if (!res.hasValue())
-      Cached[hash] = ConditionTruthVal();
-    else
-      Cached[hash] = ConditionTruthVal(res.getValue());
-
-    return Cached[hash];
+    ConditionTruthVal Result =
+        res.hasValue() ? ConditionTruthVal(res.getValue()) : ConditionTruthVal();
+    Cached[Key] = Result;
+    CachedConstraints.push_back(Constraints);
+    return Result;
   }
 
   // Cache the result of an SMT query (true, false, unknown). The key is the
-  // hash of the constraints in a state
-  mutable llvm::DenseMap<unsigned, ConditionTruthVal> Cached;
+  // root of the constraint set of a state. The sets in CachedConstraints keep
+  // those roots alive, so a key is never reused for different constraints.
+  mutable llvm::DenseMap<const void *, ConditionTruthVal> Cached;
+  mutable std::vector<ConstraintSMTType> CachedConstraints;
 }; // end class SMTConstraintManager
 
 } // namespace ento
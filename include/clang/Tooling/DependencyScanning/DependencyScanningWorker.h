@@ -13,14 +13,20 @@
 #include "clang/Basic/LLVM.h"
 #include "clang/Frontend/PCHContainerOperations.h"
 #include "clang/Tooling/CompilationDatabase.h"
+#include "llvm/ADT/STLExtras.h"
 #include "llvm/Support/Error.h"
 #include "llvm/Support/FileSystem.h"
 #include <string>
 
 namespace clang {
+
+class DependencyCollector;
+class DependencyOutputOptions;
 namespace tooling {
 namespace dependencies {
 
+class DependencyScanningService;
+
 /// An individual dependency scanning worker that is able to run on its own
 /// thread.
 ///
@@ -29,7 +35,7 @@ namespace dependencies {
 /// using the regular processing run.
 class DependencyScanningWorker {
 public:
-  DependencyScanningWorker();
+  DependencyScanningWorker(DependencyScanningService &Service);
 
   /// Print out the dependency information into a string using the dependency
   /// file format that is specified in the options (-MD is the default) and
@@ -41,10 +47,32 @@ public:
                                                 StringRef WorkingDirectory,
                                                 const CompilationDatabase &CDB);
 
+  /// Compute the dependencies of the input file and return the names of the
+  /// files it depends on, in the order they were seen, without formatting
+  /// them.
+  ///
+  /// \returns A \c StringError with the diagnostic output if clang errors
+  /// occurred, the list of dependencies otherwise.
+  llvm::Expected<std::vector<std::string>>
+  getDependencies(const std::string &Input, StringRef WorkingDirectory,
+                  const CompilationDatabase &CDB);
+
 private:
+  /// Run the scan of \p Input, collecting its dependencies with the collector
+  /// returned by \p CreateCollector.
+  llvm::Error runScan(
+      const std::string &Input, StringRef WorkingDirectory,
+      const CompilationDatabase &CDB,
+      llvm::function_ref<std::shared_ptr<DependencyCollector>(
+          std::unique_ptr<DependencyOutputOptions>)>
+          CreateCollector);
+
   IntrusiveRefCntPtr<DiagnosticOptions> DiagOpts;
   std::shared_ptr<PCHContainerOperations> PCHContainerOps;
 
+  /// The physical filesystem overlaid by \c WorkerFS. It tracks the working
+  /// directory of the current invocation without calling \c chdir.
+  llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> RealFS;
   /// The file system that is used by each worker when scanning for
   /// dependencies. This filesystem persists accross multiple compiler
   /// invocations.
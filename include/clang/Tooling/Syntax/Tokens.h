@@ -32,6 +32,7 @@
 #include "clang/Basic/SourceLocation.h"
 #include "clang/Basic/SourceManager.h"
 #include "clang/Basic/TokenKinds.h"
+#include "clang/Frontend/FrontendActions.h"
 #include "clang/Lex/Token.h"
 #include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/Optional.h"
@@ -349,6 +350,24 @@ private:
   CollectPPExpansions *Collector;
 };
 
+/// Runs only the preprocessor over the main file and collects its tokens,
+/// without parsing it. Gives the same TokenBuffer as running the full frontend
+/// with a TokenCollector, at a fraction of the cost, for clients that do not
+/// need an AST.
+class TokenCollectingAction : public PreprocessOnlyAction {
+public:
+  /// \p Result is set when the action finishes running on a file.
+  explicit TokenCollectingAction(TokenBuffer &Result) : Result(Result) {}
+
+protected:
+  bool BeginSourceFileAction(CompilerInstance &CI) override;
+  void EndSourceFileAction() override;
+
+private:
+  TokenBuffer &Result;
+  llvm::Optional<TokenCollector> Collector;
+};
+
 } // namespace syntax
 } // namespace clang
 
@@ -11,7 +11,9 @@
 //===----------------------------------------------------------------------===//
 
 #include "clang/AST/ASTContext.h"
+#include "ByteCodeInterp.h"
 #include "CXXABI.h"
+#include "ConstexprCallCache.h"
 #include "clang/AST/APValue.h"
 #include "clang/AST/ASTMutationListener.h"
 #include "clang/AST/ASTTypeTraits.h"
@@ -850,6 +852,13 @@ class ASTContext::ParentMap {
 
   ParentMapPointers PointerParents;
   ParentMapOtherNodes OtherParents;
+
+  /// Storage for the parents that are neither a single Decl nor a single
+  /// Stmt. Most nodes without pointer identity have such a parent, so they
+  /// are allocated in bulk and freed with the map.
+  llvm::SpecificBumpPtrAllocator<ast_type_traits::DynTypedNode> NodeAllocator;
+  llvm::SpecificBumpPtrAllocator<ParentVector> VectorAllocator;
+
   class ASTVisitor;
 
   static ast_type_traits::DynTypedNode
@@ -876,22 +885,6 @@ class ASTContext::ParentMap {
 
 public:
   ParentMap(ASTContext &Ctx);
-  ~ParentMap() {
-    for (const auto &Entry : PointerParents) {
-      if (Entry.second.is<ast_type_traits::DynTypedNode *>()) {
-        delete Entry.second.get<ast_type_traits::DynTypedNode *>();
-      } else if (Entry.second.is<ParentVector *>()) {
-        delete Entry.second.get<ParentVector *>();
-      }
-    }
-    for (const auto &Entry : OtherParents) {
-      if (Entry.second.is<ast_type_traits::DynTypedNode *>()) {
-        delete Entry.second.get<ast_type_traits::DynTypedNode *>();
-      } else if (Entry.second.is<ParentVector *>()) {
-        delete Entry.second.get<ParentVector *>();
-      }
-    }
-  }
 
   DynTypedNodeList getParents(const ast_type_traits::DynTypedNode &Node) {
     if (Node.getNodeKind().hasPointerIdentity())
@@ -945,6 +938,17 @@ void ASTContext::PrintStats() const {
 
   llvm::errs() << "Total bytes = " << TotalBytes << "\n";
 
+  // Lookups in the uniquing tables, for the type classes that record them.
+  Idx = 0;
+#define TYPE(Name, Parent)                                              \
+  if (NumTypeLookups[Idx])                                              \
+    llvm::errs() << "    " << NumTypeLookups[Idx] << " " << #Name       \
+                 << " type lookups, " << NumTypeLookupHits[Idx]         \
+                 << " found an existing type\n";                        \
+  ++Idx;
+#define ABSTRACT_TYPE(Name, Parent)
+#include "clang/AST/TypeNodes.def"
+
   // Implicit special member functions.
   llvm::errs() << NumImplicitDefaultConstructorsDeclared << "/"
                << NumImplicitDefaultConstructors
@@ -972,6 +976,18 @@ void ASTContext::PrintStats() const {
     ExternalSource->PrintStats();
   }
 
+  // Memory that is not part of any node; together with the per-kind totals
+  // below, this accounts for the footprint of the AST.
+  llvm::errs() << "\n*** AST Context Memory:\n";
+  llvm::errs() << "  " << getASTAllocatedMemory()
+               << " bytes allocated for AST nodes\n";
+  llvm::errs() << "  " << getSideTableAllocatedMemory()
+               << " bytes in side tables\n";
+  llvm::errs() << "  " << DeclAttrs.size()
+               << " declarations with attributes\n";
+  if (ConstexprCalls)
+    ConstexprCalls->PrintStats();
+
   BumpAlloc.PrintStats();
 }
 
@@ -2869,7 +2885,8 @@ QualType ASTContext::getPointerType(QualType T) const {
   PointerType::Profile(ID, T);
 
   void *InsertPos = nullptr;
-  if (PointerType *PT = PointerTypes.FindNodeOrInsertPos(ID, InsertPos))
+  if (PointerType *PT =
+          findUniquedType(PointerTypes, ID, InsertPos, Type::Pointer))
     return QualType(PT, 0);
 
   // If the pointee type isn't canonical, this won't be a canonical type either,
@@ -2993,7 +3010,8 @@ ASTContext::getLValueReferenceType(QualType T, bool SpelledAsLValue) const {
 
   void *InsertPos = nullptr;
   if (LValueReferenceType *RT =
-        LValueReferenceTypes.FindNodeOrInsertPos(ID, InsertPos))
+          findUniquedType(LValueReferenceTypes, ID, InsertPos,
+                          Type::LValueReference))
     return QualType(RT, 0);
 
   const auto *InnerRef = T->getAs<ReferenceType>();
@@ -3029,7 +3047,8 @@ QualType ASTContext::getRValueReferenceType(QualType T) const {
 
   void *InsertPos = nullptr;
   if (RValueReferenceType *RT =
-        RValueReferenceTypes.FindNodeOrInsertPos(ID, InsertPos))
+          findUniquedType(RValueReferenceTypes, ID, InsertPos,
+                          Type::RValueReference))
     return QualType(RT, 0);
 
   const auto *InnerRef = T->getAs<ReferenceType>();
@@ -3063,7 +3082,7 @@ QualType ASTContext::getMemberPointerType(QualType T, const Type *Cls) const {
 
   void *InsertPos = nullptr;
   if (MemberPointerType *PT =
-      MemberPointerTypes.FindNodeOrInsertPos(ID, InsertPos))
+      findUniquedType(MemberPointerTypes, ID, InsertPos, Type::MemberPointer))
     return QualType(PT, 0);
 
   // If the pointee or class type isn't canonical, this won't be a canonical
@@ -3103,7 +3122,7 @@ QualType ASTContext::getConstantArrayType(QualType EltTy,
 
   void *InsertPos = nullptr;
   if (ConstantArrayType *ATP =
-      ConstantArrayTypes.FindNodeOrInsertPos(ID, InsertPos))
+      findUniquedType(ConstantArrayTypes, ID, InsertPos, Type::ConstantArray))
     return QualType(ATP, 0);
 
   // If the element type isn't canonical or has qualifiers, this won't
@@ -3680,7 +3699,8 @@ QualType ASTContext::getFunctionTypeInternal(
 
   void *InsertPos = nullptr;
   if (FunctionProtoType *FPT =
-        FunctionProtoTypes.FindNodeOrInsertPos(ID, InsertPos)) {
+          findUniquedType(FunctionProtoTypes, ID, InsertPos,
+                          Type::FunctionProto)) {
     QualType Existing = QualType(FPT, 0);
 
     // If we find a pre-existing equivalent FunctionProtoType, we can just reuse
@@ -3978,7 +3998,8 @@ ASTContext::getSubstTemplateTypeParmType(const TemplateTypeParmType *Parm,
   SubstTemplateTypeParmType::Profile(ID, Parm, Replacement);
   void *InsertPos = nullptr;
   SubstTemplateTypeParmType *SubstParm
-    = SubstTemplateTypeParmTypes.FindNodeOrInsertPos(ID, InsertPos);
+    = findUniquedType(SubstTemplateTypeParmTypes, ID, InsertPos,
+                      Type::SubstTemplateTypeParm);
 
   if (!SubstParm) {
     SubstParm = new (*this, TypeAlignment)
@@ -4034,7 +4055,8 @@ QualType ASTContext::getTemplateTypeParmType(unsigned Depth, unsigned Index,
   TemplateTypeParmType::Profile(ID, Depth, Index, ParameterPack, TTPDecl);
   void *InsertPos = nullptr;
   TemplateTypeParmType *TypeParm
-    = TemplateTypeParmTypes.FindNodeOrInsertPos(ID, InsertPos);
+    = findUniquedType(TemplateTypeParmTypes, ID, InsertPos,
+                      Type::TemplateTypeParm);
 
   if (TypeParm)
     return QualType(TypeParm, 0);
@@ -4168,7 +4190,8 @@ QualType ASTContext::getCanonicalTemplateSpecializationType(
 
   void *InsertPos = nullptr;
   TemplateSpecializationType *Spec
-    = TemplateSpecializationTypes.FindNodeOrInsertPos(ID, InsertPos);
+    = findUniquedType(TemplateSpecializationTypes, ID, InsertPos,
+                      Type::TemplateSpecialization);
 
   if (!Spec) {
     // Allocate a new canonical template specialization type.
@@ -4195,7 +4218,8 @@ QualType ASTContext::getElaboratedType(ElaboratedTypeKeyword Keyword,
   ElaboratedType::Profile(ID, Keyword, NNS, NamedType, OwnedTagDecl);
 
   void *InsertPos = nullptr;
-  ElaboratedType *T = ElaboratedTypes.FindNodeOrInsertPos(ID, InsertPos);
+  ElaboratedType *T =
+      findUniquedType(ElaboratedTypes, ID, InsertPos, Type::Elaborated);
   if (T)
     return QualType(T, 0);
 
@@ -4222,7 +4246,7 @@ ASTContext::getParenType(QualType InnerType) const {
   ParenType::Profile(ID, InnerType);
 
   void *InsertPos = nullptr;
-  ParenType *T = ParenTypes.FindNodeOrInsertPos(ID, InsertPos);
+  ParenType *T = findUniquedType(ParenTypes, ID, InsertPos, Type::Paren);
   if (T)
     return QualType(T, 0);
 
@@ -4268,7 +4292,7 @@ QualType ASTContext::getDependentNameType(ElaboratedTypeKeyword Keyword,
 
   void *InsertPos = nullptr;
   DependentNameType *T
-    = DependentNameTypes.FindNodeOrInsertPos(ID, InsertPos);
+    = findUniquedType(DependentNameTypes, ID, InsertPos, Type::DependentName);
   if (T)
     return QualType(T, 0);
 
@@ -4400,7 +4424,7 @@ QualType ASTContext::getPackExpansionType(QualType Pattern,
          "Pack expansions must expand one or more parameter packs");
   void *InsertPos = nullptr;
   PackExpansionType *T
-    = PackExpansionTypes.FindNodeOrInsertPos(ID, InsertPos);
+    = findUniquedType(PackExpansionTypes, ID, InsertPos, Type::PackExpansion);
   if (T)
     return QualType(T, 0);
 
@@ -4905,7 +4929,7 @@ QualType ASTContext::getAutoType(QualType DeducedType, AutoTypeKeyword Keyword,
   void *InsertPos = nullptr;
   llvm::FoldingSetNodeID ID;
   AutoType::Profile(ID, DeducedType, Keyword, IsDependent, IsPack);
-  if (AutoType *AT = AutoTypes.FindNodeOrInsertPos(ID, InsertPos))
+  if (AutoType *AT = findUniquedType(AutoTypes, ID, InsertPos, Type::Auto))
     return QualType(AT, 0);
 
   auto *AT = new (*this, TypeAlignment)
@@ -10053,6 +10077,18 @@ VTableContextBase *ASTContext::getVTableContext() {
   return VTContext.get();
 }
 
+interp::Context &ASTContext::getInterpContext() {
+  if (!InterpContext)
+    InterpContext.reset(new interp::Context(*this));
+  return *InterpContext;
+}
+
+ConstexprCallCache &ASTContext::getConstexprCallCache() {
+  if (!ConstexprCalls)
+    ConstexprCalls.reset(new ConstexprCallCache());
+  return *ConstexprCalls;
+}
+
 MangleContext *ASTContext::createMangleContext(const TargetInfo *T) {
   if (!T)
     T = Target;
@@ -10322,13 +10358,14 @@ private:
         else if (const auto *S = ParentStack.back().get<Stmt>())
           NodeOrVector = S;
         else
-          NodeOrVector = new ast_type_traits::DynTypedNode(ParentStack.back());
+          NodeOrVector = new (Map.NodeAllocator.Allocate())
+              ast_type_traits::DynTypedNode(ParentStack.back());
       } else {
         if (!NodeOrVector.template is<ParentVector *>()) {
-          auto *Vector = new ParentVector(
-              1, getSingleDynTypedNodeFromParentMap(NodeOrVector));
-          delete NodeOrVector
-              .template dyn_cast<ast_type_traits::DynTypedNode *>();
+          // A DynTypedNode replaced here stays in NodeAllocator until the
+          // map is destroyed.
+          auto *Vector = new (Map.VectorAllocator.Allocate())
+              ParentVector(1, getSingleDynTypedNodeFromParentMap(NodeOrVector));
           NodeOrVector = Vector;
         }
 
@@ -2019,6 +2019,7 @@ bool ASTNodeImporter::IsStructuralMatch(Decl *From, Decl *To, bool Complain) {
       Importer.getFromContext(), Importer.getToContext(),
       Importer.getNonEquivalentDecls(), getStructuralEquivalenceKind(Importer),
       false, Complain);
+  Ctx.EquivalentDecls = &Importer.getEquivalentDecls();
   return Ctx.IsEquivalent(From, To);
 }
 
@@ -2038,6 +2039,7 @@ bool ASTNodeImporter::IsStructuralMatch(RecordDecl *FromRecord,
                                    Importer.getNonEquivalentDecls(),
                                    getStructuralEquivalenceKind(Importer),
                                    false, Complain);
+  Ctx.EquivalentDecls = &Importer.getEquivalentDecls();
   return Ctx.IsEquivalent(FromRecord, ToRecord);
 }
 
@@ -2047,6 +2049,7 @@ bool ASTNodeImporter::IsStructuralMatch(VarDecl *FromVar, VarDecl *ToVar,
       Importer.getFromContext(), Importer.getToContext(),
       Importer.getNonEquivalentDecls(), getStructuralEquivalenceKind(Importer),
       false, Complain);
+  Ctx.EquivalentDecls = &Importer.getEquivalentDecls();
   return Ctx.IsEquivalent(FromVar, ToVar);
 }
 
@@ -2060,6 +2063,7 @@ bool ASTNodeImporter::IsStructuralMatch(EnumDecl *FromEnum, EnumDecl *ToEnum) {
   StructuralEquivalenceContext Ctx(
       Importer.getFromContext(), Importer.getToContext(),
       Importer.getNonEquivalentDecls(), getStructuralEquivalenceKind(Importer));
+  Ctx.EquivalentDecls = &Importer.getEquivalentDecls();
   return Ctx.IsEquivalent(FromEnum, ToEnum);
 }
 
@@ -2069,6 +2073,7 @@ bool ASTNodeImporter::IsStructuralMatch(FunctionTemplateDecl *From,
       Importer.getFromContext(), Importer.getToContext(),
       Importer.getNonEquivalentDecls(), getStructuralEquivalenceKind(Importer),
       false, false);
+  Ctx.EquivalentDecls = &Importer.getEquivalentDecls();
   return Ctx.IsEquivalent(From, To);
 }
 
@@ -2077,6 +2082,7 @@ bool ASTNodeImporter::IsStructuralMatch(FunctionDecl *From, FunctionDecl *To) {
       Importer.getFromContext(), Importer.getToContext(),
       Importer.getNonEquivalentDecls(), getStructuralEquivalenceKind(Importer),
       false, false);
+  Ctx.EquivalentDecls = &Importer.getEquivalentDecls();
   return Ctx.IsEquivalent(From, To);
 }
 
@@ -2096,6 +2102,7 @@ bool ASTNodeImporter::IsStructuralMatch(ClassTemplateDecl *From,
                                    Importer.getToContext(),
                                    Importer.getNonEquivalentDecls(),
                                    getStructuralEquivalenceKind(Importer));
+  Ctx.EquivalentDecls = &Importer.getEquivalentDecls();
   return Ctx.IsEquivalent(From, To);
 }
 
@@ -2105,6 +2112,7 @@ bool ASTNodeImporter::IsStructuralMatch(VarTemplateDecl *From,
                                    Importer.getToContext(),
                                    Importer.getNonEquivalentDecls(),
                                    getStructuralEquivalenceKind(Importer));
+  Ctx.EquivalentDecls = &Importer.getEquivalentDecls();
   return Ctx.IsEquivalent(From, To);
 }
 
@@ -8787,5 +8795,6 @@ bool ASTImporter::IsStructurallyEquivalent(QualType From, QualType To,
   StructuralEquivalenceContext Ctx(FromContext, ToContext, NonEquivalentDecls,
                                    getStructuralEquivalenceKind(*this), false,
                                    Complain);
+  Ctx.EquivalentDecls = &EquivalentDecls;
   return Ctx.IsEquivalent(From, To);
 }
@@ -1572,13 +1572,13 @@ static bool IsStructurallyEquivalent(StructuralEquivalenceContext &Context,
 /// Determine structural equivalence of two declarations.
 static bool IsStructurallyEquivalent(StructuralEquivalenceContext &Context,
                                      Decl *D1, Decl *D2) {
-  // FIXME: Check for known structural equivalences via a callback of some sort.
-
-  // Check whether we already know that these two declarations are not
-  // structurally equivalent.
-  if (Context.NonEquivalentDecls.count(
-          std::make_pair(D1->getCanonicalDecl(), D2->getCanonicalDecl())))
+  // Check whether we already know if these two declarations are structurally
+  // equivalent or not.
+  std::pair<Decl *, Decl *> P(D1->getCanonicalDecl(), D2->getCanonicalDecl());
+  if (Context.NonEquivalentDecls.count(P))
     return false;
+  if (Context.EquivalentDecls && Context.EquivalentDecls->count(P))
+    return true;
 
   // Determine whether we've already produced a tentative equivalence for D1.
   Decl *&EquivToD1 = Context.TentativeEquivalences[D1->getCanonicalDecl()];
@@ -1712,7 +1712,10 @@ bool StructuralEquivalenceContext::IsEquivalent(Decl *D1, Decl *D2) {
   if (!::IsStructurallyEquivalent(*this, D1, D2))
     return false;
 
-  return !Finish();
+  if (Finish())
+    return false;
+  rememberEquivalences();
+  return true;
 }
 
 bool StructuralEquivalenceContext::IsEquivalent(QualType T1, QualType T2) {
@@ -1721,7 +1724,10 @@ bool StructuralEquivalenceContext::IsEquivalent(QualType T1, QualType T2) {
   if (!::IsStructurallyEquivalent(*this, T1, T2))
     return false;
 
-  return !Finish();
+  if (Finish())
+    return false;
+  rememberEquivalences();
+  return true;
 }
 
 bool StructuralEquivalenceContext::CheckCommonEquivalence(Decl *D1, Decl *D2) {
@@ -1873,6 +1879,30 @@ bool StructuralEquivalenceContext::CheckKindSpecificEquivalence(
   return true;
 }
 
+/// Determine whether \p D is complete enough for its equivalence with another
+/// declaration to stay valid while the AST is being extended.
+static bool isCompleteForEquivalence(Decl *D) {
+  if (auto *TD = dyn_cast<TagDecl>(D))
+    return TD->isCompleteDefinition();
+  if (auto *CTD = dyn_cast<ClassTemplateDecl>(D))
+    return CTD->getTemplatedDecl()->isCompleteDefinition();
+  if (auto *ID = dyn_cast<ObjCInterfaceDecl>(D))
+    return ID->hasDefinition();
+  if (auto *PD = dyn_cast<ObjCProtocolDecl>(D))
+    return PD->hasDefinition();
+  return true;
+}
+
+void StructuralEquivalenceContext::rememberEquivalences() {
+  if (!EquivalentDecls)
+    return;
+  // Finish() succeeded, so every tentative equivalence has been verified.
+  for (const auto &P : TentativeEquivalences)
+    if (isCompleteForEquivalence(P.first) &&
+        isCompleteForEquivalence(P.second))
+      EquivalentDecls->insert(P);
+}
+
 bool StructuralEquivalenceContext::Finish() {
   while (!DeclsToCheck.empty()) {
     // Check the next declaration.
@@ -0,0 +1,1172 @@
+//===--- ByteCodeInterp.cpp - Bytecode interpreter for constexpr ----------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// This file implements the bytecode compiler and interpreter for integer
+// constexpr functions. The compiler translates a function body into code for
+// a stack machine whose values are APSInts, with one slot per parameter and
+// local variable. The semantics of each operation mirror ExprConstant; every
+// case in which ExprConstant would emit a diagnostic makes the interpreter
+// fail instead.
+//
+//===----------------------------------------------------------------------===//
+
+#include "ByteCodeInterp.h"
+#include "clang/AST/ASTContext.h"
+#include "clang/AST/Decl.h"
+#include "clang/AST/DeclCXX.h"
+#include "clang/AST/Expr.h"
+#include "clang/AST/ExprCXX.h"
+#include "clang/AST/Stmt.h"
+#include "llvm/ADT/Optional.h"
+#include "llvm/ADT/SmallVector.h"
+#include <vector>
+
+using namespace clang;
+using llvm::APInt;
+using llvm::APSInt;
+
+namespace clang {
+namespace interp {
+
+enum class Opcode : uint8_t {
+  // Push the constant Arg.
+  Const,
+  // Push the value of slot Arg; fails if the slot is not initialized.
+  Load,
+  // Pop a value into slot Arg.
+  Store,
+  // Mark slot Arg as uninitialized.
+  Kill,
+  Dup,
+  Pop,
+  // Binary operators pop the right operand, then the left operand.
+  Add,
+  Sub,
+  Mul,
+  Div,
+  Rem,
+  Shl,
+  Shr,
+  And,
+  Or,
+  Xor,
+  LT,
+  GT,
+  LE,
+  GE,
+  EQ,
+  NE,
+  // Neg, Inc and Dec fail on signed overflow if Arg is non-zero.
+  Neg,
+  Not,
+  LNot,
+  Inc,
+  Dec,
+  // Convert to the type of the instruction.
+  Cast,
+  // Jumps go to the instruction Arg; the conditional ones pop the condition.
+  Jump,
+  JumpIfFalse,
+  JumpIfTrue,
+  // Call the callee Arg, popping its arguments and pushing its result.
+  Call,
+  Ret,
+  // Reached when evaluation cannot succeed, such as after the end of a
+  // function without a return statement.
+  Trap,
+  // Take one evaluation step; emitted wherever the tree walker evaluates a
+  // statement, so both evaluators run out of steps at the same point.
+  Step
+};
+
+/// The width and signedness of an integer type.
+struct IntType {
+  unsigned Width = 0;
+  bool IsUnsigned = false;
+  bool IsBool = false;
+};
+
+struct Instr {
+  Opcode Op;
+  /// The type of the result, for instructions that produce a value.
+  IntType Ty;
+  unsigned Arg;
+};
+
+/// The bytecode of a function.
+class Function {
+public:
+  std::vector<Instr> Code;
+  std::vector<APSInt> Constants;
+  std::vector<const FunctionDecl *> Callees;
+  SmallVector<IntType, 4> Params;
+  IntType ReturnType;
+  unsigned NumSlots = 0;
+};
+
+//===----------------------------------------------------------------------===//
+// Compiler
+//===----------------------------------------------------------------------===//
+
+/// Translates the body of a function into bytecode.
+class Compiler {
+public:
+  Compiler(Context &Program, Function &F)
+      : Program(Program), Ctx(Program.Ctx), F(F) {}
+
+  /// Compile \p FD into the function. Returns false if \p FD uses a construct
+  /// the compiler does not support.
+  bool compileFunction(const FunctionDecl *FD);
+
+private:
+  struct LoopLabels {
+    SmallVector<unsigned, 4> Breaks;
+    SmallVector<unsigned, 4> Continues;
+  };
+
+  bool getIntType(QualType T, IntType &Ty) const;
+  static bool isSameType(const IntType &A, const IntType &B) {
+    return A.Width == B.Width && A.IsUnsigned == B.IsUnsigned;
+  }
+
+  unsigned emit(Opcode Op, IntType Ty = IntType(), unsigned Arg = 0) {
+    F.Code.push_back({Op, Ty, Arg});
+    return F.Code.size() - 1;
+  }
+  void emitConst(const APSInt &Value, const IntType &Ty) {
+    F.Constants.push_back(Value);
+    emit(Opcode::Const, Ty, F.Constants.size() - 1);
+  }
+  /// Point the jump \p Jump at the next instruction.
+  void patch(unsigned Jump) { F.Code[Jump].Arg = F.Code.size(); }
+  void patch(ArrayRef<unsigned> Jumps, unsigned Target) {
+    for (unsigned Jump : Jumps)
+      F.Code[Jump].Arg = Target;
+  }
+
+  bool compileStmt(const Stmt *S);
+  bool compileLoopBody(const Stmt *Body, LoopLabels &Labels);
+  bool compileLocal(const VarDecl *VD);
+
+  /// Compile \p E so that it pushes its value.
+  bool compileRValue(const Expr *E);
+  /// Compile \p E for its side effects only.
+  bool compileDiscarded(const Expr *E);
+  /// Compile the glvalue \p E, which must designate a local variable, and
+  /// return the variable's slot.
+  bool compileLValue(const Expr *E, unsigned &Slot);
+
+  bool compileBinaryOperator(const BinaryOperator *E, const IntType &Ty);
+  bool compileLogicalOperator(const BinaryOperator *E, const IntType &Ty);
+  bool compileAssignment(const BinaryOperator *E, unsigned &Slot);
+  bool compileIncDec(const UnaryOperator *E, unsigned &Slot);
+  bool compileCall(const CallExpr *E, const IntType &Ty);
+  bool compileDeclRef(const DeclRefExpr *E, const IntType &Ty);
+
+  static bool getArithmeticOpcode(BinaryOperatorKind Kind, Opcode &Op);
+
+  Context &Program;
+  ASTContext &Ctx;
+  Function &F;
+  llvm::DenseMap<const VarDecl *, unsigned> Slots;
+  SmallVector<LoopLabels *, 4> Loops;
+};
+
+bool Compiler::getIntType(QualType T, IntType &Ty) const {
+  if (T.isNull() || T.isVolatileQualified() ||
+      !T->isIntegralOrEnumerationType())
+    return false;
+  Ty.Width = Ctx.getIntWidth(T);
+  Ty.IsUnsigned = T->isUnsignedIntegerOrEnumerationType();
+  Ty.IsBool = T->isBooleanType();
+  return true;
+}
+
+bool Compiler::compileFunction(const FunctionDecl *FD) {
+  const LangOptions &LangOpts = Ctx.getLangOpts();
+  if (!LangOpts.CPlusPlus || LangOpts.OpenCL)
+    return false;
+  if (FD->isInvalidDecl() || !FD->isConstexpr() || FD->isVariadic())
+    return false;
+  if (const CXXMethodDecl *MD = dyn_cast<CXXMethodDecl>(FD))
+    if (!MD->isStatic())
+      return false;
+  if (!getIntType(FD->getReturnType(), F.ReturnType))
+    return false;
+
+  for (const ParmVarDecl *Param : FD->parameters()) {
+    IntType Ty;
+    if (!getIntType(Param->getType(), Ty))
+      return false;
+    Slots[Param] = F.NumSlots++;
+    F.Params.push_back(Ty);
+  }
+
+  const CompoundStmt *Body = dyn_cast_or_null<CompoundStmt>(FD->getBody());
+  if (!Body || !compileStmt(Body))
+    return false;
+
+  // Flowing off the end of a function that returns a value is not a constant
+  // expression.
+  emit(Opcode::Trap);
+  return true;
+}
+
+bool Compiler::compileLoopBody(const Stmt *Body, LoopLabels &Labels) {
+  Loops.push_back(&Labels);
+  bool Compiled = compileStmt(Body);
+  Loops.pop_back();
+  return Compiled;
+}
+
+bool Compiler::compileStmt(const Stmt *S) {
+  emit(Opcode::Step);
+
+  switch (S->getStmtClass()) {
+  case Stmt::NullStmtClass:
+    return true;
+
+  case Stmt::CompoundStmtClass:
+    for (const Stmt *Child : cast<CompoundStmt>(S)->body())
+      if (!compileStmt(Child))
+        return false;
+    return true;
+
+  case Stmt::AttributedStmtClass:
+    return compileStmt(cast<AttributedStmt>(S)->getSubStmt());
+
+  case Stmt::DeclStmtClass:
+    // Like the tree walker, ignore everything but variables.
+    for (const Decl *D : cast<DeclStmt>(S)->decls())
+      if (const VarDecl *VD = dyn_cast<VarDecl>(D))
+        if (!compileLocal(VD))
+          return false;
+    return true;
+
+  case Stmt::ReturnStmtClass: {
+    const Expr *RetValue = cast<ReturnStmt>(S)->getRetValue();
+    if (!RetValue || !compileRValue(RetValue))
+      return false;
+    emit(Opcode::Ret);
+    return true;
+  }
+
+  case Stmt::IfStmtClass: {
+    const IfStmt *If = cast<IfStmt>(S);
+    if (If->getInit() || If->getConditionVariable())
+      return false;
+    if (!compileRValue(If->getCond()))
+      return false;
+    unsigned ToElse = emit(Opcode::JumpIfFalse);
+    if (const Stmt *Then = If->getThen())
+      if (!compileStmt(Then))
+        return false;
+    if (const Stmt *Else = If->getElse()) {
+      unsigned ToEnd = emit(Opcode::Jump);
+      patch(ToElse);
+      if (!compileStmt(Else))
+        return false;
+      patch(ToEnd);
+    } else {
+      patch(ToElse);
+    }
+    return true;
+  }
+
+  case Stmt::WhileStmtClass: {
+    const WhileStmt *While = cast<WhileStmt>(S);
+    if (While->getConditionVariable())
+      return false;
+    LoopLabels Labels;
+    unsigned Cond = F.Code.size();
+    if (!compileRValue(While->getCond()))
+      return false;
+    unsigned ToEnd = emit(Opcode::JumpIfFalse);
+    if (!compileLoopBody(While->getBody(), Labels))
+      return false;
+    emit(Opcode::Jump, IntType(), Cond);
+    patch(ToEnd);
+    patch(Labels.Breaks, F.Code.size());
+    patch(Labels.Continues, Cond);
+    return true;
+  }
+
+  case Stmt::DoStmtClass: {
+    const DoStmt *Do = cast<DoStmt>(S);
+    LoopLabels Labels;
+    unsigned Start = F.Code.size();
+    if (!compileLoopBody(Do->getBody(), Labels))
+      return false;
+    unsigned Cond = F.Code.size();
+    if (!compileRValue(Do->getCond()))
+      return false;
+    emit(Opcode::JumpIfTrue, IntType(), Start);
+    patch(Labels.Breaks, F.Code.size());
+    patch(Labels.Continues, Cond);
+    return true;
+  }
+
+  case Stmt::ForStmtClass: {
+    const ForStmt *For = cast<ForStmt>(S);
+    if (For->getConditionVariable())
+      return false;
+    if (const Stmt *Init = For->getInit())
+      if (!compileStmt(Init))
+        return false;
+    LoopLabels Labels;
+    unsigned Cond = F.Code.size();
+    Optional<unsigned> ToEnd;
+    if (const Expr *CondExpr = For->getCond()) {
+      if (!compileRValue(CondExpr))
+        return false;
+      ToEnd = emit(Opcode::JumpIfFalse);
+    }
+    if (!compileLoopBody(For->getBody(), Labels))
+      return false;
+    unsigned Inc = F.Code.size();
+    if (const Expr *IncExpr = For->getInc())
+      if (!compileDiscarded(IncExpr))
+        return false;
+    emit(Opcode::Jump, IntType(), Cond);
+    if (ToEnd)
+      patch(*ToEnd);
+    patch(Labels.Breaks, F.Code.size());
+    patch(Labels.Continues, Inc);
+    return true;
+  }
+
+  case Stmt::BreakStmtClass:
+    if (Loops.empty())
+      return false;
+    Loops.back()->Breaks.push_back(emit(Opcode::Jump));
+    return true;
+
+  case Stmt::ContinueStmtClass:
+    if (Loops.empty())
+      return false;
+    Loops.back()->Continues.push_back(emit(Opcode::Jump));
+    return true;
+
+  default:
+    if (const Expr *E = dyn_cast<Expr>(S))
+      return compileDiscarded(E);
+    return false;
+  }
+}
+
+bool Compiler::compileLocal(const VarDecl *VD) {
+  if (isa<DecompositionDecl>(VD) || !VD->hasLocalStorage())
+    return false;
+  IntType Ty;
+  if (!getIntType(VD->getType(), Ty))
+    return false;
+
+  // The variable is uninitialized until its initializer has been evaluated,
+  // including when the declaration is reached again in a loop.
+  unsigned Slot = F.NumSlots++;
+  Slots[VD] = Slot;
+  emit(Opcode::Kill, IntType(), Slot);
+
+  const Expr *Init = VD->getInit();
+  if (!Init)
+    return true;
+  if (const InitListExpr *ILE = dyn_cast<InitListExpr>(Init)) {
+    if (ILE->getNumInits() == 0) {
+      emitConst(APSInt(APInt(Ty.Width, 0), Ty.IsUnsigned), Ty);
+      emit(Opcode::Store, Ty, Slot);
+      return true;
+    }
+    if (ILE->getNumInits() != 1)
+      return false;
+    Init = ILE->getInit(0);
+  }
+  if (!compileRValue(Init))
+    return false;
+  emit(Opcode::Store, Ty, Slot);
+  return true;
+}
+
+bool Compiler::compileDiscarded(const Expr *E) {
+  if (const CastExpr *CE = dyn_cast<CastExpr>(E))
+    if (CE->getCastKind() == CK_ToVoid)
+      return compileDiscarded(CE->getSubExpr());
+  if (const ParenExpr *PE = dyn_cast<ParenExpr>(E))
+    return compileDiscarded(PE->getSubExpr());
+  if (const ExprWithCleanups *EWC = dyn_cast<ExprWithCleanups>(E))
+    return compileDiscarded(EWC->getSubExpr());
+
+  if (E->isGLValue()) {
+    unsigned Slot;
+    return compileLValue(E, Slot);
+  }
+
+  if (!compileRValue(E))
+    return false;
+  emit(Opcode::Pop);
+  return true;
+}
+
+bool Compiler::compileLValue(const Expr *E, unsigned &Slot) {
+  IntType Ty;
+  if (!E->isGLValue() || !getIntType(E->getType(), Ty))
+    return false;
+
+  switch (E->getStmtClass()) {
+  case Stmt::ParenExprClass:
+    return compileLValue(cast<ParenExpr>(E)->getSubExpr(), Slot);
+
+  case Stmt::DeclRefExprClass: {
+    const DeclRefExpr *DRE = cast<DeclRefExpr>(E);
+    if (DRE->refersToEnclosingVariableOrCapture())
+      return false;
+    const VarDecl *VD = dyn_cast<VarDecl>(DRE->getDecl());
+    if (!VD)
+      return false;
+    auto Known = Slots.find(VD);
+    if (Known == Slots.end())
+      return false;
+    Slot = Known->second;
+    return true;
+  }
+
+  case Stmt::UnaryOperatorClass:
+    // Prefix increment and decrement are lvalues in C++.
+    return compileIncDec(cast<UnaryOperator>(E), Slot);
+
+  case Stmt::BinaryOperatorClass:
+  case Stmt::CompoundAssignOperatorClass: {
+    const BinaryOperator *BO = cast<BinaryOperator>(E);
+    if (BO->getOpcode() == BO_Comma)
+      return compileDiscarded(BO->getLHS()) &&
+             compileLValue(BO->getRHS(), Slot);
+    return compileAssignment(BO, Slot);
+  }
+
+  default:
+    return false;
+  }
+}
+
+bool Compiler::compileIncDec(const UnaryOperator *E, unsigned &Slot) {
+  if (!E->isIncrementDecrementOp() || !Ctx.getLangOpts().CPlusPlus14)
+    return false;
+  IntType Ty;
+  if (!getIntType(E->getSubExpr()->getType(), Ty) || Ty.IsBool)
+    return false;
+  if (!compileLValue(E->getSubExpr(), Slot))
+    return false;
+
+  emit(Opcode::Load, Ty, Slot);
+  // The value of a postfix operation is the value before the update; it
+  // stays on the stack below the updated value.
+  if (E->isPostfix() && !E->isGLValue())
+    emit(Opcode::Dup, Ty);
+  emit(E->isIncrementOp() ? Opcode::Inc : Opcode::Dec, Ty, E->canOverflow());
+  emit(Opcode::Store, Ty, Slot);
+  return true;
+}
+
+bool Compiler::compileAssignment(const BinaryOperator *E, unsigned &Slot) {
+  if (!E->isAssignmentOp() || !Ctx.getLangOpts().CPlusPlus14)
+    return false;
+  IntType Ty;
+  if (!getIntType(E->getLHS()->getType(), Ty))
+    return false;
+  if (!compileLValue(E->getLHS(), Slot))
+    return false;
+
+  if (E->getOpcode() == BO_Assign) {
+    if (!compileRValue(E->getRHS()))
+      return false;
+    emit(Opcode::Store, Ty, Slot);
+    return true;
+  }
+
+  // The left operand is converted to the computation type, combined with the
+  // right operand and converted back, as in handleCompoundAssignment.
+  const CompoundAssignOperator *CAO = cast<CompoundAssignOperator>(E);
+  IntType ComputationTy;
+  Opcode Op;
+  if (!getIntType(CAO->getComputationLHSType(), ComputationTy) ||
+      !getArithmeticOpcode(BinaryOperator::getOpForCompoundAssignment(
+                               CAO->getOpcode()),
+                           Op))
+    return false;
+
+  emit(Opcode::Load, Ty, Slot);
+  emit(Opcode::Cast, ComputationTy);
+  if (!compileRValue(E->getRHS()))
+    return false;
+  emit(Op, ComputationTy);
+  emit(Opcode::Cast, Ty);
+  emit(Opcode::Store, Ty, Slot);
+  return true;
+}
+
+bool Compiler::getArithmeticOpcode(BinaryOperatorKind Kind, Opcode &Op) {
+  switch (Kind) {
+  case BO_Mul: Op = Opcode::Mul; return true;
+  case BO_Div: Op = Opcode::Div; return true;
+  case BO_Rem: Op = Opcode::Rem; return true;
+  case BO_Add: Op = Opcode::Add; return true;
+  case BO_Sub: Op = Opcode::Sub; return true;
+  case BO_Shl: Op = Opcode::Shl; return true;
+  case BO_Shr: Op = Opcode::Shr; return true;
+  case BO_And: Op = Opcode::And; return true;
+  case BO_Xor: Op = Opcode::Xor; return true;
+  case BO_Or:  Op = Opcode::Or;  return true;
+  case BO_LT:  Op = Opcode::LT;  return true;
+  case BO_GT:  Op = Opcode::GT;  return true;
+  case BO_LE:  Op = Opcode::LE;  return true;
+  case BO_GE:  Op = Opcode::GE;  return true;
+  case BO_EQ:  Op = Opcode::EQ;  return true;
+  case BO_NE:  Op = Opcode::NE;  return true;
+  default:
+    return false;
+  }
+}
+
+bool Compiler::compileRValue(const Expr *E) {
+  IntType Ty;
+  if (E->isValueDependent() || E->isGLValue() ||
+      !getIntType(E->getType(), Ty))
+    return false;
+
+  switch (E->getStmtClass()) {
+  case Stmt::IntegerLiteralClass: {
+    const APInt &Value = cast<IntegerLiteral>(E)->getValue();
+    if (Value.getBitWidth() != Ty.Width)
+      return false;
+    emitConst(APSInt(Value, Ty.IsUnsigned), Ty);
+    return true;
+  }
+
+  case Stmt::CharacterLiteralClass:
+    emitConst(Ctx.MakeIntValue(cast<CharacterLiteral>(E)->getValue(),
+                               E->getType()),
+              Ty);
+    return true;
+
+  case Stmt::CXXBoolLiteralExprClass:
+    emitConst(Ctx.MakeIntValue(cast<CXXBoolLiteralExpr>(E)->getValue(),
+                               E->getType()),
+              Ty);
+    return true;
+
+  case Stmt::UnaryExprOrTypeTraitExprClass:
+  case Stmt::TypeTraitExprClass:
+  case Stmt::ArrayTypeTraitExprClass:
+  case Stmt::ExpressionTraitExprClass:
+  case Stmt::CXXNoexceptExprClass:
+  case Stmt::SizeOfPackExprClass: {
+    // These don't depend on the values of local variables, so they can be
+    // folded once.
+    Expr::EvalResult Result;
+    if (!E->EvaluateAsInt(Result, Ctx) || Result.HasSideEffects ||
+        Result.Val.getInt().getBitWidth() != Ty.Width)
+      return false;
+    emitConst(Result.Val.getInt(), Ty);
+    return true;
+  }
+
+  case Stmt::ParenExprClass:
+    return compileRValue(cast<ParenExpr>(E)->getSubExpr());
+  case Stmt::ConstantExprClass:
+    return compileRValue(cast<ConstantExpr>(E)->getSubExpr());
+  case Stmt::ExprWithCleanupsClass:
+    return compileRValue(cast<ExprWithCleanups>(E)->getSubExpr());
+  case Stmt::CXXDefaultArgExprClass:
+    return compileRValue(cast<CXXDefaultArgExpr>(E)->getExpr());
+  case Stmt::SubstNonTypeTemplateParmExprClass:
+    return compileRValue(
+        cast<SubstNonTypeTemplateParmExpr>(E)->getReplacement());
+
+  case Stmt::DeclRefExprClass:
+    return compileDeclRef(cast<DeclRefExpr>(E), Ty);
+
+  case Stmt::ImplicitCastExprClass:
+  case Stmt::CStyleCastExprClass:
+  case Stmt::CXXFunctionalCastExprClass:
+  case Stmt::CXXStaticCastExprClass: {
+    const CastExpr *CE = cast<CastExpr>(E);
+    const Expr *SubExpr = CE->getSubExpr();
+    switch (CE->getCastKind()) {
+    case CK_LValueToRValue: {
+      if (SubExpr->getType().isVolatileQualified())
+        return false;
+      if (const DeclRefExpr *DRE =
+              dyn_cast<DeclRefExpr>(SubExpr->IgnoreParens()))
+        if (!Slots.count(dyn_cast<VarDecl>(DRE->getDecl())))
+          return compileDeclRef(DRE, Ty);
+      unsigned Slot;
+      if (!compileLValue(SubExpr, Slot))
+        return false;
+      emit(Opcode::Load, Ty, Slot);
+      return true;
+    }
+    case CK_NoOp:
+      return compileRValue(SubExpr);
+    case CK_IntegralCast:
+    case CK_IntegralToBoolean:
+      if (!compileRValue(SubExpr))
+        return false;
+      emit(Opcode::Cast, Ty);
+      return true;
+    default:
+      return false;
+    }
+  }
+
+  case Stmt::UnaryOperatorClass: {
+    const UnaryOperator *UO = cast<UnaryOperator>(E);
+    switch (UO->getOpcode()) {
+    case UO_Plus:
+    case UO_Extension:
+      return compileRValue(UO->getSubExpr());
+    case UO_Minus:
+      if (!compileRValue(UO->getSubExpr()))
+        return false;
+      emit(Opcode::Neg, Ty, UO->canOverflow());
+      return true;
+    case UO_Not:
+      if (!compileRValue(UO->getSubExpr()))
+        return false;
+      emit(Opcode::Not, Ty);
+      return true;
+    case UO_LNot:
+      if (!compileRValue(UO->getSubExpr()))
+        return false;
+      emit(Opcode::LNot, Ty);
+      return true;
+    case UO_PostInc:
+    case UO_PostDec: {
+      unsigned Slot;
+      return compileIncDec(UO, Slot);
+    }
+    default:
+      return false;
+    }
+  }
+
+  case Stmt::BinaryOperatorClass:
+    return compileBinaryOperator(cast<BinaryOperator>(E), Ty);
+
+  case Stmt::ConditionalOperatorClass: {
+    const ConditionalOperator *CO = cast<ConditionalOperator>(E);
+    if (!compileRValue(CO->getCond()))
+      return false;
+    unsigned ToFalse = emit(Opcode::JumpIfFalse);
+    if (!compileRValue(CO->getTrueExpr()))
+      return false;
+    unsigned ToEnd = emit(Opcode::Jump);
+    patch(ToFalse);
+    if (!compileRValue(CO->getFalseExpr()))
+      return false;
+    patch(ToEnd);
+    return true;
+  }
+
+  case Stmt::CallExprClass:
+    return compileCall(cast<CallExpr>(E), Ty);
+
+  default:
+    return false;
+  }
+}
+
+bool Compiler::compileDeclRef(const DeclRefExpr *E, const IntType &Ty) {
+  const ValueDecl *D = E->getDecl();
+
+  if (const EnumConstantDecl *ECD = dyn_cast<EnumConstantDecl>(D)) {
+    // Match the type of the expression, as in CheckReferencedDecl.
+    APSInt Value = ECD->getInitVal();
+    if (Value.isUnsigned() != Ty.IsUnsigned)
+      Value.setIsSigned(!Value.isSigned());
+    if (Value.getBitWidth() != Ty.Width)
+      Value = Value.extOrTrunc(Ty.Width);
+    emitConst(Value, Ty);
+    return true;
+  }
+
+  // Constexpr variables with static storage duration have a known value.
+  const VarDecl *VD = dyn_cast<VarDecl>(D);
+  if (!VD || !VD->isConstexpr() || VD->hasLocalStorage() ||
+      E->refersToEnclosingVariableOrCapture())
+    return false;
+  const VarDecl *InitDecl;
+  if (!VD->getAnyInitializer(InitDecl))
+    return false;
+  const APValue *Value = InitDecl->evaluateValue();
+  if (!Value || !Value->isInt() || Value->getInt().getBitWidth() != Ty.Width ||
+      Value->getInt().isUnsigned() != Ty.IsUnsigned)
+    return false;
+  emitConst(Value->getInt(), Ty);
+  return true;
+}
+
+bool Compiler::compileBinaryOperator(const BinaryOperator *E,
+                                     const IntType &Ty) {
+  switch (E->getOpcode()) {
+  case BO_Comma:
+    return compileDiscarded(E->getLHS()) && compileRValue(E->getRHS());
+
+  case BO_LAnd:
+  case BO_LOr:
+    return compileLogicalOperator(E, Ty);
+
+  case BO_Assign:
+  case BO_MulAssign:
+  case BO_DivAssign:
+  case BO_RemAssign:
+  case BO_AddAssign:
+  case BO_SubAssign:
+  case BO_ShlAssign:
+  case BO_ShrAssign:
+  case BO_AndAssign:
+  case BO_XorAssign:
+  case BO_OrAssign: {
+    // Assignments are prvalues in C.
+    unsigned Slot;
+    if (!compileAssignment(E, Slot))
+      return false;
+    emit(Opcode::Load, Ty, Slot);
+    return true;
+  }
+
+  default:
+    break;
+  }
+
+  Opcode Op;
+  IntType LHSTy;
+  if (!getArithmeticOpcode(E->getOpcode(), Op) ||
+      !getIntType(E->getLHS()->getType(), LHSTy))
+    return false;
+  // Apart from shifts, the usual arithmetic conversions have given both
+  // operands the same type, which is the result type of the arithmetic
+  // operators.
+  if (!E->isComparisonOp() && !isSameType(LHSTy, Ty))
+    return false;
+
+  if (!compileRValue(E->getLHS()) || !compileRValue(E->getRHS()))
+    return false;
+  emit(Op, Ty);
+  return true;
+}
+
+bool Compiler::compileLogicalOperator(const BinaryOperator *E,
+                                      const IntType &Ty) {
+  bool IsAnd = E->getOpcode() == BO_LAnd;
+  Opcode ShortCircuit = IsAnd ? Opcode::JumpIfFalse : Opcode::JumpIfTrue;
+
+  if (!compileRValue(E->getLHS()))
+    return false;
+  unsigned LHSJump = emit(ShortCircuit);
+  if (!compileRValue(E->getRHS()))
+    return false;
+  unsigned RHSJump = emit(ShortCircuit);
+
+  // Both operands were evaluated without short-circuiting.
+  emitConst(APSInt(APInt(Ty.Width, IsAnd), Ty.IsUnsigned), Ty);
+  unsigned ToEnd = emit(Opcode::Jump);
+  patch(LHSJump);
+  patch(RHSJump);
+  emitConst(APSInt(APInt(Ty.Width, !IsAnd), Ty.IsUnsigned), Ty);
+  patch(ToEnd);
+  return true;
+}
+
+bool Compiler::compileCall(const CallExpr *E, const IntType &Ty) {
+  const FunctionDecl *Callee = E->getDirectCallee();
+  if (!Callee || Callee->getBuiltinID() ||
+      E->getNumArgs() != Callee->getNumParams())
+    return false;
+  if (const CXXMethodDecl *MD = dyn_cast<CXXMethodDecl>(Callee))
+    if (!MD->isStatic())
+      return false;
+
+  // Don't start a call that can only fail. The callee is looked up again when
+  // the call is executed, as its compilation may still be in progress here.
+  const FunctionDecl *Definition = nullptr;
+  Callee->getBody(Definition);
+  if (!Definition || !Program.getFunction(Definition))
+    return false;
+
+  for (const Expr *Arg : E->arguments())
+    if (!compileRValue(Arg))
+      return false;
+
+  F.Callees.push_back(Callee);
+  emit(Opcode::Call, Ty, F.Callees.size() - 1);
+  return true;
+}
+
+//===----------------------------------------------------------------------===//
+// Interpreter
+//===----------------------------------------------------------------------===//
+
+/// Executes bytecode, sharing the step and call budgets between all the
+/// nested calls of one evaluation. Both are charged exactly as the tree
+/// walker charges them.
+class Interpreter {
+public:
+  Interpreter(Context &Ctx, unsigned &StepsLeft, unsigned CallsLeft)
+      : Ctx(Ctx), LangOpts(Ctx.Ctx.getLangOpts()), StepsLeft(StepsLeft),
+        CallsLeft(CallsLeft) {}
+
+  bool run(const Function &F, ArrayRef<APSInt> Args, APSInt &Result);
+
+private:
+  static bool hasType(const APSInt &Value, const IntType &Ty) {
+    return Value.getBitWidth() == Ty.Width &&
+           Value.isUnsigned() == Ty.IsUnsigned;
+  }
+
+  static APSInt makeBool(bool Value, const IntType &Ty) {
+    return APSInt(APInt(Ty.Width, Value), Ty.IsUnsigned);
+  }
+
+  bool evaluateBinary(Opcode Op, const IntType &Ty, const APSInt &LHS,
+                      const APSInt &RHS, APSInt &Result) const;
+
+  Context &Ctx;
+  const LangOptions &LangOpts;
+  unsigned &StepsLeft;
+  unsigned CallsLeft;
+};
+
+bool Interpreter::evaluateBinary(Opcode Op, const IntType &Ty,
+                                 const APSInt &LHS, const APSInt &RHS,
+                                 APSInt &Result) const {
+  // Comparisons take operands of any one type.
+  switch (Op) {
+  case Opcode::LT:
+  case Opcode::GT:
+  case Opcode::LE:
+  case Opcode::GE:
+  case Opcode::EQ:
+  case Opcode::NE: {
+    if (LHS.getBitWidth() != RHS.getBitWidth() ||
+        LHS.isUnsigned() != RHS.isUnsigned())
+      return false;
+    bool Value;
+    switch (Op) {
+    case Opcode::LT: Value = LHS < RHS; break;
+    case Opcode::GT: Value = LHS > RHS; break;
+    case Opcode::LE: Value = LHS <= RHS; break;
+    case Opcode::GE: Value = LHS >= RHS; break;
+    case Opcode::EQ: Value = LHS == RHS; break;
+    default:         Value = LHS != RHS; break;
+    }
+    Result = makeBool(Value, Ty);
+    return true;
+  }
+  default:
+    break;
+  }
+
+  if (!hasType(LHS, Ty))
+    return false;
+
+  // The right operand of a shift has its own type.
+  if (Op == Opcode::Shl || Op == Opcode::Shr) {
+    if (RHS.isNegative() || RHS.uge(LHS.getBitWidth()))
+      return false;
+    unsigned Amount = RHS.getZExtValue();
+    if (Op == Opcode::Shr) {
+      Result = LHS >> Amount;
+      return true;
+    }
+    // C++11 [expr.shift]p2: A signed left shift must have a non-negative
+    // operand, and must not overflow the corresponding unsigned type.
+    if (LHS.isSigned() && !LangOpts.CPlusPlus2a &&
+        (LHS.isNegative() || LHS.countLeadingZeros() < Amount))
+      return false;
+    Result = LHS << Amount;
+    return true;
+  }
+
+  if (!hasType(RHS, Ty))
+    return false;
+
+  bool Overflow = false;
+  switch (Op) {
+  case Opcode::Add:
+    Result = Ty.IsUnsigned ? LHS + RHS
+                           : APSInt(LHS.sadd_ov(RHS, Overflow), false);
+    return !Overflow;
+  case Opcode::Sub:
+    Result = Ty.IsUnsigned ? LHS - RHS
+                           : APSInt(LHS.ssub_ov(RHS, Overflow), false);
+    return !Overflow;
+  case Opcode::Mul:
+    Result = Ty.IsUnsigned ? LHS * RHS
+                           : APSInt(LHS.smul_ov(RHS, Overflow), false);
+    return !Overflow;
+  case Opcode::Div:
+  case Opcode::Rem:
+    if (RHS.isNullValue())
+      return false;
+    // INT_MIN / -1 and INT_MIN % -1 overflow.
+    if (LHS.isSigned() && LHS.isMinSignedValue() && RHS.isAllOnesValue())
+      return false;
+    Result = Op == Opcode::Div ? LHS / RHS : LHS % RHS;
+    return true;
+  case Opcode::And:
+    Result = LHS & RHS;
+    return true;
+  case Opcode::Or:
+    Result = LHS | RHS;
+    return true;
+  case Opcode::Xor:
+    Result = LHS ^ RHS;
+    return true;
+  default:
+    llvm_unreachable("not a binary operator");
+  }
+}
+
+bool Interpreter::run(const Function &F, ArrayRef<APSInt> Args,
+                      APSInt &Result) {
+  if (Args.size() != F.Params.size())
+    return false;
+
+  SmallVector<APSInt, 8> Slots(F.NumSlots);
+  SmallVector<bool, 8> Initialized(F.NumSlots, false);
+  for (unsigned I = 0, N = Args.size(); I != N; ++I) {
+    if (!hasType(Args[I], F.Params[I]))
+      return false;
+    Slots[I] = Args[I];
+    Initialized[I] = true;
+  }
+
+  SmallVector<APSInt, 16> Stack;
+  auto Pop = [&Stack]() {
+    APSInt Value = std::move(Stack.back());
+    Stack.pop_back();
+    return Value;
+  };
+
+  unsigned PC = 0;
+  while (true) {
+    const Instr &I = F.Code[PC++];
+    switch (I.Op) {
+    case Opcode::Const:
+      Stack.push_back(F.Constants[I.Arg]);
+      break;
+
+    case Opcode::Load:
+      if (!Initialized[I.Arg])
+        return false;
+      Stack.push_back(Slots[I.Arg]);
+      break;
+
+    case Opcode::Store: {
+      APSInt Value = Pop();
+      if (!hasType(Value, I.Ty))
+        return false;
+      Slots[I.Arg] = std::move(Value);
+      Initialized[I.Arg] = true;
+      break;
+    }
+
+    case Opcode::Kill:
+      Initialized[I.Arg] = false;
+      break;
+
+    case Opcode::Dup: {
+      APSInt Value = Stack.back();
+      Stack.push_back(std::move(Value));
+      break;
+    }
+
+    case Opcode::Pop:
+      Stack.pop_back();
+      break;
+
+    case Opcode::Add:
+    case Opcode::Sub:
+    case Opcode::Mul:
+    case Opcode::Div:
+    case Opcode::Rem:
+    case Opcode::Shl:
+    case Opcode::Shr:
+    case Opcode::And:
+    case Opcode::Or:
+    case Opcode::Xor:
+    case Opcode::LT:
+    case Opcode::GT:
+    case Opcode::LE:
+    case Opcode::GE:
+    case Opcode::EQ:
+    case Opcode::NE: {
+      APSInt RHS = Pop();
+      APSInt LHS = Pop();
+      APSInt Value;
+      if (!evaluateBinary(I.Op, I.Ty, LHS, RHS, Value))
+        return false;
+      Stack.push_back(std::move(Value));
+      break;
+    }
+
+    case Opcode::Neg: {
+      APSInt Value = Pop();
+      if (!hasType(Value, I.Ty) ||
+          (I.Arg && Value.isSigned() && Value.isMinSignedValue()))
+        return false;
+      Stack.push_back(-Value);
+      break;
+    }
+
+    case Opcode::Not: {
+      APSInt Value = Pop();
+      if (!hasType(Value, I.Ty))
+        return false;
+      Stack.push_back(~Value);
+      break;
+    }
+
+    case Opcode::LNot: {
+      APSInt Value = Pop();
+      Stack.push_back(makeBool(!Value.getBoolValue(), I.Ty));
+      break;
+    }
+
+    case Opcode::Inc:
+    case Opcode::Dec: {
+      APSInt Value = Pop();
+      if (!hasType(Value, I.Ty))
+        return false;
+      bool WasNegative = Value.isNegative();
+      if (I.Op == Opcode::Inc) {
+        ++Value;
+        if (I.Arg && !WasNegative && Value.isNegative())
+          return false;
+      } else {
+        --Value;
+        if (I.Arg && WasNegative && !Value.isNegative())
+          return false;
+      }
+      Stack.push_back(std::move(Value));
+      break;
+    }
+
+    case Opcode::Cast: {
+      // See HandleIntToIntCast.
+      APSInt Value = Pop();
+      if (I.Ty.IsBool) {
+        Stack.push_back(makeBool(Value.getBoolValue(), I.Ty));
+        break;
+      }
+      APSInt Converted = Value.extOrTrunc(I.Ty.Width);
+      Converted.setIsUnsigned(I.Ty.IsUnsigned);
+      Stack.push_back(std::move(Converted));
+      break;
+    }
+
+    case Opcode::Jump:
+      PC = I.Arg;
+      break;
+
+    case Opcode::JumpIfFalse:
+    case Opcode::JumpIfTrue: {
+      bool Condition = Pop().getBoolValue();
+      if (Condition == (I.Op == Opcode::JumpIfTrue))
+        PC = I.Arg;
+      break;
+    }
+
+    case Opcode::Call: {
+      const FunctionDecl *Definition = nullptr;
+      F.Callees[I.Arg]->getBody(Definition);
+      if (!Definition)
+        return false;
+      const Function *Callee = Ctx.getFunction(Definition);
+      if (!Callee || !CallsLeft)
+        return false;
+
+      unsigned NumArgs = Callee->Params.size();
+      if (Stack.size() < NumArgs)
+        return false;
+      SmallVector<APSInt, 4> CallArgs(Stack.end() - NumArgs, Stack.end());
+      Stack.erase(Stack.end() - NumArgs, Stack.end());
+
+      APSInt Value;
+      --CallsLeft;
+      bool Evaluated = run(*Callee, CallArgs, Value);
+      ++CallsLeft;
+      if (!Evaluated || !hasType(Value, I.Ty))
+        return false;
+      Stack.push_back(std::move(Value));
+      break;
+    }
+
+    case Opcode::Ret: {
+      APSInt Value = Pop();
+      if (!hasType(Value, F.ReturnType))
+        return false;
+      Result = std::move(Value);
+      return true;
+    }
+
+    case Opcode::Trap:
+      return false;
+
+    case Opcode::Step:
+      if (!StepsLeft)
+        return false;
+      --StepsLeft;
+      break;
+    }
+  }
+}
+
+//===----------------------------------------------------------------------===//
+// Context
+//===----------------------------------------------------------------------===//
+
+Context::Context(ASTContext &Ctx) : Ctx(Ctx) {}
+
+Context::~Context() {}
+
+const Function *Context::getFunction(const FunctionDecl *FD) {
+  auto Known = Functions.find(FD);
+  if (Known != Functions.end())
+    return Known->second.get();
+
+  // Register the function before compiling it, so that recursive calls find
+  // it.
+  auto F = llvm::make_unique<Function>();
+  Function *Result = F.get();
+  Functions[FD] = std::move(F);
+  if (Compiler(*this, *Result).compileFunction(FD))
+    return Result;
+  Functions[FD].reset();
+  return nullptr;
+}
+
+bool Context::isCompilable(const FunctionDecl *FD) {
+  return getFunction(FD);
+}
+
+bool Context::evaluateCall(const FunctionDecl *FD, ArrayRef<APSInt> Args,
+                           unsigned &StepsLeft, unsigned CallsLeft,
+                           APSInt &Result) {
+  const Function *F = getFunction(FD);
+  if (!F)
+    return false;
+
+  unsigned Steps = StepsLeft;
+  if (!Interpreter(*this, Steps, CallsLeft).run(*F, Args, Result))
+    return false;
+  StepsLeft = Steps;
+  return true;
+}
+
+} // namespace interp
+} // namespace clang
@@ -0,0 +1,81 @@
+//===--- ByteCodeInterp.h - Bytecode interpreter for constexpr --*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// This file defines a bytecode compiler and interpreter for constexpr
+// functions that only compute with integers. With
+// -fexperimental-new-constant-interpreter, ExprConstant tries it before
+// walking the body of a called function. Each function body is compiled once
+// and the bytecode is cached per FunctionDecl.
+//
+// The interpreter never produces diagnostics. Whenever it meets a construct
+// it does not support, or an evaluation that is not a constant expression,
+// it fails and the tree walker evaluates the call and diagnoses it.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_CLANG_LIB_AST_BYTECODEINTERP_H
+#define LLVM_CLANG_LIB_AST_BYTECODEINTERP_H
+
+#include "clang/Basic/LLVM.h"
+#include "llvm/ADT/APSInt.h"
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/DenseMap.h"
+#include <memory>
+
+namespace clang {
+class ASTContext;
+class FunctionDecl;
+
+namespace interp {
+class Compiler;
+class Function;
+class Interpreter;
+
+/// Holds the bytecode of the functions compiled so far.
+class Context {
+public:
+  explicit Context(ASTContext &Ctx);
+  ~Context();
+
+  /// Evaluate a call to the function definition \p FD with the arguments
+  /// \p Args.
+  ///
+  /// \param StepsLeft The remaining evaluation steps. Each statement takes one
+  /// step, as in the tree walker. Only updated if the evaluation succeeds.
+  ///
+  /// \param CallsLeft The number of nested calls that may be active at once.
+  ///
+  /// \returns true and sets \p Result if the call was evaluated. Returns false
+  /// if \p FD cannot be compiled or if the call is not a constant expression.
+  bool evaluateCall(const FunctionDecl *FD, ArrayRef<llvm::APSInt> Args,
+                    unsigned &StepsLeft, unsigned CallsLeft,
+                    llvm::APSInt &Result);
+
+  /// Returns true if \p FD can be compiled, so that evaluateCall only fails
+  /// on calls that are not constant expressions.
+  bool isCompilable(const FunctionDecl *FD);
+
+private:
+  friend class Compiler;
+  friend class Interpreter;
+
+  /// Returns the bytecode for the definition \p FD, compiling it on first
+  /// use, or null if it uses constructs the compiler does not support.
+  const Function *getFunction(const FunctionDecl *FD);
+
+  ASTContext &Ctx;
+
+  /// The compiled functions. Functions that could not be compiled map to
+  /// null, so they are not compiled again.
+  llvm::DenseMap<const FunctionDecl *, std::unique_ptr<Function>> Functions;
+};
+
+} // namespace interp
+} // namespace clang
+
+#endif
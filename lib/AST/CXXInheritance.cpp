@@ -89,9 +89,24 @@ void CXXBasePaths::swap(CXXBasePaths &Other) {
 }
 
 bool CXXRecordDecl::isDerivedFrom(const CXXRecordDecl *Base) const {
+  // Sema and CodeGen ask the same questions over and over, remember the
+  // answers for the classes whose bases are final.
+  const CXXRecordDecl *Def = getDefinition();
+  bool Cacheable = Def && !Def->isBeingDefined();
+  auto Key = std::make_pair(getCanonicalDecl(), Base->getCanonicalDecl());
+  auto &Cache = getASTContext().DerivedFromCache;
+  if (Cacheable) {
+    auto It = Cache.find(Key);
+    if (It != Cache.end())
+      return It->second;
+  }
+
   CXXBasePaths Paths(/*FindAmbiguities=*/false, /*RecordPaths=*/false,
                      /*DetectVirtual=*/false);
-  return isDerivedFrom(Base, Paths);
+  bool Result = isDerivedFrom(Base, Paths);
+  if (Cacheable)
+    Cache[Key] = Result;
+  return Result;
 }
 
 bool CXXRecordDecl::isDerivedFrom(const CXXRecordDecl *Base,
@@ -0,0 +1,71 @@
+//===--- ConstexprCallCache.cpp - Memoized constexpr call results ---------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// This file implements the cache of constexpr call results.
+//
+//===----------------------------------------------------------------------===//
+
+#include "ConstexprCallCache.h"
+#include "llvm/Support/raw_ostream.h"
+
+using namespace clang;
+
+bool ConstexprCallCache::isCacheable(ArrayRef<APValue> Args) {
+  for (const APValue &Arg : Args)
+    if (!isCacheableValue(Arg))
+      return false;
+  return true;
+}
+
+void ConstexprCallCache::Profile(llvm::FoldingSetNodeID &ID,
+                                 const FunctionDecl *FD,
+                                 ArrayRef<APValue> Args, unsigned Mode) {
+  ID.AddPointer(FD);
+  ID.AddInteger(Mode);
+  for (const APValue &Arg : Args) {
+    ID.AddInteger(unsigned(Arg.getKind()));
+    if (Arg.isInt()) {
+      Arg.getInt().Profile(ID);
+    } else {
+      // Distinguish between floating point types of the same size.
+      ID.AddPointer(&Arg.getFloat().getSemantics());
+      Arg.getFloat().bitcastToAPInt().Profile(ID);
+    }
+  }
+}
+
+const ConstexprCallCache::Entry *
+ConstexprCallCache::lookup(const FunctionDecl *FD, ArrayRef<APValue> Args,
+                           unsigned Mode, llvm::FoldingSetNodeID &Key) {
+  Profile(Key, FD, Args, Mode);
+  void *InsertPos;
+  if (Node *N = Nodes.FindNodeOrInsertPos(Key, InsertPos)) {
+    ++NumHits;
+    return &N->E;
+  }
+  ++NumMisses;
+  return nullptr;
+}
+
+void ConstexprCallCache::insert(const llvm::FoldingSetNodeID &Key,
+                                const Entry &E) {
+  if (NumEntries == MaxEntries)
+    return;
+  // Calls made while evaluating this one may have been inserted since the
+  // lookup, so the insert position has to be found again.
+  void *InsertPos;
+  if (Nodes.FindNodeOrInsertPos(Key, InsertPos))
+    return;
+  Nodes.InsertNode(new (Allocator.Allocate()) Node(Key, E), InsertPos);
+  ++NumEntries;
+}
+
+void ConstexprCallCache::PrintStats() const {
+  llvm::errs() << "  " << NumEntries << " constexpr call results cached, "
+               << NumHits << " hits, " << NumMisses << " misses.\n";
+}
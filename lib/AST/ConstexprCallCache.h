@@ -0,0 +1,86 @@
+//===--- ConstexprCallCache.h - Memoized constexpr call results -*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// This file defines a cache of the results of constexpr function calls whose
+// arguments and result are integers or floating point values. ExprConstant
+// only records a call if its evaluation did not touch any state outside of
+// its own frames and did not produce any note, so a later call with the same
+// arguments, in the same kind of evaluation, must produce the same value.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_CLANG_LIB_AST_CONSTEXPRCALLCACHE_H
+#define LLVM_CLANG_LIB_AST_CONSTEXPRCALLCACHE_H
+
+#include "clang/AST/APValue.h"
+#include "clang/Basic/LLVM.h"
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/FoldingSet.h"
+#include "llvm/Support/Allocator.h"
+
+namespace clang {
+class FunctionDecl;
+
+class ConstexprCallCache {
+public:
+  /// The result of a call, with the resources its evaluation needed.
+  struct Entry {
+    APValue Result;
+    /// The number of evaluation steps taken by the call.
+    unsigned Steps;
+    /// The call stack depth at which the call was evaluated. Deeper calls
+    /// may run out of stack, so the entry is not used for them.
+    unsigned Depth;
+  };
+
+  /// Whether calls with the arguments \p Args, or returning \p Result, can be
+  /// cached at all.
+  static bool isCacheableValue(const APValue &V) {
+    return V.isInt() || V.isFloat();
+  }
+  static bool isCacheable(ArrayRef<APValue> Args);
+
+  /// Returns the cached result of calling \p FD with \p Args, or null.
+  ///
+  /// \param Mode Identifies the kind of evaluation, which may change the
+  /// result of the call.
+  ///
+  /// \param Key Set to the key to pass to insert() once the call has been
+  /// evaluated.
+  const Entry *lookup(const FunctionDecl *FD, ArrayRef<APValue> Args,
+                      unsigned Mode, llvm::FoldingSetNodeID &Key);
+
+  /// Record the result of the call identified by \p Key. Does nothing once
+  /// the cache is full.
+  void insert(const llvm::FoldingSetNodeID &Key, const Entry &E);
+
+  void PrintStats() const;
+
+private:
+  struct Node : llvm::FastFoldingSetNode {
+    Node(const llvm::FoldingSetNodeID &ID, const Entry &E)
+        : FastFoldingSetNode(ID), E(E) {}
+    Entry E;
+  };
+
+  static void Profile(llvm::FoldingSetNodeID &ID, const FunctionDecl *FD,
+                      ArrayRef<APValue> Args, unsigned Mode);
+
+  /// The maximum number of recorded calls.
+  static constexpr unsigned MaxEntries = 1 << 16;
+
+  llvm::FoldingSet<Node> Nodes;
+  llvm::SpecificBumpPtrAllocator<Node> Allocator;
+  unsigned NumEntries = 0;
+  unsigned NumHits = 0;
+  unsigned NumMisses = 0;
+};
+
+} // namespace clang
+
+#endif
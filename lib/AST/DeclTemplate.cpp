@@ -17,6 +17,7 @@
 #include "clang/AST/DeclarationName.h"
 #include "clang/AST/Expr.h"
 #include "clang/AST/ExternalASTSource.h"
+#include "clang/AST/ODRHash.h"
 #include "clang/AST/TemplateBase.h"
 #include "clang/AST/TemplateName.h"
 #include "clang/AST/Type.h"
@@ -182,16 +183,74 @@ RedeclarableTemplateDecl::CommonBase *RedeclarableTemplateDecl::getCommonPtr() c
   return Common;
 }
 
-void RedeclarableTemplateDecl::loadLazySpecializationsImpl() const {
+static void addSpecializationHash(llvm::FoldingSetNodeID &ID,
+                                  const TemplateArgument &Arg) {
+  ID.AddInteger(Arg.getKind());
+  switch (Arg.getKind()) {
+  case TemplateArgument::Type: {
+    ODRHash Hash;
+    Hash.AddQualType(Arg.getAsType().getCanonicalType());
+    ID.AddInteger(Hash.CalculateHash());
+    break;
+  }
+  case TemplateArgument::Integral:
+    Arg.getAsIntegral().Profile(ID);
+    break;
+  case TemplateArgument::Pack:
+    ID.AddInteger(Arg.pack_size());
+    for (const TemplateArgument &Elt : Arg.pack_elements())
+      addSpecializationHash(ID, Elt);
+    break;
+  default:
+    // The remaining kinds only contribute their kind to the hash.
+    break;
+  }
+}
+
+unsigned RedeclarableTemplateDecl::computeSpecializationHash(
+    ArrayRef<TemplateArgument> Args) {
+  llvm::FoldingSetNodeID ID;
+  ID.AddInteger(Args.size());
+  for (const TemplateArgument &Arg : Args)
+    addSpecializationHash(ID, Arg);
+  return ID.ComputeHash();
+}
+
+void RedeclarableTemplateDecl::loadLazySpecializationsImpl(
+    bool OnlyPartial) const {
   // Grab the most recent declaration to ensure we've loaded any lazy
   // redeclarations of this template.
   CommonBase *CommonBasePtr = getMostRecentDecl()->getCommonPtr();
-  if (CommonBasePtr->LazySpecializations) {
+  if (LazySpecializationInfo *Specs = CommonBasePtr->LazySpecializations) {
     ASTContext &Context = getASTContext();
-    uint32_t *Specs = CommonBasePtr->LazySpecializations;
-    CommonBasePtr->LazySpecializations = nullptr;
-    for (uint32_t I = 0, N = *Specs++; I != N; ++I)
-      (void)Context.getExternalSource()->GetExternalDecl(Specs[I]);
+    if (!OnlyPartial)
+      CommonBasePtr->LazySpecializations = nullptr;
+    for (uint32_t I = 0, N = Specs[0].DeclID; I != N; ++I) {
+      LazySpecializationInfo &Spec = Specs[I + 1];
+      if (!Spec.DeclID || (OnlyPartial && !Spec.IsPartial))
+        continue;
+      uint32_t ID = Spec.DeclID;
+      Spec.DeclID = 0;
+      (void)Context.getExternalSource()->GetExternalDecl(ID);
+    }
+  }
+}
+
+void RedeclarableTemplateDecl::loadLazySpecializationsImpl(
+    ArrayRef<TemplateArgument> Args) const {
+  CommonBase *CommonBasePtr = getMostRecentDecl()->getCommonPtr();
+  if (LazySpecializationInfo *Specs = CommonBasePtr->LazySpecializations) {
+    ASTContext &Context = getASTContext();
+    unsigned Hash = computeSpecializationHash(Args);
+    for (uint32_t I = 0, N = Specs[0].DeclID; I != N; ++I) {
+      LazySpecializationInfo &Spec = Specs[I + 1];
+      if (!Spec.DeclID || Spec.ArgsHash != Hash)
+        continue;
+      // Mark the entry first, loading it may add new lazy specializations.
+      uint32_t ID = Spec.DeclID;
+      Spec.DeclID = 0;
+      (void)Context.getExternalSource()->GetExternalDecl(ID);
+    }
   }
 }
 
@@ -202,6 +261,9 @@ RedeclarableTemplateDecl::findSpecializationImpl(
     void *&InsertPos) {
   using SETraits = SpecEntryTraits<EntryType>;
 
+  // Only deserialize the specializations that may match Args.
+  loadLazySpecializationsImpl(Args);
+
   llvm::FoldingSetNodeID ID;
   EntryType::Profile(ID, Args, getASTContext());
   EntryType *Entry = Specs.FindNodeOrInsertPos(ID, InsertPos);
@@ -225,6 +287,7 @@ void RedeclarableTemplateDecl::addSpecializationImpl(
 #endif
     Specializations.InsertNode(Entry, InsertPos);
   } else {
+    loadLazySpecializationsImpl(SETraits::getTemplateArgs(Entry));
     EntryType *Existing = Specializations.GetOrInsertNode(Entry);
     (void)Existing;
     assert(SETraits::getDecl(Existing)->isCanonicalDecl() &&
@@ -276,13 +339,15 @@ FunctionTemplateDecl::getSpecializations() const {
 FunctionDecl *
 FunctionTemplateDecl::findSpecialization(ArrayRef<TemplateArgument> Args,
                                          void *&InsertPos) {
-  return findSpecializationImpl(getSpecializations(), Args, InsertPos);
+  return findSpecializationImpl(getCommonPtr()->Specializations, Args,
+                                InsertPos);
 }
 
 void FunctionTemplateDecl::addSpecialization(
       FunctionTemplateSpecializationInfo *Info, void *InsertPos) {
-  addSpecializationImpl<FunctionTemplateDecl>(getSpecializations(), Info,
-                                              InsertPos);
+  // Loading the other specializations here would invalidate InsertPos.
+  addSpecializationImpl<FunctionTemplateDecl>(getCommonPtr()->Specializations,
+                                              Info, InsertPos);
 }
 
 ArrayRef<TemplateArgument> FunctionTemplateDecl::getInjectedTemplateArgs() {
@@ -377,7 +442,7 @@ ClassTemplateDecl::getSpecializations() const {
 
 llvm::FoldingSetVector<ClassTemplatePartialSpecializationDecl> &
 ClassTemplateDecl::getPartialSpecializations() {
-  LoadLazySpecializations();
+  loadLazySpecializationsImpl(/*OnlyPartial=*/true);
   return getCommonPtr()->PartialSpecializations;
 }
 
@@ -391,28 +456,34 @@ ClassTemplateDecl::newCommon(ASTContext &C) const {
 ClassTemplateSpecializationDecl *
 ClassTemplateDecl::findSpecialization(ArrayRef<TemplateArgument> Args,
                                       void *&InsertPos) {
-  return findSpecializationImpl(getSpecializations(), Args, InsertPos);
+  return findSpecializationImpl(getCommonPtr()->Specializations, Args,
+                                InsertPos);
 }
 
 void ClassTemplateDecl::AddSpecialization(ClassTemplateSpecializationDecl *D,
                                           void *InsertPos) {
-  addSpecializationImpl<ClassTemplateDecl>(getSpecializations(), D, InsertPos);
+  // Loading the other specializations here would invalidate InsertPos.
+  addSpecializationImpl<ClassTemplateDecl>(getCommonPtr()->Specializations, D,
+                                           InsertPos);
 }
 
 ClassTemplatePartialSpecializationDecl *
 ClassTemplateDecl::findPartialSpecialization(ArrayRef<TemplateArgument> Args,
                                              void *&InsertPos) {
-  return findSpecializationImpl(getPartialSpecializations(), Args, InsertPos);
+  return findSpecializationImpl(getCommonPtr()->PartialSpecializations, Args,
+                                InsertPos);
 }
 
 void ClassTemplateDecl::AddPartialSpecialization(
                                       ClassTemplatePartialSpecializationDecl *D,
                                       void *InsertPos) {
+  auto &PartialSpecs = getCommonPtr()->PartialSpecializations;
   if (InsertPos)
-    getPartialSpecializations().InsertNode(D, InsertPos);
+    PartialSpecs.InsertNode(D, InsertPos);
   else {
+    loadLazySpecializationsImpl(D->getTemplateArgs().asArray());
     ClassTemplatePartialSpecializationDecl *Existing
-      = getPartialSpecializations().GetOrInsertNode(D);
+      = PartialSpecs.GetOrInsertNode(D);
     (void)Existing;
     assert(Existing->isCanonicalDecl() && "Non-canonical specialization?");
   }
@@ -1002,7 +1073,7 @@ VarTemplateDecl::getSpecializations() const {
 
 llvm::FoldingSetVector<VarTemplatePartialSpecializationDecl> &
 VarTemplateDecl::getPartialSpecializations() {
-  LoadLazySpecializations();
+  loadLazySpecializationsImpl(/*OnlyPartial=*/true);
   return getCommonPtr()->PartialSpecializations;
 }
 
@@ -1016,27 +1087,33 @@ VarTemplateDecl::newCommon(ASTContext &C) const {
 VarTemplateSpecializationDecl *
 VarTemplateDecl::findSpecialization(ArrayRef<TemplateArgument> Args,
                                     void *&InsertPos) {
-  return findSpecializationImpl(getSpecializations(), Args, InsertPos);
+  return findSpecializationImpl(getCommonPtr()->Specializations, Args,
+                                InsertPos);
 }
 
 void VarTemplateDecl::AddSpecialization(VarTemplateSpecializationDecl *D,
                                         void *InsertPos) {
-  addSpecializationImpl<VarTemplateDecl>(getSpecializations(), D, InsertPos);
+  // Loading the other specializations here would invalidate InsertPos.
+  addSpecializationImpl<VarTemplateDecl>(getCommonPtr()->Specializations, D,
+                                         InsertPos);
 }
 
 VarTemplatePartialSpecializationDecl *
 VarTemplateDecl::findPartialSpecialization(ArrayRef<TemplateArgument> Args,
                                            void *&InsertPos) {
-  return findSpecializationImpl(getPartialSpecializations(), Args, InsertPos);
+  return findSpecializationImpl(getCommonPtr()->PartialSpecializations, Args,
+                                InsertPos);
 }
 
 void VarTemplateDecl::AddPartialSpecialization(
     VarTemplatePartialSpecializationDecl *D, void *InsertPos) {
+  auto &PartialSpecs = getCommonPtr()->PartialSpecializations;
   if (InsertPos)
-    getPartialSpecializations().InsertNode(D, InsertPos);
+    PartialSpecs.InsertNode(D, InsertPos);
   else {
+    loadLazySpecializationsImpl(D->getTemplateArgs().asArray());
     VarTemplatePartialSpecializationDecl *Existing =
-        getPartialSpecializations().GetOrInsertNode(D);
+        PartialSpecs.GetOrInsertNode(D);
     (void)Existing;
     assert(Existing->isCanonicalDecl() && "Non-canonical specialization?");
   }
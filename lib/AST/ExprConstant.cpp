@@ -32,6 +32,8 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include "ByteCodeInterp.h"
+#include "ConstexprCallCache.h"
 #include "clang/AST/APValue.h"
 #include "clang/AST/ASTContext.h"
 #include "clang/AST/ASTDiagnostic.h"
@@ -794,6 +796,20 @@ namespace {
     /// constant value.
     bool InConstantContext;
 
+    /// Whether calls to non-constexpr functions with an available body may be
+    /// evaluated. Used by Cheerp to fold dynamic global initializers.
+    bool AllowNonConstexprCalls;
+
+    /// The number of notes, side-effects and accesses to the object whose
+    /// initializer is being evaluated seen so far. The result of a call is
+    /// only cached if this did not change while evaluating it.
+    unsigned NumUncacheableEvents = 0;
+
+    /// Whether the bytecode interpreter failed on an enclosing call. The calls
+    /// it makes are then not retried with the interpreter, which would
+    /// evaluate them again only to fail at the same point.
+    bool InterpreterFailed = false;
+
     enum EvaluationMode {
       /// Evaluate as a constant expression. Stop if we find that the expression
       /// is not a constant expression.
@@ -855,7 +871,8 @@ namespace {
         EvaluatingDecl((const ValueDecl *)nullptr),
         EvaluatingDeclValue(nullptr), HasActiveDiagnostic(false),
         HasFoldFailureDiagnostic(false),
-        InConstantContext(false), EvalMode(Mode) {}
+        InConstantContext(false), AllowNonConstexprCalls(false),
+        EvalMode(Mode) {}
 
     void setEvaluatingDecl(APValue::LValueBase Base, APValue &Value) {
       EvaluatingDecl = Base;
@@ -971,12 +988,14 @@ namespace {
     FFDiag(SourceLocation Loc,
           diag::kind DiagId = diag::note_invalid_subexpr_in_const_expr,
           unsigned ExtraNotes = 0) {
+      ++NumUncacheableEvents;
       return Diag(Loc, DiagId, ExtraNotes, false);
     }
 
     OptionalDiagnostic FFDiag(const Expr *E, diag::kind DiagId
                               = diag::note_invalid_subexpr_in_const_expr,
                             unsigned ExtraNotes = 0) {
+      ++NumUncacheableEvents;
       if (EvalStatus.Diag)
         return Diag(E->getExprLoc(), DiagId, ExtraNotes, /*IsCCEDiag*/false);
       HasActiveDiagnostic = false;
@@ -991,6 +1010,7 @@ namespace {
     OptionalDiagnostic CCEDiag(SourceLocation Loc, diag::kind DiagId
                                  = diag::note_invalid_subexpr_in_const_expr,
                                unsigned ExtraNotes = 0) {
+      ++NumUncacheableEvents;
       // Don't override a previous diagnostic. Don't bother collecting
       // diagnostics if we're evaluating for overflow.
       if (!EvalStatus.Diag || !EvalStatus.Diag->empty()) {
@@ -1040,6 +1060,7 @@ namespace {
     /// Note that we have had a side-effect, and determine whether we should
     /// keep evaluating.
     bool noteSideEffect() {
+      ++NumUncacheableEvents;
       EvalStatus.HasSideEffects = true;
       return keepEvaluatingAfterSideEffect();
     }
@@ -1065,6 +1086,7 @@ namespace {
     /// that we can evaluate past it (such as signed overflow or floating-point
     /// division by zero.)
     bool noteUndefinedBehavior() {
+      ++NumUncacheableEvents;
       EvalStatus.HasUndefinedBehavior = true;
       return keepEvaluatingAfterUndefinedBehavior();
     }
@@ -2031,8 +2053,10 @@ static bool CheckLiteralType(EvalInfo &Info, const Expr *E,
   // volatile member of the union). See:
   //   http://www.open-std.org/jtc1/sc22/wg21/docs/cwg_active.html#1677
   // Therefore, we use the C++1y behavior.
-  if (This && Info.EvaluatingDecl == This->getLValueBase())
+  if (This && Info.EvaluatingDecl == This->getLValueBase()) {
+    ++Info.NumUncacheableEvents;
     return true;
+  }
 
   // Prvalue constant expressions must be of literal types.
   if (Info.getLangOpts().CPlusPlus11)
@@ -2727,6 +2751,7 @@ static bool evaluateVarDeclInit(EvalInfo &Info, const Expr *E,
   // If we're currently evaluating the initializer of this declaration, use that
   // in-flight value.
   if (Info.EvaluatingDecl.dyn_cast<const ValueDecl*>() == VD) {
+    ++Info.NumUncacheableEvents;
     Result = Info.EvaluatingDeclValue;
     return true;
   }
@@ -2924,15 +2949,19 @@ static bool lifetimeStartedInEvaluation(EvalInfo &Info,
 
   // The variable whose initializer we're evaluating.
   if (auto *BaseD = Base.dyn_cast<const ValueDecl*>())
-    if (declaresSameEntity(Evaluating, BaseD))
+    if (declaresSameEntity(Evaluating, BaseD)) {
+      ++Info.NumUncacheableEvents;
       return true;
+    }
 
   // A temporary lifetime-extended by the variable whose initializer we're
   // evaluating.
   if (auto *BaseE = Base.dyn_cast<const Expr *>())
     if (auto *BaseMTE = dyn_cast<MaterializeTemporaryExpr>(BaseE))
-      if (declaresSameEntity(BaseMTE->getExtendingDecl(), Evaluating))
+      if (declaresSameEntity(BaseMTE->getExtendingDecl(), Evaluating)) {
+        ++Info.NumUncacheableEvents;
         return true;
+      }
 
   return false;
 }
@@ -3391,6 +3420,7 @@ static CompleteObject findCompleteObject(EvalInfo &Info, const Expr *E,
         // OK, we can read and modify an object if we're in the process of
         // evaluating its initializer, because its lifetime began in this
         // evaluation.
+        ++Info.NumUncacheableEvents;
       } else if (isModification(AK)) {
         // All the remaining cases do not permit modification of the object.
         Info.FFDiag(E, diag::note_constexpr_modify_global);
@@ -3480,6 +3510,8 @@ static CompleteObject findCompleteObject(EvalInfo &Info, const Expr *E,
           Info.Note(MTE->getExprLoc(), diag::note_constexpr_temporary_here);
           return CompleteObject();
         }
+        if (VD && VD->getCanonicalDecl() == ED->getCanonicalDecl())
+          ++Info.NumUncacheableEvents;
 
         BaseVal = Info.Ctx.getMaterializedTemporaryValue(MTE, false);
         assert(BaseVal && "got reference to unevaluated temporary");
@@ -4564,7 +4596,8 @@ static bool CheckConstexprFunction(EvalInfo &Info, SourceLocation CallLoc,
   }
 
   // Can we evaluate this function call?
-  if (Definition && Definition->isConstexpr() && Body)
+  if (Definition && Body &&
+      (Definition->isConstexpr() || Info.AllowNonConstexprCalls))
     return true;
 
   if (Info.getLangOpts().CPlusPlus11) {
@@ -5136,6 +5169,44 @@ static bool EvaluateArgs(ArrayRef<const Expr *> Args, ArgVector &ArgValues,
   return Success;
 }
 
+/// Try to evaluate a call to \p Callee with the bytecode interpreter. Returns
+/// false, without diagnosing anything, if the interpreter does not handle the
+/// call; the caller should then evaluate it by walking the body. Sets
+/// InterpreterFailed if the call was started but is not a constant expression.
+static bool evaluateCallWithInterpreter(EvalInfo &Info,
+                                        const FunctionDecl *Callee,
+                                        ArrayRef<APValue> ArgValues,
+                                        APValue &Result) {
+  SmallVector<APSInt, 8> Args;
+  for (const APValue &Arg : ArgValues) {
+    if (!Arg.isInt())
+      return false;
+    Args.push_back(Arg.getInt());
+  }
+
+  interp::Context &Interp = Info.Ctx.getInterpContext();
+  if (!Interp.isCompilable(Callee))
+    return false;
+  unsigned CallsLeft =
+      Info.getLangOpts().ConstexprCallDepth - Info.CallStackDepth;
+  APSInt Value;
+  if (!Interp.evaluateCall(Callee, Args, Info.StepsLeft, CallsLeft, Value)) {
+    Info.InterpreterFailed = true;
+    return false;
+  }
+  Result = APValue(Value);
+  return true;
+}
+
+static bool EvaluateFunctionBody(SourceLocation CallLoc,
+                                 const FunctionDecl *Callee,
+                                 const LValue *This,
+                                 ArrayRef<const Expr *> Args,
+                                 MutableArrayRef<APValue> ArgValues,
+                                 const Stmt *Body,
+                                 EvalInfo &Info, APValue &Result,
+                                 const LValue *ResultSlot);
+
 /// Evaluate a function call.
 static bool HandleFunctionCall(SourceLocation CallLoc,
                                const FunctionDecl *Callee, const LValue *This,
@@ -5149,6 +5220,58 @@ static bool HandleFunctionCall(SourceLocation CallLoc,
   if (!Info.CheckCallLimit(CallLoc))
     return false;
 
+  // A call that only computes with scalars gives the same result every time,
+  // unless it depends on the state of the evaluation. Reuse the result of a
+  // previous call if it had enough steps and stack left. The key is computed
+  // now, because the body may modify its parameters.
+  bool Cacheable = !This && !Info.checkingPotentialConstantExpression() &&
+                   ConstexprCallCache::isCacheable(ArgValues);
+  unsigned Mode = Info.EvalMode << 2 | Info.InConstantContext << 1 |
+                  Info.AllowNonConstexprCalls;
+  llvm::FoldingSetNodeID Key;
+  if (Cacheable) {
+    if (const ConstexprCallCache::Entry *E =
+            Info.Ctx.getConstexprCallCache().lookup(Callee, ArgValues, Mode,
+                                                    Key)) {
+      if (E->Steps <= Info.StepsLeft && Info.CallStackDepth <= E->Depth) {
+        Info.StepsLeft -= E->Steps;
+        Result = E->Result;
+        return true;
+      }
+    }
+  }
+
+  unsigned StepsLeft = Info.StepsLeft;
+  unsigned NumEvents = Info.NumUncacheableEvents;
+  if (!EvaluateFunctionBody(CallLoc, Callee, This, Args, ArgValues, Body, Info,
+                            Result, ResultSlot))
+    return false;
+
+  if (Cacheable && Info.NumUncacheableEvents == NumEvents &&
+      ConstexprCallCache::isCacheableValue(Result))
+    Info.Ctx.getConstexprCallCache().insert(
+        Key, {Result, StepsLeft - Info.StepsLeft, Info.CallStackDepth});
+  return true;
+}
+
+static bool EvaluateFunctionBody(SourceLocation CallLoc,
+                                 const FunctionDecl *Callee,
+                                 const LValue *This,
+                                 ArrayRef<const Expr *> Args,
+                                 MutableArrayRef<APValue> ArgValues,
+                                 const Stmt *Body,
+                                 EvalInfo &Info, APValue &Result,
+                                 const LValue *ResultSlot) {
+  // The interpreter gives up on anything the tree walker would diagnose, so
+  // falling back to walking the body still produces the usual notes. It
+  // charges steps and calls like the tree walker, so both accept the same
+  // programs.
+  llvm::SaveAndRestore<bool> InterpreterFailed(Info.InterpreterFailed);
+  if (Info.getLangOpts().EnableNewConstInterp && !This &&
+      !Info.InterpreterFailed && !Info.checkingPotentialConstantExpression() &&
+      evaluateCallWithInterpreter(Info, Callee, ArgValues, Result))
+    return true;
+
   CallStackFrame Frame(Info, CallLoc, Callee, This, ArgValues.data());
 
   // For a trivial copy or move assignment, perform an APValue copy. This is
@@ -12465,26 +12588,30 @@ bool Expr::EvaluateAsConstantExpr(EvalResult &Result, ConstExprUsage Usage,
                                  Usage);
 }
 
-bool Expr::EvaluateAsInitializer(APValue &Value, const ASTContext &Ctx,
-                                 const VarDecl *VD,
-                            SmallVectorImpl<PartialDiagnosticAt> &Notes) const {
-  assert(!isValueDependent() &&
+static bool EvaluateInitializer(const Expr *E, APValue &Value,
+                                const ASTContext &Ctx, const VarDecl *VD,
+                                SmallVectorImpl<PartialDiagnosticAt> &Notes,
+                                bool AllowNonConstexprCalls) {
+  assert(!E->isValueDependent() &&
          "Expression evaluator can't be called on a dependent expression.");
 
   // FIXME: Evaluating initializers for large array and record types can cause
   // performance problems. Only do so in C++11 for now.
-  if (isRValue() && (getType()->isArrayType() || getType()->isRecordType()) &&
+  if (E->isRValue() &&
+      (E->getType()->isArrayType() || E->getType()->isRecordType()) &&
       !Ctx.getLangOpts().CPlusPlus11)
     return false;
 
   Expr::EvalStatus EStatus;
   EStatus.Diag = &Notes;
 
-  EvalInfo InitInfo(Ctx, EStatus, VD->isConstexpr()
-                                      ? EvalInfo::EM_ConstantExpression
-                                      : EvalInfo::EM_ConstantFold);
+  EvalInfo InitInfo(Ctx, EStatus,
+                    VD->isConstexpr() && !AllowNonConstexprCalls
+                        ? EvalInfo::EM_ConstantExpression
+                        : EvalInfo::EM_ConstantFold);
   InitInfo.setEvaluatingDecl(VD, Value);
   InitInfo.InConstantContext = true;
+  InitInfo.AllowNonConstexprCalls = AllowNonConstexprCalls;
 
   LValue LVal;
   LVal.set(VD);
@@ -12501,7 +12628,7 @@ bool Expr::EvaluateAsInitializer(APValue &Value, const ASTContext &Ctx,
       return false;
   }
 
-  if (!EvaluateInPlace(Value, InitInfo, LVal, this,
+  if (!EvaluateInPlace(Value, InitInfo, LVal, E,
                        /*AllowNonLiteralTypes=*/true) ||
       EStatus.HasSideEffects)
     return false;
@@ -12510,6 +12637,20 @@ bool Expr::EvaluateAsInitializer(APValue &Value, const ASTContext &Ctx,
                                  Value);
 }
 
+bool Expr::EvaluateAsInitializer(APValue &Value, const ASTContext &Ctx,
+                                 const VarDecl *VD,
+                            SmallVectorImpl<PartialDiagnosticAt> &Notes) const {
+  return EvaluateInitializer(this, Value, Ctx, VD, Notes,
+                             /*AllowNonConstexprCalls=*/false);
+}
+
+bool Expr::EvaluateAsRelaxedInitializer(APValue &Value, const ASTContext &Ctx,
+                                        const VarDecl *VD) const {
+  SmallVector<PartialDiagnosticAt, 8> Notes;
+  return EvaluateInitializer(this, Value, Ctx, VD, Notes,
+                             /*AllowNonConstexprCalls=*/true);
+}
+
 /// isEvaluatable - Call EvaluateAsRValue to see if this expression can be
 /// constant folded, but discard the result.
 bool Expr::isEvaluatable(const ASTContext &Ctx, SideEffectsKind SEK) const {
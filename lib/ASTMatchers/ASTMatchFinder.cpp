@@ -70,6 +70,8 @@ struct MatchKey {
 struct MemoizedMatchResult {
   bool ResultOfMatch;
   BoundNodesTreeBuilder Nodes;
+  // Whether the result was reused since the cache was last trimmed.
+  bool Reused = false;
 };
 
 // A RecursiveASTVisitor that traverses all children or all descendants of
@@ -401,6 +403,7 @@ public:
 
     MemoizationMap::iterator I = ResultCache.find(Key);
     if (I != ResultCache.end()) {
+      I->second.Reused = true;
       *Builder = I->second.Nodes;
       return I->second.ResultOfMatch;
     }
@@ -417,6 +420,25 @@ public:
     return CachedResult.ResultOfMatch;
   }
 
+  // Once the memoization cache is full, drop the results that were not reused
+  // since it was last trimmed, so that the results of the matchers and nodes
+  // currently being matched survive. If most entries are reused, clear the
+  // whole cache, so that trimming stays amortized constant time per entry.
+  void trimResultCache() {
+    if (ResultCache.size() <= MaxMemoizationEntries)
+      return;
+    for (auto I = ResultCache.begin(), E = ResultCache.end(); I != E;) {
+      if (I->second.Reused) {
+        I->second.Reused = false;
+        ++I;
+      } else {
+        I = ResultCache.erase(I);
+      }
+    }
+    if (ResultCache.size() > MaxMemoizationEntries / 2)
+      ResultCache.clear();
+  }
+
   // Matches children or descendants of 'Node' with 'BaseMatcher'.
   bool matchesRecursively(const ast_type_traits::DynTypedNode &Node,
                           const DynTypedMatcher &Matcher,
@@ -439,8 +461,7 @@ public:
                       BoundNodesTreeBuilder *Builder,
                       ast_type_traits::TraversalKind Traversal,
                       BindKind Bind) override {
-    if (ResultCache.size() > MaxMemoizationEntries)
-      ResultCache.clear();
+    trimResultCache();
     return memoizedMatchesRecursively(Node, Matcher, Builder, 1, Traversal,
                                       Bind);
   }
@@ -449,8 +470,7 @@ public:
                            const DynTypedMatcher &Matcher,
                            BoundNodesTreeBuilder *Builder,
                            BindKind Bind) override {
-    if (ResultCache.size() > MaxMemoizationEntries)
-      ResultCache.clear();
+    trimResultCache();
     return memoizedMatchesRecursively(Node, Matcher, Builder, INT_MAX,
                                       ast_type_traits::TraversalKind::TK_AsIs,
                                       Bind);
@@ -460,10 +480,9 @@ public:
                          const DynTypedMatcher &Matcher,
                          BoundNodesTreeBuilder *Builder,
                          AncestorMatchMode MatchMode) override {
-    // Reset the cache outside of the recursive call to make sure we
+    // Trim the cache outside of the recursive call to make sure we
     // don't invalidate any iterators.
-    if (ResultCache.size() > MaxMemoizationEntries)
-      ResultCache.clear();
+    trimResultCache();
     return memoizedMatchesAncestorOfRecursively(Node, Matcher, Builder,
                                                 MatchMode);
   }
@@ -644,6 +663,7 @@ private:
     // calls to match might invalidate the result cache iterators.
     MemoizationMap::iterator I = ResultCache.find(Key);
     if (I != ResultCache.end()) {
+      I->second.Reused = true;
       *Builder = I->second.Nodes;
       return I->second.ResultOfMatch;
     }
@@ -3940,6 +3940,16 @@ CFGBlock *CFGBuilder::VisitSwitchStmt(SwitchStmt *Terminator) {
   // Create a new block that will contain the switch statement.
   SwitchTerminatedBlock = createBlock(false);
 
+  // Every case label and the default edge become a successor of the switch
+  // block. Reserve them up front, as large switches have thousands of cases.
+  unsigned NumCases = 0;
+  for (const SwitchCase *SC = Terminator->getSwitchCaseList(); SC;
+       SC = SC->getNextSwitchCase())
+    if (isa<CaseStmt>(SC))
+      ++NumCases;
+  SwitchTerminatedBlock->reserveSuccessors(NumCases + 1,
+                                           cfg->getBumpVectorContext());
+
   // Now process the switch body.  The code after the switch is the implicit
   // successor.
   Succ = SwitchSuccessor;
@@ -13,8 +13,12 @@
 #include "clang/Basic/FileSystemStatCache.h"
 #include "llvm/Support/Chrono.h"
 #include "llvm/Support/ErrorOr.h"
+#include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/VirtualFileSystem.h"
+#include "llvm/Support/raw_ostream.h"
+#include <chrono>
+#include <tuple>
 #include <utility>
 
 using namespace clang;
@@ -118,3 +122,162 @@ MemorizeStatCalls::getStat(StringRef Path, llvm::vfs::Status &Status,
 
   return std::error_code();
 }
+
+/// The first line of a persistent stat cache file.
+static const char PersistentStatCacheMagic[] = "clang-stat-cache-v1";
+
+PersistentStatCache::PersistentStatCache(StringRef CachePath)
+    : CachePath(CachePath) {
+  // The cache is mapped read-only; later writes replace the file instead of
+  // modifying it in place.
+  llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> Buffer =
+      llvm::MemoryBuffer::getFile(CachePath, /*FileSize=*/-1,
+                                  /*RequiresNullTerminator=*/false);
+  if (Buffer)
+    parse((*Buffer)->getBuffer(), Directories);
+}
+
+void PersistentStatCache::parse(StringRef Buffer,
+                                llvm::StringMap<DirectoryInfo> &Directories) {
+  StringRef Line;
+  std::tie(Line, Buffer) = Buffer.split('\n');
+  if (Line != PersistentStatCacheMagic)
+    return;
+
+  // The file is a sequence of "D <mtime> <directory>" lines, each followed by
+  // the "F <name>" lines of the entries known not to exist in it.
+  DirectoryInfo *Current = nullptr;
+  while (!Buffer.empty()) {
+    std::tie(Line, Buffer) = Buffer.split('\n');
+    if (Line.consume_front("D ")) {
+      StringRef Time, Dir;
+      std::tie(Time, Dir) = Line.split(' ');
+      uint64_t Nanoseconds;
+      if (Time.getAsInteger(10, Nanoseconds) || Dir.empty()) {
+        Current = nullptr;
+        continue;
+      }
+      Current = &Directories[Dir];
+      Current->ModTime =
+          llvm::sys::TimePoint<>(std::chrono::nanoseconds(Nanoseconds));
+      Current->Missing.clear();
+    } else if (Line.consume_front("F ") && Current && !Line.empty()) {
+      Current->Missing.insert(Line);
+    }
+  }
+}
+
+PersistentStatCache::DirectoryInfo *
+PersistentStatCache::getValidDirectory(StringRef Dir,
+                                       llvm::vfs::FileSystem &FS) {
+  DirectoryInfo &Info = Directories[Dir];
+  if (Info.State == DirectoryInfo::Unchecked) {
+    llvm::ErrorOr<llvm::vfs::Status> DirStatus = FS.status(Dir);
+    if (!DirStatus || !DirStatus->isDirectory()) {
+      Info.State = DirectoryInfo::Unusable;
+    } else if (std::chrono::system_clock::now() -
+                   DirStatus->getLastModificationTime() <
+               std::chrono::seconds(2)) {
+      // The directory is being modified right now, and a coarse timestamp
+      // could hide the next change.  Don't trust or extend its entries.
+      Info.State = DirectoryInfo::Unusable;
+    } else {
+      if (Info.ModTime != DirStatus->getLastModificationTime()) {
+        // Something was added to or removed from the directory since its
+        // entries were recorded.
+        if (!Info.Missing.empty())
+          Modified = true;
+        Info.Missing.clear();
+        Info.ModTime = DirStatus->getLastModificationTime();
+      }
+      Info.State = DirectoryInfo::Valid;
+    }
+  }
+  return Info.State == DirectoryInfo::Valid ? &Info : nullptr;
+}
+
+std::error_code
+PersistentStatCache::getStat(StringRef Path, llvm::vfs::Status &Status,
+                             bool isFile,
+                             std::unique_ptr<llvm::vfs::File> *F,
+                             llvm::vfs::FileSystem &FS) {
+  SmallString<256> AbsPath(Path);
+  DirectoryInfo *Info = nullptr;
+  StringRef Name;
+  if (!FS.makeAbsolute(AbsPath)) {
+    llvm::sys::path::remove_dots(AbsPath);
+    StringRef Dir = llvm::sys::path::parent_path(AbsPath);
+    Name = llvm::sys::path::filename(AbsPath);
+    if (!Dir.empty() && !Name.empty() && Name != "." && Name != "..")
+      Info = getValidDirectory(Dir, FS);
+  }
+
+  if (Info && Info->Missing.count(Name))
+    return std::make_error_code(std::errc::no_such_file_or_directory);
+
+  std::error_code EC = get(Path, Status, isFile, F, nullptr, FS);
+  if (Info && EC == std::errc::no_such_file_or_directory &&
+      Info->Missing.insert(Name).second)
+    Modified = true;
+  return EC;
+}
+
+std::error_code PersistentStatCache::save() {
+  if (!Modified)
+    return std::error_code();
+
+  // Start from what is on disk now, so that the results of the invocations
+  // that finished in the meantime are kept, and overlay the directories that
+  // were validated by this invocation.
+  llvm::StringMap<DirectoryInfo> Merged;
+  if (llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> Buffer =
+          llvm::MemoryBuffer::getFile(CachePath, /*FileSize=*/-1,
+                                      /*RequiresNullTerminator=*/false))
+    parse((*Buffer)->getBuffer(), Merged);
+  for (auto &Entry : Directories) {
+    const DirectoryInfo &Info = Entry.second;
+    if (Info.State != DirectoryInfo::Valid)
+      continue;
+    DirectoryInfo &Target = Merged[Entry.first()];
+    if (Target.ModTime != Info.ModTime) {
+      Target.Missing.clear();
+      Target.ModTime = Info.ModTime;
+    }
+    for (const auto &Name : Info.Missing)
+      Target.Missing.insert(Name.first());
+  }
+
+  // Write the new cache next to the old one and rename it into place, so
+  // that concurrent readers never see a partially written file.
+  SmallString<128> TempPath;
+  int FD;
+  if (std::error_code EC = llvm::sys::fs::createUniqueFile(
+          CachePath + "-%%%%%%%%", FD, TempPath))
+    return EC;
+  {
+    llvm::raw_fd_ostream OS(FD, /*shouldClose=*/true);
+    OS << PersistentStatCacheMagic << '\n';
+    for (const auto &Entry : Merged) {
+      const DirectoryInfo &Info = Entry.second;
+      if (Info.Missing.empty() || Entry.first().find('\n') != StringRef::npos)
+        continue;
+      OS << "D " << Info.ModTime.time_since_epoch().count() << ' '
+         << Entry.first() << '\n';
+      for (const auto &Name : Info.Missing)
+        if (Name.first().find('\n') == StringRef::npos)
+          OS << "F " << Name.first() << '\n';
+    }
+    OS.close();
+    if (OS.has_error()) {
+      OS.clear_error();
+      llvm::sys::fs::remove(TempPath);
+      return std::make_error_code(std::errc::io_error);
+    }
+  }
+  if (std::error_code EC = llvm::sys::fs::rename(TempPath, CachePath)) {
+    llvm::sys::fs::remove(TempPath);
+    return EC;
+  }
+  Modified = false;
+  return std::error_code();
+}
@@ -787,11 +787,8 @@ FileID SourceManager::getFileIDLocal(unsigned SLocOffset) const {
   unsigned LessIndex = 0;
   NumProbes = 0;
   while (true) {
-    bool Invalid = false;
     unsigned MiddleIndex = (GreaterIndex-LessIndex)/2+LessIndex;
-    unsigned MidOffset = getLocalSLocEntry(MiddleIndex, &Invalid).getOffset();
-    if (Invalid)
-      return FileID::get(0);
+    unsigned MidOffset = LocalSLocEntryTable[MiddleIndex].getOffset();
 
     ++NumProbes;
 
@@ -802,10 +799,11 @@ FileID SourceManager::getFileIDLocal(unsigned SLocOffset) const {
       continue;
     }
 
-    // If the middle index contains the value, succeed and return.
-    // FIXME: This could be made faster by using a function that's aware of
-    // being in the local area.
-    if (isOffsetInFileID(FileID::get(MiddleIndex), SLocOffset)) {
+    // If the middle index contains the value, succeed and return. All of the
+    // entries are local, so the entry ends where the next local entry starts,
+    // or at NextLocalOffset for the last one.
+    if (MiddleIndex + 1 == LocalSLocEntryTable.size() ||
+        SLocOffset < LocalSLocEntryTable[MiddleIndex + 1].getOffset()) {
       FileID Res = FileID::get(MiddleIndex);
 
       // If this isn't a macro expansion, remember it.  We have good locality
@@ -1241,23 +1239,38 @@ static void ComputeLineNumbers(DiagnosticsEngine &Diag, ContentCache *FI,
 
   const unsigned char *Buf = (const unsigned char *)Buffer->getBufferStart();
   const unsigned char *End = (const unsigned char *)Buffer->getBufferEnd();
+  unsigned BufLen = End - Buf;
   unsigned I = 0;
-  while (true) {
-    // Skip over the contents of the line.
-    while (Buf[I] != '\n' && Buf[I] != '\r' && Buf[I] != '\0')
+#ifdef __SSE2__
+  const __m128i LFs = _mm_set1_epi8('\n');
+  const __m128i CRs = _mm_set1_epi8('\r');
+#endif
+  while (I < BufLen) {
+#ifdef __SSE2__
+    // Skip over the contents of the line sixteen bytes at a time.
+    while (I + 16 <= BufLen) {
+      __m128i Chunk = _mm_loadu_si128((const __m128i *)(Buf + I));
+      unsigned Mask = _mm_movemask_epi8(_mm_or_si128(
+          _mm_cmpeq_epi8(Chunk, LFs), _mm_cmpeq_epi8(Chunk, CRs)));
+      if (Mask) {
+        I += llvm::countTrailingZeros(Mask);
+        break;
+      }
+      I += 16;
+    }
+#endif
+    // Skip over the rest of the line. Embedded NULs are line contents.
+    while (I < BufLen && Buf[I] != '\n' && Buf[I] != '\r')
       ++I;
+    if (I == BufLen)
+      break;
 
-    if (Buf[I] == '\n' || Buf[I] == '\r') {
-      // If this is \r\n, skip both characters.
-      if (Buf[I] == '\r' && Buf[I+1] == '\n')
-        ++I;
+    // If this is \r\n, skip both characters. The buffer is NUL terminated,
+    // so Buf[I+1] is always readable.
+    if (Buf[I] == '\r' && Buf[I+1] == '\n')
       ++I;
-      LineOffsets.push_back(I);
-    } else {
-      // Otherwise, this is a NUL. If end of file, exit.
-      if (Buf+I == End) break;
-      ++I;
-    }
+    ++I;
+    LineOffsets.push_back(I);
   }
 
   // Copy the offsets into the FileInfo structure.
@@ -2131,6 +2144,11 @@ void SourceManager::PrintStats() const {
                << llvm::capacity_in_bytes(LocalSLocEntryTable)
                << " bytes of capacity), "
                << NextLocalOffset << "B of Sloc address space used.\n";
+  unsigned NumLocalExpansions = llvm::count_if(
+      LocalSLocEntryTable,
+      [](const SrcMgr::SLocEntry &Entry) { return Entry.isExpansion(); });
+  llvm::errs() << NumLocalExpansions << " of the local SLocEntry's are macro "
+               << "expansions.\n";
   llvm::errs() << LoadedSLocEntryTable.size()
                << " loaded SLocEntries allocated, "
                << MaxLoadedOffset - CurrentLoadedOffset
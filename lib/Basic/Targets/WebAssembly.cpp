@@ -255,12 +255,32 @@ void CheerpTargetInfo::getTargetDefines(const LangOptions &Opts,
     }
   }
 
+  // SIMD and bulk memory are only available to [[cheerp::wasm]] code
+  if (Opts.getCheerpLinearOutput() == LangOptions::CHEERP_LINEAR_OUTPUT_Wasm) {
+    if (Opts.CheerpWasmSIMD)
+      Builder.defineMacro("__wasm_simd128__");
+    if (Opts.CheerpWasmBulkMemory)
+      Builder.defineMacro("__wasm_bulk_memory__");
+  }
+
+  // Lets genericjs code pick native 64-bit storage, like BigInt64Array
+  if (Opts.CheerpUseBigInts)
+    Builder.defineMacro("__CHEERP_BIGINTS__");
+
   if (Opts.CPlusPlus)
     Builder.defineMacro("_GNU_SOURCE");
 
   Builder.defineMacro("__LITTLE_ENDIAN__");
 }
 
+void CheerpTargetInfo::adjust(LangOptions &Opts) {
+  TargetInfo::adjust(Opts);
+  // Wasm atomics work on up to 64 bits, without shared memory atomic
+  // operations are lowered to regular ones instead
+  if (Opts.CheerpWasmSharedMemory)
+    MaxAtomicPromoteWidth = MaxAtomicInlineWidth = 64;
+}
+
 const Builtin::Info CheerpTargetInfo::BuiltinInfo[] = {
 #define BUILTIN(ID, TYPE, ATTRS) { #ID, TYPE, ATTRS, 0, ALL_LANGUAGES },
 #define LIBBUILTIN(ID, TYPE, ATTRS, HEADER) { #ID, TYPE, ATTRS, HEADER,\
@@ -185,6 +185,7 @@ public:
   virtual ArrayRef<Builtin::Info> getTargetBuiltins() const;
   virtual void getTargetDefines(const LangOptions &Opts,
                                 MacroBuilder &Builder) const;
+  virtual void adjust(LangOptions &Opts);
 
   virtual BuiltinVaListKind getBuiltinVaListKind() const {
     return TargetInfo::CharPtrBuiltinVaList;
@@ -18,6 +18,9 @@
 #include "llvm/ADT/StringExtras.h"
 #include "llvm/ADT/StringSwitch.h"
 #include "llvm/ADT/Triple.h"
+#include "llvm/Analysis/AssumptionCache.h"
+#include "llvm/Analysis/InlineCost.h"
+#include "llvm/Analysis/OptimizationRemarkEmitter.h"
 #include "llvm/Analysis/TargetLibraryInfo.h"
 #include "llvm/Analysis/TargetTransformInfo.h"
 #include "llvm/Bitcode/BitcodeReader.h"
@@ -29,15 +32,19 @@
 #include "llvm/CodeGen/RegAllocRegistry.h"
 #include "llvm/CodeGen/SchedulerRegistry.h"
 #include "llvm/CodeGen/TargetSubtargetInfo.h"
+#include "llvm/IR/CallSite.h"
 #include "llvm/IR/DataLayout.h"
 #include "llvm/IR/IRPrintingPasses.h"
 #include "llvm/IR/LegacyPassManager.h"
 #include "llvm/IR/Module.h"
 #include "llvm/IR/ModuleSummaryIndex.h"
 #include "llvm/IR/Verifier.h"
+#include "llvm/InitializePasses.h"
 #include "llvm/LTO/LTOBackend.h"
 #include "llvm/MC/MCAsmInfo.h"
 #include "llvm/MC/SubtargetFeature.h"
+#include "llvm/PassInfo.h"
+#include "llvm/PassRegistry.h"
 #include "llvm/Passes/PassBuilder.h"
 #include "llvm/Passes/PassPlugin.h"
 #include "llvm/Support/BuryPointer.h"
@@ -53,6 +60,7 @@
 #include "llvm/Transforms/Coroutines.h"
 #include "llvm/Transforms/IPO.h"
 #include "llvm/Transforms/IPO/AlwaysInliner.h"
+#include "llvm/Transforms/IPO/Inliner.h"
 #include "llvm/Transforms/IPO/PassManagerBuilder.h"
 #include "llvm/Transforms/IPO/ThinLTOBitcodeWriter.h"
 #include "llvm/Transforms/InstCombine/InstCombine.h"
@@ -542,16 +550,52 @@ getInstrProfOptions(const CodeGenOptions &CodeGenOpts,
   return Options;
 }
 
+namespace {
+/// Run a function pass only on the genericjs functions, leaving the
+/// [[cheerp::wasm]] ones (in the "asmjs" section) alone. The wrapped pass must
+/// not require any analysis.
+class CheerpGenericJSOnly : public FunctionPass {
+  std::unique_ptr<FunctionPass> Inner;
+
+public:
+  static char ID;
+  explicit CheerpGenericJSOnly(FunctionPass *Inner)
+      : FunctionPass(ID), Inner(Inner) {}
+
+  bool runOnFunction(Function &F) override {
+    if (F.getSection() == "asmjs")
+      return false;
+    return Inner->runOnFunction(F);
+  }
+
+  StringRef getPassName() const override { return Inner->getPassName(); }
+};
+}
+
+char CheerpGenericJSOnly::ID = 0;
+
 static void addCheerpPasses(const PassManagerBuilder &Builder,
                             legacy::PassManagerBase &PM) {
-  PM.add(createLowerInvokePass());
+  const PassManagerBuilderWrapper &BuilderWrapper =
+      static_cast<const PassManagerBuilderWrapper &>(Builder);
+  //With wasm exceptions invokes in wasm code are kept and lowered to
+  //try/catch by the backend, genericjs code still needs them lowered
+  if (BuilderWrapper.getLangOpts().CheerpWasmExceptions)
+    PM.add(new CheerpGenericJSOnly(createLowerInvokePass()));
+  else
+    PM.add(createLowerInvokePass());
   PM.add(createCFGSimplificationPass());
   //Run mem2reg first, to remove load/stores for the this argument
   //We need this to track this in custom constructors for DOM types, such as String::String(const char*)
   PM.add(createPromoteMemoryToRegisterPass());
   PM.add(createCheerpNativeRewriterPass());
-  //Cheerp is single threaded, convert atomic instructions to regular ones
-  PM.add(createLowerAtomicPass());
+  //Cheerp is single threaded, convert atomic instructions to regular ones.
+  //With shared memory the ones in wasm code are kept and lowered to Wasm
+  //atomics by the backend, genericjs code has no atomics
+  if (BuilderWrapper.getLangOpts().CheerpWasmSharedMemory)
+    PM.add(new CheerpGenericJSOnly(createLowerAtomicPass()));
+  else
+    PM.add(createLowerAtomicPass());
 }
 
 static void addPostInlineCheerpPasses(const PassManagerBuilder &Builder,
@@ -565,6 +609,129 @@ static void addModuleCheerpPasses(const PassManagerBuilder &Builder,
   PM.add(createByValLoweringPass());
 }
 
+static void addPostLinkCheerpPasses(const PassManagerBuilder &Builder,
+                                    legacy::PassManagerBase &PM) {
+  // -Os converts loops to canonical form, which may causes empty forwarding
+  // branches, remove those
+  PM.add(createCFGSimplificationPass());
+}
+
+namespace llvm {
+void initializeCheerpInlinerPass(PassRegistry &);
+}
+
+/// The inliner used for Cheerp. It uses the regular cost model within a
+/// section. Across sections, inlining moves the callee to the section of the
+/// caller:
+/// - [[cheerp::wasm]] code is never inlined into genericjs code, where it
+///   would lose the wasm speed.
+/// - Small genericjs functions that only compute on scalars are inlined into
+///   wasm code with a bonus, as that removes a costly call from wasm to JS.
+///   Genericjs functions handling pointers use JS objects, which wasm code
+///   cannot, and are never inlined there.
+class CheerpInliner : public LegacyInlinerBase {
+  InlineParams Params;
+  TargetTransformInfoWrapperPass *TTIWP = nullptr;
+
+  /// The threshold bonus of a genericjs callee inlined into wasm code.
+  static const int BoundaryBonus = 225;
+
+  static bool isScalarOnly(const Function &F) {
+    if (F.getReturnType()->isPointerTy())
+      return false;
+    for (const Argument &A : F.args())
+      if (A.getType()->isPointerTy())
+        return false;
+    for (const BasicBlock &BB : F) {
+      for (const Instruction &I : BB) {
+        if (I.getType()->isPointerTy())
+          return false;
+        const auto *Call = dyn_cast<CallBase>(&I);
+        for (const Use &Op : I.operands())
+          if (Op->getType()->isPointerTy() &&
+              !(Call && Call->isCallee(&Op) && isa<Function>(Op.get())))
+            return false;
+      }
+    }
+    return true;
+  }
+
+public:
+  static char ID;
+  CheerpInliner() : CheerpInliner(llvm::getInlineParams()) {}
+  explicit CheerpInliner(InlineParams Params)
+      : LegacyInlinerBase(ID), Params(std::move(Params)) {
+    initializeCheerpInlinerPass(*PassRegistry::getPassRegistry());
+  }
+
+  InlineCost getInlineCost(CallSite CS) override {
+    Function *Callee = CS.getCalledFunction();
+    Function *Caller = CS.getCaller();
+    InlineParams CallParams = Params;
+    if (Callee && Callee->getSection() != Caller->getSection()) {
+      if (Caller->getSection() != "asmjs")
+        return InlineCost::getNever("wasm callee in a genericjs caller");
+      if (Callee->isDeclaration() || !isScalarOnly(*Callee))
+        return InlineCost::getNever("genericjs callee uses JS objects");
+      CallParams.DefaultThreshold += BoundaryBonus;
+    }
+
+    TargetTransformInfo &TTI = TTIWP->getTTI(*Callee);
+    OptimizationRemarkEmitter ORE(Caller);
+    std::function<AssumptionCache &(Function &)> GetAssumptionCache =
+        [&](Function &F) -> AssumptionCache & {
+      return ACT->getAssumptionCache(F);
+    };
+    return llvm::getInlineCost(cast<CallBase>(*CS.getInstruction()),
+                               CallParams, TTI, GetAssumptionCache,
+                               /*GetBFI=*/None, PSI, &ORE);
+  }
+
+  bool runOnSCC(CallGraphSCC &SCC) override {
+    TTIWP = &getAnalysis<TargetTransformInfoWrapperPass>();
+    return LegacyInlinerBase::runOnSCC(SCC);
+  }
+
+  void getAnalysisUsage(AnalysisUsage &AU) const override {
+    AU.addRequired<TargetTransformInfoWrapperPass>();
+    LegacyInlinerBase::getAnalysisUsage(AU);
+  }
+
+  StringRef getPassName() const override { return "Cheerp Function Inlining"; }
+};
+
+char CheerpInliner::ID = 0;
+INITIALIZE_PASS_BEGIN(CheerpInliner, "cheerp-inline",
+                      "Cheerp Function Inlining", false, false)
+INITIALIZE_PASS_DEPENDENCY(AssumptionCacheTracker)
+INITIALIZE_PASS_DEPENDENCY(CallGraphWrapperPass)
+INITIALIZE_PASS_DEPENDENCY(ProfileSummaryInfoWrapperPass)
+INITIALIZE_PASS_DEPENDENCY(TargetTransformInfoWrapperPass)
+INITIALIZE_PASS_DEPENDENCY(TargetLibraryInfoWrapperPass)
+INITIALIZE_PASS_END(CheerpInliner, "cheerp-inline",
+                    "Cheerp Function Inlining", false, false)
+
+void clang::initializeCheerpPasses(PassRegistry &Registry) {
+  initializeCheerpInlinerPass(Registry);
+}
+
+/// Add the Cheerp passes that run on the whole linked program. They are
+/// looked up by name, as registered by the Cheerp backend for opt.
+static bool addCheerpLinkTimePasses(const CodeGenOptions &CodeGenOpts,
+                                    DiagnosticsEngine &Diags,
+                                    legacy::PassManagerBase &PM) {
+  PassRegistry &Registry = *PassRegistry::getPassRegistry();
+  for (const std::string &Name : CodeGenOpts.CheerpLinkTimePasses) {
+    const PassInfo *PI = Registry.getPassInfo(Name);
+    if (!PI || !PI->getNormalCtor()) {
+      Diags.Report(diag::err_fe_unknown_cheerp_pass) << Name;
+      return false;
+    }
+    PM.add(PI->createPass());
+  }
+  return true;
+}
+
 void EmitAssemblyHelper::CreatePasses(legacy::PassManager &MPM,
                                       legacy::FunctionPassManager &FPM) {
   // Handle disabling of all LLVM passes, where we want to preserve the
@@ -583,7 +750,17 @@ void EmitAssemblyHelper::CreatePasses(legacy::PassManager &MPM,
 
   PassManagerBuilderWrapper PMBuilder(TargetTriple, CodeGenOpts, LangOpts);
 
-  if (TargetTriple.getArch() == llvm::Triple::cheerp)
+  if (TargetTriple.getArch() == llvm::Triple::cheerp &&
+      !CodeGenOpts.CheerpLinkTimePasses.empty())
+  {
+    // This is the whole linked program, the compile time Cheerp passes
+    // already ran on each of its modules
+    if (!addCheerpLinkTimePasses(CodeGenOpts, Diags, MPM))
+      return;
+    PMBuilder.addExtension(PassManagerBuilder::EP_OptimizerLast,
+                           addPostLinkCheerpPasses);
+  }
+  else if (TargetTriple.getArch() == llvm::Triple::cheerp)
   {
     PMBuilder.addExtension(PassManagerBuilder::EP_EarlyAsPossible,
                            addCheerpPasses);
@@ -603,6 +780,9 @@ void EmitAssemblyHelper::CreatePasses(legacy::PassManager &MPM,
     bool InsertLifetimeIntrinsics = (CodeGenOpts.OptimizationLevel != 0 &&
                                      !CodeGenOpts.DisableLifetimeMarkers);
     PMBuilder.Inliner = createAlwaysInlinerLegacyPass(InsertLifetimeIntrinsics);
+  } else if (TargetTriple.getArch() == llvm::Triple::cheerp) {
+    PMBuilder.Inliner = new CheerpInliner(getInlineParams(
+        CodeGenOpts.OptimizationLevel, CodeGenOpts.OptimizeSize));
   } else {
     // We do not want to inline hot callsites for SamplePGO module-summary build
     // because profile annotation will happen again in ThinLTO backend, and we
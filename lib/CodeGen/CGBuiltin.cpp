@@ -23,6 +23,7 @@
 #include "clang/AST/Decl.h"
 #include "clang/AST/OSLog.h"
 #include "clang/AST/ParentMap.h"
+#include "clang/AST/StmtCXX.h"
 #include "clang/Basic/TargetBuiltins.h"
 #include "clang/Basic/TargetInfo.h"
 #include "clang/CodeGen/CGFunctionInfo.h"
@@ -36,6 +37,7 @@
 #include "llvm/Support/ConvertUTF.h"
 #include "llvm/Support/ScopedPrinter.h"
 #include "llvm/Support/TargetParser.h"
+#include "llvm/Support/TimeProfiler.h"
 #include <sstream>
 #include "clang/Sema/SemaDiagnostic.h"
 
@@ -1517,6 +1519,79 @@ static bool TypeRequiresBuiltinLaunder(CodeGenModule &CGM, QualType Ty) {
   return TypeRequiresBuiltinLaunderImp(CGM.getContext(), Ty, Seen);
 }
 
+/// Returns true if S is not inside a loop of the function body described by PM.
+static bool isExecutedOncePerCall(const ParentMap &PM, const Stmt *S) {
+  for (const Stmt *P = PM.getParent(S); P; P = PM.getParent(P)) {
+    if (isa<ForStmt>(P) || isa<WhileStmt>(P) || isa<DoStmt>(P) ||
+        isa<CXXForRangeStmt>(P))
+      return false;
+  }
+  return true;
+}
+
+const ParentMap &CodeGenFunction::getCurFuncParentMap() {
+  const FunctionDecl *FD = cast<FunctionDecl>(CurFuncDecl);
+  // CurFuncDecl changes while an inheriting constructor is inlined, so make
+  // sure the map describes the body being emitted.
+  if (!CurFuncParentMap || CurFuncParentMapBody != FD->getBody()) {
+    CurFuncParentMap.reset(new ParentMap(FD->getBody()));
+    CurFuncParentMapBody = FD->getBody();
+    CurFuncBodyContainsLabel =
+        ContainsLabel(FD->getBody(), /*IgnoreCaseStmts=*/true);
+  }
+  return *CurFuncParentMap;
+}
+
+bool CodeGenFunction::curFuncContainsLabel() {
+  getCurFuncParentMap();
+  return CurFuncBodyContainsLabel;
+}
+
+/// Upper bound on the number of field copies emitted by
+/// EmitCheerpUnrolledStructCopy, bigger copies are left to llvm.memcpy.
+static const uint64_t CheerpMaxUnrolledFieldCopies = 16;
+
+/// In genericjs code a memcpy between arrays of structs can only be lowered
+/// by the backend to a generic loop over the elements. When the size is a
+/// small constant and every field is a scalar, copy the fields directly
+/// instead. Returns false if the copy has not been emitted.
+static bool EmitCheerpUnrolledStructCopy(CodeGenFunction &CGF, Address Dest,
+                                         Address Src, QualType Ty,
+                                         llvm::Value *SizeVal) {
+  const RecordType *RT = Ty->getAs<RecordType>();
+  if (!RT || RT->getDecl()->isUnion() ||
+      RT->getDecl()->hasAttr<ByteLayoutAttr>())
+    return false;
+  llvm::ConstantInt *CSize = dyn_cast<llvm::ConstantInt>(SizeVal);
+  if (!CSize)
+    return false;
+  llvm::StructType *STy = dyn_cast<llvm::StructType>(Dest.getElementType());
+  if (!STy || STy != Src.getElementType() || STy->getNumElements() == 0)
+    return false;
+  for (llvm::Type *FieldTy : STy->elements()) {
+    if (!FieldTy->isIntegerTy() && !FieldTy->isFloatingPointTy() &&
+        !FieldTy->isPointerTy())
+      return false;
+  }
+  uint64_t EltSize = CGF.getContext().getTypeSizeInChars(Ty).getQuantity();
+  uint64_t Size = CSize->getZExtValue();
+  if (EltSize == 0 || Size % EltSize != 0)
+    return false;
+  uint64_t NumElts = Size / EltSize;
+  if (NumElts * STy->getNumElements() > CheerpMaxUnrolledFieldCopies)
+    return false;
+  CGBuilderTy &Builder = CGF.Builder;
+  for (uint64_t I = 0; I < NumElts; I++) {
+    Address DestElt = Builder.CreateConstInBoundsGEP(Dest, I);
+    Address SrcElt = Builder.CreateConstInBoundsGEP(Src, I);
+    for (unsigned J = 0; J < STy->getNumElements(); J++) {
+      llvm::Value *V = Builder.CreateLoad(Builder.CreateStructGEP(SrcElt, J));
+      Builder.CreateStore(V, Builder.CreateStructGEP(DestElt, J));
+    }
+  }
+  return true;
+}
+
 RValue CodeGenFunction::emitRotate(const CallExpr *E, bool IsRotateRight) {
   llvm::Value *Src = EmitScalarExpr(E->getArg(0));
   llvm::Value *ShiftAmt = EmitScalarExpr(E->getArg(1));
@@ -2347,7 +2422,7 @@ RValue CodeGenFunction::EmitBuiltinExpr(const GlobalDecl GD, unsigned BuiltinID,
     if (!asmjs && !getTarget().isByteAddressable()) {
       const FunctionDecl* FD=dyn_cast<FunctionDecl>(CurFuncDecl);
       assert(FD);
-      ParentMap PM(FD->getBody());
+      const ParentMap &PM = getCurFuncParentMap();
       const Stmt* parent=PM.getParent(E);
       // We need an explicit cast after the call, void* can't be used
       llvm::Type *Tys[] = { VoidPtrTy };
@@ -2358,6 +2433,25 @@ RValue CodeGenFunction::EmitBuiltinExpr(const GlobalDecl GD, unsigned BuiltinID,
       {
           QualType returnType=retCE->getType();
           Tys[0] = ConvertType(returnType);
+          // A constant size alloca which is executed at most once per call is
+          // a local array, which does not need a heap allocation and can be
+          // scalar replaced if it does not escape
+          QualType elemType=returnType->getPointeeType();
+          llvm::ConstantInt* CSize=dyn_cast<llvm::ConstantInt>(Size);
+          if (CSize && !elemType->isIncompleteType() &&
+              isExecutedOncePerCall(PM, E) && !curFuncContainsLabel())
+          {
+            CharUnits elemSize=getContext().getTypeSizeInChars(elemType);
+            uint64_t size=CSize->getZExtValue();
+            if (!elemSize.isZero() && size != 0 && size % elemSize.getQuantity() == 0)
+            {
+              llvm::Type* arrayTy=llvm::ArrayType::get(ConvertTypeForMem(elemType),
+                                                       size / elemSize.getQuantity());
+              Address array=CreateTempAlloca(arrayTy, getContext().getTypeAlignInChars(elemType), "alloca");
+              Address first=Builder.CreateConstArrayGEP(array, 0);
+              return RValue::get(Builder.CreateBitCast(first.getPointer(), Tys[0]));
+            }
+          }
       }
       Function *F = CGM.getIntrinsic(Intrinsic::cheerp_allocate, Tys);
       return RValue::get(Builder.CreateCall(F, Size));
@@ -2431,6 +2525,13 @@ RValue CodeGenFunction::EmitBuiltinExpr(const GlobalDecl GD, unsigned BuiltinID,
                         E->getArg(0)->getExprLoc(), FD, 0);
     EmitNonNullArgCheck(RValue::get(Src.getPointer()), E->getArg(1)->getType(),
                         E->getArg(1)->getExprLoc(), FD, 1);
+    // Arrays of primitive types are copied by the backend with a single
+    // TypedArray.set, small struct arrays are better copied field by field
+    if (!asmjs && !getTarget().isByteAddressable() &&
+        EmitCheerpUnrolledStructCopy(*this, Dest, Src,
+          DestE->getType()->getPointeeType().getCanonicalType().getUnqualifiedType(),
+          SizeVal))
+      return RValue::get(Dest.getPointer());
     Builder.CreateMemCpy(Dest, Src, SizeVal, false, getTarget().isByteAddressable());
     return RValue::get(Dest.getPointer());
   }
@@ -9383,6 +9484,10 @@ Value *CodeGenFunction::EmitAArch64BuiltinExpr(unsigned BuiltinID,
 
 Value *CodeGenFunction::EmitCheerpBuiltinExpr(unsigned BuiltinID,
                                               const CallExpr *E, bool asmjs) {
+  llvm::TimeTraceScope TimeScope("CheerpBuiltin", [&]() {
+    return std::string(getContext().BuiltinInfo.getName(BuiltinID));
+  });
+
   //Emit the operands
   SmallVector<Value*, 4> Ops;
   for (unsigned i = 0, e = E->getNumArgs(); i != e; i++) {
@@ -9437,10 +9542,7 @@ Value *CodeGenFunction::EmitCheerpBuiltinExpr(unsigned BuiltinID,
     return Builder.CreateCall(F, Ops);
   }
   else if (BuiltinID == Builtin::BImalloc) {
-    const FunctionDecl* FD=dyn_cast<FunctionDecl>(CurFuncDecl);
-    assert(FD);
-    ParentMap PM(FD->getBody());
-    const Stmt* parent=PM.getParent(E);
+    const Stmt* parent=getCurFuncParentMap().getParent(E);
     // We need an explicit cast after the call, void* can't be used
     llvm::Type *Tys[] = { VoidPtrTy };
     const CastExpr* retCE=dyn_cast_or_null<CastExpr>(parent);
@@ -9458,10 +9560,7 @@ Value *CodeGenFunction::EmitCheerpBuiltinExpr(unsigned BuiltinID,
     return Builder.CreateCall(F, Ops);
   }
   else if (BuiltinID == Builtin::BIcalloc) {
-    const FunctionDecl* FD=dyn_cast<FunctionDecl>(CurFuncDecl);
-    assert(FD);
-    ParentMap PM(FD->getBody());
-    const Stmt* parent=PM.getParent(E);
+    const Stmt* parent=getCurFuncParentMap().getParent(E);
     // We need an explicit cast after the call, void* can't be used
     llvm::Type *Tys[] = { VoidPtrTy };
     const CastExpr* retCE=dyn_cast_or_null<CastExpr>(parent);
@@ -9499,10 +9598,7 @@ Value *CodeGenFunction::EmitCheerpBuiltinExpr(unsigned BuiltinID,
     llvm::Type *Tys[] = { VoidPtrTy, ConvertType(reallocType) };
     Ops[0]=EmitScalarExpr(existingMem);
     // Some additional checks that can't be done in Sema
-    const FunctionDecl* FD=dyn_cast<FunctionDecl>(CurFuncDecl);
-    assert(FD);
-    ParentMap PM(FD->getBody());
-    const Stmt* parent=PM.getParent(E);
+    const Stmt* parent=getCurFuncParentMap().getParent(E);
     // We need an explicit cast after the call, void* can't be used
     const CastExpr* retCE=dyn_cast_or_null<CastExpr>(parent);
     if (!retCE || retCE->getType()->isVoidPointerType())
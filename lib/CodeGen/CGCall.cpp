@@ -3443,6 +3443,25 @@ void CodeGenFunction::EmitCallArgs(
       std::swap(Args.back(), *(&Args.back() - 1));
   };
 
+  // CHEERP: Arguments bound to a cheerp::complete_object parameter are never
+  // offset by the callee, so genericjs code can pass them without the
+  // base+offset representation
+  auto MaybeMakeCompleteObject = [&](unsigned I, RValue EmittedArg) {
+    if (!AC.hasFunctionDecl() || I >= AC.getNumParams() ||
+        !AC.getParamDecl(I)->hasAttr<CompleteObjectAttr>())
+      return;
+    if (getTarget().isByteAddressable() || !CurFn ||
+        CurFn->getSection() == StringRef("asmjs"))
+      return;
+    llvm::Value *V = EmittedArg.getScalarVal();
+    if (!V || !V->getType()->isPointerTy())
+      return;
+    llvm::Type *Tys[] = { V->getType(), V->getType() };
+    llvm::Function *F =
+        CGM.getIntrinsic(llvm::Intrinsic::cheerp_make_complete_object, Tys);
+    Args.back().setRValue(RValue::get(Builder.CreateCall(F, V)));
+  };
+
   // Insert a stack save if we're going to need any inalloca args.
   bool HasInAllocaArgs = false;
   if (CGM.getTarget().getCXXABI().isMicrosoft()) {
@@ -3479,6 +3498,8 @@ void CodeGenFunction::EmitCallArgs(
     // non-null argument check for r-value only.
     if (!Args.back().hasLValue()) {
       RValue RVArg = Args.back().getKnownRValue();
+      if (RVArg.isScalar())
+        MaybeMakeCompleteObject(Idx, RVArg);
       EmitNonNullArgCheck(RVArg, ArgTypes[Idx], (*Arg)->getExprLoc(), AC,
                           ParamsToSkip + Idx);
       // @llvm.objectsize should never have side-effects and shouldn't need
@@ -3787,7 +3808,7 @@ RValue CodeGenFunction::EmitCall(const CGFunctionInfo &CallInfo,
                                  ReturnValueSlot ReturnValue,
                                  const CallArgList &CallArgs,
                                  llvm::CallBase **callOrInvoke,
-                                 SourceLocation Loc) {
+                                 SourceLocation Loc, bool IsMustTail) {
   // FIXME: We no longer need the types from CallArgs; lift up and simplify.
 
   assert(Callee.isOrdinary() || Callee.isVirtual());
@@ -3800,6 +3821,8 @@ RValue CodeGenFunction::EmitCall(const CGFunctionInfo &CallInfo,
   llvm::FunctionType *IRFuncTy = getTypes().GetFunctionType(CallInfo);
 
   const Decl *TargetDecl = Callee.getAbstractInfo().getCalleeDecl().getDecl();
+  checkCheerpSectionCrossing(Loc, dyn_cast_or_null<FunctionDecl>(TargetDecl));
+  checkCheerpBoundaryCrossing(Loc, dyn_cast_or_null<FunctionDecl>(TargetDecl));
   if (const FunctionDecl *FD = dyn_cast_or_null<FunctionDecl>(TargetDecl))
     // We can only guarantee that a function is called from the correct
     // context/function based on the appropriate target attributes,
@@ -4343,6 +4366,11 @@ RValue CodeGenFunction::EmitCall(const CGFunctionInfo &CallInfo,
                                          UnusedReturnSizePtr);
 
   llvm::BasicBlock *InvokeDest = CannotThrow ? nullptr : getInvokeDest();
+  // A musttail call must be followed by the return, it can't be an invoke
+  if (IsMustTail && InvokeDest) {
+    CGM.ErrorUnsupported(MustTailCall, "musttail call inside a try block");
+    InvokeDest = nullptr;
+  }
 
   SmallVector<llvm::OperandBundleDef, 1> BundleList =
       getBundlesForFunclet(CalleePtr);
@@ -4390,6 +4418,8 @@ RValue CodeGenFunction::EmitCall(const CGFunctionInfo &CallInfo,
   if (llvm::CallInst *Call = dyn_cast<llvm::CallInst>(CI)) {
     if (TargetDecl && TargetDecl->hasAttr<NotTailCalledAttr>())
       Call->setTailCallKind(llvm::CallInst::TCK_NoTail);
+    else if (IsMustTail)
+      Call->setTailCallKind(llvm::CallInst::TCK_MustTail);
   }
 
   // Add metadata for calls to MSAllocator functions
@@ -4441,6 +4471,22 @@ RValue CodeGenFunction::EmitCall(const CGFunctionInfo &CallInfo,
     return GetUndefRValue(RetTy);
   }
 
+  // A musttail call returns immediately, without going through the epilogue.
+  // Sema guarantees that caller and callee have the same prototype.
+  if (IsMustTail) {
+    if (EHStack.stable_begin() != PrologueCleanupDepth)
+      CGM.ErrorUnsupported(MustTailCall, "musttail call skipping over cleanups");
+    if (RetAI.isIndirect() || RetAI.isInAlloca())
+      CGM.ErrorUnsupported(MustTailCall, "musttail call returning in memory");
+    if (CI->getType()->isVoidTy())
+      Builder.CreateRetVoid();
+    else
+      Builder.CreateRet(CI);
+    Builder.ClearInsertionPoint();
+    EnsureInsertPoint();
+    return GetUndefRValue(RetTy);
+  }
+
   // Perform the swifterror writeback.
   if (swiftErrorTemp.isValid()) {
     llvm::Value *errorResult = Builder.CreateLoad(swiftErrorTemp);
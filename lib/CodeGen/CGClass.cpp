@@ -472,6 +472,23 @@ Address
 CodeGenFunction::GenerateUpcastCollapsed(Address Value,
                                          llvm::Type* BasePtrTy)
 {
+  if (Value.getType() == BasePtrTy)
+    return Value;
+  // If the base is in the directbase chain of the derived type the upcast is
+  // already statically known to be valid and a bitcast is enough
+  llvm::StructType* BaseTy = dyn_cast<llvm::StructType>(BasePtrTy->getPointerElementType());
+  if (llvm::StructType* DerivedTy = dyn_cast<llvm::StructType>(Value.getElementType())) {
+    if (const CGRecordLayout* Layout = getTypes().lookupCGRecordLayout(DerivedTy)) {
+      if (BaseTy && Layout->isCollapsedBaseType(BaseTy))
+        return Builder.CreateBitCast(Value, BasePtrTy);
+    } else {
+      for (llvm::StructType* I = DerivedTy->getDirectBase(); BaseTy && I != nullptr; I = I->getDirectBase()) {
+        if (I == BaseTy)
+          return Builder.CreateBitCast(Value, BasePtrTy);
+      }
+    }
+  }
+
   llvm::Type* types[] = { BasePtrTy, Value.getType() };
 
   llvm::Function* intrinsic = llvm::Intrinsic::getDeclaration(&CGM.getModule(),
@@ -2907,7 +2924,9 @@ void CodeGenFunction::EmitTypeMetadataCodeForVCall(const CXXRecordDecl *RD,
   if (SanOpts.has(SanitizerKind::CFIVCall))
     EmitVTablePtrCheckForCall(RD, VTable, CodeGenFunction::CFITCK_VCall, Loc);
   else if (CGM.getCodeGenOpts().WholeProgramVTables &&
-           CGM.HasHiddenLTOVisibility(RD)) {
+           CGM.HasHiddenLTOVisibility(RD) &&
+           // CHEERP: genericjs vtables use the cheerp.vtable.type metadata
+           (CGM.getTarget().isByteAddressable() || RD->hasAttr<AsmJSAttr>())) {
     llvm::Metadata *MD =
         CGM.CreateMetadataIdentifierForType(QualType(RD->getTypeForDecl(), 0));
     llvm::Value *TypeId =
@@ -464,9 +464,11 @@ CodeGenModule::EmitCXXGlobalVarDeclInitFunc(const VarDecl *D,
 
   // Create a variable initialization function.
   llvm::Function *Fn =
-      CreateGlobalInitOrDestructFunction(FTy, FnName.str(),
-                                         getTypes().arrangeNullaryFunction(),
-                                         D->getLocation());
+      D->hasAttr<LazyInitAttr>()
+          ? getLazyInitFunction(D)
+          : CreateGlobalInitOrDestructFunction(
+                FTy, FnName.str(), getTypes().arrangeNullaryFunction(),
+                D->getLocation());
 
   // CHEERP: if the global is in the asmjs section, also put the initializer
   // there
@@ -477,6 +479,13 @@ CodeGenModule::EmitCXXGlobalVarDeclInitFunc(const VarDecl *D,
   CodeGenFunction(*this).GenerateCXXGlobalVarDeclInitFunc(Fn, D, Addr,
                                                           PerformInit);
 
+  // The uses of a lazily initialized variable call its initializer, so it
+  // doesn't run before main.
+  if (D->hasAttr<LazyInitAttr>()) {
+    DelayedCXXInitPosition[D] = ~0U;
+    return;
+  }
+
   llvm::GlobalVariable *COMDATKey =
       supportsCOMDAT() && D->isExternallyVisible() ? Addr : nullptr;
 
@@ -531,6 +540,35 @@ CodeGenModule::EmitCXXGlobalVarDeclInitFunc(const VarDecl *D,
   DelayedCXXInitPosition[D] = ~0U;
 }
 
+llvm::Function *CodeGenModule::getLazyInitFunction(const VarDecl *D) {
+  llvm::Function *&Fn = LazyInitFuncs[D];
+  if (Fn)
+    return Fn;
+
+  SmallString<256> FnName;
+  {
+    llvm::raw_svector_ostream Out(FnName);
+    getCXXABI().getMangleContext().mangleDynamicInitializer(D, Out);
+  }
+  Fn = CreateGlobalInitOrDestructFunction(
+      llvm::FunctionType::get(VoidTy, false), FnName.str(),
+      getTypes().arrangeNullaryFunction(), D->getLocation());
+  // CHEERP: keep the initializer in the section of the global
+  if (D->hasAttr<AsmJSAttr>())
+    Fn->setSection("asmjs");
+  return Fn;
+}
+
+void CodeGenModule::EmitLazyInitFuncStubs() {
+  for (const auto &I : LazyInitFuncs) {
+    llvm::Function *Fn = I.second;
+    if (!Fn->isDeclaration())
+      continue;
+    llvm::BasicBlock *BB = llvm::BasicBlock::Create(getLLVMContext(), "", Fn);
+    llvm::ReturnInst::Create(getLLVMContext(), BB);
+  }
+}
+
 void CodeGenModule::EmitCXXThreadLocalInitFunc() {
   getCXXABI().EmitThreadLocalInitFuncs(
       *this, CXXThreadLocals, CXXThreadLocalInits, CXXThreadLocalInitVars);
@@ -667,9 +705,13 @@ void CodeGenFunction::GenerateCXXGlobalVarDeclInitFunc(llvm::Function *Fn,
   // Also use guarded initialization for a variable with dynamic TLS and
   // unordered initialization. (If the initialization is ordered, the ABI
   // layer will guard the whole-TU initialization for us.)
+  //
+  // Lazily initialized variables are guarded too, as each of their uses calls
+  // the initializer.
   if (Addr->hasWeakLinkage() || Addr->hasLinkOnceLinkage() ||
       (D->getTLSKind() == VarDecl::TLS_Dynamic &&
-       isTemplateInstantiation(D->getTemplateSpecializationKind()))) {
+       isTemplateInstantiation(D->getTemplateSpecializationKind())) ||
+      D->hasAttr<LazyInitAttr>()) {
     EmitCXXGuardedInit(*D, Addr, PerformInit);
   } else {
     EmitCXXGlobalVarDeclInit(*D, Addr, PerformInit);
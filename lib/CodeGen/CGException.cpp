@@ -724,6 +724,12 @@ llvm::BasicBlock *CodeGenFunction::getInvokeDestImpl() {
   if (LO.CUDA && LO.CUDAIsDevice)
     return nullptr;
 
+  // Cheerp lowers invokes to calls unless wasm exceptions are enabled, so any
+  // landing pad and EH cleanup emitted here would be thrown away.
+  if (CGM.getTarget().getTriple().getArch() == llvm::Triple::cheerp &&
+      !LO.CheerpWasmExceptions)
+    return nullptr;
+
   // Check the innermost scope for a cached landing pad.  If this is
   // a non-EH cleanup, we'll check enclosing scopes in EmitLandingPad.
   llvm::BasicBlock *LP = EHStack.begin()->getCachedLandingPad();
@@ -2378,6 +2378,11 @@ static LValue EmitGlobalVarDeclLValue(CodeGenFunction &CGF,
       return CGF.MakeAddrLValue(Addr, T, AlignmentSource::Decl);
   }
 
+  // Initialize a [[cheerp::lazy_init]] variable on its first use, except from
+  // its own initializer.
+  if (VD->hasAttr<LazyInitAttr>() && CGF.CurGD.getDecl() != VD)
+    CGF.EmitRuntimeCallOrInvoke(CGF.CGM.getLazyInitFunction(VD));
+
   llvm::Value *V = CGF.CGM.GetAddrOfGlobalVar(VD);
   llvm::Type *RealVarTy = CGF.getTypes().ConvertTypeForMem(VD->getType());
   V = EmitBitCastOfLValueToProperType(CGF, V, RealVarTy);
@@ -3453,6 +3458,49 @@ static Address emitArraySubscriptGEP(CodeGenFunction &CGF, Address addr,
   return Address(eltPtr, eltAlign);
 }
 
+/// Describe the extent of a constant size array subscript to the Cheerp
+/// backend, so -cheerp-bounds-check can skip checks it can prove redundant.
+/// Subscripts which are statically in bounds are marked as such directly.
+static void addCheerpArrayExtentMetadata(CodeGenFunction &CGF,
+                                         llvm::Value *EltPtr,
+                                         const Expr *Array, const Expr *Idx) {
+  auto *GEP = dyn_cast<llvm::GetElementPtrInst>(EltPtr);
+  if (!GEP)
+    return;
+  const ConstantArrayType *CAT =
+      CGF.getContext().getAsConstantArrayType(Array->getType());
+  if (!CAT)
+    return;
+  const llvm::APInt &Size = CAT->getSize();
+  llvm::LLVMContext &Ctx = CGF.getLLVMContext();
+  llvm::Module &M = CGF.CGM.getModule();
+
+  GEP->setMetadata(M.getMDKindID("cheerp.array.extent"),
+                   llvm::MDNode::get(Ctx, llvm::ConstantAsMetadata::get(
+                                              llvm::ConstantInt::get(
+                                                  CGF.IntPtrTy, Size))));
+
+  bool InBounds = false;
+  Expr::EvalResult Result;
+  if (Idx->EvaluateAsInt(Result, CGF.getContext())) {
+    const llvm::APSInt &V = Result.Val.getInt();
+    InBounds = !V.isNegative() &&
+               llvm::APSInt::compareValues(V, llvm::APSInt(Size, true)) < 0;
+  } else {
+    // An unsigned index whose whole range fits in the array, like an unsigned
+    // char used on a 256 elements table.
+    QualType IdxTy = Idx->IgnoreParenImpCasts()->getType();
+    if (IdxTy->isUnsignedIntegerType()) {
+      uint64_t Width = CGF.getContext().getIntWidth(IdxTy);
+      InBounds = Width < 64 && Size.getActiveBits() <= 64 &&
+                 (uint64_t(1) << Width) <= Size.getZExtValue();
+    }
+  }
+  if (InBounds)
+    GEP->setMetadata(M.getMDKindID("cheerp.inbounds"),
+                     llvm::MDNode::get(Ctx, None));
+}
+
 LValue CodeGenFunction::EmitArraySubscriptExpr(const ArraySubscriptExpr *E,
                                                bool Accessed) {
   // The index must always be an integer, which is not an aggregate.  Emit it
@@ -3590,6 +3638,9 @@ LValue CodeGenFunction::EmitArraySubscriptExpr(const ArraySubscriptExpr *E,
         *this, ArrayLV.getAddress(), {CGM.getSize(CharUnits::Zero()), Idx},
         E->getType(), !getLangOpts().isSignedOverflowDefined(), SignedIndices,
         E->getExprLoc());
+    if (!getTarget().isByteAddressable())
+      addCheerpArrayExtentMetadata(*this, Addr.getPointer(), Array,
+                                   E->getIdx());
     EltBaseInfo = ArrayLV.getBaseInfo();
     EltTBAAInfo = CGM.getTBAAInfoForSubobject(ArrayLV, E->getType());
   } else {
@@ -4956,7 +5007,7 @@ RValue CodeGenFunction::EmitCall(QualType CalleeType, const CGCallee &OrigCallee
 
   llvm::CallBase *CallOrInvoke = nullptr;
   RValue Call = EmitCall(FnInfo, Callee, ReturnValue, Args, &CallOrInvoke,
-                         E->getExprLoc());
+                         E->getExprLoc(), E == MustTailCall);
 
   // Generate function declaration DISuprogram in order to be used
   // in debug info about call sites.
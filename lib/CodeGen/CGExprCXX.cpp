@@ -1312,6 +1312,115 @@ static void EmitNewInitializer(CodeGenFunction &CGF, const CXXNewExpr *E,
                             AggValueSlot::DoesNotOverlap);
 }
 
+/// Number of released objects of each [[cheerp::pooled]] type kept for reuse
+static const unsigned CheerpObjectPoolSize = 32;
+
+/// Get the free list of a [[cheerp::pooled]] genericjs type, as an array of
+/// released objects and the count of the valid entries. Every translation
+/// unit shares the same pool for a type, unless \p RD is not visible outside
+/// of this one.
+static llvm::GlobalVariable *getCheerpObjectPool(CodeGenModule &CGM,
+                                                 const CXXRecordDecl *RD,
+                                                 llvm::PointerType *PtrTy,
+                                                 llvm::GlobalVariable *&Count) {
+  llvm::Module &M = CGM.getModule();
+  std::string Name =
+      ("cheerp.pool." + cast<llvm::StructType>(PtrTy->getElementType())->getName()).str();
+  llvm::GlobalVariable *Pool = M.getNamedGlobal(Name);
+  Count = M.getNamedGlobal(Name + ".count");
+  if (Pool) {
+    assert(Count);
+    return Pool;
+  }
+  llvm::GlobalValue::LinkageTypes Linkage =
+      RD->isExternallyVisible() ? llvm::GlobalValue::LinkOnceODRLinkage
+                                : llvm::GlobalValue::InternalLinkage;
+  llvm::ArrayType *PoolTy = llvm::ArrayType::get(PtrTy, CheerpObjectPoolSize);
+  Pool = new llvm::GlobalVariable(M, PoolTy, /*isConstant=*/false, Linkage,
+                                  llvm::ConstantAggregateZero::get(PoolTy),
+                                  Name);
+  Count = new llvm::GlobalVariable(M, CGM.Int32Ty, /*isConstant=*/false,
+                                   Linkage,
+                                   llvm::ConstantInt::get(CGM.Int32Ty, 0),
+                                   Name + ".count");
+  return Pool;
+}
+
+/// Allocate an object of a [[cheerp::pooled]] genericjs type, reusing a
+/// released one if available. The constructor then initializes it in place.
+static llvm::Value *EmitCheerpPooledAllocate(CodeGenFunction &CGF,
+                                             const CXXRecordDecl *RD,
+                                             llvm::PointerType *PtrTy,
+                                             llvm::Value *Size,
+                                             llvm::CallBase *&Alloc) {
+  CGBuilderTy &Builder = CGF.Builder;
+  llvm::GlobalVariable *Count;
+  llvm::GlobalVariable *Pool = getCheerpObjectPool(CGF.CGM, RD, PtrTy, Count);
+
+  llvm::BasicBlock *ReuseBB = CGF.createBasicBlock("pool.reuse");
+  llvm::BasicBlock *AllocBB = CGF.createBasicBlock("pool.alloc");
+  llvm::BasicBlock *ContBB = CGF.createBasicBlock("pool.cont");
+
+  llvm::Value *N = Builder.CreateLoad(Address(Count, CharUnits::fromQuantity(4)));
+  Builder.CreateCondBr(Builder.CreateICmpEQ(N, Builder.getInt32(0)), AllocBB,
+                       ReuseBB);
+
+  CGF.EmitBlock(ReuseBB);
+  llvm::Value *Last = Builder.CreateSub(N, Builder.getInt32(1));
+  Builder.CreateStore(Last, Address(Count, CharUnits::fromQuantity(4)));
+  llvm::Value *ReuseIdx[] = {Builder.getInt32(0), Last};
+  llvm::Value *Slot = Builder.CreateInBoundsGEP(Pool, ReuseIdx);
+  llvm::Value *Reused = Builder.CreateLoad(Address(Slot, CharUnits::fromQuantity(4)));
+  Builder.CreateBr(ContBB);
+
+  CGF.EmitBlock(AllocBB);
+  llvm::Function *F = CGF.CGM.getIntrinsic(llvm::Intrinsic::cheerp_allocate, {PtrTy});
+  Alloc = Builder.CreateCall(F, {Size});
+  Builder.CreateBr(ContBB);
+
+  CGF.EmitBlock(ContBB);
+  llvm::PHINode *Result = Builder.CreatePHI(PtrTy, 2);
+  Result->addIncoming(Reused, ReuseBB);
+  Result->addIncoming(Alloc, AllocBB);
+  return Result;
+}
+
+/// Release an object of a [[cheerp::pooled]] genericjs type, after its
+/// destructor has run. It is only dropped for the GC if the pool is full.
+static void EmitCheerpPooledDeallocate(CodeGenFunction &CGF,
+                                       const CXXRecordDecl *RD,
+                                       llvm::PointerType *PtrTy,
+                                       llvm::Value *Ptr,
+                                       llvm::CallBase *&Dealloc) {
+  CGBuilderTy &Builder = CGF.Builder;
+  llvm::GlobalVariable *Count;
+  llvm::GlobalVariable *Pool = getCheerpObjectPool(CGF.CGM, RD, PtrTy, Count);
+
+  llvm::BasicBlock *KeepBB = CGF.createBasicBlock("pool.keep");
+  llvm::BasicBlock *DropBB = CGF.createBasicBlock("pool.drop");
+  llvm::BasicBlock *ContBB = CGF.createBasicBlock("pool.cont");
+
+  llvm::Value *N = Builder.CreateLoad(Address(Count, CharUnits::fromQuantity(4)));
+  Builder.CreateCondBr(
+      Builder.CreateICmpUGE(N, Builder.getInt32(CheerpObjectPoolSize)), DropBB,
+      KeepBB);
+
+  CGF.EmitBlock(KeepBB);
+  llvm::Value *KeepIdx[] = {Builder.getInt32(0), N};
+  llvm::Value *Slot = Builder.CreateInBoundsGEP(Pool, KeepIdx);
+  Builder.CreateStore(Ptr, Address(Slot, CharUnits::fromQuantity(4)));
+  Builder.CreateStore(Builder.CreateAdd(N, Builder.getInt32(1)),
+                      Address(Count, CharUnits::fromQuantity(4)));
+  Builder.CreateBr(ContBB);
+
+  CGF.EmitBlock(DropBB);
+  llvm::Function *F = CGF.CGM.getIntrinsic(llvm::Intrinsic::cheerp_deallocate, {PtrTy});
+  Dealloc = Builder.CreateCall(F, {Ptr});
+  Builder.CreateBr(ContBB);
+
+  CGF.EmitBlock(ContBB);
+}
+
 /// Emit a call to an operator new or operator delete function, as implicitly
 /// created by new-expressions and delete-expressions.
 static RValue EmitNewDeleteCall(CodeGenFunction &CGF,
@@ -1342,8 +1451,33 @@ static RValue EmitNewDeleteCall(CodeGenFunction &CGF,
       break;
     }
   }
+  // Objects of [[cheerp::pooled]] types are recycled through a free list
+  bool pooled = false;
+  if (cheerp && !asmjs && !IsArray) {
+    if (const CXXRecordDecl* RD = allocType->getAsCXXRecordDecl())
+      pooled = RD->hasAttr<PooledAttr>();
+  }
   //CHEERP TODO: warning/error when `cheerp && !asmjs && user_defined_new`
-  if(!IsDelete && cheerp && !(asmjs && user_defined_new))
+  if(!IsDelete && pooled)
+  {
+    QualType retType = CGF.getContext().getPointerType(allocType);
+    llvm::PointerType* ptrType = cast<llvm::PointerType>(CGF.ConvertType(retType));
+    llvm::Value* Size = Args[0].getKnownRValue().getScalarVal();
+    RV = RValue::get(EmitCheerpPooledAllocate(
+        CGF, allocType->getAsCXXRecordDecl(), ptrType, Size, CallOrInvoke));
+  }
+  else if(IsDelete && pooled)
+  {
+    QualType retType = CGF.getContext().getPointerType(allocType);
+    llvm::PointerType* ptrType = cast<llvm::PointerType>(CGF.ConvertType(retType));
+    llvm::Value* Ptr = Args[0].getKnownRValue().getScalarVal();
+    if (Ptr->getType() != ptrType)
+      Ptr = CGF.Builder.CreateBitCast(Ptr, ptrType);
+    EmitCheerpPooledDeallocate(CGF, allocType->getAsCXXRecordDecl(), ptrType,
+                               Ptr, CallOrInvoke);
+    RV = RValue::get(CallOrInvoke);
+  }
+  else if(!IsDelete && cheerp && !(asmjs && user_defined_new))
   {
     // Forge a call to a special type safe allocator intrinsic
     QualType retType = CGF.getContext().getPointerType(allocType);
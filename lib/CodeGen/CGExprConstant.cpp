@@ -1026,6 +1026,78 @@ EmitArrayConstant(CodeGenModule &CGM, llvm::ArrayType *DesiredType,
   return llvm::ConstantStruct::get(SType, Elements);
 }
 
+template <typename T>
+static llvm::Constant *
+EmitIntegerDataArrayConstant(CodeGenModule &CGM, llvm::ArrayType *DesiredType,
+                             const APValue &Value) {
+  auto GetElt = [](const APValue &V, T &Elt) {
+    if (!V.isInt())
+      return false;
+    Elt = static_cast<T>(V.getInt().getZExtValue());
+    return true;
+  };
+
+  T Filler = 0;
+  if (Value.hasArrayFiller() && !GetElt(Value.getArrayFiller(), Filler))
+    return nullptr;
+
+  // Only the initialized elements are stored until we know how much of the
+  // array has to be emitted, the bound can be much larger.
+  unsigned NumElements = Value.getArraySize();
+  unsigned NumInitElts = Value.getArrayInitializedElts();
+  SmallVector<T, 64> Data(NumInitElts);
+  unsigned NonzeroLength = Filler ? NumElements : 0;
+  for (unsigned I = 0; I < NumInitElts; ++I) {
+    if (!GetElt(Value.getArrayInitializedElt(I), Data[I]))
+      return nullptr;
+    if (Data[I] && NonzeroLength < I + 1)
+      NonzeroLength = I + 1;
+  }
+
+  // Produce the same constants as EmitArrayConstant.
+  if (NonzeroLength == 0)
+    return llvm::ConstantAggregateZero::get(DesiredType);
+  llvm::LLVMContext &Ctx = CGM.getLLVMContext();
+  unsigned TrailingZeroes = NumElements - NonzeroLength;
+  if (CGM.getTarget().isByteAddressable() && TrailingZeroes >= 8) {
+    if (NonzeroLength < 8)
+      return nullptr;
+    // The filler is zero, so all the non-zero elements are initialized.
+    Data.resize(NonzeroLength);
+    llvm::Constant *Elts[] = {
+        llvm::ConstantDataArray::get(Ctx, makeArrayRef(Data)),
+        llvm::ConstantAggregateZero::get(llvm::ArrayType::get(
+            DesiredType->getElementType(), TrailingZeroes))};
+    return llvm::ConstantStruct::getAnon(Ctx, Elts, /*Packed=*/true);
+  }
+  Data.resize(NumElements, Filler);
+  return llvm::ConstantDataArray::get(Ctx, makeArrayRef(Data));
+}
+
+/// Emit an array of integers from its evaluated value without creating a
+/// constant for every element. Returns null if the value cannot be emitted
+/// this way.
+static llvm::Constant *
+EmitIntegerDataArrayConstant(CodeGenModule &CGM, llvm::ArrayType *DesiredType,
+                             QualType EltType, const APValue &Value) {
+  llvm::Type *EltTy = DesiredType->getElementType();
+  if (!EltTy->isIntegerTy() ||
+      EltTy->getIntegerBitWidth() != CGM.getContext().getTypeSize(EltType))
+    return nullptr;
+  switch (EltTy->getIntegerBitWidth()) {
+  case 8:
+    return EmitIntegerDataArrayConstant<uint8_t>(CGM, DesiredType, Value);
+  case 16:
+    return EmitIntegerDataArrayConstant<uint16_t>(CGM, DesiredType, Value);
+  case 32:
+    return EmitIntegerDataArrayConstant<uint32_t>(CGM, DesiredType, Value);
+  case 64:
+    return EmitIntegerDataArrayConstant<uint64_t>(CGM, DesiredType, Value);
+  default:
+    return nullptr;
+  }
+}
+
 // This class only needs to handle arrays, structs and unions. Outside C++11
 // mode, we don't currently constant fold those types.  All other types are
 // handled by constant folding.
@@ -1527,6 +1599,24 @@ llvm::Constant *ConstantEmitter::emitForInitializer(const APValue &value,
   return C;
 }
 
+llvm::Constant *
+ConstantEmitter::tryEmitForRelaxedInitializer(const VarDecl &D) {
+  initializeNonAbstract(D.getType().getAddressSpace());
+  InConstantContext = true;
+
+  // See the FIXME in tryEmitPrivateForVarInit about references bound to
+  // temporaries.
+  const Expr *E = D.getInit();
+  if (!E || D.getType()->isReferenceType() || E->isValueDependent())
+    return markIfFailed(nullptr);
+
+  APValue Value;
+  if (!E->EvaluateAsRelaxedInitializer(Value, CGM.getContext(), &D))
+    return markIfFailed(nullptr);
+
+  return markIfFailed(tryEmitPrivateForMemory(Value, D.getType()));
+}
+
 llvm::GlobalValue *ConstantEmitter::getCurrentAddrPrivate() {
   assert(!Abstract && "cannot get current address for abstract constant");
 
@@ -2338,6 +2428,17 @@ llvm::Constant *ConstantEmitter::tryEmitPrivate(const APValue &Value,
         return nullptr;
     }
 
+    // Large tables of integers are extremely common, emit them without
+    // creating a constant for each element.
+    if (CAT && CAT->getElementType()->isIntegerType() &&
+        !CAT->getElementType()->isBooleanType()) {
+      llvm::ArrayType *Desired =
+          cast<llvm::ArrayType>(CGM.getTypes().ConvertType(DestType));
+      if (llvm::Constant *C = EmitIntegerDataArrayConstant(
+              CGM, Desired, CAT->getElementType(), Value))
+        return C;
+    }
+
     // Emit initializer elements.
     SmallVector<llvm::Constant*, 16> Elts;
     if (Filler && Filler->isNullValue())
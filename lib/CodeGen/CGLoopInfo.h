@@ -211,6 +211,9 @@ public:
   /// Return the top loop id metadata.
   llvm::MDNode *getCurLoopID() const { return getInfo().getLoopID(); }
 
+  /// Return the number of loops enclosing the current point.
+  unsigned getDepth() const { return Active.size(); }
+
   /// Return true if the top loop is parallel.
   bool getCurLoopParallel() const {
     return hasInfo() ? getInfo().getAttributes().IsParallel : false;
@@ -13,6 +13,7 @@
 #include "clang/AST/DeclCXX.h"
 #include "clang/Basic/LLVM.h"
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/IR/DerivedTypes.h"
 
 namespace llvm {
@@ -141,6 +142,10 @@ private:
   // Pointer to the directBase layout if any
   const CGRecordLayout* DirectBaseLayout;
 
+  // Cheerp: All the types in the directbase chain of the complete object type.
+  // An upcast to any of them is a plain bitcast
+  llvm::SmallPtrSet<llvm::StructType *, 4> CollapsedBaseTypes;
+
   /// False if any direct or indirect subobject of this class, when
   /// considered as a complete object, requires a non-zero bitpattern
   /// when zero-initialized.
@@ -252,6 +257,12 @@ public:
     return BaseOffsetFromNo;
   }
 
+  /// Return true if BaseTy is in the directbase chain of this record, so that
+  /// its fields are embedded at the start of the derived type.
+  bool isCollapsedBaseType(llvm::StructType *BaseTy) const {
+    return CollapsedBaseTypes.count(BaseTy);
+  }
+
   void print(raw_ostream &OS) const;
   void dump() const;
 };
@@ -828,6 +828,17 @@ CGBitFieldInfo CGBitFieldInfo::MakeInfo(CodeGenTypes &Types,
   return CGBitFieldInfo(Offset, Size, IsSigned, StorageSize, StorageOffset);
 }
 
+// Cheerp: Check whether the record itself has the client_layout attribute, or
+// if the first base has it, recursively
+static bool hasClientLayout(const RecordDecl *D) {
+  if (D->hasAttr<ClientLayoutAttr>())
+    return true;
+  const CXXRecordDecl *RD = dyn_cast<CXXRecordDecl>(D);
+  if (!RD || RD->bases_begin() == RD->bases_end())
+    return false;
+  return hasClientLayout(RD->bases_begin()->getType()->getAsCXXRecordDecl());
+}
+
 CGRecordLayout *CodeGenTypes::ComputeRecordLayout(const RecordDecl *D,
                                                   llvm::StructType *Ty) {
   CGRecordLowering Builder(*this, D, /*Packed=*/false);
@@ -873,6 +884,10 @@ CGRecordLayout *CodeGenTypes::ComputeRecordLayout(const RecordDecl *D,
   RL->NonVirtualBases.swap(Builder.NonVirtualBases);
   RL->CompleteObjectVirtualBases.swap(Builder.VirtualBases);
 
+  // Cheerp: Compute the directbase chain once, upcasts query it for every base
+  for (llvm::StructType* I = Ty->getDirectBase(); I != nullptr; I = I->getDirectBase())
+    RL->CollapsedBaseTypes.insert(I);
+
   if(isa<CXXRecordDecl>(D))
   {
     RL->firstBaseElement = Builder.firstBaseElement;
@@ -903,12 +918,43 @@ CGRecordLayout *CodeGenTypes::ComputeRecordLayout(const RecordDecl *D,
     }
   }
 
+  // Cheerp: Arrays of [[cheerp::soa]] records are stored as one typed array
+  // per field, let the backend know about them
+  if (!getTarget().isByteAddressable() && D->hasAttr<StructOfArraysAttr>() &&
+      !D->hasAttr<AsmJSAttr>())
+  {
+    llvm::Metadata* typeName[] = {llvm::MDString::get(getLLVMContext(), Ty->getName())};
+    llvm::NamedMDNode* soaMeta = TheModule.getOrInsertNamedMetadata("cheerp_soa_types");
+    soaMeta->addOperand(llvm::MDNode::get(getLLVMContext(), typeName));
+  }
+
   // Add all the field numbers.
   RL->FieldInfo.swap(Builder.Fields);
 
   // Add bitfield info.
   RL->BitFields.swap(Builder.BitFields);
 
+  // Cheerp: client_layout records are plain JS objects, list the properties in
+  // layout order so that the backend can create all of them at once and keep
+  // a single shape for every instance
+  if (!getTarget().isByteAddressable() && hasClientLayout(D))
+  {
+    llvm::SmallVector<std::pair<unsigned, llvm::Metadata*>, 8> Props;
+    for (const FieldDecl* FD: D->fields())
+    {
+      if (FD->isBitField() || !FD->getIdentifier() || !RL->FieldInfo.count(FD))
+        continue;
+      Props.push_back({RL->getLLVMFieldNo(FD),
+                       llvm::MDString::get(getLLVMContext(), FD->getName())});
+    }
+    llvm::sort(Props, llvm::less_first());
+    llvm::SmallVector<llvm::Metadata*, 8> Names;
+    for (const auto& P: Props)
+      Names.push_back(P.second);
+    llvm::NamedMDNode* shapeMeta = TheModule.getOrInsertNamedMetadata((Ty->getName() + "_shape").str());
+    shapeMeta->addOperand(llvm::MDNode::get(getLLVMContext(), Names));
+  }
+
   // Dump the layout, if requested.
   if (getContext().getLangOpts().DumpRecordLayouts) {
     llvm::outs() << "\n*** Dumping IRgen Record Layout\n";
@@ -23,6 +23,7 @@
 #include "llvm/IR/InlineAsm.h"
 #include "llvm/IR/Intrinsics.h"
 #include "llvm/IR/MDBuilder.h"
+#include "llvm/Support/SaveAndRestore.h"
 
 using namespace clang;
 using namespace CodeGen;
@@ -583,6 +584,15 @@ void CodeGenFunction::EmitLabelStmt(const LabelStmt &S) {
 }
 
 void CodeGenFunction::EmitAttributedStmt(const AttributedStmt &S) {
+  const CallExpr *musttail = nullptr;
+  for (const auto *A : S.getAttrs()) {
+    // Sema only accepts musttail on a return statement of a plain call
+    if (isa<MustTailAttr>(A)) {
+      const ReturnStmt *R = cast<ReturnStmt>(S.getSubStmt());
+      musttail = cast<CallExpr>(R->getRetValue()->IgnoreParens());
+    }
+  }
+  SaveAndRestore<const CallExpr *> save_musttail(MustTailCall, musttail);
   EmitStmt(S.getSubStmt(), S.getAttrs());
 }
 
@@ -1152,6 +1152,12 @@ bool CodeGenModule::HasHiddenLTOVisibility(const CXXRecordDecl *RD) {
 
 void CodeGenModule::EmitVTableTypeMetadata(llvm::GlobalVariable *VTable,
                                            const VTableLayout &VTLayout) {
+  // CHEERP: genericjs vtables are structs of per-subobject structs, and byte
+  // offsets into them are meaningless
+  if (!getTarget().isByteAddressable() && VTable->getSection() != "asmjs") {
+    EmitCheerpVTableTypeMetadata(VTable, VTLayout);
+    return;
+  }
   if (!getCodeGenOpts().LTOUnit)
     return;
 
@@ -1212,8 +1218,57 @@ void CodeGenModule::EmitVTableTypeMetadata(llvm::GlobalVariable *VTable,
   }
 }
 
+void CodeGenModule::EmitCheerpVTableTypeMetadata(llvm::GlobalVariable *VTable,
+                                                 const VTableLayout &VTLayout) {
+  if (!getCodeGenOpts().WholeProgramVTables)
+    return;
+
+  // In genericjs the vptr points to a whole vtable of the group, so the index
+  // of the vtable is enough to identify the address point
+  typedef std::pair<unsigned, const CXXRecordDecl *> AddressPoint;
+  std::vector<AddressPoint> AddressPoints;
+  for (auto &&AP : VTLayout.getAddressPoints())
+    AddressPoints.push_back(
+        std::make_pair(AP.second.VTableIndex, AP.first.getBase()));
+
+  // Sort the address points for determinism.
+  llvm::sort(AddressPoints, [this](const AddressPoint &AP1,
+                                   const AddressPoint &AP2) {
+    if (AP1.first != AP2.first)
+      return AP1.first < AP2.first;
+    if (AP1.second == AP2.second)
+      return false;
+
+    std::string S1;
+    llvm::raw_string_ostream O1(S1);
+    getCXXABI().getMangleContext().mangleTypeName(
+        QualType(AP1.second->getTypeForDecl(), 0), O1);
+    O1.flush();
+
+    std::string S2;
+    llvm::raw_string_ostream O2(S2);
+    getCXXABI().getMangleContext().mangleTypeName(
+        QualType(AP2.second->getTypeForDecl(), 0), O2);
+    O2.flush();
+
+    return S1 < S2;
+  });
+
+  for (auto AP : AddressPoints) {
+    llvm::Metadata *Ops[] = {
+        llvm::ConstantAsMetadata::get(
+            llvm::ConstantInt::get(Int32Ty, AP.first)),
+        CreateMetadataIdentifierForType(
+            QualType(AP.second->getTypeForDecl(), 0))};
+    VTable->addMetadata("cheerp.vtable.type",
+                        *llvm::MDTuple::get(getLLVMContext(), Ops));
+  }
+}
+
 llvm::Type* CodeGenTypes::GetVTableBaseType(bool asmjs)
 {
+  if (VTableBaseTypes[asmjs])
+    return VTableBaseTypes[asmjs];
   StringRef typeName = asmjs ? "struct._ZN10__cxxabiv119__vtable_base_asmjsE" : "struct._ZN10__cxxabiv113__vtable_baseE";
   llvm::Type* ResultType = CGM.getModule().getTypeByName(typeName);
   if(!ResultType)
@@ -1221,6 +1276,7 @@ llvm::Type* CodeGenTypes::GetVTableBaseType(bool asmjs)
     llvm::StructType* ty = llvm::StructType::create(CGM.getLLVMContext(), typeName);
     ResultType = ty;
   }
+  VTableBaseTypes[asmjs] = ResultType;
   return ResultType;
 }
 
@@ -1261,23 +1317,33 @@ llvm::Type* CodeGenTypes::GetVTableSubObjectType(CodeGenModule& CGM,
 }
 
 llvm::Type* CodeGenTypes::GetPrimaryVTableType(const CXXRecordDecl* RD) {
+  auto Cached = PrimaryVTableTypes.find(RD);
+  if (Cached != PrimaryVTableTypes.end())
+    return Cached->second;
   ItaniumVTableContext &VTContext = CGM.getItaniumVTableContext();
   const VTableLayout& VTLayout = VTContext.getVTableLayout(RD);
   bool asmjs = RD->hasAttr<AsmJSAttr>();
 
   auto firstComp = VTLayout.vtable_components().begin() + VTLayout.getVTableOffset(0);
   auto lastComp = firstComp + VTLayout.getVTableSize(0);
-  return GetVTableSubObjectType(CGM, firstComp, lastComp, 0, asmjs);
+  llvm::Type* Ty = GetVTableSubObjectType(CGM, firstComp, lastComp, 0, asmjs);
+  PrimaryVTableTypes[RD] = Ty;
+  return Ty;
 }
 
 llvm::Type* CodeGenTypes::GetSecondaryVTableType(const CXXRecordDecl* RD) {
+  auto Cached = SecondaryVTableTypes.find(RD);
+  if (Cached != SecondaryVTableTypes.end())
+    return Cached->second;
   ItaniumVTableContext &VTContext = CGM.getItaniumVTableContext();
   const VTableLayout& VTLayout = VTContext.getVTableLayout(RD);
   bool asmjs = RD->hasAttr<AsmJSAttr>();
 
   auto firstComp = VTLayout.vtable_components().begin() + VTLayout.getVTableOffset(0);
   auto lastComp = firstComp + VTLayout.getVTableSize(0);
-  return GetVTableSubObjectType(CGM, firstComp, lastComp, VTLayout.getPrimaryVirtualMethodsCount(), asmjs);
+  llvm::Type* Ty = GetVTableSubObjectType(CGM, firstComp, lastComp, VTLayout.getPrimaryVirtualMethodsCount(), asmjs);
+  SecondaryVTableTypes[RD] = Ty;
+  return Ty;
 }
 
 llvm::Type* CodeGenTypes::GetBasicVTableType(uint32_t virtualMethodsCount, bool asmjs)
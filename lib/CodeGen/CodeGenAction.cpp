@@ -17,29 +17,43 @@
 #include "clang/Basic/FileManager.h"
 #include "clang/Basic/SourceManager.h"
 #include "clang/Basic/TargetInfo.h"
+#include "clang/Basic/Version.h"
 #include "clang/CodeGen/BackendUtil.h"
+#include "clang/CodeGen/CodeGenCheerp.h"
 #include "clang/CodeGen/ModuleBuilder.h"
 #include "clang/Driver/DriverDiagnostic.h"
 #include "clang/Frontend/CompilerInstance.h"
 #include "clang/Frontend/FrontendDiagnostic.h"
 #include "clang/Lex/Preprocessor.h"
+#include "llvm/ADT/DenseSet.h"
+#include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/BinaryFormat/Magic.h"
 #include "llvm/Bitcode/BitcodeReader.h"
+#include "llvm/Bitcode/BitcodeWriter.h"
 #include "llvm/CodeGen/MachineOptimizationRemarkEmitter.h"
 #include "llvm/IR/DebugInfo.h"
 #include "llvm/IR/DiagnosticInfo.h"
 #include "llvm/IR/DiagnosticPrinter.h"
 #include "llvm/IR/GlobalValue.h"
+#include "llvm/IR/LegacyPassManager.h"
 #include "llvm/IR/LLVMContext.h"
 #include "llvm/IR/Module.h"
 #include "llvm/IR/RemarkStreamer.h"
 #include "llvm/IRReader/IRReader.h"
 #include "llvm/Linker/Linker.h"
+#include "llvm/Object/Archive.h"
 #include "llvm/Pass.h"
+#include "llvm/Support/FileSystem.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/SHA1.h"
 #include "llvm/Support/SourceMgr.h"
+#include "llvm/Support/TimeProfiler.h"
 #include "llvm/Support/Timer.h"
 #include "llvm/Support/ToolOutputFile.h"
 #include "llvm/Support/YAMLTraits.h"
+#include "llvm/Transforms/IPO.h"
 #include "llvm/Transforms/IPO/Internalize.h"
 
 #include <memory>
@@ -946,6 +960,361 @@ static void BitcodeInlineAsmDiagHandler(const llvm::SMDiagnostic &SM,
   Diags->Report(DiagID).AddString("cannot compile inline asm");
 }
 
+/// Hash everything that can change how a module is optimized, followed by the
+/// module \p Bitcode, into a cache entry path of the -cheerp-lto-cache-dir
+/// directory.
+static std::string getModuleCachePath(CompilerInstance &CI, StringRef Prefix,
+                                      StringRef Bitcode) {
+  const CodeGenOptions &CodeGenOpts = CI.getCodeGenOpts();
+  SHA1 Hasher;
+  auto AddString = [&Hasher](StringRef S) {
+    Hasher.update(S);
+    Hasher.update(ArrayRef<uint8_t>{0});
+  };
+
+  AddString(getClangFullVersion());
+  AddString(CI.getTargetOpts().Triple);
+  AddString(std::to_string(CodeGenOpts.OptimizationLevel));
+  AddString(std::to_string(CodeGenOpts.OptimizeSize));
+  for (const std::string &Pass : CodeGenOpts.CheerpLinkTimePasses)
+    AddString(Pass);
+  for (const std::string &Arg : CI.getFrontendOpts().LLVMArgs)
+    AddString(Arg);
+  Hasher.update(Bitcode);
+
+  SmallString<128> Path(CodeGenOpts.CheerpLTOCacheDir);
+  llvm::sys::path::append(Path, Prefix + toHex(Hasher.result()) + ".bc");
+  return Path.str();
+}
+
+/// Store \p Data as the cache entry \p CachePath. Failing to populate the
+/// cache is not an error. Write to a temporary file first so that concurrent
+/// builds never see a partial entry.
+static void writeModuleCacheEntry(StringRef CacheDir, StringRef CachePath,
+                                  ArrayRef<char> Data) {
+  int FD;
+  SmallString<128> TempPath;
+  if (llvm::sys::fs::create_directories(CacheDir) ||
+      llvm::sys::fs::createUniqueFile(CachePath + ".tmp-%%%%%%", FD, TempPath))
+    return;
+  raw_fd_ostream OS(FD, /*shouldClose=*/true);
+  OS.write(Data.data(), Data.size());
+  OS.close();
+  if (OS.has_error()) {
+    OS.clear_error();
+    llvm::sys::fs::remove(TempPath);
+    return;
+  }
+  if (llvm::sys::fs::rename(TempPath, CachePath))
+    llvm::sys::fs::remove(TempPath);
+}
+
+/// Load the link input \p Buf after running the per-module optimization
+/// pipeline on it, the same one a translation unit gets at compile time. The
+/// result is cached by the input contents and the optimization options, so an
+/// unchanged input is only pre-optimized once across builds. What this saves
+/// is the per-module work on unchanged inputs: the linked program still goes
+/// through the whole-program passes and the final pipeline, unless
+/// optimizeWithModuleCache finds all of it unchanged. \p Parse loads the input
+/// when it is not cached. Returns null on error.
+static std::unique_ptr<llvm::Module> loadPreOptimizedModule(
+    CompilerInstance &CI, MemoryBufferRef Buf, LLVMContext &Ctx,
+    llvm::function_ref<std::unique_ptr<llvm::Module>()> Parse) {
+  std::string CachePath = getModuleCachePath(CI, "input-", Buf.getBuffer());
+  if (auto CachedBuf = MemoryBuffer::getFile(CachePath)) {
+    Expected<std::unique_ptr<llvm::Module>> CachedOrErr =
+        getOwningLazyBitcodeModule(std::move(*CachedBuf), Ctx);
+    if (CachedOrErr)
+      return std::move(*CachedOrErr);
+    // A corrupted entry is just a miss, it is overwritten below
+    consumeError(CachedOrErr.takeError());
+  }
+
+  std::unique_ptr<llvm::Module> M = Parse();
+  if (!M)
+    return nullptr;
+
+  // The whole program passes only make sense after linking
+  CodeGenOptions InputOpts = CI.getCodeGenOpts();
+  InputOpts.CheerpLinkTimePasses.clear();
+  InputOpts.LinkBitcodeFiles.clear();
+  SmallVector<char, 0> Optimized;
+  EmitBackendOutput(CI.getDiagnostics(), CI.getHeaderSearchOpts(), InputOpts,
+                    CI.getTargetOpts(), CI.getLangOpts(),
+                    CI.getTarget().getDataLayout(), M.get(), Backend_EmitBC,
+                    llvm::make_unique<raw_svector_ostream>(Optimized));
+  if (CI.getDiagnostics().hasErrorOccurred())
+    return nullptr;
+  writeModuleCacheEntry(InputOpts.CheerpLTOCacheDir, CachePath, Optimized);
+  return M;
+}
+
+/// Load the link input \p Buf, running the per-module optimization pipeline
+/// on it first with -cheerp-cache-link-inputs. Without it the module is
+/// loaded lazily, so only the functions that are linked in are ever read.
+/// \p Buf must stay alive until the module is linked. Returns null on error.
+static std::unique_ptr<llvm::Module>
+loadLinkInput(CompilerInstance &CI, MemoryBufferRef Buf, LLVMContext &Ctx,
+              llvm::function_ref<void(Error)> ReportError) {
+  if (CI.getCodeGenOpts().CheerpCacheLinkInputs)
+    return loadPreOptimizedModule(
+        CI, Buf, Ctx, [&]() -> std::unique_ptr<llvm::Module> {
+          Expected<std::unique_ptr<llvm::Module>> ModuleOrErr =
+              parseBitcodeFile(Buf, Ctx);
+          if (!ModuleOrErr) {
+            ReportError(ModuleOrErr.takeError());
+            return nullptr;
+          }
+          return std::move(*ModuleOrErr);
+        });
+
+  Expected<std::unique_ptr<llvm::Module>> ModuleOrErr =
+      getLazyBitcodeModule(Buf, Ctx);
+  if (!ModuleOrErr) {
+    ReportError(ModuleOrErr.takeError());
+    return nullptr;
+  }
+  return std::move(*ModuleOrErr);
+}
+
+/// Link the members of the bitcode archive \p Buf needed to resolve the
+/// undefined symbols of \p M, the same way a linker handles static archives.
+/// \p LinkedMembers holds the offsets of the members of this archive that
+/// were already linked, by this call or by an earlier search of the archive.
+static bool linkBitcodeArchive(CompilerInstance &CI, llvm::Module &M,
+                               MemoryBufferRef Buf, unsigned LinkFlags,
+                               llvm::DenseSet<uint64_t> &LinkedMembers) {
+  auto ReportError = [&](Error E) {
+    handleAllErrors(std::move(E), [&](ErrorInfoBase &EIB) {
+      CI.getDiagnostics().Report(diag::err_fe_cannot_link_module)
+          << Buf.getBufferIdentifier() << EIB.message();
+    });
+    return true;
+  };
+
+  Expected<std::unique_ptr<object::Archive>> ArchiveOrErr =
+      object::Archive::create(Buf);
+  if (!ArchiveOrErr)
+    return ReportError(ArchiveOrErr.takeError());
+  object::Archive &Archive = **ArchiveOrErr;
+
+  // Members are linked as a whole, each one is pulled in at most once over
+  // all the searches of the archive. Linking one again would duplicate its
+  // definitions and its appending globals.
+  LinkFlags &= ~Linker::Flags::LinkOnlyNeeded;
+
+  // Linking a member may introduce new undefined symbols, keep going until
+  // no more members are pulled in
+  bool Changed = true;
+  while (Changed) {
+    Changed = false;
+    std::vector<std::string> Undefined;
+    for (const llvm::GlobalValue &GV : M.global_values())
+      if (GV.isDeclaration() && GV.hasName() &&
+          !GV.getName().startswith("llvm."))
+        Undefined.push_back(GV.getName());
+
+    for (const std::string &Name : Undefined) {
+      Expected<Optional<object::Archive::Child>> ChildOrErr =
+          Archive.findSym(Name);
+      if (!ChildOrErr)
+        return ReportError(ChildOrErr.takeError());
+      if (!*ChildOrErr ||
+          !LinkedMembers.insert((*ChildOrErr)->getChildOffset()).second)
+        continue;
+
+      Expected<MemoryBufferRef> MemberOrErr =
+          (*ChildOrErr)->getMemoryBufferRef();
+      if (!MemberOrErr)
+        return ReportError(MemberOrErr.takeError());
+      std::unique_ptr<llvm::Module> MemberModule = loadLinkInput(
+          CI, *MemberOrErr, M.getContext(),
+          [&](Error E) { ReportError(std::move(E)); });
+      if (!MemberModule)
+        return true;
+      if (Linker::linkModules(M, std::move(MemberModule), LinkFlags))
+        return true;
+      Changed = true;
+    }
+  }
+  return false;
+}
+
+/// Link the bitcode file \p Buf, given as \p F, into \p M. Archives are only
+/// accepted as -cheerp-link-bitcode-library inputs.
+/// \p Relink is set when a library is searched again, its appending globals
+/// (global constructors and the like) were already linked the first time.
+/// \p LinkedMembers records the archive members linked so far, by file name.
+/// Returns true on error.
+static bool
+linkBitcodeInput(CompilerInstance &CI, llvm::Module &M,
+                 const CodeGenOptions::BitcodeFileToLink &F,
+                 MemoryBufferRef Buf, bool Relink,
+                 llvm::StringMap<llvm::DenseSet<uint64_t>> &LinkedMembers) {
+  if (F.LinkAsLibrary &&
+      identify_magic(Buf.getBuffer()) == file_magic::archive)
+    return linkBitcodeArchive(CI, M, Buf, F.LinkFlags,
+                              LinkedMembers[F.Filename]);
+
+  std::unique_ptr<llvm::Module> InputModule =
+      loadLinkInput(CI, Buf, M.getContext(), [&](Error E) {
+        handleAllErrors(std::move(E), [&](ErrorInfoBase &EIB) {
+          CI.getDiagnostics().Report(diag::err_cannot_open_file)
+              << F.Filename << EIB.message();
+        });
+      });
+  if (!InputModule)
+    return true;
+  if (Relink) {
+    for (auto I = InputModule->global_begin(), E = InputModule->global_end();
+         I != E;) {
+      llvm::GlobalVariable &GV = *I++;
+      if (GV.hasAppendingLinkage())
+        GV.eraseFromParent();
+    }
+  }
+  return Linker::linkModules(M, std::move(InputModule), F.LinkFlags);
+}
+
+static size_t countDefinitions(const llvm::Module &M) {
+  return llvm::count_if(M.global_values(), [](const llvm::GlobalValue &GV) {
+    return !GV.isDeclaration();
+  });
+}
+
+/// Whether an IR input is the Cheerp link step, either because it targets
+/// Cheerp or because Cheerp specific link options were given.
+static bool isCheerpLinkStep(CompilerInstance &CI) {
+  const CodeGenOptions &CodeGenOpts = CI.getCodeGenOpts();
+  return CI.getTarget().getTriple().getArch() == llvm::Triple::cheerp ||
+         CodeGenOpts.CheerpCacheLinkInputs ||
+         llvm::any_of(CodeGenOpts.LinkBitcodeFiles,
+                      [](const CodeGenOptions::BitcodeFileToLink &F) {
+                        return F.LinkAsLibrary;
+                      });
+}
+
+/// Link the files given with -mlink-bitcode-file into the IR module \p M.
+/// Returns true on error.
+static bool linkBitcodeFilesIntoIRModule(CompilerInstance &CI,
+                                         llvm::Module &M) {
+  llvm::TimeTraceScope TimeScope("Link", StringRef(""));
+  // The inputs are mapped in memory, together with lazy loading only the
+  // parts of a library that are actually linked are ever read
+  std::vector<std::pair<const CodeGenOptions::BitcodeFileToLink *,
+                        std::unique_ptr<MemoryBuffer>>>
+      Libraries;
+  llvm::StringMap<llvm::DenseSet<uint64_t>> LinkedMembers;
+  for (const CodeGenOptions::BitcodeFileToLink &F :
+       CI.getCodeGenOpts().LinkBitcodeFiles) {
+    ErrorOr<std::unique_ptr<MemoryBuffer>> BCBuf = MemoryBuffer::getFile(
+        F.Filename, /*FileSize=*/-1, /*RequiresNullTerminator=*/false);
+    if (!BCBuf) {
+      CI.getDiagnostics().Report(diag::err_cannot_open_file)
+          << F.Filename << BCBuf.getError().message();
+      return true;
+    }
+    if (F.LinkAsLibrary) {
+      Libraries.emplace_back(&F, std::move(*BCBuf));
+      continue;
+    }
+    if (linkBitcodeInput(CI, M, F, (*BCBuf)->getMemBufferRef(),
+                         /*Relink=*/false, LinkedMembers))
+      return true;
+  }
+
+  // Libraries only provide what the program needs. Any of them may need
+  // symbols from another one, so keep searching them all until none of them
+  // provides anything new.
+  size_t Definitions = countDefinitions(M);
+  for (bool Relink = false; !Libraries.empty(); Relink = true) {
+    for (const auto &Library : Libraries)
+      if (linkBitcodeInput(CI, M, *Library.first,
+                           Library.second->getMemBufferRef(), Relink,
+                           LinkedMembers))
+        return true;
+    size_t NewDefinitions = countDefinitions(M);
+    if (NewDefinitions == Definitions)
+      break;
+    Definitions = NewDefinitions;
+  }
+  return false;
+}
+
+/// Drop everything that is not reachable from the entry points of the linked
+/// Cheerp program: webMain, main, the functions in the jsexport metadata and
+/// the globals in llvm.used and llvm.compiler.used. Runtime functions that
+/// the later Cheerp passes call into must be kept through the used lists.
+static void removeCheerpUnreachableCode(llvm::Module &M) {
+  llvm::TimeTraceScope TimeScope("RemoveUnreachable", StringRef(""));
+  llvm::SmallPtrSet<const llvm::GlobalValue *, 16> Roots;
+  llvm::SmallVector<llvm::Function *, 16> Exported;
+  cheerp::collectJsExportedFunctions(M, Exported);
+  Roots.insert(Exported.begin(), Exported.end());
+  llvm::SmallPtrSet<llvm::GlobalValue *, 16> Used;
+  llvm::collectUsedGlobalVariables(M, Used, /*CompilerUsed=*/false);
+  llvm::collectUsedGlobalVariables(M, Used, /*CompilerUsed=*/true);
+  Roots.insert(Used.begin(), Used.end());
+  for (StringRef Name : {"webMain", "main"})
+    if (const llvm::GlobalValue *GV = M.getNamedValue(Name))
+      Roots.insert(GV);
+
+  llvm::internalizeModule(M, [&Roots](const llvm::GlobalValue &GV) {
+    return Roots.count(&GV);
+  });
+  llvm::legacy::PassManager PM;
+  PM.add(llvm::createGlobalDCEPass());
+  PM.run(M);
+}
+
+/// Compute the path of the cached optimized version of \p M. The key covers
+/// the whole linked module and everything that can change how it is
+/// optimized, so a change to any of the link inputs is a miss.
+static std::string getOptimizedModuleCachePath(CompilerInstance &CI,
+                                               llvm::Module &M) {
+  // The module identifier is the name of the (temporary) input file, leave it
+  // out of the key
+  std::string ModuleID = M.getModuleIdentifier();
+  M.setModuleIdentifier("");
+  SmallVector<char, 0> Bitcode;
+  raw_svector_ostream OS(Bitcode);
+  WriteBitcodeToFile(M, OS);
+  M.setModuleIdentifier(ModuleID);
+  return getModuleCachePath(CI, "lto-", StringRef(Bitcode.data(),
+                                                  Bitcode.size()));
+}
+
+/// Run the optimizer on \p M only if no identical module was optimized
+/// before, otherwise replace it with the cached result. In both cases only
+/// code generation is left to do afterwards.
+static void optimizeWithModuleCache(CompilerInstance &CI,
+                                    std::unique_ptr<llvm::Module> &M) {
+  std::string CachePath = getOptimizedModuleCachePath(CI, *M);
+  CodeGenOptions &CodeGenOpts = CI.getCodeGenOpts();
+
+  if (auto CachedBuf = MemoryBuffer::getFile(CachePath)) {
+    Expected<std::unique_ptr<llvm::Module>> CachedOrErr =
+        parseBitcodeFile((*CachedBuf)->getMemBufferRef(), M->getContext());
+    if (CachedOrErr) {
+      M = std::move(*CachedOrErr);
+      CodeGenOpts.DisableLLVMPasses = true;
+      return;
+    }
+    // A corrupted entry is just a miss, it is overwritten below
+    consumeError(CachedOrErr.takeError());
+  }
+
+  SmallVector<char, 0> Optimized;
+  EmitBackendOutput(CI.getDiagnostics(), CI.getHeaderSearchOpts(), CodeGenOpts,
+                    CI.getTargetOpts(), CI.getLangOpts(),
+                    CI.getTarget().getDataLayout(), M.get(), Backend_EmitBC,
+                    llvm::make_unique<raw_svector_ostream>(Optimized));
+  CodeGenOpts.DisableLLVMPasses = true;
+  if (CI.getDiagnostics().hasErrorOccurred())
+    return;
+  writeModuleCacheEntry(CodeGenOpts.CheerpLTOCacheDir, CachePath, Optimized);
+}
+
 std::unique_ptr<llvm::Module>
 CodeGenAction::loadModule(MemoryBufferRef MBRef) {
   CompilerInstance &CI = getCompilerInstance();
@@ -1029,7 +1398,23 @@ void CodeGenAction::ExecuteAction() {
     if (Invalid)
       return;
 
-    TheModule = loadModule(*MainFile);
+    if (CI.getCodeGenOpts().CheerpCacheLinkInputs) {
+      TheModule = loadPreOptimizedModule(
+          CI, MainFile->getMemBufferRef(), *VMContext,
+          [&] { return loadModule(MainFile->getMemBufferRef()); });
+      // Cached modules are loaded lazily, but this one is linked into
+      if (TheModule) {
+        if (Error E = TheModule->materializeAll()) {
+          handleAllErrors(std::move(E), [&](ErrorInfoBase &EIB) {
+            CI.getDiagnostics().Report(diag::err_cannot_open_file)
+                << getCurrentFile() << EIB.message();
+          });
+          return;
+        }
+      }
+    } else {
+      TheModule = loadModule(*MainFile);
+    }
     if (!TheModule)
       return;
 
@@ -1041,6 +1426,14 @@ void CodeGenAction::ExecuteAction() {
       TheModule->setTargetTriple(TargetOpts.Triple);
     }
 
+    // For the Cheerp link step, link in the -mlink-bitcode-file modules, this
+    // lets a whole program be linked and compiled in a single process
+    if (isCheerpLinkStep(CI) && linkBitcodeFilesIntoIRModule(CI, *TheModule))
+      return;
+    if (CI.getCodeGenOpts().CheerpLinkRootsOnly &&
+        CI.getTarget().getTriple().getArch() == llvm::Triple::cheerp)
+      removeCheerpUnreachableCode(*TheModule);
+
     EmbedBitcode(TheModule.get(), CI.getCodeGenOpts(),
                  MainFile->getMemBufferRef());
 
@@ -1048,6 +1441,12 @@ void CodeGenAction::ExecuteAction() {
     Ctx.setInlineAsmDiagnosticHandler(BitcodeInlineAsmDiagHandler,
                                       &CI.getDiagnostics());
 
+    if (!CI.getCodeGenOpts().CheerpLTOCacheDir.empty()) {
+      optimizeWithModuleCache(CI, TheModule);
+      if (CI.getDiagnostics().hasErrorOccurred())
+        return;
+    }
+
     EmitBackendOutput(CI.getDiagnostics(), CI.getHeaderSearchOpts(),
                       CI.getCodeGenOpts(), TargetOpts, CI.getLangOpts(),
                       CI.getTarget().getDataLayout(), TheModule.get(), BA,
@@ -21,6 +21,15 @@ void cheerp::JsExportContext::addFreeFunctionJsExportMetadata(llvm::Function* F)
        namedNode->addOperand(node);
 }
 
+void cheerp::JsExportContext::addBatchJsExportMetadata(llvm::Function* F)
+{
+       llvm::NamedMDNode* namedNode = module.getOrInsertNamedMetadata("jsexported_batch_functions");
+       llvm::SmallVector<llvm::Metadata*,1> values;
+       values.push_back(llvm::ConstantAsMetadata::get(F));
+       llvm::MDNode* node = llvm::MDNode::get(context,values);
+       namedNode->addOperand(node);
+}
+
 void cheerp::JsExportContext::addRecordJsExportMetadata(const clang::CXXMethodDecl *method, llvm::Function* F, const llvm::StringRef className)
 {
        llvm::NamedMDNode* namedNode = module.getOrInsertNamedMetadata(llvm::Twine(className,"_methods").str());
@@ -34,3 +43,59 @@ void cheerp::JsExportContext::addRecordJsExportMetadata(const clang::CXXMethodDe
        llvm::MDNode* node = llvm::MDNode::get(context,values);
        namedNode->addOperand(node);
 }
+
+static std::string getTypeScriptType(clang::QualType Ty)
+{
+       const clang::QualType Canonical = Ty.getCanonicalType();
+       if (Canonical->isVoidType())
+               return "void";
+       if (Canonical->isBooleanType())
+               return "boolean";
+       if (Canonical->isIntegerType() || Canonical->isRealFloatingType())
+               return "number";
+       if (Canonical->isFunctionType() || Canonical->isFunctionPointerType() ||
+           (Canonical->isReferenceType() && Canonical->getPointeeType()->isFunctionType()))
+               return "Function";
+       if (Canonical->isPointerType() || Canonical->isReferenceType())
+       {
+               // Both client types and jsexported records are exposed with their own name
+               if (const clang::CXXRecordDecl* Record = Canonical->getPointeeType()->getAsCXXRecordDecl())
+                       return Record->getNameAsString();
+       }
+       return "any";
+}
+
+void cheerp::JsExportContext::addJsExportTypesMetadata(const clang::FunctionDecl* FD, llvm::Function* F)
+{
+       llvm::SmallVector<llvm::Metadata*,4> values;
+       values.push_back(llvm::MDString::get(context, getTypeScriptType(FD->getReturnType())));
+       for (const clang::ParmVarDecl* param: FD->parameters())
+               values.push_back(llvm::MDString::get(context, getTypeScriptType(param->getOriginalType())));
+       F->setMetadata("cheerp.jsexport.types", llvm::MDNode::get(context, values));
+}
+
+void cheerp::collectJsExportedFunctions(const llvm::Module& module, llvm::SmallVectorImpl<llvm::Function*>& functions)
+{
+       for (const llvm::NamedMDNode& namedNode: module.named_metadata())
+       {
+               llvm::StringRef name = namedNode.getName();
+               // Record methods are listed in <struct type name>_methods, see
+               // addRecordJsExportMetadata
+               llvm::StringRef className = name;
+               bool isRecordMethods = className.consume_back("_methods") &&
+                                      module.getTypeByName(className);
+               if (name != "jsexported_free_functions" &&
+                   name != "jsexported_batch_functions" && !isRecordMethods)
+                       continue;
+               for (const llvm::MDNode* node: namedNode.operands())
+               {
+                       if (node->getNumOperands() == 0)
+                               continue;
+                       auto* value = llvm::dyn_cast<llvm::ConstantAsMetadata>(node->getOperand(0));
+                       if (!value)
+                               continue;
+                       if (llvm::Function* F = llvm::dyn_cast<llvm::Function>(value->getValue()->stripPointerCasts()))
+                               functions.push_back(F);
+               }
+       }
+}
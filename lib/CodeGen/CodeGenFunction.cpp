@@ -24,6 +24,7 @@
 #include "clang/AST/ASTLambda.h"
 #include "clang/AST/Decl.h"
 #include "clang/AST/DeclCXX.h"
+#include "clang/AST/ParentMap.h"
 #include "clang/AST/StmtCXX.h"
 #include "clang/AST/StmtObjC.h"
 #include "clang/Basic/Builtins.h"
@@ -953,6 +954,7 @@ void CodeGenFunction::StartFunction(GlobalDecl GD,
 	 const llvm::StringRef className = clang::cast<llvm::StructType>(ConvertType(MD->getParent()))->getName();
          cheerp::JsExportContext jsExportContext(CGM.getModule(), getLLVMContext(), Int32Ty);
          jsExportContext.addRecordJsExportMetadata(MD, CurFn, className);
+         jsExportContext.addJsExportTypesMetadata(MD, CurFn);
        }
      }
   }
@@ -2192,6 +2194,60 @@ static bool hasRequiredFeatures(const SmallVectorImpl<StringRef> &ReqFeatures,
       });
 }
 
+// Whether the Cheerp section of D comes from the default of the translation
+// unit, and not from an attribute of D or of its contexts.
+static bool hasDefaultCheerpSection(const Decl *D) {
+  for (; D; D = dyn_cast<Decl>(D->getDeclContext())) {
+    if (const AsmJSAttr *A = D->getAttr<AsmJSAttr>()) {
+      if (!A->isImplicit())
+        return false;
+    } else if (const GenericJSAttr *A = D->getAttr<GenericJSAttr>()) {
+      if (!A->isImplicit())
+        return false;
+    }
+    if (isa<TranslationUnitDecl>(D))
+      break;
+  }
+  return true;
+}
+
+// Emits a remark for calls from one Cheerp section to an inline function or a
+// template instantiation that was placed in the other one only by default.
+// They could be moved to the side of their callers with an attribute.
+void CodeGenFunction::checkCheerpSectionCrossing(
+    SourceLocation Loc, const FunctionDecl *TargetDecl) {
+  const auto *Caller = dyn_cast_or_null<NamedDecl>(CurFuncDecl);
+  if (!TargetDecl || !Caller || CGM.getTarget().isByteAddressable())
+    return;
+  if (CGM.getDiags().isIgnored(diag::remark_cheerp_section_crossing, Loc))
+    return;
+  if (!TargetDecl->isInlined() && !TargetDecl->isTemplateInstantiation())
+    return;
+  bool CallerIsWasm = CurFn->getSection() == "asmjs";
+  if (CallerIsWasm == TargetDecl->hasAttr<AsmJSAttr>())
+    return;
+  if (!hasDefaultCheerpSection(TargetDecl))
+    return;
+  CGM.getDiags().Report(Loc, diag::remark_cheerp_section_crossing)
+      << CallerIsWasm << Caller << TargetDecl;
+}
+
+// Emits a remark for every call between the genericjs and wasm sections, with
+// the depth of the enclosing loop nest, to help finding the hot ones.
+void CodeGenFunction::checkCheerpBoundaryCrossing(
+    SourceLocation Loc, const FunctionDecl *TargetDecl) {
+  const auto *Caller = dyn_cast_or_null<NamedDecl>(CurFuncDecl);
+  if (!TargetDecl || !Caller || CGM.getTarget().isByteAddressable())
+    return;
+  if (CGM.getDiags().isIgnored(diag::remark_cheerp_boundary_crossing, Loc))
+    return;
+  bool CallerIsWasm = CurFn->getSection() == "asmjs";
+  if (CallerIsWasm == TargetDecl->hasAttr<AsmJSAttr>())
+    return;
+  CGM.getDiags().Report(Loc, diag::remark_cheerp_boundary_crossing)
+      << CallerIsWasm << Caller << TargetDecl << LoopStack.getDepth();
+}
+
 // Emits an error if we don't have a valid set of target features for the
 // called function.
 void CodeGenFunction::checkTargetFeatures(const CallExpr *E,
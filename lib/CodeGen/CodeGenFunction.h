@@ -75,6 +75,7 @@ class ObjCAtTryStmt;
 class ObjCAtThrowStmt;
 class ObjCAtSynchronizedStmt;
 class ObjCAutoreleasePoolStmt;
+class ParentMap;
 
 namespace analyze_os_log {
 class OSLogBufferLayout;
@@ -467,6 +468,12 @@ public:
   /// should emit cleanups.
   bool CurFuncIsThunk = false;
 
+  /// The parent map returned by getCurFuncParentMap(), along with the body it
+  /// was built for and whether that body contains labels.
+  std::unique_ptr<ParentMap> CurFuncParentMap;
+  const Stmt *CurFuncParentMapBody = nullptr;
+  bool CurFuncBodyContainsLabel = false;
+
   /// In ARC, whether we should autorelease the return value.
   bool AutoreleaseResult = false;
 
@@ -484,6 +491,10 @@ public:
   /// region.
   bool IsInPreservedAIRegion = false;
 
+  /// The call marked with the musttail attribute in the current return
+  /// statement, if any.
+  const CallExpr *MustTailCall = nullptr;
+
   const CodeGen::CGBlockInfo *BlockInfo = nullptr;
   llvm::Value *BlockPointer = nullptr;
 
@@ -3621,7 +3632,8 @@ public:
   /// LLVM arguments and the types they were derived from.
   RValue EmitCall(const CGFunctionInfo &CallInfo, const CGCallee &Callee,
                   ReturnValueSlot ReturnValue, const CallArgList &Args,
-                  llvm::CallBase **callOrInvoke, SourceLocation Loc);
+                  llvm::CallBase **callOrInvoke, SourceLocation Loc,
+                  bool IsMustTail = false);
   RValue EmitCall(const CGFunctionInfo &CallInfo, const CGCallee &Callee,
                   ReturnValueSlot ReturnValue, const CallArgList &Args,
                   llvm::CallBase **callOrInvoke = nullptr) {
@@ -3637,6 +3649,10 @@ public:
 
   void checkTargetFeatures(const CallExpr *E, const FunctionDecl *TargetDecl);
   void checkTargetFeatures(SourceLocation Loc, const FunctionDecl *TargetDecl);
+  void checkCheerpSectionCrossing(SourceLocation Loc,
+                                  const FunctionDecl *TargetDecl);
+  void checkCheerpBoundaryCrossing(SourceLocation Loc,
+                                   const FunctionDecl *TargetDecl);
 
   llvm::CallInst *EmitRuntimeCall(llvm::FunctionCallee callee,
                                   const Twine &name = "");
@@ -3786,6 +3802,13 @@ public:
 
   llvm::Value *BuildVector(ArrayRef<llvm::Value*> Ops);
   llvm::Value *EmitCheerpBuiltinExpr(unsigned BuiltinID, const CallExpr *E, bool asmjs);
+  /// Returns the parent map of the body of CurFuncDecl. It is built on first
+  /// use and shared by all the Cheerp allocation builtins in the function,
+  /// which use it to find the cast that determines the allocated type.
+  const ParentMap &getCurFuncParentMap();
+  /// Returns true if the body of CurFuncDecl contains labels, which may be the
+  /// target of a backward goto. Computed together with the parent map.
+  bool curFuncContainsLabel();
   llvm::Value *EmitX86BuiltinExpr(unsigned BuiltinID, const CallExpr *E);
   llvm::Value *EmitPPCBuiltinExpr(unsigned BuiltinID, const CallExpr *E);
   llvm::Value *EmitAMDGPUBuiltinExpr(unsigned BuiltinID, const CallExpr *E);
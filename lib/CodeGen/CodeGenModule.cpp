@@ -401,6 +401,7 @@ void CodeGenModule::Release() {
   applyReplacements();
   checkAliases();
   emitMultiVersionFunctions();
+  EmitLazyInitFuncStubs();
   EmitCXXGlobalInitFunc();
   EmitCXXGlobalDtorFunc();
   registerGlobalDtorsWithAtExit();
@@ -1097,7 +1098,13 @@ StringRef CodeGenModule::getMangledName(GlobalDecl GD) {
 
   // Keep the first result in the case of a mangling collision.
   const auto *ND = cast<NamedDecl>(GD.getDecl());
-  std::string MangledName = getMangledNameImpl(*this, GD, ND);
+  std::string MangledName;
+  {
+    // Individual manglings are too short to be recorded, but -ftime-trace
+    // reports the total time spent here.
+    llvm::TimeTraceScope TimeScope("Mangle", StringRef(""));
+    MangledName = getMangledNameImpl(*this, GD, ND);
+  }
 
   // Adjust kernel stub mangling as we may need to be able to differentiate
   // them from the kernel itself (e.g., for HIP).
@@ -1640,6 +1647,11 @@ void CodeGenModule::SetLLVMFunctionAttributesForDefinition(const Decl *D,
   {
     cheerp::JsExportContext jsExportContext(getModule(), getLLVMContext(), Int32Ty);
     jsExportContext.addFreeFunctionJsExportMetadata(F);
+    jsExportContext.addJsExportTypesMetadata(cast<FunctionDecl>(D), F);
+    // The backend also emits a wrapper looping over a typed array of
+    // argument tuples
+    if (D->hasAttr<JsExportBatchAttr>())
+      jsExportContext.addBatchJsExportMetadata(F);
   }
 }
 
@@ -3868,6 +3880,15 @@ void CodeGenModule::EmitGlobalVarDefinition(const VarDecl *D,
       }
     }
 
+    // Cheerp has no cheap way to run global constructors, so before falling
+    // back to a dynamic initializer try to fold it, also evaluating calls to
+    // non-constexpr functions. This is allowed by [basic.start.static]p3.
+    if (!Init && !getTarget().isByteAddressable() &&
+        getLangOpts().CPlusPlus && !D->getTLSKind()) {
+      emitter.emplace(*this);
+      Init = emitter->tryEmitForRelaxedInitializer(*InitDecl);
+    }
+
     if (!Init) {
       QualType T = InitExpr->getType();
       if (D->getType()->isReferenceType())
@@ -4379,8 +4400,12 @@ void CodeGenModule::EmitGlobalFunctionDefinition(GlobalDecl GD,
   maybeSetTrivialComdat(*D, *Fn);
 
   //cheerp: set the section to asmjs
-  if (D->hasAttr<AsmJSAttr>())
+  if (D->hasAttr<AsmJSAttr>()) {
     Fn->setSection("asmjs");
+    // The backend moves lazy functions to a module loaded on first call
+    if (D->hasAttr<LazyAttr>())
+      Fn->addFnAttr("cheerp-lazy");
+  }
 
   CodeGenFunction(*this).GenerateCode(D, Fn, FI);
 
@@ -5499,23 +5524,19 @@ void CodeGenModule::EmitDeferredUnusedCoverageMappings() {
     case Decl::Function:
     case Decl::ObjCMethod: {
       CodeGenPGO PGO(*this);
-      GlobalDecl GD(cast<FunctionDecl>(D));
-      PGO.emitEmptyCounterMapping(D, getMangledName(GD),
-                                  getFunctionLinkage(GD));
+      PGO.emitEmptyCounterMapping(GlobalDecl(cast<FunctionDecl>(D)));
       break;
     }
     case Decl::CXXConstructor: {
       CodeGenPGO PGO(*this);
-      GlobalDecl GD(cast<CXXConstructorDecl>(D), Ctor_Base);
-      PGO.emitEmptyCounterMapping(D, getMangledName(GD),
-                                  getFunctionLinkage(GD));
+      PGO.emitEmptyCounterMapping(
+          GlobalDecl(cast<CXXConstructorDecl>(D), Ctor_Base));
       break;
     }
     case Decl::CXXDestructor: {
       CodeGenPGO PGO(*this);
-      GlobalDecl GD(cast<CXXDestructorDecl>(D), Dtor_Base);
-      PGO.emitEmptyCounterMapping(D, getMangledName(GD),
-                                  getFunctionLinkage(GD));
+      PGO.emitEmptyCounterMapping(
+          GlobalDecl(cast<CXXDestructorDecl>(D), Dtor_Base));
       break;
     }
     default:
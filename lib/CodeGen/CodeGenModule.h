@@ -460,6 +460,10 @@ private:
   /// init_priority attribute.
   SmallVector<GlobalInitData, 8> PrioritizedCXXGlobalInits;
 
+  /// The guarded initialization functions of [[cheerp::lazy_init]] variables,
+  /// which are called on each use instead of before main.
+  llvm::DenseMap<const VarDecl *, llvm::Function *> LazyInitFuncs;
+
   /// Global destructor functions and arguments that need to run on termination.
   std::vector<
       std::tuple<llvm::FunctionType *, llvm::WeakTrackingVH, llvm::Constant *>>
@@ -807,6 +811,10 @@ public:
                                      SourceLocation Loc = SourceLocation(),
                                      bool TLS = false);
 
+  /// Return the function initializing the [[cheerp::lazy_init]] variable \p D
+  /// on its first use. Its body is emitted with the definition of \p D.
+  llvm::Function *getLazyInitFunction(const VarDecl *D);
+
   /// Return the AST address space of the underlying global variable for D, as
   /// determined by its declaration. Normally this is the same as the address
   /// space of D's type, but in CUDA, address spaces are associated with
@@ -1284,6 +1292,11 @@ public:
   void EmitVTableTypeMetadata(llvm::GlobalVariable *VTable,
                               const VTableLayout &VTLayout);
 
+  /// Emit the Cheerp class hierarchy metadata for the given genericjs vtable,
+  /// used by the Cheerp whole program devirtualization.
+  void EmitCheerpVTableTypeMetadata(llvm::GlobalVariable *VTable,
+                                    const VTableLayout &VTLayout);
+
   /// Generate a cross-DSO type identifier for MD.
   llvm::ConstantInt *CreateCrossDsoCfiTypeId(llvm::Metadata *MD);
 
@@ -1396,6 +1409,10 @@ private:
   /// Emit the function that initializes C++ globals.
   void EmitCXXGlobalInitFunc();
 
+  /// Give an empty body to the lazy initialization functions of variables
+  /// that turned out not to need a dynamic initialization.
+  void EmitLazyInitFuncStubs();
+
   /// Emit the function that destroys C++ globals.
   void EmitCXXGlobalDtorFunc();
 
@@ -844,9 +844,8 @@ void CodeGenPGO::emitCounterRegionMapping(const Decl *D) {
       FuncNameVar, FuncName, FunctionHash, CoverageMapping);
 }
 
-void
-CodeGenPGO::emitEmptyCounterMapping(const Decl *D, StringRef Name,
-                                    llvm::GlobalValue::LinkageTypes Linkage) {
+void CodeGenPGO::emitEmptyCounterMapping(GlobalDecl GD) {
+  const Decl *D = GD.getDecl();
   if (skipRegionMappingForDecl(D))
     return;
 
@@ -861,7 +860,9 @@ CodeGenPGO::emitEmptyCounterMapping(const Decl *D, StringRef Name,
   if (CoverageMapping.empty())
     return;
 
-  setFuncName(Name, Linkage);
+  // Mangle the name only now, as most unused functions, e.g. the inline
+  // functions of system headers, get no mapping.
+  setFuncName(CGM.getMangledName(GD), CGM.getFunctionLinkage(GD));
   CGM.getCoverageMapping()->addFunctionMappingRecord(
       FuncNameVar, FuncName, FunctionHash, CoverageMapping, false);
 }
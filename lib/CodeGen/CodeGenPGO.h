@@ -82,8 +82,7 @@ public:
   void assignRegionCounters(GlobalDecl GD, llvm::Function *Fn);
   /// Emit a coverage mapping range with a counter zero
   /// for an unused declaration.
-  void emitEmptyCounterMapping(const Decl *D, StringRef FuncName,
-                               llvm::GlobalValue::LinkageTypes Linkage);
+  void emitEmptyCounterMapping(GlobalDecl GD);
   // Insert instrumentation or attach profile metadata at value sites
   void valueProfile(CGBuilderTy &Builder, uint32_t ValueKind,
                     llvm::Instruction *ValueSite, llvm::Value *ValuePtr);
@@ -204,8 +204,9 @@ llvm::MDNode *CodeGenTBAA::getTypeInfo(QualType QTy) {
     return getBaseTypeInfo(QTy);
 
   const Type *Ty = Context.getCanonicalType(QTy).getTypePtr();
-  if (llvm::MDNode *N = MetadataCache[Ty])
-    return N;
+  auto CachedNode = MetadataCache.find(Ty);
+  if (CachedNode != MetadataCache.end())
+    return CachedNode->second;
 
   // Note that the following helper call is allowed to add new nodes to the
   // cache, which invalidates all its previously obtained iterators. So we
@@ -280,14 +281,23 @@ CodeGenTBAA::CollectFields(uint64_t BaseOffset,
 
 llvm::MDNode *
 CodeGenTBAA::getTBAAStructInfo(QualType QTy) {
+  // The cache is keyed on the canonical type, which loses the may_alias
+  // attribute of a typedef; such copies get all their fields as char
+  SmallVector<llvm::MDBuilder::TBAAStructField, 4> Fields;
+  if (TypeHasMayAlias(QTy)) {
+    if (CollectFields(0, QTy, Fields, /*MayAlias=*/true))
+      return MDHelper.createTBAAStructNode(Fields);
+    return nullptr;
+  }
+
   const Type *Ty = Context.getCanonicalType(QTy).getTypePtr();
 
-  if (llvm::MDNode *N = StructMetadataCache[Ty])
-    return N;
+  auto CachedNode = StructMetadataCache.find(Ty);
+  if (CachedNode != StructMetadataCache.end())
+    return CachedNode->second;
 
-  SmallVector<llvm::MDBuilder::TBAAStructField, 4> Fields;
-  if (CollectFields(0, QTy, Fields, TypeHasMayAlias(QTy)))
-    return MDHelper.createTBAAStructNode(Fields);
+  if (CollectFields(0, QTy, Fields, /*MayAlias=*/false))
+    return StructMetadataCache[Ty] = MDHelper.createTBAAStructNode(Fields);
 
   // For now, handle any other kind of type conservatively.
   return StructMetadataCache[Ty] = nullptr;
@@ -345,8 +355,9 @@ llvm::MDNode *CodeGenTBAA::getBaseTypeInfo(QualType QTy) {
     return nullptr;
 
   const Type *Ty = Context.getCanonicalType(QTy).getTypePtr();
-  if (llvm::MDNode *N = BaseTypeMetadataCache[Ty])
-    return N;
+  auto CachedNode = BaseTypeMetadataCache.find(Ty);
+  if (CachedNode != BaseTypeMetadataCache.end())
+    return CachedNode->second;
 
   // Note that the following helper call is allowed to add new nodes to the
   // cache, which invalidates all its previously obtained iterators. So we
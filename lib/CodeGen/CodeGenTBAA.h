@@ -133,7 +133,8 @@ class CodeGenTBAA {
   llvm::DenseMap<TBAAAccessInfo, llvm::MDNode *> AccessTagMetadataCache;
 
   /// StructMetadataCache - This maps clang::Types to llvm::MDNodes describing
-  /// them for struct assignments.
+  /// them for struct assignments, or to null for types that are handled
+  /// conservatively.
   llvm::DenseMap<const Type *, llvm::MDNode *> StructMetadataCache;
 
   llvm::MDNode *Root;
@@ -31,7 +31,8 @@ using namespace CodeGen;
 CodeGenTypes::CodeGenTypes(CodeGenModule &cgm)
   : CGM(cgm), Context(cgm.getContext()), TheModule(cgm.getModule()),
     Target(cgm.getTarget()), TheCXXABI(cgm.getCXXABI()),
-    TheABIInfo(cgm.getTargetCodeGenInfo().getABIInfo()) {
+    TheABIInfo(cgm.getTargetCodeGenInfo().getABIInfo()),
+    VTableBaseTypes{nullptr, nullptr} {
   SkippedLayout = false;
 }
 
@@ -767,6 +768,9 @@ llvm::StructType *CodeGenTypes::ConvertRecordDeclType(const RecordDecl *RD) {
   // Layout fields.
   CGRecordLayout *Layout = ComputeRecordLayout(RD, Ty);
   CGRecordLayouts[Key] = Layout;
+  LLVMTypeLayouts[Layout->getLLVMType()] = Layout;
+  if (llvm::StructType *BaseTy = Layout->getBaseSubobjectLLVMType())
+    LLVMTypeLayouts[BaseTy] = Layout;
 
   // We're done laying out this struct.
   bool EraseResult = RecordsBeingLaidOut.erase(Key); (void)EraseResult;
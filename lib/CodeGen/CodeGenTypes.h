@@ -82,6 +82,10 @@ class CodeGenTypes {
   /// Contains the LLVM IR type for any converted RecordDecl.
   llvm::DenseMap<const Type*, llvm::StructType *> RecordDeclTypes;
 
+  /// Maps the complete and base subobject LLVM types of a record to its
+  /// layout.
+  llvm::DenseMap<llvm::StructType *, const CGRecordLayout *> LLVMTypeLayouts;
+
   /// Hold memoized CGFunctionInfo results.
   llvm::FoldingSet<CGFunctionInfo> FunctionInfos;
 
@@ -105,6 +109,14 @@ class CodeGenTypes {
 
   llvm::SmallSet<const Type *, 8> RecordsWithOpaqueMemberPointers;
 
+  /// Cheerp vtable base types, indexed by whether they are for asmjs records.
+  llvm::Type *VTableBaseTypes[2];
+
+  /// Cheerp vtable types of each dynamic record. A vtable layout never changes
+  /// once computed, so these never need to be invalidated.
+  llvm::DenseMap<const CXXRecordDecl *, llvm::Type *> PrimaryVTableTypes;
+  llvm::DenseMap<const CXXRecordDecl *, llvm::Type *> SecondaryVTableTypes;
+
   /// Helper for ConvertType.
   llvm::Type *ConvertFunctionTypeInternal(QualType FT);
 
@@ -176,6 +188,12 @@ public:
 
   const CGRecordLayout &getCGRecordLayout(const RecordDecl*);
 
+  /// Return the layout of the record converted to the given LLVM type, or
+  /// null if it is not the type of an already laid out record.
+  const CGRecordLayout *lookupCGRecordLayout(llvm::StructType *Ty) const {
+    return LLVMTypeLayouts.lookup(Ty);
+  }
+
   /// UpdateCompletedType - When we find the full definition for a TagDecl,
   /// replace the 'opaque' type we previously made for it if applicable.
   void UpdateCompletedType(const TagDecl *TD);
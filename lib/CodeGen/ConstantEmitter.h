@@ -75,6 +75,12 @@ public:
   llvm::Constant *emitForInitializer(const APValue &value, LangAS destAddrSpace,
                                      QualType destType);
 
+  /// Try to emit the initializer of the given declaration by evaluating it
+  /// with calls to non-constexpr functions allowed.  Used by Cheerp to avoid
+  /// running dynamic initializers.  If this succeeds, the emission must be
+  /// finalized.
+  llvm::Constant *tryEmitForRelaxedInitializer(const VarDecl &D);
+
   void finalize(llvm::GlobalVariable *global);
 
   // All of the "abstract" emission methods below permit the emission to
@@ -1427,17 +1427,30 @@ llvm::Value *ItaniumCXXABI::EmitDynamicCastCall(
   // Compute the offset hint.
   const CXXRecordDecl *SrcDecl = SrcRecordTy->getAsCXXRecordDecl();
   const CXXRecordDecl *DestDecl = DestRecordTy->getAsCXXRecordDecl();
-  llvm::Value *OffsetHint = llvm::ConstantInt::get(
-      PtrDiffLTy,
-      computeOffsetHint(CGF.getContext(), SrcDecl, DestDecl).getQuantity());
+  CharUnits Offset = computeOffsetHint(CGF.getContext(), SrcDecl, DestDecl);
+  llvm::Value *OffsetHint =
+      llvm::ConstantInt::get(PtrDiffLTy, Offset.getQuantity());
 
   llvm::Value *Value = ThisAddr.getPointer();
   bool asmjs = SrcDecl->hasAttr<AsmJSAttr>();
   llvm::Value *VTable = CGF.GetVTablePtr(ThisAddr, CGF.getTypes().GetVTableBaseType(asmjs)->getPointerTo(), SrcDecl);
   llvm::Value *DynCastObj = Value;
 
-  // Emit the call to __dynamic_cast.
-  if(!CGF.getTarget().isByteAddressable()) {
+  // Cheerp: Nothing derives from a final class, so when the source is its
+  // primary base the cast succeeds exactly if the object uses the vtable of
+  // the destination. Compare the vtable instead of walking the type info.
+  bool ExactCast = !CGF.getTarget().isByteAddressable() && !asmjs &&
+                   !DestDecl->hasAttr<AsmJSAttr>() &&
+                   DestDecl->hasAttr<FinalAttr>() && Offset.isZero();
+  if(ExactCast) {
+    llvm::Value *DestVTable = getVTableAddressPoint(
+        BaseSubobject(DestDecl, CharUnits::Zero()), DestDecl);
+    DestVTable = CGF.Builder.CreateBitCast(DestVTable, VTable->getType());
+    llvm::Value *IsExact = CGF.Builder.CreateICmpEQ(VTable, DestVTable);
+    Value = CGF.Builder.CreateSelect(
+        IsExact, CGF.Builder.CreateBitCast(DynCastObj, DestLTy),
+        llvm::ConstantPointerNull::get(cast<llvm::PointerType>(DestLTy)));
+  } else if(!CGF.getTarget().isByteAddressable()) {
     llvm::Type* Tys[] = { DynCastObj->getType() };
     llvm::Function* intrinsic = llvm::Intrinsic::getDeclaration(&CGF.CGM.getModule(), llvm::Intrinsic::cheerp_downcast_current, Tys);
     Value = CGF.Builder.CreateCall(intrinsic, Value);
@@ -1449,7 +1462,7 @@ llvm::Value *ItaniumCXXABI::EmitDynamicCastCall(
     Value = CGF.EmitNounwindRuntimeCall(getItaniumDynamicCastFn(CGF), args);
   }
 
-  if(!CGF.getTarget().isByteAddressable()) {
+  if(!CGF.getTarget().isByteAddressable() && !ExactCast) {
     llvm::BasicBlock *EndBB = CGF.createBasicBlock("cheerp_downcast_end");
     llvm::BasicBlock *DynamicBB = CGF.createBasicBlock("cheerp_dynamic_downcast");
     llvm::SwitchInst *SI = CGF.Builder.CreateSwitch(Value, DynamicBB);
@@ -1478,7 +1491,7 @@ llvm::Value *ItaniumCXXABI::EmitDynamicCastCall(
     Result->addIncoming(ZeroDowncast, ZeroBB);
     Result->addIncoming(FailedDowncast, FailedBB);
     Value = Result;
-  } else
+  } else if(!ExactCast)
     Value = CGF.Builder.CreateBitCast(Value, DestLTy);
 
   /// C++ [expr.dynamic.cast]p9:
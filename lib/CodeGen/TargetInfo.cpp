@@ -8669,18 +8669,44 @@ private:
   ABIArgInfo classifyReturnType(QualType RetTy) const {
     return DefaultABIInfo::classifyReturnType(RetTy);
   };
-  ABIArgInfo classifyArgumentType(QualType Ty) const {
+  ABIArgInfo classifyArgumentType(QualType Ty, bool IsFixed) const {
+    if (IsFixed && isSmallScalarRecord(Ty))
+      return ABIArgInfo::getExpand();
     return DefaultABIInfo::classifyArgumentType(Ty);
   };
 
+  /// Small records of scalars, like std::pair<int, T*>, are passed as their
+  /// fields. Passing them byval costs a temporary object in genericjs and a
+  /// stack copy in the linear memory.
+  bool isSmallScalarRecord(QualType Ty) const {
+    const RecordType *RT = Ty->getAs<RecordType>();
+    if (!RT || getRecordArgABI(RT, getCXXABI()) != CGCXXABI::RAA_Default)
+      return false;
+    const RecordDecl *RD = RT->getDecl();
+    if (RD->isUnion() || RD->hasFlexibleArrayMember() || RD->isByteLayout())
+      return false;
+    if (const CXXRecordDecl *CXXRD = dyn_cast<CXXRecordDecl>(RD))
+      if (CXXRD->getNumBases() || CXXRD->isDynamicClass())
+        return false;
+    unsigned NumFields = 0;
+    for (const FieldDecl *FD : RD->fields()) {
+      QualType FT = FD->getType();
+      if (FD->isBitField() || !(FT->isArithmeticType() || FT->isPointerType()) ||
+          FT->isAnyComplexType() || ++NumFields > 2)
+        return false;
+    }
+    return NumFields != 0;
+  }
+
   // DefaultABIInfo's classifyReturnType and classifyArgumentType are
   // non-virtual, but computeInfo and EmitVAArg are virtual, so we
   // overload them.
   void computeInfo(CGFunctionInfo &FI) const override {
     if (!getCXXABI().classifyReturnType(FI))
       FI.getReturnInfo() = classifyReturnType(FI.getReturnType());
+    unsigned ArgNo = 0;
     for (auto &Arg : FI.arguments())
-      Arg.info = classifyArgumentType(Arg.type);
+      Arg.info = classifyArgumentType(Arg.type, ArgNo++ < FI.getNumRequiredArgs());
   }
 };
 
@@ -348,12 +348,6 @@ llvm::Expected<ASTUnit *> CrossTranslationUnitContext::loadExternalAST(
   //        translation units contains decls with the same lookup name an
   //        error will be returned.
 
-  if (NumASTLoaded >= CTULoadThreshold) {
-    ++NumASTLoadThresholdReached;
-    return llvm::make_error<IndexError>(
-        index_error_code::load_threshold_reached);
-  }
-
   ASTUnit *Unit = nullptr;
   auto NameUnitCacheEntry = NameASTUnitMap.find(LookupName);
   if (NameUnitCacheEntry == NameASTUnitMap.end()) {
@@ -366,7 +360,7 @@ llvm::Expected<ASTUnit *> CrossTranslationUnitContext::loadExternalAST(
       llvm::Expected<llvm::StringMap<std::string>> IndexOrErr =
           parseCrossTUIndex(IndexFile, CrossTUDir);
       if (IndexOrErr)
-        NameFileMap = *IndexOrErr;
+        NameFileMap = std::move(*IndexOrErr);
       else
         return IndexOrErr.takeError();
     }
@@ -379,6 +373,14 @@ llvm::Expected<ASTUnit *> CrossTranslationUnitContext::loadExternalAST(
     StringRef ASTFileName = It->second;
     auto ASTCacheEntry = FileASTUnitMap.find(ASTFileName);
     if (ASTCacheEntry == FileASTUnitMap.end()) {
+      // Only loading a new AST file counts against the threshold. Lookups
+      // served by an AST file that is already in memory are free.
+      if (NumASTLoaded >= CTULoadThreshold) {
+        ++NumASTLoadThresholdReached;
+        return llvm::make_error<IndexError>(
+            index_error_code::load_threshold_reached);
+      }
+
       IntrusiveRefCntPtr<DiagnosticOptions> DiagOpts = new DiagnosticOptions();
       TextDiagnosticPrinter *DiagClient =
           new TextDiagnosticPrinter(llvm::errs(), &*DiagOpts);
@@ -97,19 +97,30 @@ public:
   }
 
   // Blocks on caller thread and uses codition_variable to wait until there's an
-  // event to return.
-  DirectoryWatcher::Event pop_front_blocking() {
+  // event. Then returns all the queued events up to and including the first
+  // WatcherGotInvalidated, so that bursts of changes reach the Receiver in a
+  // single call. An event equal to the one before it (e.g. a file written in
+  // several chunks) carries no new information and is dropped.
+  std::vector<DirectoryWatcher::Event> pop_all_blocking() {
     std::unique_lock<std::mutex> L(Mtx);
-    while (true) {
-      // Since we might have missed all the prior notifications on NonEmpty we
-      // have to check the queue first (under lock).
-      if (!Events.empty()) {
-        DirectoryWatcher::Event Front = Events.front();
-        Events.pop();
-        return Front;
-      }
-      NonEmpty.wait(L, [this]() { return !Events.empty(); });
+    // Since we might have missed all the prior notifications on NonEmpty we
+    // have to check the queue first (under lock).
+    NonEmpty.wait(L, [this]() { return !Events.empty(); });
+
+    std::vector<DirectoryWatcher::Event> Result;
+    while (!Events.empty()) {
+      DirectoryWatcher::Event Front = std::move(Events.front());
+      Events.pop();
+      const bool IsLast =
+          Front.Kind ==
+          DirectoryWatcher::Event::EventKind::WatcherGotInvalidated;
+      if (Result.empty() || Result.back().Kind != Front.Kind ||
+          Result.back().Filename != Front.Filename)
+        Result.push_back(std::move(Front));
+      if (IsLast)
+        break;
     }
+    return Result;
   }
 };
 
@@ -267,6 +278,11 @@ void DirectoryWatcherLinux::InotifyPollingLoop() {
       } else if (Event->mask & IN_IGNORED) {
         StopWork();
         return;
+      } else if (Event->mask & IN_Q_OVERFLOW) {
+        // The kernel queue overflowed and events were lost. The client has to
+        // start over with a new watcher.
+        StopWork();
+        return;
       } else {
         StopWork();
         llvm_unreachable("Unknown event type.");
@@ -283,9 +299,10 @@ void DirectoryWatcherLinux::InitialScan() {
 
 void DirectoryWatcherLinux::EventReceivingLoop() {
   while (true) {
-    DirectoryWatcher::Event Event = this->Queue.pop_front_blocking();
-    this->Receiver(Event, false);
-    if (Event.Kind ==
+    std::vector<DirectoryWatcher::Event> Events =
+        this->Queue.pop_all_blocking();
+    this->Receiver(Events, false);
+    if (Events.back().Kind ==
         DirectoryWatcher::Event::EventKind::WatcherGotInvalidated) {
       StopWork();
       return;
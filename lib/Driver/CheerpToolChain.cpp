@@ -94,6 +94,17 @@ bool Cheerp::isPICDefaultForced() const {
   return true;
 }
 
+void Cheerp::adjustDebugInfoKind(codegenoptions::DebugInfoKind &DebugInfoKind,
+                                 const llvm::opt::ArgList &Args) const {
+  // The Cheerp writer only reads debug locations and subprograms to write
+  // sourcemaps. When they are only needed for -cheerp-sourcemap=, emit just
+  // those; an explicit -g keeps its usual meaning.
+  if (DebugInfoKind == codegenoptions::NoDebugInfo &&
+      Args.hasArg(options::OPT_cheerp_sourcemap_EQ) &&
+      !Args.hasArg(options::OPT_g_Group))
+    DebugInfoKind = codegenoptions::DebugLineTablesOnly;
+}
+
 Tool *Cheerp::buildLinker() const {
   return new tools::cheerp::Link(*this);
 }
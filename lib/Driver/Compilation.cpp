@@ -17,14 +17,20 @@
 #include "clang/Driver/Util.h"
 #include "llvm/ADT/None.h"
 #include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallString.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/Triple.h"
 #include "llvm/Option/ArgList.h"
 #include "llvm/Option/OptSpecifier.h"
 #include "llvm/Option/Option.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/ThreadPool.h"
+#include "llvm/Support/Threading.h"
 #include "llvm/Support/raw_ostream.h"
 #include <cassert>
+#include <condition_variable>
+#include <mutex>
 #include <string>
 #include <system_error>
 #include <utility>
@@ -148,8 +154,7 @@ bool Compilation::CleanupFileMap(const ArgStringMap &Files,
   return Success;
 }
 
-int Compilation::ExecuteCommand(const Command &C,
-                                const Command *&FailingCommand) const {
+bool Compilation::PrintCommand(const Command &C) const {
   if ((getDriver().CCPrintOptions ||
        getArgs().hasArg(options::OPT_v)) && !getDriver().CCGenDiagnostics) {
     raw_ostream *OS = &llvm::errs();
@@ -165,8 +170,7 @@ int Compilation::ExecuteCommand(const Command &C,
       if (EC) {
         getDriver().Diag(diag::err_drv_cc_print_options_failure)
             << EC.message();
-        FailingCommand = &C;
-        return 1;
+        return false;
       }
       OS = OwnedStream.get();
     }
@@ -176,10 +180,22 @@ int Compilation::ExecuteCommand(const Command &C,
 
     C.Print(*OS, "\n", /*Quote=*/getDriver().CCPrintOptions);
   }
+  return true;
+}
+
+int Compilation::ExecuteCommand(const Command &C,
+                                const Command *&FailingCommand) const {
+  if (!PrintCommand(C)) {
+    FailingCommand = &C;
+    return 1;
+  }
 
   std::string Error;
   bool ExecutionFailed;
+  auto Start = std::chrono::steady_clock::now();
   int Res = C.Execute(Redirects, &Error, &ExecutionFailed);
+  if (RecordJobTimes)
+    JobTimes.push_back({&C, Start, std::chrono::steady_clock::now()});
   if (!Error.empty()) {
     assert(Res && "Error string set with 0 result code!");
     getDriver().Diag(diag::err_drv_command_failure) << Error;
@@ -222,6 +238,14 @@ static bool InputsOk(const Command &C,
 
 void Compilation::ExecuteJobs(const JobList &Jobs,
                               FailingCommandList &FailingCommands) const {
+  // Output redirected for diagnostics and the cl driver printing the input
+  // names need to see the jobs one at a time
+  if (ParallelJobs > 1 && Jobs.size() > 1 && Redirects.empty() &&
+      !TheDriver.IsCLMode() && llvm::llvm_is_multithreaded()) {
+    ExecuteJobsInParallel(Jobs, FailingCommands, ParallelJobs);
+    return;
+  }
+
   // According to UNIX standard, driver need to continue compiling all the
   // inputs on the command line even one of them failed.
   // In all but CLMode, execute all the jobs unless the necessary inputs for the
@@ -239,6 +263,181 @@ void Compilation::ExecuteJobs(const JobList &Jobs,
   }
 }
 
+namespace {
+/// The state of a job run by ExecuteJobsInParallel.
+struct ParallelJob {
+  enum { Waiting, Running, Done, Skipped } State = Waiting;
+  /// The jobs producing the inputs of this one.
+  SmallVector<unsigned, 4> Deps;
+  /// The files capturing the stdout and stderr of the job.
+  SmallString<128> OutFile, ErrFile;
+  int Res = 0;
+  bool ExecutionFailed = false;
+  std::string Error;
+  std::chrono::steady_clock::time_point Start, End;
+};
+} // namespace
+
+/// Collect in \p Deps the jobs which produce the inputs of \p A.
+static void collectJobDeps(const Action *A,
+                           const llvm::DenseMap<const Action *, unsigned> &JobOf,
+                           SmallVectorImpl<unsigned> &Deps) {
+  for (const Action *Input : A->inputs()) {
+    auto It = JobOf.find(Input);
+    if (It != JobOf.end())
+      Deps.push_back(It->second);
+    else
+      collectJobDeps(Input, JobOf, Deps);
+  }
+}
+
+/// Copy the content of \p File to \p OS and remove it.
+static void replayOutput(StringRef File, raw_ostream &OS) {
+  if (auto Buf = llvm::MemoryBuffer::getFile(File))
+    OS << (*Buf)->getBuffer();
+  OS.flush();
+  llvm::sys::fs::remove(File);
+}
+
+void Compilation::ExecuteJobsInParallel(const JobList &Jobs,
+                                        FailingCommandList &FailingCommands,
+                                        unsigned Threads) const {
+  SmallVector<const Command *, 8> Commands;
+  for (const auto &Job : Jobs)
+    Commands.push_back(&Job);
+
+  // Offloading jobs are skipped after any earlier failure, see ActionFailed,
+  // so they need all the earlier jobs to be done
+  bool InOrder = llvm::any_of(Commands, [](const Command *C) {
+    return C->getSource().isOffloading(Action::OFK_Cuda) ||
+           C->getSource().isOffloading(Action::OFK_HIP);
+  });
+  llvm::DenseMap<const Action *, unsigned> JobOf;
+  for (unsigned I = 0, E = Commands.size(); I != E && !InOrder; ++I) {
+    // Jobs sharing their source action can't be told apart as dependencies
+    if (!JobOf.insert({&Commands[I]->getSource(), I}).second) {
+      JobOf.clear();
+      break;
+    }
+  }
+
+  std::vector<ParallelJob> State(Commands.size());
+  for (unsigned I = 0, E = Commands.size(); I != E; ++I) {
+    // Without a dependency graph run the jobs in order
+    if (JobOf.empty()) {
+      if (I)
+        State[I].Deps.push_back(I - 1);
+    } else {
+      collectJobDeps(&Commands[I]->getSource(), JobOf, State[I].Deps);
+    }
+    if (llvm::sys::fs::createTemporaryFile("clang-job", "out",
+                                           State[I].OutFile) ||
+        llvm::sys::fs::createTemporaryFile("clang-job", "err",
+                                           State[I].ErrFile)) {
+      // Without the files to capture the output there is no way to order it
+      for (ParallelJob &J : State) {
+        if (!J.OutFile.empty())
+          llvm::sys::fs::remove(J.OutFile);
+        if (!J.ErrFile.empty())
+          llvm::sys::fs::remove(J.ErrFile);
+      }
+      for (const Command *C : Commands) {
+        if (!InputsOk(*C, FailingCommands))
+          continue;
+        const Command *FailingCommand = nullptr;
+        if (int Res = ExecuteCommand(*C, FailingCommand))
+          FailingCommands.push_back(std::make_pair(Res, FailingCommand));
+      }
+      return;
+    }
+  }
+
+  std::mutex Mutex;
+  std::condition_variable JobDone;
+  llvm::ThreadPool Pool(Threads);
+  unsigned Running = 0, NextToReplay = 0;
+  // The jobs that failed so far
+  SmallVector<std::pair<int, const Command *>, 4> Failed;
+
+  std::unique_lock<std::mutex> Lock(Mutex);
+  while (NextToReplay != Commands.size()) {
+    // Start the jobs whose inputs are ready. As in ExecuteJobs, a job is only
+    // skipped if one of its inputs failed, which is known once the jobs
+    // producing them are done, so the jobs that run do not depend on the
+    // scheduling
+    for (unsigned I = NextToReplay, E = Commands.size();
+         I != E && Running != Threads; ++I) {
+      ParallelJob &J = State[I];
+      if (J.State != ParallelJob::Waiting)
+        continue;
+      if (llvm::any_of(J.Deps, [&](unsigned D) {
+            return State[D].State == ParallelJob::Waiting ||
+                   State[D].State == ParallelJob::Running;
+          }))
+        continue;
+      if (!InputsOk(*Commands[I], Failed)) {
+        J.State = ParallelJob::Skipped;
+        continue;
+      }
+      if (!PrintCommand(*Commands[I])) {
+        J.State = ParallelJob::Done;
+        J.Res = 1;
+        Failed.push_back(std::make_pair(1, Commands[I]));
+        continue;
+      }
+      J.State = ParallelJob::Running;
+      ++Running;
+      Pool.async([&, I] {
+        ParallelJob &J = State[I];
+        Optional<StringRef> JobRedirects[] = {None, StringRef(J.OutFile),
+                                              StringRef(J.ErrFile)};
+        auto Start = std::chrono::steady_clock::now();
+        std::string Error;
+        bool ExecutionFailed = false;
+        int Res = Commands[I]->Execute(JobRedirects, &Error, &ExecutionFailed);
+        std::lock_guard<std::mutex> Guard(Mutex);
+        J.Start = Start;
+        J.End = std::chrono::steady_clock::now();
+        J.Res = Res;
+        J.ExecutionFailed = ExecutionFailed;
+        J.Error = std::move(Error);
+        J.State = ParallelJob::Done;
+        --Running;
+        if (int FailRes = ExecutionFailed ? 1 : Res)
+          Failed.push_back(std::make_pair(FailRes, Commands[I]));
+        JobDone.notify_one();
+      });
+    }
+
+    // Replay the output of the finished jobs in job order, so that it does
+    // not depend on the scheduling
+    while (NextToReplay != Commands.size() &&
+           (State[NextToReplay].State == ParallelJob::Done ||
+            State[NextToReplay].State == ParallelJob::Skipped)) {
+      ParallelJob &J = State[NextToReplay];
+      const Command *C = Commands[NextToReplay++];
+      replayOutput(J.OutFile, llvm::outs());
+      replayOutput(J.ErrFile, llvm::errs());
+      if (J.State == ParallelJob::Skipped)
+        continue;
+      if (RecordJobTimes)
+        JobTimes.push_back({C, J.Start, J.End});
+      if (!J.Error.empty()) {
+        assert(J.Res && "Error string set with 0 result code!");
+        getDriver().Diag(diag::err_drv_command_failure) << J.Error;
+      }
+      if (int Res = J.ExecutionFailed ? 1 : J.Res)
+        FailingCommands.push_back(std::make_pair(Res, C));
+    }
+
+    if (NextToReplay != Commands.size() && Running)
+      JobDone.wait(Lock);
+  }
+  Lock.unlock();
+
+  Pool.wait();
+}
+
 void Compilation::initCompilationForDiagnostics() {
   ForDiagnostics = true;
 
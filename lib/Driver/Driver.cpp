@@ -76,6 +76,7 @@
 #include "llvm/Support/Program.h"
 #include "llvm/Support/StringSaver.h"
 #include "llvm/Support/TargetRegistry.h"
+#include "llvm/Support/Threading.h"
 #include "llvm/Support/VirtualFileSystem.h"
 #include "llvm/Support/raw_ostream.h"
 #include <map>
@@ -1047,6 +1048,9 @@ Compilation *Driver::BuildCompilation(ArrayRef<const char *> ArgList) {
   // Ignore -pipe.
   Args.ClaimAllArgs(options::OPT_pipe);
 
+  // -fparallel-jobs= is only used when executing the compilation.
+  Args.ClaimAllArgs(options::OPT_fparallel_jobs_EQ);
+
   // Extract -ccc args.
   //
   // FIXME: We need to figure out where this behavior should live. Most of it
@@ -1471,6 +1475,16 @@ int Driver::ExecuteCompilation(
     return 0;
   }
 
+  if (const Arg *A = C.getArgs().getLastArg(options::OPT_fparallel_jobs_EQ)) {
+    unsigned ParallelJobs;
+    if (StringRef(A->getValue()).getAsInteger(10, ParallelJobs))
+      Diag(diag::err_drv_invalid_int_value)
+          << A->getAsString(C.getArgs()) << A->getValue();
+    else
+      C.setParallelJobs(ParallelJobs ? ParallelJobs
+                                     : llvm::hardware_concurrency());
+  }
+
   // If there were errors building the compilation, quit now.
   if (Diags.hasErrorOccurred())
     return 1;
@@ -1479,8 +1493,14 @@ int Driver::ExecuteCompilation(
   for (auto &Job : C.getJobs())
     setUpResponseFiles(C, Job);
 
+  bool CheerpTimeReport = C.getArgs().hasArg(options::OPT_cheerp_time_report);
+  C.setRecordJobTimes(CheerpTimeReport);
+
   C.ExecuteJobs(C.getJobs(), FailingCommands);
 
+  if (CheerpTimeReport)
+    tools::cheerp::writeTimeReport(C);
+
   // If the command succeeded, we are done.
   if (FailingCommands.empty())
     return 0;
@@ -3395,7 +3415,14 @@ void Driver::BuildActions(Compilation &C, DerivedArgList &Args,
   // Add a link action if necessary.
   if (!LinkerInputs.empty()) {
     // Cheerp: We need an additional step for to generated JS
-    if (C.getDefaultToolChain().getArch() == llvm::Triple::cheerp)
+    if (C.getDefaultToolChain().getArch() == llvm::Triple::cheerp &&
+        Args.hasArg(options::OPT_cheerp_integrated_link) &&
+        !Args.hasArg(options::OPT_cheerp_dump_bc))
+    {
+      // Link, optimize and generate the JS in a single step
+      Actions.push_back(C.MakeAction<CheerpCompileJobAction>(LinkerInputs, types::TY_Image));
+    }
+    else if (C.getDefaultToolChain().getArch() == llvm::Triple::cheerp)
     {
       // First link the whole program
       Action* linkJob = C.MakeAction<LinkJobAction>(LinkerInputs, types::TY_LLVM_BC);
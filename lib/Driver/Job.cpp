@@ -19,6 +19,7 @@
 #include "llvm/ADT/StringRef.h"
 #include "llvm/ADT/StringSet.h"
 #include "llvm/ADT/StringSwitch.h"
+#include "llvm/Support/CommandLine.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/Program.h"
@@ -313,13 +314,17 @@ void Command::setEnvironment(llvm::ArrayRef<const char *> NewEnvironment) {
   Environment.push_back(nullptr);
 }
 
-int Command::Execute(ArrayRef<llvm::Optional<StringRef>> Redirects,
-                     std::string *ErrMsg, bool *ExecutionFailed) const {
+void Command::PrintFileNames() const {
   if (PrintInputFilenames) {
     for (const char *Arg : InputFilenames)
       llvm::outs() << llvm::sys::path::filename(Arg) << "\n";
     llvm::outs().flush();
   }
+}
+
+int Command::Execute(ArrayRef<llvm::Optional<StringRef>> Redirects,
+                     std::string *ErrMsg, bool *ExecutionFailed) const {
+  PrintFileNames();
 
   SmallVector<const char*, 128> Argv;
 
@@ -370,6 +375,43 @@ int Command::Execute(ArrayRef<llvm::Optional<StringRef>> Redirects,
                                    /*memoryLimit*/ 0, ErrMsg, ExecutionFailed);
 }
 
+CC1Command::CC1Command(const Action &Source_, const Tool &Creator_,
+                       const char *Executable_,
+                       const llvm::opt::ArgStringList &Arguments_,
+                       ArrayRef<InputInfo> Inputs)
+    : Command(Source_, Creator_, Executable_, Arguments_, Inputs) {}
+
+void CC1Command::Print(raw_ostream &OS, const char *Terminator, bool Quote,
+                       CrashReportInfo *CrashInfo) const {
+  OS << " (in-process)\n";
+  Command::Print(OS, Terminator, Quote, CrashInfo);
+}
+
+int CC1Command::Execute(ArrayRef<llvm::Optional<StringRef>> Redirects,
+                        std::string *ErrMsg, bool *ExecutionFailed) const {
+  // The output and the environment of an in-process job cannot be changed.
+  if (!Redirects.empty() || hasEnvironment())
+    return Command::Execute(Redirects, ErrMsg, ExecutionFailed);
+
+  PrintFileNames();
+
+  SmallVector<const char *, 128> Argv;
+  Argv.push_back(getExecutable());
+  Argv.append(getArguments().begin(), getArguments().end());
+
+  // Each cc1 invocation parses its -mllvm options again. Forget the ones seen
+  // by the previous invocation in this process, which would otherwise be
+  // reported as given more than once.
+  llvm::cl::ResetAllOptionOccurrences();
+
+  // The job always starts, so ExecutionFailed is never set.
+  if (ExecutionFailed)
+    *ExecutionFailed = false;
+
+  const Driver &D = getCreator().getToolChain().getDriver();
+  return D.CC1Main(Argv);
+}
+
 FallbackCommand::FallbackCommand(const Action &Source_, const Tool &Creator_,
                                  const char *Executable_,
                                  const llvm::opt::ArgStringList &Arguments_,
@@ -446,9 +446,17 @@ static void addExceptionArgs(const ArgList &Args, types::ID InputType,
   }
 
   if (types::isCXX(InputType)) {
-    // Disable C++ EH by default on XCore and PS4.
+    // Disable C++ EH by default on XCore and PS4. Cheerp only enables them by
+    // default for wasm with the exceptions feature.
     bool CXXExceptionsEnabled =
-        Triple.getArch() != llvm::Triple::xcore && Triple.getArch() != llvm::Triple::cheerp && !Triple.isPS4CPU();
+        Triple.getArch() != llvm::Triple::xcore && !Triple.isPS4CPU();
+    if (Triple.getArch() == llvm::Triple::cheerp) {
+      auto WasmFeatures = cheerp::getWasmFeatures(TC.getDriver(), Args);
+      CXXExceptionsEnabled =
+          Triple.getEnvironment() == llvm::Triple::WebAssembly &&
+          std::binary_search(WasmFeatures.begin(), WasmFeatures.end(),
+                             cheerp::EXCEPTIONS);
+    }
     Arg *ExceptionArg = Args.getLastArg(
         options::OPT_fcxx_exceptions, options::OPT_fno_cxx_exceptions,
         options::OPT_fexceptions, options::OPT_fno_exceptions);
@@ -764,6 +772,15 @@ static void addPGOAndCoverageFlags(const ToolChain &TC, Compilation &C,
     D.Diag(diag::err_drv_argument_not_allowed_with)
         << CSPGOGenerateArg->getSpelling() << PGOGenerateArg->getSpelling();
 
+  // There is no profile runtime to write the counters of a Cheerp program,
+  // profiles can only be used
+  if (TC.getTriple().getArch() == llvm::Triple::cheerp) {
+    for (const Arg *A : {PGOGenerateArg, CSPGOGenerateArg, ProfileGenerateArg})
+      if (A)
+        D.Diag(diag::err_drv_unsupported_opt_for_target)
+            << A->getSpelling() << TC.getTriple().str();
+  }
+
   if (ProfileGenerateArg) {
     if (ProfileGenerateArg->getOption().matches(
             options::OPT_fprofile_instr_generate_EQ))
@@ -3266,12 +3283,15 @@ static void RenderDebugOptions(const ToolChain &TC, const Driver &D,
   // CodeView. Clang doesn't track end columns, just starting columns, which,
   // in theory, is fine for CodeView (and PDB).  In practice, however, the
   // Microsoft debuggers don't handle missing end columns well, so it's better
-  // not to include any column info.
+  // not to include any column info. Cheerp only uses debug locations to write
+  // sourcemaps, which are much smaller and faster to generate with one segment
+  // per line, so column info has to be requested explicitly there.
   if (const Arg *A = Args.getLastArg(options::OPT_gcolumn_info))
     (void)checkDebugInfoOption(A, Args, D, TC);
   if (Args.hasFlag(options::OPT_gcolumn_info, options::OPT_gno_column_info,
                    /*Default=*/!EmitCodeView &&
-                       DebuggerTuning != llvm::DebuggerKind::SCE))
+                       DebuggerTuning != llvm::DebuggerKind::SCE &&
+                       T.getArch() != llvm::Triple::cheerp))
     CmdArgs.push_back("-dwarf-column-info");
 
   // FIXME: Move backend command line options to the module.
@@ -3802,10 +3822,17 @@ void Clang::ConstructJob(Compilation &C, const JobAction &JA,
   if (C.getDriver().embedBitcodeMarkerOnly() && !C.getDriver().isUsingLTO())
     CmdArgs.push_back("-fembed-bitcode=marker");
 
+  // Run the compile job in the driver process if requested. Jobs that
+  // reproduce a crash always get their own process.
+  bool InProcess = Args.hasFlag(options::OPT_fintegrated_cc1,
+                                options::OPT_fno_integrated_cc1, false) &&
+                   D.CC1Main && !C.isForDiagnostics();
+
   // We normally speed up the clang process a bit by skipping destructors at
   // exit, but when we're generating diagnostics we can rely on some of the
-  // cleanup.
-  if (!C.isForDiagnostics())
+  // cleanup. An in-process job must clean up too, since the driver may run
+  // more of them.
+  if (!C.isForDiagnostics() && !InProcess)
     CmdArgs.push_back("-disable-free");
 
 #ifdef NDEBUG
@@ -4268,6 +4295,7 @@ void Clang::ConstructJob(Compilation &C, const JobAction &JA,
   CmdArgs.push_back(D.ResourceDir.c_str());
 
   Args.AddLastArg(CmdArgs, options::OPT_working_directory);
+  Args.AddLastArg(CmdArgs, options::OPT_fheader_lookup_cache_EQ);
 
   RenderARCMigrateToolOptions(D, Args, CmdArgs);
 
@@ -4378,6 +4406,29 @@ void Clang::ConstructJob(Compilation &C, const JobAction &JA,
   if (std::binary_search(wasmFeatures.begin(), wasmFeatures.end(), cheerp::ANYREF)) {
     CmdArgs.push_back("-cheerp-wasm-externref");
   }
+  // Pass cheerp-wasm-shared-memory if sharedmem feature enabled
+  if (std::binary_search(wasmFeatures.begin(), wasmFeatures.end(), cheerp::SHAREDMEM)) {
+    CmdArgs.push_back("-cheerp-wasm-shared-memory");
+  }
+  // Pass cheerp-wasm-simd if simd feature enabled
+  if (std::binary_search(wasmFeatures.begin(), wasmFeatures.end(), cheerp::SIMD)) {
+    CmdArgs.push_back("-cheerp-wasm-simd");
+  }
+  // Pass cheerp-wasm-bulk-memory if bulkmemory feature enabled
+  if (std::binary_search(wasmFeatures.begin(), wasmFeatures.end(), cheerp::BULKMEMORY)) {
+    CmdArgs.push_back("-cheerp-wasm-bulk-memory");
+  }
+  // Pass cheerp-wasm-return-calls if returncalls feature enabled
+  if (std::binary_search(wasmFeatures.begin(), wasmFeatures.end(), cheerp::RETURNCALLS)) {
+    CmdArgs.push_back("-cheerp-wasm-return-calls");
+  }
+  // Pass cheerp-wasm-exceptions if exceptions feature enabled
+  if (std::binary_search(wasmFeatures.begin(), wasmFeatures.end(), cheerp::EXCEPTIONS)) {
+    CmdArgs.push_back("-cheerp-wasm-exceptions");
+  }
+  // Forward cheerp-use-bigints argument
+  if (Arg *CheerpUseBigInts = Args.getLastArg(options::OPT_cheerp_use_bigints))
+    CheerpUseBigInts->render(Args, CmdArgs);
 
   // GCC's behavior for -Wwrite-strings is a bit strange:
   //  * In C, this "warning flag" changes the types of string literals from
@@ -4448,6 +4499,8 @@ void Clang::ConstructJob(Compilation &C, const JobAction &JA,
     CmdArgs.push_back(A->getValue());
   }
 
+  Args.AddLastArg(CmdArgs, options::OPT_fexperimental_new_constant_interpreter);
+
   if (Arg *A = Args.getLastArg(options::OPT_fbracket_depth_EQ)) {
     CmdArgs.push_back("-fbracket-depth");
     CmdArgs.push_back(A->getValue());
@@ -4648,6 +4701,8 @@ void Clang::ConstructJob(Compilation &C, const JobAction &JA,
   Args.AddLastArg(CmdArgs, options::OPT_ftime_report);
   Args.AddLastArg(CmdArgs, options::OPT_ftime_trace);
   Args.AddLastArg(CmdArgs, options::OPT_ftime_trace_granularity_EQ);
+  if (Args.hasArg(options::OPT_cheerp_time_report))
+    cheerp::addTimeTraceArgs(C, Args, CmdArgs);
   Args.AddLastArg(CmdArgs, options::OPT_ftrapv);
   Args.AddLastArg(CmdArgs, options::OPT_malign_double);
 
@@ -4898,6 +4953,10 @@ void Clang::ConstructJob(Compilation &C, const JobAction &JA,
                    options::OPT_fno_delayed_template_parsing, IsWindowsMSVC))
     CmdArgs.push_back("-fdelayed-template-parsing");
 
+  if (Args.hasFlag(options::OPT_fdelayed_inline_method_parsing,
+                   options::OPT_fno_delayed_inline_method_parsing, false))
+    CmdArgs.push_back("-fdelayed-inline-method-parsing");
+
   // -fgnu-keywords default varies depending on language; only pass if
   // specified.
   Args.AddLastArg(CmdArgs, options::OPT_fgnu_keywords,
@@ -5389,7 +5448,8 @@ void Clang::ConstructJob(Compilation &C, const JobAction &JA,
       Args.hasFlag(options::OPT_fwhole_program_vtables,
                    options::OPT_fno_whole_program_vtables, false);
   if (WholeProgramVTables) {
-    if (!D.isUsingLTO())
+    // Cheerp always links and optimizes the whole program
+    if (!D.isUsingLTO() && getToolChain().getArch() != llvm::Triple::cheerp)
       D.Diag(diag::err_drv_argument_only_allowed_with)
           << "-fwhole-program-vtables"
           << "-flto";
@@ -5459,6 +5519,10 @@ void Clang::ConstructJob(Compilation &C, const JobAction &JA,
                    options::OPT_fno_complete_member_pointers, false))
     CmdArgs.push_back("-fcomplete-member-pointers");
 
+  if (Args.hasFlag(options::OPT_fpch_instantiate_templates,
+                   options::OPT_fno_pch_instantiate_templates, false))
+    CmdArgs.push_back("-fpch-instantiate-templates");
+
   if (!Args.hasFlag(options::OPT_fcxx_static_destructors,
                     options::OPT_fno_cxx_static_destructors, true))
     CmdArgs.push_back("-fno-c++-static-destructors");
@@ -5540,6 +5604,9 @@ void Clang::ConstructJob(Compilation &C, const JobAction &JA,
     // fails, so that the main compilation's fallback to cl.exe runs.
     C.addCommand(llvm::make_unique<ForceSuccessCommand>(JA, *this, Exec,
                                                         CmdArgs, Inputs));
+  } else if (InProcess) {
+    C.addCommand(
+        llvm::make_unique<CC1Command>(JA, *this, Exec, CmdArgs, Inputs));
   } else {
     C.addCommand(llvm::make_unique<Command>(JA, *this, Exec, CmdArgs, Inputs));
   }
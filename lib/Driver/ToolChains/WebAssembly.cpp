@@ -16,8 +16,11 @@
 #include "clang/Driver/Options.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/Path.h"
+#include "llvm/ADT/StringSet.h"
 #include "llvm/ADT/StringSwitch.h"
 #include "llvm/Option/ArgList.h"
+#include "llvm/Support/JSON.h"
+#include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
 
 using namespace clang::driver;
@@ -264,64 +267,92 @@ Tool *WebAssembly::buildLinker() const {
   return new tools::wasm::Linker(*this);
 }
 
-void cheerp::Link::ConstructJob(Compilation &C, const JobAction &JA,
-                                const InputInfo &Output,
-                                const InputInfoList &Inputs,
-                                const ArgList &Args,
-                                const char *LinkingOutput) const {
-  ArgStringList CmdArgs;
-
-  CmdArgs.push_back("-o");
-  CmdArgs.push_back(Output.getFilename());
+/// Find one of the Cheerp runtime libraries. A symbol-indexed archive
+/// (\p BaseName.a) is preferred over the monolithic \p BaseName.bc when the
+/// toolchain ships one. llvm-link is not given -only-needed, which would also
+/// apply to every object after the first, so it still links all the members
+/// and the unused runtime code is dropped by the LTO passes as before.
+static const char *getCheerpRuntimeLib(const ToolChain &TC, const ArgList &Args,
+                                       StringRef BaseName)
+{
+  std::string ArchiveName = (BaseName + ".a").str();
+  std::string Found = TC.GetFilePath(ArchiveName.c_str());
+  if (Found == ArchiveName)
+    Found = TC.GetFilePath((BaseName + ".bc").str().c_str());
+  return Args.MakeArgString(Found);
+}
 
+/// Collect the inputs of the Cheerp link step: \p Objects receives the
+/// compiled bitcode files, \p Libraries the Cheerp runtime libraries and any
+/// library passed with -l.
+static void addCheerpLinkInputs(Compilation &C, const ToolChain &TC,
+                                const InputInfoList &Inputs,
+                                const ArgList &Args, ArgStringList &Objects,
+                                ArgStringList &Libraries) {
   for (InputInfoList::const_iterator
          it = Inputs.begin(), ie = Inputs.end(); it != ie; ++it) {
     const InputInfo &II = *it;
     if(II.isFilename())
-      CmdArgs.push_back(II.getFilename());
+      Objects.push_back(II.getFilename());
   }
 
   // Add standard libraries
   if (!Args.hasArg(options::OPT_nostdlib) &&
       !Args.hasArg(options::OPT_nodefaultlibs)) {
     if (C.getDriver().CCCIsCXX()) {
-      CmdArgs.push_back(Args.MakeArgString(getToolChain().GetFilePath("libstdlibs.bc")));
+      Libraries.push_back(getCheerpRuntimeLib(TC, Args, "libstdlibs"));
     } else {
-      CmdArgs.push_back(Args.MakeArgString(getToolChain().GetFilePath("libc.bc")));
-      CmdArgs.push_back(Args.MakeArgString(getToolChain().GetFilePath("libm.bc")));
+      Libraries.push_back(getCheerpRuntimeLib(TC, Args, "libc"));
+      Libraries.push_back(getCheerpRuntimeLib(TC, Args, "libm"));
     }
 
     // Add wasm helper if needed
     Arg *CheerpMode = Args.getLastArg(options::OPT_cheerp_mode_EQ);
     Arg *CheerpLinearOutput = Args.getLastArg(options::OPT_cheerp_linear_output_EQ);
-    llvm::Triple::EnvironmentType env = getToolChain().getTriple().getEnvironment();
+    llvm::Triple::EnvironmentType env = TC.getTriple().getEnvironment();
     if((CheerpMode && CheerpMode->getValue() == StringRef("wasm")) ||
        (CheerpLinearOutput && CheerpLinearOutput->getValue() == StringRef("wasm")) ||
        (!CheerpMode && !CheerpLinearOutput && env == llvm::Triple::WebAssembly))
     {
-      CmdArgs.push_back(Args.MakeArgString(getToolChain().GetFilePath("libwasm.bc")));
+      Libraries.push_back(getCheerpRuntimeLib(TC, Args, "libwasm"));
     }
   }
  
-  // Do not add the same library more than once
+  // Do not add the same library more than once, nor search for it again
   std::set<std::string> usedLibs;
+  llvm::StringSet<> seenNames;
   for (auto& it: Args.filtered(options::OPT_l)) {
+    if (!seenNames.insert(it->getValue()).second)
+      continue;
     std::string libName("lib");
     libName += it->getValue();
     std::string bcLibName = libName + ".bc";
-    std::string foundLib = getToolChain().GetFilePath(bcLibName.c_str());
+    std::string foundLib = TC.GetFilePath(bcLibName.c_str());
     if (foundLib == bcLibName) {
       // Try again using .a, the internal format is still assumed to be BC
       std::string aLibName = libName + ".a";
-      foundLib = getToolChain().GetFilePath(aLibName.c_str());
+      foundLib = TC.GetFilePath(aLibName.c_str());
       if(foundLib == aLibName)
         foundLib = bcLibName;
     }
     if (usedLibs.count(foundLib))
       continue;
     usedLibs.insert(foundLib);
-    CmdArgs.push_back(Args.MakeArgString(foundLib));
+    Libraries.push_back(Args.MakeArgString(foundLib));
   }
+}
+
+void cheerp::Link::ConstructJob(Compilation &C, const JobAction &JA,
+                                const InputInfo &Output,
+                                const InputInfoList &Inputs,
+                                const ArgList &Args,
+                                const char *LinkingOutput) const {
+  ArgStringList CmdArgs;
+
+  CmdArgs.push_back("-o");
+  CmdArgs.push_back(Output.getFilename());
+
+  addCheerpLinkInputs(C, getToolChain(), Inputs, Args, CmdArgs, CmdArgs);
 
   const char *Exec = Args.MakeArgString((getToolChain().GetProgramPath("llvm-link")));
   C.addCommand(llvm::make_unique<Command>(JA, *this, Exec, CmdArgs, Inputs));
@@ -360,27 +391,25 @@ static void checkCheerpArgCompatibility(const Driver& D, const ArgList& Args)
       linearOut, secondaryPath, secondaryFile);
 }
 
-void cheerp::CheerpOptimizer::ConstructJob(Compilation &C, const JobAction &JA,
-                                          const InputInfo &Output,
-                                          const InputInfoList &Inputs,
+/// Compute the arguments of the Cheerp optimizer step. \p Options receives
+/// the backend options and \p Passes the names of the passes to run, in
+/// order, on the linked module. Returns the optimization level of the final
+/// LTO pipeline, or null if it should not run.
+static const char *addCheerpOptimizerArgs(Compilation &C, const Driver &D,
                                           const ArgList &Args,
-                                          const char *LinkingOutput) const {
-  ArgStringList CmdArgs;
-  const Driver &D = getToolChain().getDriver();
-  checkCheerpArgCompatibility(D, Args);
-
-  CmdArgs.push_back("-march=cheerp");
+                                          ArgStringList &Options,
+                                          ArgStringList &Passes) {
   if(Args.hasArg(options::OPT_cheerp_preexecute))
-    CmdArgs.push_back("-PreExecute");
+    Passes.push_back("PreExecute");
   if(Args.hasArg(options::OPT_cheerp_preexecute_main))
-    CmdArgs.push_back("-cheerp-preexecute-main");
+    Options.push_back("-cheerp-preexecute-main");
   if(Arg* cheerpFixFuncCasts = Args.getLastArg(options::OPT_cheerp_fix_wrong_func_casts))
-    cheerpFixFuncCasts->render(Args, CmdArgs);
+    cheerpFixFuncCasts->render(Args, Options);
   if(Arg* cheerpUseBigInts = Args.getLastArg(options::OPT_cheerp_use_bigints))
-    cheerpUseBigInts->render(Args, CmdArgs);
+    cheerpUseBigInts->render(Args, Options);
 
   if(Arg* cheerpLinearOutput = Args.getLastArg(options::OPT_cheerp_linear_output_EQ))
-    cheerpLinearOutput->render(Args, CmdArgs);
+    cheerpLinearOutput->render(Args, Options);
   else if(Arg *CheerpMode = C.getArgs().getLastArg(options::OPT_cheerp_mode_EQ))
   {
     // cheerp-mode is mutually exclusive with cheerp-linear-output, but this is
@@ -399,22 +428,63 @@ void cheerp::CheerpOptimizer::ConstructJob(Compilation &C, const JobAction &JA,
     {
       linearOut += "wasm";
     }
-    CmdArgs.push_back(Args.MakeArgString(linearOut));
+    Options.push_back(Args.MakeArgString(linearOut));
   }
-  auto features = getWasmFeatures(D, Args);
-  if(std::find(features.begin(), features.end(), EXPORTEDTABLE) != features.end())
-    CmdArgs.push_back("-cheerp-wasm-exported-table");
-
-  CmdArgs.push_back("-GlobalDepsAnalyzer");
-  CmdArgs.push_back("-TypeOptimizer");
-  CmdArgs.push_back("-CheerpLowerSwitch");
-  CmdArgs.push_back("-I64Lowering");
-  CmdArgs.push_back("-ReplaceNopCastsAndByteSwaps");
-  if(!Args.hasArg(options::OPT_cheerp_no_lto))
+  auto features = cheerp::getWasmFeatures(D, Args);
+  if(std::find(features.begin(), features.end(), cheerp::EXPORTEDTABLE) != features.end())
+    Options.push_back("-cheerp-wasm-exported-table");
+
+  // Honor -cheerp-no-pointer-scev
+  if (Arg *CheerpNoPointerSCEV = Args.getLastArg(options::OPT_cheerp_no_pointer_scev))
+    CheerpNoPointerSCEV->render(Args, Options);
+
+  Passes.push_back("GlobalDepsAnalyzer");
+  Passes.push_back("TypeOptimizer");
+  Passes.push_back("CheerpLowerSwitch");
+  Passes.push_back("I64Lowering");
+  Passes.push_back("ReplaceNopCastsAndByteSwaps");
+  if(Args.hasArg(options::OPT_cheerp_no_lto))
+    return nullptr;
+
+  Passes.push_back("FreeAndDeleteRemoval");
+  Options.push_back("-cheerp-lto");
+  // There are no summaries, imports or parallel backends for Cheerp: with
+  // -flto=thin the linked program is only optimized at the level the user
+  // asked for, instead of always at -Os
+  if(D.getLTOMode() == LTOK_Thin) {
+    D.Diag(diag::warn_drv_cheerp_thinlto);
+    if (Arg *A = Args.getLastArg(options::OPT_O_Group)) {
+      StringRef OOpt;
+      if (A->getOption().matches(options::OPT_O4) ||
+          A->getOption().matches(options::OPT_Ofast))
+        OOpt = "3";
+      else if (A->getOption().matches(options::OPT_O))
+        OOpt = A->getValue();
+      else if (A->getOption().matches(options::OPT_O0))
+        OOpt = "0";
+      if (!OOpt.empty())
+        return Args.MakeArgString(Twine("-O") + OOpt);
+    }
+  }
+  return "-Os";
+}
+
+void cheerp::CheerpOptimizer::ConstructJob(Compilation &C, const JobAction &JA,
+                                          const InputInfo &Output,
+                                          const InputInfoList &Inputs,
+                                          const ArgList &Args,
+                                          const char *LinkingOutput) const {
+  ArgStringList CmdArgs, Passes;
+  const Driver &D = getToolChain().getDriver();
+  checkCheerpArgCompatibility(D, Args);
+
+  CmdArgs.push_back("-march=cheerp");
+  const char *LTOLevel = addCheerpOptimizerArgs(C, D, Args, CmdArgs, Passes);
+  for (const char *Pass : Passes)
+    CmdArgs.push_back(Args.MakeArgString(Twine("-") + Pass));
+  if(LTOLevel)
   {
-    CmdArgs.push_back("-FreeAndDeleteRemoval");
-    CmdArgs.push_back("-cheerp-lto");
-    CmdArgs.push_back("-Os");
+    CmdArgs.push_back(LTOLevel);
     // -Os converts loops to canonical form, which may causes empty forwarding branches, remove those
     CmdArgs.push_back("-simplifycfg");
   }
@@ -426,9 +496,6 @@ void cheerp::CheerpOptimizer::ConstructJob(Compilation &C, const JobAction &JA,
 
   // Honor -mllvm
   Args.AddAllArgValues(CmdArgs, options::OPT_mllvm);
-  // Honor -cheerp-no-pointer-scev
-  if (Arg *CheerpNoPointerSCEV = Args.getLastArg(options::OPT_cheerp_no_pointer_scev))
-    CheerpNoPointerSCEV->render(Args, CmdArgs);
 
   const char *Exec = Args.MakeArgString((getToolChain().GetProgramPath("opt")));
   C.addCommand(llvm::make_unique<Command>(JA, *this, Exec, CmdArgs, Inputs));
@@ -442,6 +509,9 @@ static cheerp::CheerpWasmOpt parseWasmOpt(StringRef opt)
     .Case("exportedtable", cheerp::EXPORTEDTABLE)
     .Case("externref", cheerp::ANYREF)
     .Case("returncalls", cheerp::RETURNCALLS)
+    .Case("simd", cheerp::SIMD)
+    .Case("bulkmemory", cheerp::BULKMEMORY)
+    .Case("exceptions", cheerp::EXCEPTIONS)
     .Default(cheerp::INVALID);
 }
 
@@ -490,23 +560,17 @@ std::vector<cheerp::CheerpWasmOpt> cheerp::getWasmFeatures(const Driver& D, cons
   return features;
 }
 
-void cheerp::CheerpCompiler::ConstructJob(Compilation &C, const JobAction &JA,
-                                          const InputInfo &Output,
-                                          const InputInfoList &Inputs,
-                                          const ArgList &Args,
-                                          const char *LinkingOutput) const {
-  const Driver &D = getToolChain().getDriver();
-  checkCheerpArgCompatibility(D, Args);
-
-  ArgStringList CmdArgs;
-
-  CmdArgs.push_back("-march=cheerp");
+/// Compute the backend options of the Cheerp code generation step. Returns
+/// the file the primary (JS) output should be written to.
+static const char *addCheerpCompilerArgs(Compilation &C, const ToolChain &TC,
+                                         const InputInfo &Output,
+                                         const ArgList &Args,
+                                         ArgStringList &CmdArgs) {
+  const Driver &D = TC.getDriver();
+  const char *OutputFile = Output.getFilename();
 
   if(Arg* cheerpAsmJSMemFile = Args.getLastArg(options::OPT_cheerp_asmjs_mem_file_EQ))
   {
-    CmdArgs.push_back("-o");
-    CmdArgs.push_back(Output.getFilename());
-
     std::string secondaryFile("-cheerp-secondary-output-file=");
     secondaryFile += cheerpAsmJSMemFile->getValue();
     CmdArgs.push_back(Args.MakeArgString(secondaryFile));
@@ -517,8 +581,7 @@ void cheerp::CheerpCompiler::ConstructJob(Compilation &C, const JobAction &JA,
   }
   else if(Arg* cheerpWasmLoader = Args.getLastArg(options::OPT_cheerp_wasm_loader_EQ))
   {
-    CmdArgs.push_back("-o");
-    CmdArgs.push_back(Args.MakeArgString(cheerpWasmLoader->getValue()));
+    OutputFile = Args.MakeArgString(cheerpWasmLoader->getValue());
 
     std::string secondaryFile("-cheerp-secondary-output-file=");
     secondaryFile += Output.getFilename();
@@ -534,8 +597,6 @@ void cheerp::CheerpCompiler::ConstructJob(Compilation &C, const JobAction &JA,
   }
   else
   {
-    CmdArgs.push_back("-o");
-    CmdArgs.push_back(Output.getFilename());
     if (Arg* cheerpMode = Args.getLastArg(options::OPT_cheerp_mode_EQ))
     {
       if (cheerpMode->getValue() == StringRef("wasm"))
@@ -545,7 +606,7 @@ void cheerp::CheerpCompiler::ConstructJob(Compilation &C, const JobAction &JA,
     }
   }
 
-  llvm::Triple::EnvironmentType env = getToolChain().getTriple().getEnvironment();
+  llvm::Triple::EnvironmentType env = TC.getTriple().getEnvironment();
   Arg* cheerpMode = Args.getLastArg(options::OPT_cheerp_mode_EQ);
   Arg* cheerpLinearOutput = Args.getLastArg(options::OPT_cheerp_linear_output_EQ);
   if (cheerpLinearOutput)
@@ -633,6 +694,12 @@ void cheerp::CheerpCompiler::ConstructJob(Compilation &C, const JobAction &JA,
       case RETURNCALLS:
         CmdArgs.push_back("-cheerp-wasm-return-calls");
         break;
+      case SIMD:
+      case BULKMEMORY:
+      case EXCEPTIONS:
+        // Only the frontend knows about these, the writer lowers the IR it
+        // gets
+        break;
       default:
         llvm_unreachable("invalid wasm option");
         break;
@@ -665,8 +732,17 @@ void cheerp::CheerpCompiler::ConstructJob(Compilation &C, const JobAction &JA,
     cheerpReservedNames->render(Args, CmdArgs);
   if(Arg* cheerpGlobalPrefix = Args.getLastArg(options::OPT_cheerp_global_prefix_EQ))
     cheerpGlobalPrefix->render(Args, CmdArgs);
-  if(Arg *cheerpHeapSize = Args.getLastArg(options::OPT_cheerp_linear_heap_size))
+  if(Arg *cheerpHeapSize = Args.getLastArg(options::OPT_cheerp_linear_heap_size)) {
+    unsigned heapSize;
+    if (StringRef(cheerpHeapSize->getValue()).getAsInteger(10, heapSize)) {
+      D.Diag(diag::err_drv_invalid_int_value)
+      << cheerpHeapSize->getAsString(Args) << cheerpHeapSize->getValue();
+    } else if (heapSize > 4096) {
+      D.Diag(diag::err_drv_cheerp_heap_size_too_large)
+      << cheerpHeapSize->getAsString(Args);
+    }
     cheerpHeapSize->render(Args, CmdArgs);
+  }
   if(Arg *cheerpStackSize = Args.getLastArg(options::OPT_cheerp_linear_stack_size))
     cheerpStackSize->render(Args, CmdArgs);
   if(Arg* cheerpNoICF = Args.getLastArg(options::OPT_cheerp_no_icf))
@@ -684,6 +760,111 @@ void cheerp::CheerpCompiler::ConstructJob(Compilation &C, const JobAction &JA,
   if(Arg* cheerpUseBigInts = Args.getLastArg(options::OPT_cheerp_use_bigints))
     cheerpUseBigInts->render(Args, CmdArgs);
 
+  return OutputFile;
+}
+
+/// Build a single cc1 job which links the inputs in memory, runs the Cheerp
+/// optimizer passes and the JS/Wasm writer without writing any intermediate
+/// bitcode to disk.
+static void constructIntegratedCheerpJob(Compilation &C, const JobAction &JA,
+                                         const Tool &T, const InputInfo &Output,
+                                         const InputInfoList &Inputs,
+                                         const ArgList &Args) {
+  const ToolChain &TC = T.getToolChain();
+  const Driver &D = TC.getDriver();
+
+  ArgStringList Objects, Libraries, BackendOptions, Passes;
+  addCheerpLinkInputs(C, TC, Inputs, Args, Objects, Libraries);
+  const char *LTOLevel =
+      addCheerpOptimizerArgs(C, D, Args, BackendOptions, Passes);
+  const char *OutputFile =
+      addCheerpCompilerArgs(C, TC, Output, Args, BackendOptions);
+  Args.AddAllArgValues(BackendOptions, options::OPT_mllvm);
+
+  ArgStringList CmdArgs;
+  CmdArgs.push_back("-cc1");
+  CmdArgs.push_back("-triple");
+  CmdArgs.push_back(Args.MakeArgString(TC.getTripleString()));
+  CmdArgs.push_back("-emit-obj");
+  CmdArgs.push_back(LTOLevel ? LTOLevel : "-O0");
+  if (Args.hasArg(options::OPT_cheerp_time_report))
+    cheerp::addTimeTraceArgs(C, Args, CmdArgs);
+
+  for (const char *Pass : Passes) {
+    CmdArgs.push_back("-cheerp-link-time-pass");
+    CmdArgs.push_back(Pass);
+  }
+  if (Args.hasArg(options::OPT_cheerp_link_roots_only))
+    CmdArgs.push_back("-cheerp-link-roots-only");
+  if (Arg *CacheDir = Args.getLastArg(options::OPT_cheerp_lto_cache_dir_EQ)) {
+    CmdArgs.push_back("-cheerp-lto-cache-dir");
+    CmdArgs.push_back(CacheDir->getValue());
+    if (Args.hasArg(options::OPT_cheerp_incremental_link))
+      CmdArgs.push_back("-cheerp-cache-link-inputs");
+  } else if (Arg *A = Args.getLastArg(options::OPT_cheerp_incremental_link)) {
+    D.Diag(diag::err_drv_argument_only_allowed_with)
+        << A->getAsString(Args) << "-cheerp-lto-cache-dir=";
+  }
+
+  // Both opt and llc used to receive some of the options, but in a single
+  // process each one can only be set once
+  llvm::StringSet<> SeenOptions;
+  for (const char *Option : BackendOptions) {
+    if (!SeenOptions.insert(Option).second)
+      continue;
+    CmdArgs.push_back("-mllvm");
+    CmdArgs.push_back(Option);
+  }
+
+  CmdArgs.push_back("-o");
+  CmdArgs.push_back(OutputFile);
+
+  // The first input becomes the main module, the other objects are linked
+  // into it. Libraries only provide the symbols that are needed, so without
+  // any object there is nothing to link.
+  if (Objects.empty()) {
+    D.Diag(diag::err_drv_no_input_files);
+    return;
+  }
+  CmdArgs.push_back("-x");
+  CmdArgs.push_back("ir");
+  CmdArgs.push_back(Objects.front());
+  for (const char *Input : llvm::makeArrayRef(Objects).drop_front()) {
+    CmdArgs.push_back("-mlink-bitcode-file");
+    CmdArgs.push_back(Input);
+  }
+  for (const char *Library : Libraries) {
+    CmdArgs.push_back("-cheerp-link-bitcode-library");
+    CmdArgs.push_back(Library);
+  }
+
+  C.addCommand(llvm::make_unique<Command>(JA, T, D.getClangProgramPath(),
+                                           CmdArgs, Inputs));
+}
+
+void cheerp::CheerpCompiler::ConstructJob(Compilation &C, const JobAction &JA,
+                                          const InputInfo &Output,
+                                          const InputInfoList &Inputs,
+                                          const ArgList &Args,
+                                          const char *LinkingOutput) const {
+  const Driver &D = getToolChain().getDriver();
+  checkCheerpArgCompatibility(D, Args);
+
+  if (Args.hasArg(options::OPT_cheerp_integrated_link) &&
+      !Args.hasArg(options::OPT_cheerp_dump_bc)) {
+    constructIntegratedCheerpJob(C, JA, *this, Output, Inputs, Args);
+    return;
+  }
+
+  ArgStringList CmdArgs;
+
+  CmdArgs.push_back("-march=cheerp");
+
+  const char *OutputFile =
+      addCheerpCompilerArgs(C, getToolChain(), Output, Args, CmdArgs);
+  CmdArgs.push_back("-o");
+  CmdArgs.push_back(OutputFile);
+
   // Set output to binary mode to avoid linefeed conversion on Windows.
   CmdArgs.push_back("-filetype");
   CmdArgs.push_back("obj");
@@ -697,3 +878,99 @@ void cheerp::CheerpCompiler::ConstructJob(Compilation &C, const JobAction &JA,
   const char *Exec = Args.MakeArgString((getToolChain().GetProgramPath("llc")));
   C.addCommand(llvm::make_unique<Command>(JA, *this, Exec, CmdArgs, Inputs));
 }
+
+void cheerp::addTimeTraceArgs(Compilation &C, const ArgList &Args,
+                              ArgStringList &CmdArgs) {
+  if (!Args.hasArg(options::OPT_ftime_trace))
+    CmdArgs.push_back("-ftime-trace");
+  std::string TracePath = C.getDriver().GetTemporaryPath("time-trace", "json");
+  CmdArgs.push_back("-ftime-trace-file");
+  CmdArgs.push_back(C.addTempFile(Args.MakeArgString(TracePath)));
+}
+
+/// Return the -ftime-trace-file passed to \p Job, if any.
+static StringRef getJobTimeTraceFile(const Command &Job) {
+  const ArgStringList &JobArgs = Job.getArguments();
+  for (size_t i = 0; i + 1 < JobArgs.size(); ++i)
+    if (StringRef(JobArgs[i]) == "-ftime-trace-file")
+      return JobArgs[i + 1];
+  return StringRef();
+}
+
+void cheerp::writeTimeReport(const Compilation &C) {
+  const Driver &D = C.getDriver();
+  ArrayRef<Compilation::JobTime> JobTimes = C.getJobTimes();
+  if (JobTimes.empty())
+    return;
+
+  using namespace std::chrono;
+  steady_clock::time_point Origin = JobTimes.front().Start;
+  auto toMicroseconds = [Origin](steady_clock::time_point T) -> int64_t {
+    return duration_cast<microseconds>(T - Origin).count();
+  };
+
+  // Every job is shown as a separate process in the trace viewer, the events
+  // recorded by cc1 jobs are nested inside the job that produced them
+  llvm::json::Array Events;
+  for (size_t i = 0; i < JobTimes.size(); ++i) {
+    const Compilation::JobTime &JT = JobTimes[i];
+    const Command &Job = *JT.Job;
+    int64_t Pid = i + 1;
+    int64_t Start = toMicroseconds(JT.Start);
+    std::string JobName = (llvm::sys::path::filename(Job.getExecutable()) +
+                           " (" + Job.getSource().getClassName() + ")").str();
+
+    Events.push_back(llvm::json::Object{
+        {"ph", "M"}, {"pid", Pid}, {"tid", 0}, {"name", "process_name"},
+        {"args", llvm::json::Object{{"name", JobName}}}});
+    Events.push_back(llvm::json::Object{
+        {"ph", "X"}, {"pid", Pid}, {"tid", 0}, {"ts", Start},
+        {"dur", toMicroseconds(JT.End) - Start},
+        {"name", Job.getSource().getClassName()}});
+
+    StringRef TraceFile = getJobTimeTraceFile(Job);
+    if (TraceFile.empty())
+      continue;
+    // A job may have failed before writing its trace, just skip it
+    auto Buf = llvm::MemoryBuffer::getFile(TraceFile);
+    if (!Buf)
+      continue;
+    llvm::Expected<llvm::json::Value> Trace =
+        llvm::json::parse((*Buf)->getBuffer());
+    if (!Trace) {
+      llvm::consumeError(Trace.takeError());
+      continue;
+    }
+    llvm::json::Object *TraceObj = Trace->getAsObject();
+    llvm::json::Array *JobEvents =
+        TraceObj ? TraceObj->getArray("traceEvents") : nullptr;
+    if (!JobEvents)
+      continue;
+    for (llvm::json::Value &E : *JobEvents) {
+      llvm::json::Object *EventObj = E.getAsObject();
+      if (!EventObj)
+        continue;
+      // Keep our own process names
+      llvm::Optional<StringRef> Phase = EventObj->getString("ph");
+      if (Phase && *Phase == "M")
+        continue;
+      (*EventObj)["pid"] = Pid;
+      if (llvm::Optional<int64_t> Ts = EventObj->getInteger("ts"))
+        (*EventObj)["ts"] = *Ts + Start;
+      Events.push_back(std::move(E));
+    }
+  }
+
+  std::string ReportPath =
+      (C.getArgs().getLastArgValue(options::OPT_o, D.getDefaultImageName()) +
+       ".time-report.json").str();
+  std::error_code EC;
+  llvm::raw_fd_ostream OS(ReportPath, EC, llvm::sys::fs::F_Text);
+  if (EC) {
+    D.Diag(diag::err_drv_cheerp_time_report_failure)
+        << ReportPath << EC.message();
+    return;
+  }
+  OS << llvm::json::Value(
+      llvm::json::Object{{"traceEvents", std::move(Events)}});
+}
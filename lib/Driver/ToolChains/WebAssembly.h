@@ -43,9 +43,20 @@ namespace cheerp {
     EXPORTEDTABLE,
     ANYREF,
     RETURNCALLS,
+    SIMD,
+    BULKMEMORY,
+    EXCEPTIONS,
   };
   std::vector<CheerpWasmOpt> getWasmFeatures(const Driver& D, const llvm::opt::ArgList& Args);
 
+  /// With -cheerp-time-report, make a cc1 job write its -ftime-trace profile
+  /// to a temporary file, to be merged in the report by writeTimeReport.
+  void addTimeTraceArgs(Compilation &C, const llvm::opt::ArgList &Args,
+                        llvm::opt::ArgStringList &CmdArgs);
+
+  /// Write the -cheerp-time-report trace of the jobs executed by \p C.
+  void writeTimeReport(const Compilation &C);
+
   class LLVM_LIBRARY_VISIBILITY Link : public Tool {
   public:
     Link(const ToolChain &TC) : Tool("cheerp::Link", "linker", TC) {}
@@ -138,6 +149,8 @@ public:
   bool isPICDefault() const override;
   bool isPIEDefault() const override;
   bool isPICDefaultForced() const override;
+  void adjustDebugInfoKind(codegenoptions::DebugInfoKind &DebugInfoKind,
+                           const llvm::opt::ArgList &Args) const override;
 
   void
   AddClangSystemIncludeArgs(const llvm::opt::ArgList &DriverArgs,
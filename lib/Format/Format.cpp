@@ -2296,6 +2296,12 @@ reformat(const FormatStyle &Style, StringRef Code,
   unsigned Penalty = 0;
   for (size_t I = 0, E = Passes.size(); I < E; ++I) {
     std::pair<tooling::Replacements, unsigned> PassFixes = Passes[I](*Env);
+    // A pass that changed nothing leaves the code and the ranges as they
+    // were, so the next pass can reuse the current environment.
+    if (PassFixes.first.empty()) {
+      Penalty += PassFixes.second;
+      continue;
+    }
     auto NewCode = applyAllReplacements(
         CurrentCode ? StringRef(*CurrentCode) : Code, PassFixes.first);
     if (NewCode) {
@@ -922,6 +922,7 @@ private:
     ++Count;
 
     unsigned Penalty = 0;
+    bool Greedy = false;
 
     // While not empty, take first element and follow edges.
     while (!Queue.empty()) {
@@ -939,11 +940,30 @@ private:
       if (Count > 50000)
         Node->State.IgnoreStackForComparison = true;
 
+      // If even that does not keep the analysis in bounds, give up on the
+      // optimal solution and complete the cheapest state found so far.
+      if (!Greedy && Count > MaxStatesForOptimalSolution) {
+        LLVM_DEBUG(llvm::dbgs() << "Completing line greedily.\n");
+        Greedy = true;
+        Queue = QueueType();
+      }
+
+      FormatDecision LastFormat = Node->State.NextToken->Decision;
+      if (Greedy) {
+        // Follow a single edge from each state, preferring not to break.
+        if ((LastFormat == FD_Unformatted || LastFormat == FD_Continue) &&
+            addNextStateToQueue(Penalty, Node, /*NewLine=*/false, &Count,
+                                &Queue))
+          continue;
+        if (LastFormat == FD_Unformatted || LastFormat == FD_Break)
+          addNextStateToQueue(Penalty, Node, /*NewLine=*/true, &Count, &Queue);
+        continue;
+      }
+
       if (!Seen.insert(&Node->State).second)
         // State already examined with lower penalty.
         continue;
 
-      FormatDecision LastFormat = Node->State.NextToken->Decision;
       if (LastFormat == FD_Unformatted || LastFormat == FD_Continue)
         addNextStateToQueue(Penalty, Node, /*NewLine=*/false, &Count, &Queue);
       if (LastFormat == FD_Unformatted || LastFormat == FD_Break)
@@ -972,22 +992,24 @@ private:
   ///
   /// Assume the current state is \p PreviousNode and has been reached with a
   /// penalty of \p Penalty. Insert a line break if \p NewLine is \c true.
-  void addNextStateToQueue(unsigned Penalty, StateNode *PreviousNode,
+  /// Returns \c false if the state cannot be reached.
+  bool addNextStateToQueue(unsigned Penalty, StateNode *PreviousNode,
                            bool NewLine, unsigned *Count, QueueType *Queue) {
     if (NewLine && !Indenter->canBreak(PreviousNode->State))
-      return;
+      return false;
     if (!NewLine && Indenter->mustBreak(PreviousNode->State))
-      return;
+      return false;
 
     StateNode *Node = new (Allocator.Allocate())
         StateNode(PreviousNode->State, NewLine, PreviousNode);
     if (!formatChildren(Node->State, NewLine, /*DryRun=*/true, Penalty))
-      return;
+      return false;
 
     Penalty += Indenter->addTokenToState(Node->State, NewLine, true);
 
     Queue->push(QueueItem(OrderedPenalty(Penalty, *Count), Node));
     ++(*Count);
+    return true;
   }
 
   /// Applies the best formatting by reconstructing the path in the
@@ -1015,6 +1037,10 @@ private:
     }
   }
 
+  /// The number of states after which a line is no longer formatted
+  /// optimally, but completed greedily from the cheapest state so far.
+  static const unsigned MaxStatesForOptimalSolution = 500000;
+
   llvm::SpecificBumpPtrAllocator<StateNode> Allocator;
 };
 
@@ -2052,6 +2052,23 @@ void AugmentedCodeCompleteConsumer::ProcessCodeCompleteResults(Sema &S,
   llvm::StringSet<llvm::BumpPtrAllocator> HiddenNames;
   using Result = CodeCompletionResult;
   SmallVector<Result, 8> AllResults;
+
+  // The preferred type is the same for every cached result, so classify it
+  // and look it up among the cached completion types only once.
+  SimplifiedTypeClass ExpectedSTC = STC_Other;
+  unsigned ExpectedTypeID = 0;
+  if (!Context.getPreferredType().isNull()) {
+    CanQualType Expected = S.Context.getCanonicalType(
+        Context.getPreferredType().getUnqualifiedType());
+    ExpectedSTC = getSimplifiedTypeClass(Expected);
+    llvm::StringMap<unsigned> &CachedCompletionTypes =
+        AST.getCachedCompletionTypes();
+    llvm::StringMap<unsigned>::iterator Pos =
+        CachedCompletionTypes.find(QualType(Expected).getAsString());
+    if (Pos != CachedCompletionTypes.end())
+      ExpectedTypeID = Pos->second;
+  }
+
   for (ASTUnit::cached_completion_iterator
             C = AST.cached_completion_begin(),
          CEnd = AST.cached_completion_end();
@@ -2084,17 +2101,9 @@ void AugmentedCodeCompleteConsumer::ProcessCodeCompleteResults(Sema &S,
                                          S.getLangOpts(),
                                Context.getPreferredType()->isAnyPointerType());
       } else if (C->Type) {
-        CanQualType Expected
-          = S.Context.getCanonicalType(
-                               Context.getPreferredType().getUnqualifiedType());
-        SimplifiedTypeClass ExpectedSTC = getSimplifiedTypeClass(Expected);
         if (ExpectedSTC == C->TypeClass) {
           // We know this type is similar; check for an exact match.
-          llvm::StringMap<unsigned> &CachedCompletionTypes
-            = AST.getCachedCompletionTypes();
-          llvm::StringMap<unsigned>::iterator Pos
-            = CachedCompletionTypes.find(QualType(Expected).getAsString());
-          if (Pos != CachedCompletionTypes.end() && Pos->second == C->Type)
+          if (ExpectedTypeID == C->Type)
             Priority /= CCF_ExactTypeMatch;
           else
             Priority /= CCF_SimilarTypeMatch;
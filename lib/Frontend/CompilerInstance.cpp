@@ -13,6 +13,7 @@
 #include "clang/Basic/CharInfo.h"
 #include "clang/Basic/Diagnostic.h"
 #include "clang/Basic/FileManager.h"
+#include "clang/Basic/FileSystemStatCache.h"
 #include "clang/Basic/SourceManager.h"
 #include "clang/Basic/Stack.h"
 #include "clang/Basic/TargetInfo.h"
@@ -90,6 +91,7 @@ void CompilerInstance::setAuxTarget(TargetInfo *Value) { AuxTarget = Value; }
 
 void CompilerInstance::setFileManager(FileManager *Value) {
   FileMgr = Value;
+  HeaderLookupCache = nullptr;
 }
 
 void CompilerInstance::setSourceManager(SourceManager *Value) {
@@ -306,6 +308,13 @@ FileManager *CompilerInstance::createFileManager(
                                                     getDiagnostics());
   assert(VFS && "FileManager has no VFS?");
   FileMgr = new FileManager(getFileSystemOpts(), std::move(VFS));
+  HeaderLookupCache = nullptr;
+  if (!getFileSystemOpts().StatCachePath.empty()) {
+    auto Cache = llvm::make_unique<PersistentStatCache>(
+        getFileSystemOpts().StatCachePath);
+    HeaderLookupCache = Cache.get();
+    FileMgr->setStatCache(std::move(Cache));
+  }
   return FileMgr.get();
 }
 
@@ -948,6 +957,11 @@ bool CompilerInstance::ExecuteAction(FrontendAction &Act) {
     }
   }
 
+  // Record the failed header lookups for the next invocations.  The cache is
+  // only an optimization, so failing to write it is not an error.
+  if (HeaderLookupCache)
+    (void)HeaderLookupCache->save();
+
   // Notify the diagnostic client that all files were processed.
   getDiagnostics().getClient()->finish();
 
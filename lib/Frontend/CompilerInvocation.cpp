@@ -1096,11 +1096,14 @@ static bool ParseCodeGenArgs(CodeGenOptions &Opts, ArgList &Args, InputKind IK,
 
   Opts.RelaxELFRelocations = Args.hasArg(OPT_mrelax_relocations);
   Opts.DebugCompilationDir = Args.getLastArgValue(OPT_fdebug_compilation_dir);
-  for (auto *A :
-       Args.filtered(OPT_mlink_bitcode_file, OPT_mlink_builtin_bitcode)) {
+  for (auto *A : Args.filtered(OPT_mlink_bitcode_file, OPT_mlink_builtin_bitcode,
+                               OPT_cheerp_link_bitcode_library)) {
     CodeGenOptions::BitcodeFileToLink F;
     F.Filename = A->getValue();
-    if (A->getOption().matches(OPT_mlink_builtin_bitcode)) {
+    if (A->getOption().matches(OPT_cheerp_link_bitcode_library)) {
+      F.LinkFlags = llvm::Linker::Flags::LinkOnlyNeeded;
+      F.LinkAsLibrary = true;
+    } else if (A->getOption().matches(OPT_mlink_builtin_bitcode)) {
       F.LinkFlags = llvm::Linker::Flags::LinkOnlyNeeded;
       // When linking CUDA bitcode, propagate function attributes so that
       // e.g. libdevice gets fast-math attrs if we're building with fast-math.
@@ -1109,6 +1112,11 @@ static bool ParseCodeGenArgs(CodeGenOptions &Opts, ArgList &Args, InputKind IK,
     }
     Opts.LinkBitcodeFiles.push_back(F);
   }
+  Opts.CheerpLinkTimePasses = Args.getAllArgValues(OPT_cheerp_link_time_pass);
+  Opts.CheerpLTOCacheDir = Args.getLastArgValue(OPT_cheerp_lto_cache_dir);
+  Opts.CheerpLinkRootsOnly = Args.hasArg(OPT_cheerp_link_roots_only);
+  Opts.CheerpCacheLinkInputs = Args.hasArg(OPT_cheerp_cache_link_inputs) &&
+                               !Opts.CheerpLTOCacheDir.empty();
   Opts.SanitizeCoverageType =
       getLastArgIntValue(Args, OPT_fsanitize_coverage_type, 0, Diags);
   Opts.SanitizeCoverageIndirectCalls =
@@ -1605,6 +1613,7 @@ bool clang::ParseDiagnosticArgs(DiagnosticOptions &Opts, ArgList &Args,
 
 static void ParseFileSystemArgs(FileSystemOptions &Opts, ArgList &Args) {
   Opts.WorkingDir = Args.getLastArgValue(OPT_working_directory);
+  Opts.StatCachePath = Args.getLastArgValue(OPT_fheader_lookup_cache_EQ);
 }
 
 /// Parse the argument to the -ftest-module-file-extension
@@ -1798,6 +1807,7 @@ static InputKind ParseFrontendArgs(FrontendOptions &Opts, ArgList &Args,
   Opts.TimeTrace = Args.hasArg(OPT_ftime_trace);
   Opts.TimeTraceGranularity = getLastArgIntValue(
       Args, OPT_ftime_trace_granularity_EQ, Opts.TimeTraceGranularity, Diags);
+  Opts.TimeTraceFile = Args.getLastArgValue(OPT_ftime_trace_file);
   Opts.ShowVersion = Args.hasArg(OPT_version);
   Opts.ASTMergeFiles = Args.getAllArgValues(OPT_ast_merge);
   Opts.LLVMArgs = Args.getAllArgValues(OPT_mllvm);
@@ -2406,6 +2416,18 @@ static void ParseCheerpArgs(LangOptions &Opts, ArgList &Args,
   if (const Arg *A = Args.getLastArg(OPT_cheerp_wasm_anyref)) {
     Opts.CheerpAnyref = 1;
   }
+  if (Args.hasArg(OPT_cheerp_wasm_simd))
+    Opts.CheerpWasmSIMD = 1;
+  if (Args.hasArg(OPT_cheerp_wasm_bulk_memory))
+    Opts.CheerpWasmBulkMemory = 1;
+  if (Args.hasArg(OPT_cheerp_wasm_shared_memory))
+    Opts.CheerpWasmSharedMemory = 1;
+  if (Args.hasArg(OPT_cheerp_wasm_return_calls))
+    Opts.CheerpWasmReturnCalls = 1;
+  if (Args.hasArg(OPT_cheerp_wasm_exceptions))
+    Opts.CheerpWasmExceptions = 1;
+  if (Args.hasArg(OPT_cheerp_use_bigints))
+    Opts.CheerpUseBigInts = 1;
 
 }
 
@@ -2798,8 +2820,12 @@ static void ParseLangArgs(LangOptions &Opts, ArgList &Args, InputKind IK,
       getLastArgIntValue(Args, OPT_fconstexpr_depth, 512, Diags);
   Opts.ConstexprStepLimit =
       getLastArgIntValue(Args, OPT_fconstexpr_steps, 1048576, Diags);
+  Opts.EnableNewConstInterp =
+      Args.hasArg(OPT_fexperimental_new_constant_interpreter);
   Opts.BracketDepth = getLastArgIntValue(Args, OPT_fbracket_depth, 256, Diags);
   Opts.DelayedTemplateParsing = Args.hasArg(OPT_fdelayed_template_parsing);
+  Opts.DelayedInlineMethodParsing =
+      Args.hasArg(OPT_fdelayed_inline_method_parsing);
   Opts.NumLargeByValueCopy =
       getLastArgIntValue(Args, OPT_Wlarge_by_value_copy_EQ, 0, Diags);
   Opts.MSBitfields = Args.hasArg(OPT_mms_bitfields);
@@ -3187,6 +3213,7 @@ static void ParseLangArgs(LangOptions &Opts, ArgList &Args, InputKind IK,
 
   Opts.CompleteMemberPointers = Args.hasArg(OPT_fcomplete_member_pointers);
   Opts.BuildingPCHWithObjectFile = Args.hasArg(OPT_building_pch_with_obj);
+  Opts.PCHInstantiateTemplates = Args.hasArg(OPT_fpch_instantiate_templates);
 }
 
 static bool isStrictlyPreprocessorAction(frontend::ActionKind Action) {
@@ -3244,6 +3271,7 @@ static void ParsePreprocessorArgs(PreprocessorOptions &Opts, ArgList &Args,
   Opts.PCHThroughHeader = Args.getLastArgValue(OPT_pch_through_header_EQ);
   Opts.UsePredefines = !Args.hasArg(OPT_undef);
   Opts.DetailedRecord = Args.hasArg(OPT_detailed_preprocessing_record);
+  Opts.MacroExpansionStats = Args.hasArg(OPT_fmacro_expansion_stats);
   Opts.DisablePCHValidation = Args.hasArg(OPT_fno_validate_pch);
   Opts.AllowPCHWithCompilerErrors = Args.hasArg(OPT_fallow_pch_with_errors);
 
@@ -980,6 +980,9 @@ void FrontendAction::EndSourceFile() {
     CI.setASTConsumer(nullptr);
   }
 
+  if (CI.hasPreprocessor() && CI.getPreprocessorOpts().MacroExpansionStats)
+    CI.getPreprocessor().PrintMacroExpansionStats();
+
   if (CI.getFrontendOpts().ShowStats) {
     llvm::errs() << "\nSTATISTICS FOR '" << getCurrentFile() << "':\n";
     CI.getPreprocessor().PrintStats();
@@ -789,6 +789,16 @@ static void PrintPreprocessedTokens(Preprocessor &PP, Token &Tok,
     } else if (Tok.isLiteral() && !Tok.needsCleaning() &&
                Tok.getLiteralData()) {
       OS.write(Tok.getLiteralData(), Tok.getLength());
+    } else if (const char *Punc = tok::getPunctuatorSpelling(Tok.getKind())) {
+      // Punctuators are spelled as their kind unless they were written as
+      // digraphs, which are longer, so avoid looking up the source buffer.
+      StringRef Spelling = Punc;
+      if (Tok.needsCleaning() || Spelling.size() != Tok.getLength()) {
+        const char *TokPtr = Buffer;
+        unsigned Len = PP.getSpelling(Tok, TokPtr);
+        Spelling = StringRef(TokPtr, Len);
+      }
+      OS << Spelling;
     } else if (Tok.getLength() < llvm::array_lengthof(Buffer)) {
       const char *TokPtr = Buffer;
       unsigned Len = PP.getSpelling(Tok, TokPtr);
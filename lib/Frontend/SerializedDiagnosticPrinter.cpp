@@ -19,6 +19,7 @@
 #include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Bitstream/BitCodes.h"
 #include "llvm/Bitstream/BitstreamReader.h"
@@ -209,7 +210,7 @@ private:
   unsigned getEmitDiagnosticFlag(StringRef DiagName);
 
   /// Emit (lazily) the file string and retrieved the file identifier.
-  unsigned getEmitFile(const char *Filename);
+  unsigned getEmitFile(StringRef Filename);
 
   /// Add SourceLocation information the specified record.
   void AddLocToRecord(FullSourceLoc Loc, PresumedLoc PLoc,
@@ -269,14 +270,11 @@ private:
     /// The collection of diagnostic categories used.
     llvm::DenseSet<unsigned> Categories;
 
-    /// The collection of files used.
-    llvm::DenseMap<const char *, unsigned> Files;
+    /// The collection of files used, uniqued by name.
+    llvm::StringMap<unsigned> Files;
 
-    typedef llvm::DenseMap<const void *, std::pair<unsigned, StringRef> >
-    DiagFlagsTy;
-
-    /// Map for uniquing strings.
-    DiagFlagsTy DiagFlags;
+    /// The collection of diagnostic flags used, uniqued by name.
+    llvm::StringMap<unsigned> DiagFlags;
 
     /// Whether we have already started emission of any DIAG blocks. Once
     /// this becomes \c true, we never close a DIAG block until we know that we're
@@ -368,17 +366,16 @@ void SDiagsWriter::AddCharSourceRangeToRecord(CharSourceRange Range,
   AddLocToRecord(FullSourceLoc(Range.getEnd(), SM), Record, TokSize);
 }
 
-unsigned SDiagsWriter::getEmitFile(const char *FileName){
-  if (!FileName)
+unsigned SDiagsWriter::getEmitFile(StringRef Name) {
+  if (Name.empty())
     return 0;
 
-  unsigned &entry = State->Files[FileName];
+  unsigned &entry = State->Files[Name];
   if (entry)
     return entry;
 
   // Lazily generate the record for the file.
   entry = State->Files.size();
-  StringRef Name(FileName);
   RecordData::value_type Record[] = {RECORD_FILENAME, entry, 0 /* For legacy */,
                                      0 /* For legacy */, Name.size()};
   State->Stream.EmitRecordWithBlob(State->Abbrevs.get(RECORD_FILENAME), Record,
@@ -547,22 +544,20 @@ unsigned SDiagsWriter::getEmitDiagnosticFlag(StringRef FlagName) {
   if (FlagName.empty())
     return 0;
 
-  // Here we assume that FlagName points to static data whose pointer
-  // value is fixed.  This allows us to unique by diagnostic groups.
-  const void *data = FlagName.data();
-  std::pair<unsigned, StringRef> &entry = State->DiagFlags[data];
-  if (entry.first == 0) {
-    entry.first = State->DiagFlags.size();
-    entry.second = FlagName;
+  // Unique by name rather than by address: the flags of merged child records
+  // point into the buffer of the file being read.
+  unsigned &entry = State->DiagFlags[FlagName];
+  if (entry == 0) {
+    entry = State->DiagFlags.size();
 
     // Lazily emit the string in a separate record.
-    RecordData::value_type Record[] = {RECORD_DIAG_FLAG, entry.first,
+    RecordData::value_type Record[] = {RECORD_DIAG_FLAG, entry,
                                        FlagName.size()};
     State->Stream.EmitRecordWithBlob(State->Abbrevs.get(RECORD_DIAG_FLAG),
                                      Record, FlagName);
   }
 
-  return entry.first;
+  return entry;
 }
 
 void SDiagsWriter::HandleDiagnostic(DiagnosticsEngine::Level DiagLevel,
@@ -844,7 +839,7 @@ SDiagsMerger::visitFixitRecord(const serialized_diags::Location &Start,
 std::error_code SDiagsMerger::visitFilenameRecord(unsigned ID, unsigned Size,
                                                   unsigned Timestamp,
                                                   StringRef Name) {
-  FileLookup[ID] = Writer.getEmitFile(Name.str().c_str());
+  FileLookup[ID] = Writer.getEmitFile(Name);
   return std::error_code();
 }
 
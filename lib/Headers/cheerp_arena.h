@@ -0,0 +1,101 @@
+/*===---- cheerp_arena.h - Cheerp arena allocator --------------------------===
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ *===-----------------------------------------------------------------------===
+ */
+
+#ifndef __CHEERP_ARENA_H
+#define __CHEERP_ARENA_H
+
+#ifndef __ASMJS__
+#error "cheerp_arena.h needs linear memory, compile with the wasm target"
+#endif
+
+/* A bump allocator over a caller provided region of the linear memory.
+ * Allocations are never freed one by one: cheerp_arena_reset releases all of
+ * them at once, which is much cheaper than a malloc/free pair per object for
+ * request scoped data. */
+
+typedef struct cheerp_arena_t {
+  char *__base;
+  char *__cur;
+  char *__end;
+} cheerp_arena_t;
+
+static __inline__ void __attribute__((__always_inline__))
+cheerp_arena_init(cheerp_arena_t *__a, void *__buf, __SIZE_TYPE__ __size) {
+  __a->__base = (char *)__buf;
+  __a->__cur = (char *)__buf;
+  __a->__end = (char *)__buf + __size;
+}
+
+/* Returns 0 when the arena has no room left. __align must be a power of 2 */
+static __inline__ void *__attribute__((__always_inline__))
+cheerp_arena_alloc(cheerp_arena_t *__a, __SIZE_TYPE__ __size,
+                   __SIZE_TYPE__ __align) {
+  __UINTPTR_TYPE__ __p = ((__UINTPTR_TYPE__)__a->__cur + __align - 1) &
+                         ~(__UINTPTR_TYPE__)(__align - 1);
+  if (__p > (__UINTPTR_TYPE__)__a->__end ||
+      __size > (__UINTPTR_TYPE__)__a->__end - __p)
+    return 0;
+  __a->__cur = (char *)__p + __size;
+  return (void *)__p;
+}
+
+static __inline__ void __attribute__((__always_inline__))
+cheerp_arena_reset(cheerp_arena_t *__a) {
+  __a->__cur = __a->__base;
+}
+
+#ifdef __cplusplus
+/* new (arena) T(...) allocates T in the arena, and evaluates to a null pointer
+ * when the arena is full. The destructor of T is not called when the arena is
+ * reset */
+inline void *operator new(__SIZE_TYPE__ __size, cheerp_arena_t &__a) noexcept {
+  return cheerp_arena_alloc(&__a, __size, __BIGGEST_ALIGNMENT__);
+}
+
+inline void *operator new[](__SIZE_TYPE__ __size,
+                           cheerp_arena_t &__a) noexcept {
+  return cheerp_arena_alloc(&__a, __size, __BIGGEST_ALIGNMENT__);
+}
+
+/* Only used if a constructor throws, the memory is reclaimed on reset */
+inline void operator delete(void *, cheerp_arena_t &) {}
+inline void operator delete[](void *, cheerp_arena_t &) {}
+
+/* Releases everything allocated in the arena during its lifetime, like
+ * __builtin_cheerp_stack_save/__builtin_cheerp_stack_restore do for the
+ * stack */
+class cheerp_arena_scope {
+public:
+  explicit cheerp_arena_scope(cheerp_arena_t &__a)
+      : __arena(__a), __saved(__a.__cur) {}
+  ~cheerp_arena_scope() { __arena.__cur = __saved; }
+  cheerp_arena_scope(const cheerp_arena_scope &) = delete;
+  cheerp_arena_scope &operator=(const cheerp_arena_scope &) = delete;
+
+private:
+  cheerp_arena_t &__arena;
+  char *__saved;
+};
+#endif
+
+#endif /* __CHEERP_ARENA_H */
@@ -0,0 +1,712 @@
+/*===---- wasm_simd128.h - WebAssembly 128-bit SIMD intrinsics -------------===
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ *===-----------------------------------------------------------------------===
+ */
+
+#ifndef __WASM_SIMD128_H
+#define __WASM_SIMD128_H
+
+#ifndef __wasm_simd128__
+#error "wasm_simd128.h needs -cheerp-wasm-enable=simd and wasm linear output"
+#endif
+
+/* The operations are written with the generic vector extensions, the Cheerp
+ * backend lowers the resulting vector IR to v128 instructions. */
+
+typedef int v128_t __attribute__((__vector_size__(16), __aligned__(16)));
+
+typedef signed char __i8x16
+    __attribute__((__vector_size__(16), __aligned__(16)));
+typedef unsigned char __u8x16
+    __attribute__((__vector_size__(16), __aligned__(16)));
+typedef short __i16x8
+    __attribute__((__vector_size__(16), __aligned__(16)));
+typedef unsigned short __u16x8
+    __attribute__((__vector_size__(16), __aligned__(16)));
+typedef int __i32x4
+    __attribute__((__vector_size__(16), __aligned__(16)));
+typedef unsigned int __u32x4
+    __attribute__((__vector_size__(16), __aligned__(16)));
+typedef long long __i64x2
+    __attribute__((__vector_size__(16), __aligned__(16)));
+typedef unsigned long long __u64x2
+    __attribute__((__vector_size__(16), __aligned__(16)));
+typedef float __f32x4
+    __attribute__((__vector_size__(16), __aligned__(16)));
+typedef double __f64x2
+    __attribute__((__vector_size__(16), __aligned__(16)));
+
+#define __DEFAULT_FN_ATTRS                                                     \
+  __attribute__((__always_inline__, __nodebug__, __cheerp_wasm__))
+
+/* Memory */
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_v128_load(const void *__mem) {
+  struct __wasm_v128_load_struct {
+    v128_t __v;
+  } __attribute__((__packed__, __may_alias__));
+  return ((const struct __wasm_v128_load_struct *)__mem)->__v;
+}
+
+static __inline__ void __DEFAULT_FN_ATTRS
+wasm_v128_store(void *__mem, v128_t __a) {
+  struct __wasm_v128_store_struct {
+    v128_t __v;
+  } __attribute__((__packed__, __may_alias__));
+  ((struct __wasm_v128_store_struct *)__mem)->__v = __a;
+}
+
+/* Construction */
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_i32x4_make(int __c0, int __c1, int __c2, int __c3) {
+  return (v128_t)(__i32x4){__c0, __c1, __c2, __c3};
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_i64x2_make(long long __c0, long long __c1) {
+  return (v128_t)(__i64x2){__c0, __c1};
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_f32x4_make(float __c0, float __c1, float __c2, float __c3) {
+  return (v128_t)(__f32x4){__c0, __c1, __c2, __c3};
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_f64x2_make(double __c0, double __c1) {
+  return (v128_t)(__f64x2){__c0, __c1};
+}
+
+/* Splat */
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_i8x16_splat(signed char __a) {
+  return (v128_t)(__i8x16){__a, __a, __a, __a, __a, __a, __a, __a,
+                           __a, __a, __a, __a, __a, __a, __a, __a};
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_i16x8_splat(short __a) {
+  return (v128_t)(__i16x8){__a, __a, __a, __a, __a, __a, __a, __a};
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_i32x4_splat(int __a) {
+  return (v128_t)(__i32x4){__a, __a, __a, __a};
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_i64x2_splat(long long __a) {
+  return (v128_t)(__i64x2){__a, __a};
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_f32x4_splat(float __a) {
+  return (v128_t)(__f32x4){__a, __a, __a, __a};
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_f64x2_splat(double __a) {
+  return (v128_t)(__f64x2){__a, __a};
+}
+
+/* Lanes, the index must be a constant */
+
+#define wasm_i8x16_extract_lane(__a, __i) ((signed char)((__i8x16)(__a))[__i])
+#define wasm_i16x8_extract_lane(__a, __i) ((short)((__i16x8)(__a))[__i])
+#define wasm_i32x4_extract_lane(__a, __i) ((int)((__i32x4)(__a))[__i])
+#define wasm_i64x2_extract_lane(__a, __i) ((long long)((__i64x2)(__a))[__i])
+#define wasm_f32x4_extract_lane(__a, __i) ((float)((__f32x4)(__a))[__i])
+#define wasm_f64x2_extract_lane(__a, __i) ((double)((__f64x2)(__a))[__i])
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_i8x16_replace_lane(v128_t __a, int __i, signed char __b) {
+  __i8x16 __v = (__i8x16)__a;
+  __v[__i] = __b;
+  return (v128_t)__v;
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_i16x8_replace_lane(v128_t __a, int __i, short __b) {
+  __i16x8 __v = (__i16x8)__a;
+  __v[__i] = __b;
+  return (v128_t)__v;
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_i32x4_replace_lane(v128_t __a, int __i, int __b) {
+  __i32x4 __v = (__i32x4)__a;
+  __v[__i] = __b;
+  return (v128_t)__v;
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_i64x2_replace_lane(v128_t __a, int __i, long long __b) {
+  __i64x2 __v = (__i64x2)__a;
+  __v[__i] = __b;
+  return (v128_t)__v;
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_f32x4_replace_lane(v128_t __a, int __i, float __b) {
+  __f32x4 __v = (__f32x4)__a;
+  __v[__i] = __b;
+  return (v128_t)__v;
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_f64x2_replace_lane(v128_t __a, int __i, double __b) {
+  __f64x2 __v = (__f64x2)__a;
+  __v[__i] = __b;
+  return (v128_t)__v;
+}
+
+/* Arithmetic */
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_i8x16_add(v128_t __a, v128_t __b) {
+  return (v128_t)((__i8x16)__a + (__i8x16)__b);
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_i8x16_sub(v128_t __a, v128_t __b) {
+  return (v128_t)((__i8x16)__a - (__i8x16)__b);
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_i8x16_neg(v128_t __a) {
+  return (v128_t)(-(__i8x16)__a);
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_i16x8_add(v128_t __a, v128_t __b) {
+  return (v128_t)((__i16x8)__a + (__i16x8)__b);
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_i16x8_sub(v128_t __a, v128_t __b) {
+  return (v128_t)((__i16x8)__a - (__i16x8)__b);
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_i16x8_mul(v128_t __a, v128_t __b) {
+  return (v128_t)((__i16x8)__a * (__i16x8)__b);
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_i16x8_neg(v128_t __a) {
+  return (v128_t)(-(__i16x8)__a);
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_i32x4_add(v128_t __a, v128_t __b) {
+  return (v128_t)((__i32x4)__a + (__i32x4)__b);
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_i32x4_sub(v128_t __a, v128_t __b) {
+  return (v128_t)((__i32x4)__a - (__i32x4)__b);
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_i32x4_mul(v128_t __a, v128_t __b) {
+  return (v128_t)((__i32x4)__a * (__i32x4)__b);
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_i32x4_neg(v128_t __a) {
+  return (v128_t)(-(__i32x4)__a);
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_i64x2_add(v128_t __a, v128_t __b) {
+  return (v128_t)((__i64x2)__a + (__i64x2)__b);
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_i64x2_sub(v128_t __a, v128_t __b) {
+  return (v128_t)((__i64x2)__a - (__i64x2)__b);
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_i64x2_mul(v128_t __a, v128_t __b) {
+  return (v128_t)((__i64x2)__a * (__i64x2)__b);
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_i64x2_neg(v128_t __a) {
+  return (v128_t)(-(__i64x2)__a);
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_f32x4_add(v128_t __a, v128_t __b) {
+  return (v128_t)((__f32x4)__a + (__f32x4)__b);
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_f32x4_sub(v128_t __a, v128_t __b) {
+  return (v128_t)((__f32x4)__a - (__f32x4)__b);
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_f32x4_mul(v128_t __a, v128_t __b) {
+  return (v128_t)((__f32x4)__a * (__f32x4)__b);
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_f32x4_div(v128_t __a, v128_t __b) {
+  return (v128_t)((__f32x4)__a / (__f32x4)__b);
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_f32x4_neg(v128_t __a) {
+  return (v128_t)(-(__f32x4)__a);
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_f64x2_add(v128_t __a, v128_t __b) {
+  return (v128_t)((__f64x2)__a + (__f64x2)__b);
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_f64x2_sub(v128_t __a, v128_t __b) {
+  return (v128_t)((__f64x2)__a - (__f64x2)__b);
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_f64x2_mul(v128_t __a, v128_t __b) {
+  return (v128_t)((__f64x2)__a * (__f64x2)__b);
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_f64x2_div(v128_t __a, v128_t __b) {
+  return (v128_t)((__f64x2)__a / (__f64x2)__b);
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_f64x2_neg(v128_t __a) {
+  return (v128_t)(-(__f64x2)__a);
+}
+
+/* Shifts, the count is taken modulo the lane width */
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_i8x16_shl(v128_t __a, unsigned int __b) {
+  return (v128_t)((__i8x16)__a << (signed char)(__b & 7));
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_i8x16_shr(v128_t __a, unsigned int __b) {
+  return (v128_t)((__i8x16)__a >> (signed char)(__b & 7));
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_u8x16_shr(v128_t __a, unsigned int __b) {
+  return (v128_t)((__u8x16)__a >> (unsigned char)(__b & 7));
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_i16x8_shl(v128_t __a, unsigned int __b) {
+  return (v128_t)((__i16x8)__a << (short)(__b & 15));
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_i16x8_shr(v128_t __a, unsigned int __b) {
+  return (v128_t)((__i16x8)__a >> (short)(__b & 15));
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_u16x8_shr(v128_t __a, unsigned int __b) {
+  return (v128_t)((__u16x8)__a >> (unsigned short)(__b & 15));
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_i32x4_shl(v128_t __a, unsigned int __b) {
+  return (v128_t)((__i32x4)__a << (int)(__b & 31));
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_i32x4_shr(v128_t __a, unsigned int __b) {
+  return (v128_t)((__i32x4)__a >> (int)(__b & 31));
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_u32x4_shr(v128_t __a, unsigned int __b) {
+  return (v128_t)((__u32x4)__a >> (unsigned int)(__b & 31));
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_i64x2_shl(v128_t __a, unsigned int __b) {
+  return (v128_t)((__i64x2)__a << (long long)(__b & 63));
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_i64x2_shr(v128_t __a, unsigned int __b) {
+  return (v128_t)((__i64x2)__a >> (long long)(__b & 63));
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_u64x2_shr(v128_t __a, unsigned int __b) {
+  return (v128_t)((__u64x2)__a >> (unsigned long long)(__b & 63));
+}
+
+/* Bitwise */
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_v128_not(v128_t __a) {
+  return ~__a;
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_v128_and(v128_t __a, v128_t __b) {
+  return __a & __b;
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_v128_or(v128_t __a, v128_t __b) {
+  return __a | __b;
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_v128_xor(v128_t __a, v128_t __b) {
+  return __a ^ __b;
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_v128_andnot(v128_t __a, v128_t __b) {
+  return __a & ~__b;
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_v128_bitselect(v128_t __a, v128_t __b, v128_t __mask) {
+  return (__a & __mask) | (__b & ~__mask);
+}
+
+/* Comparisons, every lane of the result is all ones or all zeros */
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_i8x16_eq(v128_t __a, v128_t __b) {
+  return (v128_t)((__i8x16)__a == (__i8x16)__b);
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_i8x16_ne(v128_t __a, v128_t __b) {
+  return (v128_t)((__i8x16)__a != (__i8x16)__b);
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_i8x16_lt(v128_t __a, v128_t __b) {
+  return (v128_t)((__i8x16)__a < (__i8x16)__b);
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_i8x16_gt(v128_t __a, v128_t __b) {
+  return (v128_t)((__i8x16)__a > (__i8x16)__b);
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_i8x16_le(v128_t __a, v128_t __b) {
+  return (v128_t)((__i8x16)__a <= (__i8x16)__b);
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_i8x16_ge(v128_t __a, v128_t __b) {
+  return (v128_t)((__i8x16)__a >= (__i8x16)__b);
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_i16x8_eq(v128_t __a, v128_t __b) {
+  return (v128_t)((__i16x8)__a == (__i16x8)__b);
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_i16x8_ne(v128_t __a, v128_t __b) {
+  return (v128_t)((__i16x8)__a != (__i16x8)__b);
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_i16x8_lt(v128_t __a, v128_t __b) {
+  return (v128_t)((__i16x8)__a < (__i16x8)__b);
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_i16x8_gt(v128_t __a, v128_t __b) {
+  return (v128_t)((__i16x8)__a > (__i16x8)__b);
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_i16x8_le(v128_t __a, v128_t __b) {
+  return (v128_t)((__i16x8)__a <= (__i16x8)__b);
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_i16x8_ge(v128_t __a, v128_t __b) {
+  return (v128_t)((__i16x8)__a >= (__i16x8)__b);
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_i32x4_eq(v128_t __a, v128_t __b) {
+  return (v128_t)((__i32x4)__a == (__i32x4)__b);
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_i32x4_ne(v128_t __a, v128_t __b) {
+  return (v128_t)((__i32x4)__a != (__i32x4)__b);
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_i32x4_lt(v128_t __a, v128_t __b) {
+  return (v128_t)((__i32x4)__a < (__i32x4)__b);
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_i32x4_gt(v128_t __a, v128_t __b) {
+  return (v128_t)((__i32x4)__a > (__i32x4)__b);
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_i32x4_le(v128_t __a, v128_t __b) {
+  return (v128_t)((__i32x4)__a <= (__i32x4)__b);
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_i32x4_ge(v128_t __a, v128_t __b) {
+  return (v128_t)((__i32x4)__a >= (__i32x4)__b);
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_i64x2_eq(v128_t __a, v128_t __b) {
+  return (v128_t)((__i64x2)__a == (__i64x2)__b);
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_i64x2_ne(v128_t __a, v128_t __b) {
+  return (v128_t)((__i64x2)__a != (__i64x2)__b);
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_i64x2_lt(v128_t __a, v128_t __b) {
+  return (v128_t)((__i64x2)__a < (__i64x2)__b);
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_i64x2_gt(v128_t __a, v128_t __b) {
+  return (v128_t)((__i64x2)__a > (__i64x2)__b);
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_i64x2_le(v128_t __a, v128_t __b) {
+  return (v128_t)((__i64x2)__a <= (__i64x2)__b);
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_i64x2_ge(v128_t __a, v128_t __b) {
+  return (v128_t)((__i64x2)__a >= (__i64x2)__b);
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_f32x4_eq(v128_t __a, v128_t __b) {
+  return (v128_t)((__f32x4)__a == (__f32x4)__b);
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_f32x4_ne(v128_t __a, v128_t __b) {
+  return (v128_t)((__f32x4)__a != (__f32x4)__b);
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_f32x4_lt(v128_t __a, v128_t __b) {
+  return (v128_t)((__f32x4)__a < (__f32x4)__b);
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_f32x4_gt(v128_t __a, v128_t __b) {
+  return (v128_t)((__f32x4)__a > (__f32x4)__b);
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_f32x4_le(v128_t __a, v128_t __b) {
+  return (v128_t)((__f32x4)__a <= (__f32x4)__b);
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_f32x4_ge(v128_t __a, v128_t __b) {
+  return (v128_t)((__f32x4)__a >= (__f32x4)__b);
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_f64x2_eq(v128_t __a, v128_t __b) {
+  return (v128_t)((__f64x2)__a == (__f64x2)__b);
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_f64x2_ne(v128_t __a, v128_t __b) {
+  return (v128_t)((__f64x2)__a != (__f64x2)__b);
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_f64x2_lt(v128_t __a, v128_t __b) {
+  return (v128_t)((__f64x2)__a < (__f64x2)__b);
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_f64x2_gt(v128_t __a, v128_t __b) {
+  return (v128_t)((__f64x2)__a > (__f64x2)__b);
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_f64x2_le(v128_t __a, v128_t __b) {
+  return (v128_t)((__f64x2)__a <= (__f64x2)__b);
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_f64x2_ge(v128_t __a, v128_t __b) {
+  return (v128_t)((__f64x2)__a >= (__f64x2)__b);
+}
+
+/* Min and max */
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_i8x16_min(v128_t __a, v128_t __b) {
+  return wasm_v128_bitselect(__a, __b, wasm_i8x16_lt(__a, __b));
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_i8x16_max(v128_t __a, v128_t __b) {
+  return wasm_v128_bitselect(__a, __b, wasm_i8x16_gt(__a, __b));
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_i16x8_min(v128_t __a, v128_t __b) {
+  return wasm_v128_bitselect(__a, __b, wasm_i16x8_lt(__a, __b));
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_i16x8_max(v128_t __a, v128_t __b) {
+  return wasm_v128_bitselect(__a, __b, wasm_i16x8_gt(__a, __b));
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_i32x4_min(v128_t __a, v128_t __b) {
+  return wasm_v128_bitselect(__a, __b, wasm_i32x4_lt(__a, __b));
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_i32x4_max(v128_t __a, v128_t __b) {
+  return wasm_v128_bitselect(__a, __b, wasm_i32x4_gt(__a, __b));
+}
+
+/* NaN if either lane is NaN, and -0 is less than +0 */
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_f32x4_min(v128_t __a, v128_t __b) {
+  v128_t __r = wasm_v128_bitselect(__a, __b, wasm_f32x4_lt(__a, __b));
+  __r = wasm_v128_bitselect(__a | __b, __r, wasm_f32x4_eq(__a, __b));
+  return wasm_v128_bitselect(wasm_f32x4_add(__a, __b), __r,
+                             wasm_f32x4_ne(__a, __a) | wasm_f32x4_ne(__b, __b));
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_f32x4_max(v128_t __a, v128_t __b) {
+  v128_t __r = wasm_v128_bitselect(__a, __b, wasm_f32x4_gt(__a, __b));
+  __r = wasm_v128_bitselect(__a & __b, __r, wasm_f32x4_eq(__a, __b));
+  return wasm_v128_bitselect(wasm_f32x4_add(__a, __b), __r,
+                             wasm_f32x4_ne(__a, __a) | wasm_f32x4_ne(__b, __b));
+}
+
+/* Pseudo-minimum and maximum, b < a ? b : a and a < b ? b : a */
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_f32x4_pmin(v128_t __a, v128_t __b) {
+  return wasm_v128_bitselect(__b, __a, wasm_f32x4_lt(__b, __a));
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_f32x4_pmax(v128_t __a, v128_t __b) {
+  return wasm_v128_bitselect(__b, __a, wasm_f32x4_lt(__a, __b));
+}
+
+/* NaN if either lane is NaN, and -0 is less than +0 */
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_f64x2_min(v128_t __a, v128_t __b) {
+  v128_t __r = wasm_v128_bitselect(__a, __b, wasm_f64x2_lt(__a, __b));
+  __r = wasm_v128_bitselect(__a | __b, __r, wasm_f64x2_eq(__a, __b));
+  return wasm_v128_bitselect(wasm_f64x2_add(__a, __b), __r,
+                             wasm_f64x2_ne(__a, __a) | wasm_f64x2_ne(__b, __b));
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_f64x2_max(v128_t __a, v128_t __b) {
+  v128_t __r = wasm_v128_bitselect(__a, __b, wasm_f64x2_gt(__a, __b));
+  __r = wasm_v128_bitselect(__a & __b, __r, wasm_f64x2_eq(__a, __b));
+  return wasm_v128_bitselect(wasm_f64x2_add(__a, __b), __r,
+                             wasm_f64x2_ne(__a, __a) | wasm_f64x2_ne(__b, __b));
+}
+
+/* Pseudo-minimum and maximum, b < a ? b : a and a < b ? b : a */
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_f64x2_pmin(v128_t __a, v128_t __b) {
+  return wasm_v128_bitselect(__b, __a, wasm_f64x2_lt(__b, __a));
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_f64x2_pmax(v128_t __a, v128_t __b) {
+  return wasm_v128_bitselect(__b, __a, wasm_f64x2_lt(__a, __b));
+}
+
+/* Conversions */
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_f32x4_convert_i32x4(v128_t __a) {
+  return (v128_t)__builtin_convertvector((__i32x4)__a, __f32x4);
+}
+
+static __inline__ v128_t __DEFAULT_FN_ATTRS
+wasm_f32x4_convert_u32x4(v128_t __a) {
+  return (v128_t)__builtin_convertvector((__u32x4)__a, __f32x4);
+}
+
+/* Shuffles, the lane indices must be constants */
+
+#define wasm_i8x16_shuffle(__a, __b, __c0, __c1, __c2, __c3, __c4, __c5, __c6, \
+                           __c7, __c8, __c9, __c10, __c11, __c12, __c13,       \
+                           __c14, __c15)                                       \
+  ((v128_t)__builtin_shufflevector((__i8x16)(__a), (__i8x16)(__b), __c0,      \
+                                   __c1, __c2, __c3, __c4, __c5, __c6, __c7,   \
+                                   __c8, __c9, __c10, __c11, __c12, __c13,     \
+                                   __c14, __c15))
+
+#define wasm_i16x8_shuffle(__a, __b, __c0, __c1, __c2, __c3, __c4, __c5, __c6, \
+                           __c7)                                               \
+  ((v128_t)__builtin_shufflevector((__i16x8)(__a), (__i16x8)(__b), __c0,      \
+                                   __c1, __c2, __c3, __c4, __c5, __c6, __c7))
+
+#define wasm_i32x4_shuffle(__a, __b, __c0, __c1, __c2, __c3)                   \
+  ((v128_t)__builtin_shufflevector((__i32x4)(__a), (__i32x4)(__b), __c0,      \
+                                   __c1, __c2, __c3))
+
+#define wasm_i64x2_shuffle(__a, __b, __c0, __c1)                               \
+  ((v128_t)__builtin_shufflevector((__i64x2)(__a), (__i64x2)(__b), __c0,      \
+                                   __c1))
+
+#undef __DEFAULT_FN_ATTRS
+
+#endif /* __WASM_SIMD128_H */
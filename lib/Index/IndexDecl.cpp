@@ -759,6 +759,9 @@ bool IndexingContext::indexTopLevelDecl(const Decl *D) {
   if (isa<ObjCMethodDecl>(D))
     return true; // Wait for the objc container.
 
+  if (!shouldIndexFile(D->getLocation()))
+    return true;
+
   return indexDecl(D);
 }
 
@@ -48,6 +48,17 @@ bool IndexingContext::shouldIndexTemplateParameters() const {
   return IndexOpts.IndexTemplateParameters;
 }
 
+bool IndexingContext::shouldIndexFile(SourceLocation Loc) {
+  if (!IndexOpts.ShouldIndexFile)
+    return true;
+  const SourceManager &SM = Ctx->getSourceManager();
+  FileID FID = SM.getFileID(SM.getFileLoc(Loc));
+  auto It = FilesToIndex.try_emplace(FID, false);
+  if (It.second)
+    It.first->second = IndexOpts.ShouldIndexFile(FID);
+  return It.first->second;
+}
+
 bool IndexingContext::handleDecl(const Decl *D,
                                  SymbolRoleSet Roles,
                                  ArrayRef<SymbolRelation> Relations) {
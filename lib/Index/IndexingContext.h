@@ -15,6 +15,7 @@
 #include "clang/Index/IndexingAction.h"
 #include "clang/Lex/MacroInfo.h"
 #include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/DenseMap.h"
 
 namespace clang {
   class ASTContext;
@@ -40,6 +41,9 @@ class IndexingContext {
   IndexDataConsumer &DataConsumer;
   ASTContext *Ctx = nullptr;
 
+  /// The answers of IndexingOptions::ShouldIndexFile, per file.
+  llvm::DenseMap<FileID, bool> FilesToIndex;
+
 public:
   IndexingContext(IndexingOptions IndexOpts, IndexDataConsumer &DataConsumer)
     : IndexOpts(IndexOpts), DataConsumer(DataConsumer) {}
@@ -65,6 +69,10 @@ public:
 
   bool shouldIndexTemplateParameters() const;
 
+  /// Whether top-level declarations at \p Loc should be indexed, according
+  /// to IndexingOptions::ShouldIndexFile.
+  bool shouldIndexFile(SourceLocation Loc);
+
   static bool isTemplateImplicitInstantiation(const Decl *D);
 
   bool handleDecl(const Decl *D, SymbolRoleSet Roles = SymbolRoleSet(),
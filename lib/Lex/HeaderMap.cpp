@@ -164,6 +164,24 @@ Optional<StringRef> HeaderMapImpl::getString(unsigned StrTabIdx) const {
   return StringRef(Data, Len);
 }
 
+bool HeaderMapImpl::keyEquals(unsigned StrTabIdx, StringRef Filename) const {
+  // Add the start of the string table to the idx.
+  StrTabIdx += getEndianAdjustedWord(getHeader().StringsOffset);
+
+  // The key must fit in the buffer together with its null terminator.
+  if (StrTabIdx >= FileBuffer->getBufferSize() ||
+      Filename.size() >= FileBuffer->getBufferSize() - StrTabIdx)
+    return false;
+
+  // Compare in place, without finding the key's length first: most probed
+  // keys differ within their first few characters.
+  const char *Data = FileBuffer->getBufferStart() + StrTabIdx;
+  for (unsigned I = 0, E = Filename.size(); I != E; ++I)
+    if (!Data[I] || toLowercase(Data[I]) != toLowercase(Filename[I]))
+      return false;
+  return Data[Filename.size()] == '\0';
+}
+
 //===----------------------------------------------------------------------===//
 // The Main Drivers
 //===----------------------------------------------------------------------===//
@@ -221,10 +239,7 @@ StringRef HeaderMapImpl::lookupFilename(StringRef Filename,
     if (B.Key == HMAP_EmptyBucketKey) return StringRef(); // Hash miss.
 
     // See if the key matches.  If not, probe on.
-    Optional<StringRef> Key = getString(B.Key);
-    if (LLVM_UNLIKELY(!Key))
-      continue;
-    if (!Filename.equals_lower(*Key))
+    if (!keyEquals(B.Key, Filename))
       continue;
 
     // If so, we have a match in the hash table.  Construct the destination
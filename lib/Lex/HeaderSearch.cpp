@@ -1553,6 +1553,12 @@ HeaderSearch::loadModuleMapFile(const DirectoryEntry *Dir, bool IsSystem,
   if (KnownDir != DirectoryHasModuleMap.end())
     return KnownDir->second ? LMM_AlreadyLoaded : LMM_InvalidModuleMap;
 
+  unsigned SearchKind = IsFramework ? 2 : 1;
+  auto KnownMissing = DirectoryLacksModuleMap.find(Dir);
+  if (KnownMissing != DirectoryLacksModuleMap.end() &&
+      (KnownMissing->second & SearchKind))
+    return LMM_InvalidModuleMap;
+
   if (const FileEntry *ModuleMapFile = lookupModuleMapFile(Dir, IsFramework)) {
     LoadModuleMapResult Result =
         loadModuleMapFileImpl(ModuleMapFile, IsSystem, Dir);
@@ -1565,6 +1571,7 @@ HeaderSearch::loadModuleMapFile(const DirectoryEntry *Dir, bool IsSystem,
       DirectoryHasModuleMap[Dir] = false;
     return Result;
   }
+  DirectoryLacksModuleMap[Dir] |= SearchKind;
   return LMM_InvalidModuleMap;
 }
 
@@ -47,6 +47,13 @@
 #include <tuple>
 #include <utility>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#elif __ALTIVEC__
+#include <altivec.h>
+#undef bool
+#endif
+
 using namespace clang;
 
 //===----------------------------------------------------------------------===//
@@ -1625,14 +1632,94 @@ bool Lexer::tryConsumeIdentifierUTF8Char(const char *&CurPtr) {
   return true;
 }
 
+#ifdef __SSE2__
+/// Return a mask of the bytes of \p Chars that are in the range [Lo, Hi].
+/// The range must not contain bytes with the high bit set, so that the signed
+/// comparisons give the right answer.
+static inline __m128i inCharRange(__m128i Chars, char Lo, char Hi) {
+  return _mm_and_si128(_mm_cmpgt_epi8(Chars, _mm_set1_epi8(Lo - 1)),
+                       _mm_cmplt_epi8(Chars, _mm_set1_epi8(Hi + 1)));
+}
+
+/// Return the offset of the first byte of the 16-byte \p Mask that is clear,
+/// or 16 if all of them are set.
+static inline unsigned firstUnsetByte(__m128i Mask) {
+  unsigned Bits = ~_mm_movemask_epi8(Mask) & 0xFFFF;
+  return Bits ? llvm::countTrailingZeros(Bits) : 16;
+}
+#endif
+
+/// Return a pointer to the first character at or after \p CurPtr that doesn't
+/// match [_A-Za-z0-9].  The buffer is known to be null terminated.
+static const char *skipIdentifierBody(const char *CurPtr,
+                                      const char *BufferEnd) {
+#ifdef __SSE2__
+  while (CurPtr+16 <= BufferEnd) {
+    __m128i Chars = _mm_loadu_si128((const __m128i*)CurPtr);
+    __m128i Matches = _mm_or_si128(
+        _mm_or_si128(inCharRange(Chars, 'a', 'z'), inCharRange(Chars, 'A', 'Z')),
+        _mm_or_si128(inCharRange(Chars, '0', '9'),
+                     _mm_cmpeq_epi8(Chars, _mm_set1_epi8('_'))));
+    unsigned Offset = firstUnsetByte(Matches);
+    CurPtr += Offset;
+    if (Offset != 16)
+      return CurPtr;
+  }
+#endif
+  while (isIdentifierBody(*CurPtr))
+    ++CurPtr;
+  return CurPtr;
+}
+
+/// Return a pointer to the first character at or after \p CurPtr that isn't
+/// horizontal whitespace.  The buffer is known to be null terminated.
+static const char *skipHorizontalWhitespace(const char *CurPtr,
+                                            const char *BufferEnd) {
+#ifdef __SSE2__
+  while (CurPtr+16 <= BufferEnd) {
+    __m128i Chars = _mm_loadu_si128((const __m128i*)CurPtr);
+    // ' ', '\t', '\v' and '\f'.
+    __m128i Matches = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi8(Chars, _mm_set1_epi8(' ')),
+                     _mm_cmpeq_epi8(Chars, _mm_set1_epi8('\t'))),
+        inCharRange(Chars, '\v', '\f'));
+    unsigned Offset = firstUnsetByte(Matches);
+    CurPtr += Offset;
+    if (Offset != 16)
+      return CurPtr;
+  }
+#endif
+  while (isHorizontalWhitespace(*CurPtr))
+    ++CurPtr;
+  return CurPtr;
+}
+
+/// Return a pointer to the first '\n', '\r' or null character at or after
+/// \p CurPtr.  The buffer is known to be null terminated.
+static const char *findLineCommentBreak(const char *CurPtr,
+                                        const char *BufferEnd) {
+#ifdef __SSE2__
+  while (CurPtr+16 <= BufferEnd) {
+    __m128i Chars = _mm_loadu_si128((const __m128i*)CurPtr);
+    __m128i Breaks = _mm_or_si128(
+        _mm_cmpeq_epi8(Chars, _mm_setzero_si128()),
+        _mm_or_si128(_mm_cmpeq_epi8(Chars, _mm_set1_epi8('\n')),
+                     _mm_cmpeq_epi8(Chars, _mm_set1_epi8('\r'))));
+    if (int Mask = _mm_movemask_epi8(Breaks))
+      return CurPtr + llvm::countTrailingZeros<unsigned>(Mask);
+    CurPtr += 16;
+  }
+#endif
+  while (*CurPtr != 0 && *CurPtr != '\n' && *CurPtr != '\r')
+    ++CurPtr;
+  return CurPtr;
+}
+
 bool Lexer::LexIdentifier(Token &Result, const char *CurPtr) {
   // Match [_A-Za-z0-9]*, we have already matched [_A-Za-z$]
   unsigned Size;
-  unsigned char C = *CurPtr++;
-  while (isIdentifierBody(C))
-    C = *CurPtr++;
-
-  --CurPtr;   // Back up over the skipped character.
+  CurPtr = skipIdentifierBody(CurPtr, BufferEnd);
+  unsigned char C = *CurPtr;
 
   // Fast path, no $,\,? in identifier found.  '\' might be an escaped newline
   // or UCN, and ? might be a trigraph for '\', an escaped newline or UCN.
@@ -2183,8 +2270,10 @@ bool Lexer::SkipWhitespace(Token &Result, const char *CurPtr,
   // Skip consecutive spaces efficiently.
   while (true) {
     // Skip horizontal whitespace very aggressively.
-    while (isHorizontalWhitespace(Char))
-      Char = *++CurPtr;
+    if (isHorizontalWhitespace(Char)) {
+      CurPtr = skipHorizontalWhitespace(CurPtr+1, BufferEnd);
+      Char = *CurPtr;
+    }
 
     // Otherwise if we have something other than whitespace, we're done.
     if (!isVerticalWhitespace(Char))
@@ -2252,11 +2341,10 @@ bool Lexer::SkipLineComment(Token &Result, const char *CurPtr,
   // character that ends the line comment.
   char C;
   while (true) {
+    // Skip over characters in the fast loop, stopping at the potential EOF or
+    // a newline.
+    CurPtr = findLineCommentBreak(CurPtr, BufferEnd);
     C = *CurPtr;
-    // Skip over characters in the fast loop.
-    while (C != 0 &&                // Potentially EOF.
-           C != '\n' && C != '\r')  // Newline or DOS-style newline.
-      C = *++CurPtr;
 
     const char *NextLine = CurPtr;
     if (C != 0) {
@@ -2459,13 +2547,6 @@ static bool isEndOfBlockCommentWithEscapedNewLine(const char *CurPtr,
   return true;
 }
 
-#ifdef __SSE2__
-#include <emmintrin.h>
-#elif __ALTIVEC__
-#include <altivec.h>
-#undef bool
-#endif
-
 /// We have just read from input the / and * characters that started a comment.
 /// Read until we find the * and / characters that terminate the comment.
 /// Note that we don't bother decoding trigraphs or escaped newlines in block
@@ -2637,6 +2718,229 @@ bool Lexer::SkipBlockComment(Token &Result, const char *CurPtr,
   return false;
 }
 
+/// isExcludedLineSpecialChar - Return true if the excluded line scan has to
+/// look at this character instead of skipping over it.
+static bool isExcludedLineSpecialChar(char C) {
+  switch (C) {
+  case '\n': case '\r': case '\0': case '\\':
+  case '/': case '"': case '\'': case '?':
+    return true;
+  default:
+    return false;
+  }
+}
+
+/// Return the first character at or after \p CurPtr that is special to the
+/// excluded line scan.  The buffer is known to be null terminated.
+static const char *findExcludedLineSpecialChar(const char *CurPtr,
+                                               const char *BufferEnd) {
+#ifdef __SSE2__
+  const __m128i NewLines = _mm_set1_epi8('\n');
+  const __m128i Returns = _mm_set1_epi8('\r');
+  const __m128i Nulls = _mm_setzero_si128();
+  const __m128i Backslashes = _mm_set1_epi8('\\');
+  const __m128i Slashes = _mm_set1_epi8('/');
+  const __m128i DoubleQuotes = _mm_set1_epi8('"');
+  const __m128i SingleQuotes = _mm_set1_epi8('\'');
+  const __m128i Questions = _mm_set1_epi8('?');
+  while (CurPtr+16 <= BufferEnd) {
+    __m128i Chars = _mm_loadu_si128((const __m128i*)CurPtr);
+    __m128i Cmp = _mm_or_si128(
+        _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(Chars, NewLines),
+                                  _mm_cmpeq_epi8(Chars, Returns)),
+                     _mm_or_si128(_mm_cmpeq_epi8(Chars, Nulls),
+                                  _mm_cmpeq_epi8(Chars, Backslashes))),
+        _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(Chars, Slashes),
+                                  _mm_cmpeq_epi8(Chars, DoubleQuotes)),
+                     _mm_or_si128(_mm_cmpeq_epi8(Chars, SingleQuotes),
+                                  _mm_cmpeq_epi8(Chars, Questions))));
+    if (int Mask = _mm_movemask_epi8(Cmp))
+      return CurPtr + llvm::countTrailingZeros<unsigned>(Mask);
+    CurPtr += 16;
+  }
+#endif
+  while (!isExcludedLineSpecialChar(*CurPtr))
+    ++CurPtr;
+  return CurPtr;
+}
+
+/// If \p CurPtr points to a backslash that starts an escaped newline, return
+/// the character after the newline.  Otherwise return null.
+static const char *skipEscapedNewLine(const char *CurPtr) {
+  assert(*CurPtr == '\\' && "not a backslash");
+  ++CurPtr;
+  while (isHorizontalWhitespace(*CurPtr))
+    ++CurPtr;
+  if (*CurPtr != '\n' && *CurPtr != '\r')
+    return nullptr;
+  // Handle \r\n and \n\r as a single newline.
+  if ((CurPtr[1] == '\n' || CurPtr[1] == '\r') && CurPtr[0] != CurPtr[1])
+    ++CurPtr;
+  return CurPtr + 1;
+}
+
+/// SkipExcludedLines - Quickly skip over the lines of an excluded conditional
+/// block that cannot start a preprocessor directive.  This follows the rules
+/// of the dependency directives minimizer: comments, string and character
+/// literals and escaped newlines are honored, and the scan stops at the start
+/// of the first line whose first token might be a '#' or anything else that
+/// the regular lexer has to look at, such as trigraphs or raw string literals.
+///
+/// The lexer is left at the start of a physical line, or unchanged if no
+/// complete line could be skipped.
+void Lexer::SkipExcludedLines() {
+  assert(isLexingRawMode() && !ParsingPreprocessorDirective &&
+         "Not skipping an excluded block?");
+  // The scan doesn't check for a code-completion point, and the traditional
+  // and assembler preprocessing modes lex literals and comments differently.
+  if ((PP && PP->getCodeCompletionFileLoc() == FileLoc) ||
+      LangOpts.TraditionalCPP || LangOpts.AsmPreprocessor)
+    return;
+
+  const char *CurPtr = BufferPtr;
+  // The start of the last physical line that begins outside of any comment,
+  // literal or escaped newline.  This is where the regular lexer resumes.
+  const char *LineStart = IsAtPhysicalStartOfLine ? CurPtr : nullptr;
+  // True if only whitespace and comments were seen on the current line.
+  bool AtLineStart = IsAtPhysicalStartOfLine;
+
+  while (true) {
+    if (AtLineStart) {
+      while (isHorizontalWhitespace(*CurPtr))
+        ++CurPtr;
+      // Stop at anything that might start a directive: '#', the '%:' digraph
+      // and the '??=' trigraph, or an escaped newline before one of them.
+      char C = *CurPtr;
+      if (C == '#' || C == '%' || C == '?' || C == '\\' || C == '\0')
+        break;
+    }
+
+    const char *Special = findExcludedLineSpecialChar(CurPtr, BufferEnd);
+    if (Special != CurPtr)
+      AtLineStart = false;
+    CurPtr = Special;
+    switch (*CurPtr) {
+    case '\n':
+    case '\r':
+      // Handle \r\n and \n\r as a single newline.
+      if ((CurPtr[1] == '\n' || CurPtr[1] == '\r') && CurPtr[0] != CurPtr[1])
+        ++CurPtr;
+      LineStart = ++CurPtr;
+      AtLineStart = true;
+      continue;
+    case '\\':
+      // An escaped newline continues the current line.
+      if (const char *Next = skipEscapedNewLine(CurPtr))
+        CurPtr = Next;
+      else
+        ++CurPtr;
+      AtLineStart = false;
+      continue;
+    case '?':
+      if (LangOpts.Trigraphs && CurPtr[1] == '?')
+        break;
+      ++CurPtr;
+      AtLineStart = false;
+      continue;
+    case '/':
+      if (CurPtr[1] == '/') {
+        // Even if line comments are disabled the lexer may treat this as one.
+        if (!LangOpts.LineComment)
+          break;
+        // Skip to the end of the line comment, which might be continued by an
+        // escaped newline.
+        CurPtr += 2;
+        while (true) {
+          CurPtr = findExcludedLineSpecialChar(CurPtr, BufferEnd);
+          if (*CurPtr == '\\') {
+            if (const char *Next = skipEscapedNewLine(CurPtr))
+              CurPtr = Next;
+            else
+              ++CurPtr;
+            continue;
+          }
+          if (*CurPtr == '\n' || *CurPtr == '\r' || *CurPtr == '\0' ||
+              (*CurPtr == '?' && LangOpts.Trigraphs))
+            break;
+          ++CurPtr;
+        }
+        if (*CurPtr != '\n' && *CurPtr != '\r')
+          break;
+        continue;
+      }
+      if (CurPtr[1] == '*') {
+        // Find the terminating '*' '/', starting after the degenerate '/' '*'
+        // '/' case.  A comment that might end with an escaped newline between
+        // the '*' and '/' is left to the regular lexer.
+        const char *End = CurPtr + 2;
+        while (true) {
+          End = End + 1 < BufferEnd
+                    ? static_cast<const char *>(
+                          memchr(End + 1, '/', BufferEnd - (End + 1)))
+                    : nullptr;
+          if (!End || End[-1] == '*' || End[-1] == '\n' || End[-1] == '\r')
+            break;
+        }
+        if (!End || End[-1] != '*')
+          break;
+        // The comment doesn't change whether we are at the start of a line.
+        CurPtr = End + 1;
+        continue;
+      }
+      ++CurPtr;
+      AtLineStart = false;
+      continue;
+    case '"':
+    case '\'': {
+      // Raw string literals, digit separators and encoding prefixes are left
+      // to the regular lexer.
+      char Quote = *CurPtr;
+      if (CurPtr != BufferStart &&
+          (Quote == '"' ? CurPtr[-1] == 'R'
+                        : isPreprocessingNumberBody(CurPtr[-1])))
+        break;
+      ++CurPtr;
+      while (true) {
+        CurPtr = findExcludedLineSpecialChar(CurPtr, BufferEnd);
+        if (*CurPtr == Quote || *CurPtr == '\n' || *CurPtr == '\r' ||
+            *CurPtr == '\0' || (*CurPtr == '?' && LangOpts.Trigraphs))
+          break;
+        if (*CurPtr == '\\') {
+          if (const char *Next = skipEscapedNewLine(CurPtr))
+            CurPtr = Next;
+          else if (CurPtr[1] != '\0')
+            CurPtr += 2;
+          else
+            break;
+          continue;
+        }
+        ++CurPtr;
+      }
+      // An unterminated literal ends at the end of the line in raw mode; let
+      // the regular lexer deal with it.
+      if (*CurPtr != Quote)
+        break;
+      ++CurPtr;
+      AtLineStart = false;
+      continue;
+    }
+    default:
+      // The end of the buffer or an embedded null.
+      assert(*CurPtr == '\0' && "unexpected special character");
+      break;
+    }
+    break;
+  }
+
+  if (!LineStart || LineStart == BufferPtr)
+    return;
+  BufferPtr = LineStart;
+  IsAtStartOfLine = true;
+  IsAtPhysicalStartOfLine = true;
+  HasLeadingSpace = false;
+  HasLeadingEmptyMacro = false;
+}
+
 //===----------------------------------------------------------------------===//
 // Primary Lexing Entry Points
 //===----------------------------------------------------------------------===//
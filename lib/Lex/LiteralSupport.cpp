@@ -1660,9 +1660,10 @@ void StringLiteralParser::init(ArrayRef<Token> StringToks){
         // Is this a span of non-escape characters?
         if (ThisTokBuf[0] != '\\') {
           const char *InStart = ThisTokBuf;
-          do {
-            ++ThisTokBuf;
-          } while (ThisTokBuf != ThisTokEnd && ThisTokBuf[0] != '\\');
+          ThisTokBuf = static_cast<const char *>(
+              memchr(ThisTokBuf, '\\', ThisTokEnd - ThisTokBuf));
+          if (!ThisTokBuf)
+            ThisTokBuf = ThisTokEnd;
 
           // Copy the character span over.
           if (CopyStringFragment(StringToks[i], ThisTokBegin,
@@ -1753,12 +1754,35 @@ static const char *resyncUTF8(const char *Err, const char *End) {
   return Err;
 }
 
+/// Returns true if \p Fragment only contains ASCII characters. This checks
+/// eight bytes at a time, since fragments can be large embedded sources.
+static bool isAllASCII(StringRef Fragment) {
+  const char *Ptr = Fragment.begin(), *End = Fragment.end();
+  for (; End - Ptr >= 8; Ptr += 8) {
+    uint64_t Word;
+    memcpy(&Word, Ptr, sizeof(Word));
+    if (Word & 0x8080808080808080ULL)
+      return false;
+  }
+  for (; Ptr != End; ++Ptr)
+    if (!isASCII(*Ptr))
+      return false;
+  return true;
+}
+
 /// This function copies from Fragment, which is a sequence of bytes
 /// within Tok's contents (which begin at TokBegin) into ResultPtr.
 /// Performs widening for multi-byte characters.
 bool StringLiteralParser::CopyStringFragment(const Token &Tok,
                                              const char *TokBegin,
                                              StringRef Fragment) {
+  // ASCII is valid UTF-8 and needs no widening in narrow strings.
+  if (CharByteWidth == 1 && isAllASCII(Fragment)) {
+    memcpy(ResultPtr, Fragment.data(), Fragment.size());
+    ResultPtr += Fragment.size();
+    return false;
+  }
+
   const llvm::UTF8 *ErrorPtrTmp;
   if (ConvertUTF8toWide(CharByteWidth, Fragment, ResultPtr, ErrorPtrTmp))
     return false;
@@ -174,6 +174,11 @@ const std::vector<Token> &MacroArgs::getPreExpArgument(unsigned Arg,
   const Token *AT = getUnexpArgument(Arg);
   unsigned NumToks = getArgLength(AT)+1;  // Include the EOF.
 
+  // The expansion is usually at least as long as the argument. The vector
+  // keeps its storage when this MacroArgs is put on the free list, so this
+  // rarely allocates.
+  Result.reserve(NumToks);
+
   // Otherwise, we have to pre-expand this argument, populating Result.  To do
   // this, we set up a fake TokenLexer to lex from the unexpanded argument
   // list.  With this installed, we lex expanded tokens until we hit the EOF
@@ -395,8 +395,15 @@ void Preprocessor::SkipExcludedConditionalBlock(SourceLocation HashTokenLoc,
   // disabling warnings, etc.
   CurPPLexer->LexingRawMode = true;
   Token Tok;
+  // Whether the lines that follow might be skipped by scanning the buffer
+  // instead of lexing every token.  This is retried at most once for each line
+  // that the fast scan hands back to the lexer.
+  bool TryFastSkip = true;
   while (true) {
+    if (TryFastSkip)
+      CurLexer->SkipExcludedLines();
     CurLexer->Lex(Tok);
+    TryFastSkip = Tok.isAtStartOfLine();
 
     if (Tok.is(tok::code_completion)) {
       if (CodeComplete)
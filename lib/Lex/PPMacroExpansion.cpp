@@ -510,6 +510,9 @@ bool Preprocessor::HandleMacroExpandedIdentifier(Token &Identifier,
     ++NumMacroExpanded;
   }
 
+  if (PPOpts->MacroExpansionStats)
+    ++MacroExpansionCounts[Identifier.getIdentifierInfo()];
+
   // Notice that this macro has been used.
   markMacroAsUsed(MI);
 
@@ -297,6 +297,22 @@ void Preprocessor::PrintStats() {
                << llvm::capacity_in_bytes(CommentHandlers) << "\n";
 }
 
+void Preprocessor::PrintMacroExpansionStats() {
+  using MacroCount = std::pair<const IdentifierInfo *, unsigned>;
+  std::vector<MacroCount> Counts(MacroExpansionCounts.begin(),
+                                 MacroExpansionCounts.end());
+  llvm::sort(Counts, [](const MacroCount &LHS, const MacroCount &RHS) {
+    if (LHS.second != RHS.second)
+      return LHS.second > RHS.second;
+    return LHS.first->getName() < RHS.first->getName();
+  });
+
+  llvm::errs() << "\n*** Macro Expansion Stats:\n";
+  for (const auto &Count : Counts)
+    llvm::errs() << "  " << Count.second << "\t" << Count.first->getName()
+                 << "\n";
+}
+
 Preprocessor::macro_iterator
 Preprocessor::macro_begin(bool IncludeExternalMacros) const {
   if (IncludeExternalMacros && ExternalSource &&
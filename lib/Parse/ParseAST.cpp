@@ -116,6 +116,7 @@ void clang::ParseAST(Sema &S, bool PrintStats, bool SkipFunctionBodies) {
   if (PrintStats) {
     Decl::EnableStatistics();
     Stmt::EnableStatistics();
+    S.getASTContext().CollectTypeLookupStats = true;
   }
 
   // Also turn on collection of stats inside of the Sema object.
@@ -18,6 +18,14 @@
 #include "clang/Sema/Scope.h"
 using namespace clang;
 
+/// Returns true if \p D has attributes that were written by the user. Implicit
+/// ones, like the Cheerp section attributes that Sema adds to every function
+/// and record, don't affect whether a body can be parsed late.
+static bool hasExplicitAttrs(const Decl *D) {
+  return llvm::any_of(D->attrs(),
+                      [](const Attr *A) { return !A->isImplicit(); });
+}
+
 /// ParseCXXInlineMethodDef - We parsed and verified that the specified
 /// Declarator is a well formed C++ inline method definition. Now lex its body
 /// and store its tokens for parsing after the C++ class is complete.
@@ -129,6 +137,30 @@ NamedDecl *Parser::ParseCXXInlineMethodDef(
     return FnD;
   }
 
+  // In delayed inline method parsing mode, consume the body of an ordinary
+  // inline member function and only parse it at the end of the translation
+  // unit if it is used. Bodies that may be needed before then, or whose
+  // definition must be emitted even if unused, are parsed as usual.
+  if (getLangOpts().DelayedInlineMethodParsing && FnD &&
+      isa<CXXMethodDecl>(FnD) &&
+      D.getFunctionDefinitionKind() == FDK_Definition &&
+      !D.getDeclSpec().hasConstexprSpecifier() &&
+      !hasExplicitAttrs(FnD) &&
+      !hasExplicitAttrs(cast<CXXMethodDecl>(FnD)->getParent()) &&
+      !cast<CXXMethodDecl>(FnD)->getReturnType()->getContainedAutoType() &&
+      !Actions.CurContext->isDependentContext() &&
+      !FnD->getParentFunctionOrMethod() &&
+      Actions.TUKind == TU_Complete && !getLangOpts().Modules &&
+      !PP.isCodeCompletionEnabled() && !PP.isIncrementalProcessingEnabled()) {
+    CachedTokens Toks;
+    LexTemplateFunctionForLateParsing(Toks);
+
+    auto *FD = cast<CXXMethodDecl>(FnD);
+    Actions.CheckForFunctionRedefinition(FD);
+    Actions.MarkAsLateParsedTemplate(FD, FnD, Toks);
+    return FnD;
+  }
+
   // Consume the tokens and store them for later parsing.
 
   LexedMethod* LM = new LexedMethod(this, FnD);
@@ -647,7 +647,8 @@ bool Parser::ParseTopLevelDecl(DeclGroupPtrTy &Result, bool IsFirstDecl) {
 
   case tok::eof:
     // Late template parsing can begin.
-    if (getLangOpts().DelayedTemplateParsing)
+    if (getLangOpts().DelayedTemplateParsing ||
+        getLangOpts().DelayedInlineMethodParsing)
       Actions.SetLateTemplateParser(LateTemplateParserCallback,
                                     PP.isIncrementalProcessingEnabled() ?
                                     LateTemplateParserCleanupCallback : nullptr,
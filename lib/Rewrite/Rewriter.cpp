@@ -29,6 +29,7 @@
 #include <iterator>
 #include <map>
 #include <memory>
+#include <string>
 #include <system_error>
 #include <utility>
 
@@ -125,6 +126,38 @@ void RewriteBuffer::ReplaceText(unsigned OrigOffset, unsigned OrigLength,
     AddReplaceDelta(OrigOffset, NewStr.size() - OrigLength);
 }
 
+void RewriteBuffer::ReplaceTexts(ArrayRef<TextEdit> Edits) {
+  if (Edits.empty())
+    return;
+
+  // Flatten the current contents. The offsets of the edits are all mapped
+  // against them before any delta from this batch is added, which is why the
+  // edits have to be sorted and disjoint.
+  std::string Old;
+  Old.reserve(Buffer.size());
+  for (RopePieceBTreeIterator I = begin(), E = end(); I != E;
+       I.MoveToNextPiece())
+    Old.append(I.piece().data(), I.piece().size());
+
+  std::string New;
+  New.reserve(Old.size());
+  unsigned Cursor = 0;
+  for (const TextEdit &Edit : Edits) {
+    unsigned RealOffset = getMappedOffset(Edit.OrigOffset, true);
+    assert(RealOffset >= Cursor && "Edits must be sorted and disjoint");
+    assert(RealOffset + Edit.OrigLength <= Old.size() && "Invalid location");
+    New.append(Old, Cursor, RealOffset - Cursor);
+    New.append(Edit.NewStr.data(), Edit.NewStr.size());
+    Cursor = RealOffset + Edit.OrigLength;
+  }
+  New.append(Old, Cursor, std::string::npos);
+  Buffer.assign(New.data(), New.data() + New.size());
+
+  for (const TextEdit &Edit : Edits)
+    if (Edit.OrigLength != Edit.NewStr.size())
+      AddReplaceDelta(Edit.OrigOffset, Edit.NewStr.size() - Edit.OrigLength);
+}
+
 //===----------------------------------------------------------------------===//
 // Rewriter class
 //===----------------------------------------------------------------------===//
@@ -907,6 +907,14 @@ void Sema::ActOnEndOfTranslationUnitFragment(TUFragmentKind Kind) {
     PerformPendingInstantiations();
   }
 
+  // Parse the delayed inline methods that turned out to be used. Their bodies
+  // can use more vtables and templates, which can use more inline methods.
+  while (LateTemplateParser && !UsedLateParsedInlineMethods.empty()) {
+    ParseUsedLateParsedInlineMethods();
+    DefineUsedVTables();
+    PerformPendingInstantiations();
+  }
+
   assert(LateParsedInstantiations.empty() &&
          "end of TU template instantiation should not create more "
          "late-parsed templates");
@@ -940,6 +948,16 @@ void Sema::ActOnEndOfTranslationUnit() {
 
     CheckDelayedMemberExceptionSpecs();
   } else {
+    // Optionally perform the pending instantiations now, so that they are
+    // serialized with the PCH instead of being repeated by every translation
+    // unit that uses it. Instantiations of late-parsed templates are
+    // postponed again and are transferred below.
+    if (LangOpts.PCHInstantiateTemplates) {
+      llvm::TimeTraceScope TimeScope("PerformPendingInstantiations",
+                                     StringRef(""));
+      PerformPendingInstantiations();
+    }
+
     // If we are building a TU prefix for serialization, it is safe to transfer
     // these over, even though they are not parsed. The end of the TU should be
     // outside of any eager template instantiation scope, so when this AST is
@@ -1263,8 +1281,19 @@ void Sema::EmitCurrentDiagnostic(unsigned DiagID) {
   // issue I am not seeing yet), then there should at least be a clarifying
   // comment somewhere.
   if (Optional<TemplateDeductionInfo*> Info = isSFINAEContext()) {
-    switch (DiagnosticIDs::getDiagnosticSFINAEResponse(
-              Diags.getCurrentDiagID())) {
+    DiagnosticIDs::SFINAEResponse Response =
+        DiagnosticIDs::getDiagnosticSFINAEResponse(Diags.getCurrentDiagID());
+
+    // A suppressed warning is only kept so that it can be replayed if the
+    // specialization is used. Don't copy one that would be ignored at its
+    // location anyway, nor the notes that follow it.
+    if (!DiagnosticIDs::isBuiltinNote(Diags.getCurrentDiagID()))
+      LastSuppressedDiagnosticIgnored =
+          Response == DiagnosticIDs::SFINAE_Suppress &&
+          Diags.isIgnored(Diags.getCurrentDiagID(),
+                          Diags.getCurrentDiagLoc());
+
+    switch (Response) {
     case DiagnosticIDs::SFINAE_Report:
       // We'll report the diagnostic below.
       break;
@@ -1323,7 +1352,7 @@ void Sema::EmitCurrentDiagnostic(unsigned DiagID) {
     case DiagnosticIDs::SFINAE_Suppress:
       // Make a copy of this suppressed diagnostic and store it with the
       // template-deduction information;
-      if (*Info) {
+      if (*Info && !LastSuppressedDiagnosticIgnored) {
         Diagnostic DiagInfo(&Diags);
         (*Info)->addSuppressedDiagnostic(DiagInfo.getLocation(),
                        PartialDiagnostic(DiagInfo, Context.getDiagAllocator()));
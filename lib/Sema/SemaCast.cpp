@@ -883,6 +883,14 @@ void CastOperation::CheckDynamicCast() {
     return;
   }
 
+  // Cheerp: A cast to a final class is emitted as a comparison with its
+  // vtable, so the vtable has to be emitted as well.
+  if (DestRecord && !Self.getASTContext().getTargetInfo().isByteAddressable()) {
+    CXXRecordDecl *DestDecl = cast<CXXRecordDecl>(DestRecord->getDecl());
+    if (DestDecl->hasAttr<FinalAttr>())
+      Self.MarkVTableUsed(OpRange.getBegin(), DestDecl);
+  }
+
   // Done. Everything else is run-time checks.
   Kind = CK_Dynamic;
 }
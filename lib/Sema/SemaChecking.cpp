@@ -396,6 +396,11 @@ void Sema::checkFortifiedBuiltinMemoryFunction(FunctionDecl *FD,
   }
   }
 
+  // Evaluating the sizes is the expensive part of this check, so skip it if
+  // the warning would be ignored anyway, as it is in system headers.
+  if (Diags.isIgnored(DiagID, TheCall->getBeginLoc()))
+    return;
+
   llvm::APSInt ObjectSize;
   // For __builtin___*_chk, the object size is explicitly provided by the caller
   // (usually using __builtin_object_size). Use that value to check this call.
@@ -10768,6 +10773,10 @@ static bool AnalyzeBitFieldAssignment(Sema &S, FieldDecl *Bitfield, Expr *Init,
   if (FieldWidth == 1 && Value == 1)
     return false;
 
+  if (S.Diags.isIgnored(diag::warn_impcast_bitfield_precision_constant,
+                        InitLoc))
+    return true;
+
   std::string PrettyValue = Value.toString(10);
   std::string PrettyTrunc = TruncatedValue.toString(10);
 
@@ -10897,6 +10906,10 @@ static void DiagnoseFloatingImpCast(Sema &S, Expr *E, QualType T,
     DiagID = diag::warn_impcast_float_to_integer;
   }
 
+  // Don't print the values if the warning is ignored here.
+  if (S.Diags.isIgnored(DiagID, E->getExprLoc()))
+    return;
+
   // FIXME: Force the precision of the source value down so we don't print
   // digits which are usually useless (we don't really care here if we
   // truncate a digit by accident in edge cases).  Ideally, APFloat::toString
@@ -11456,7 +11469,9 @@ CheckImplicitConversion(Sema &S, Expr *E, QualType T, SourceLocation CC,
       llvm::APSInt Value(32);
       Value = Result.Val.getInt();
 
-      if (S.SourceMgr.isInSystemMacro(CC))
+      if (S.SourceMgr.isInSystemMacro(CC) ||
+          S.Diags.isIgnored(diag::warn_impcast_integer_precision_constant,
+                            E->getExprLoc()))
         return;
 
       std::string PrettySourceValue = Value.toString(10);
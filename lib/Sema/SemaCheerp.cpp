@@ -17,6 +17,7 @@
 #include "clang/AST/Decl.h"
 #include "clang/AST/DeclBase.h"
 #include "llvm/Cheerp/ForbiddenIdentifiers.h"
+#include "llvm/Support/TimeProfiler.h"
 #include <string>
 #include <unordered_map>
 
@@ -74,6 +75,53 @@ void cheerp::checkCouldBeJsExported(const clang::CXXRecordDecl* Record, clang::S
 	checkDestructor(Record, sema, shouldContinue);
 }
 
+void cheerp::checkCouldBeStructOfArrays(const clang::CXXRecordDecl* Record, clang::Sema& sema)
+{
+	using namespace clang;
+
+	if (Record->isDynamicClass())
+		sema.Diag(Record->getLocation(), diag::err_cheerp_attribute_on_virtual_class) << Record->getAttr<StructOfArraysAttr>();
+
+	if (Record->getNumBases())
+		sema.Diag(Record->getLocation(), diag::err_cheerp_soa_inheritance);
+
+	//Every field is stored in its own typed array
+	for (const FieldDecl* field : Record->fields())
+	{
+		if (!field->getType()->isArithmeticType() || field->isBitField())
+			sema.Diag(field->getLocation(), diag::err_cheerp_soa_field) << field->getType();
+	}
+}
+
+void cheerp::checkCouldBeJsExportBatched(const clang::FunctionDecl* FD, clang::Sema& sema)
+{
+	using namespace clang;
+
+	if (!FD->hasAttr<JsExportAttr>())
+		sema.Diag(FD->getLocation(), diag::err_cheerp_jsexport_batch_requires_jsexport);
+
+	//Nothing can be returned from a batch of calls
+	if (!FD->getReturnType()->isVoidType())
+		sema.Diag(FD->getLocation(), diag::err_cheerp_jsexport_batch_return);
+
+	//The arguments of each call are read from a typed array of tuples
+	for (auto it : FD->parameters())
+	{
+		switch (classifyType(it->getOriginalType(), sema))
+		{
+			case TypeKind::Boolean:
+			case TypeKind::IntLess32Bit:
+			case TypeKind::UnsignedInt32Bit:
+			case TypeKind::SignedInt32Bit:
+			case TypeKind::FloatingPoint:
+				break;
+			default:
+				sema.Diag(it->getLocation(), diag::err_cheerp_jsexport_batch_param) << it->getOriginalType();
+				break;
+		}
+	}
+}
+
 void cheerp::checkParameters(const clang::FunctionDecl* FD, clang::Sema& sema)
 {
 	for (auto it : FD->parameters())
@@ -255,6 +303,11 @@ void cheerp::checkCouldReturnBeJsExported(const clang::QualType& Ty, const clang
 }
 
 cheerp::TypeKind cheerp::classifyType(const clang::QualType& Qy, const clang::Sema& sema)
+{
+	return sema.cheerpSemaData.classifyType(Qy);
+}
+
+static cheerp::TypeKind computeTypeKind(const clang::QualType& Qy, const clang::Sema& sema)
 {
 	const clang::QualType& Desugared = Qy.getDesugaredType(sema.Context);
 	const clang::Type* Ty = Desugared.getTypePtr();
@@ -318,6 +371,20 @@ cheerp::TypeKind cheerp::classifyType(const clang::QualType& Qy, const clang::Se
 	return TypeKind::Other;
 }
 
+cheerp::TypeKind cheerp::CheerpSemaData::classifyType(const clang::QualType& Qy) const
+{
+	const clang::Type* Canonical = sema.Context.getCanonicalType(Qy).getTypePtr();
+	auto it = typeKinds.find(Canonical);
+	if (it != typeKinds.end())
+		return it->second;
+
+	const TypeKind kind = computeTypeKind(Qy, sema);
+	//Incomplete types may still become jsexportable once defined
+	if (!Canonical->isIncompleteType())
+		typeKinds.insert({Canonical, kind});
+	return kind;
+}
+
 void cheerp::checkFunction(clang::FunctionDecl* FD, clang::Sema& sema)
 {
 	sema.cheerpSemaData.addFunction(FD);
@@ -337,6 +404,9 @@ void cheerp::CheerpSemaData::addFunction(clang::FunctionDecl* FD)
 	{
 		checkFunctionToBeJsExported(FD, /*isMethod*/false);
 	}
+
+	if (FD->hasAttr<JsExportBatchAttr>())
+		checkCouldBeJsExportBatched(FD, sema);
 }
 
 bool cheerp::isTemplate(const clang::FunctionDecl* FD)
@@ -384,14 +454,14 @@ void cheerp::CheerpSemaData::checkFunctionToBeJsExported(const clang::FunctionDe
 void cheerp::CheerpSemaData::checkTopLevelName(const clang::NamedDecl* ND)
 {
 	using namespace clang;
-	const auto& name = ND->getName();
 	auto context = getCanonicalContext(ND);
 
-	const auto pair = namedDecl.emplace(std::pair<const clang::DeclContext*, std::string>(context, name), ND);
+	//Identifiers are uniqued, so the pointer is enough to compare the names
+	const auto pair = namedDecl.insert({std::make_pair(context, ND->getIdentifier()), ND});
 
 	if (!pair.second && pair.first->second->getCanonicalDecl() != ND->getCanonicalDecl())
 	{
-		sema.Diag(ND->getLocation(), diag::err_cheerp_jsexport_same_name_top_level) << name;
+		sema.Diag(ND->getLocation(), diag::err_cheerp_jsexport_same_name_top_level) << ND->getName();
 		sema.Diag(pair.first->second->getLocation(), diag::note_previous_definition);
 	}
 }
@@ -415,6 +485,10 @@ void cheerp::CheerpSemaData::addMethod(clang::CXXMethodDecl* method, const bool
 
 void cheerp::CheerpSemaData::checkRecord(const clang::CXXRecordDecl* record)
 {
+	llvm::TimeTraceScope TimeScope("CheerpCheckRecord", [&]() {
+		return record->getQualifiedNameAsString();
+	});
+
 	checkTopLevelName(record);
 	//Here all checks about external feasibility of jsexporting a class/struct have to be performed (eg. checking for name clashes against other functions)
 	checkName(record, record->getName(), sema);
@@ -6708,6 +6708,26 @@ static void handleJsExportAttr(Sema &S, Decl *D, const ParsedAttr &Attr) {
     S.Diag(Attr.getLoc(), diag::err_cheerp_jsexport_ignored);
 }
 
+static void handleLazyInitAttr(Sema &S, Decl *D, const ParsedAttr &Attr) {
+  // The initialization is done on the uses of the variable, so all of them
+  // must be in this translation unit
+  const auto *VD = cast<VarDecl>(D);
+  if (!VD->isFileVarDecl() || VD->isStaticDataMember() || VD->getTLSKind() ||
+      VD->isExternallyVisible()) {
+    S.Diag(Attr.getLoc(), diag::err_cheerp_lazy_init_not_internal_global);
+    return;
+  }
+  handleSimpleAttribute<LazyInitAttr>(S, D, Attr);
+}
+
+static void handleJsExportBatchAttr(Sema &S, Decl *D, const ParsedAttr &Attr) {
+  if (!isa<FunctionDecl>(D) || isa<CXXMethodDecl>(D)) {
+    S.Diag(Attr.getLoc(), diag::err_cheerp_jsexport_batch_not_free_function);
+    return;
+  }
+  handleSimpleAttribute<JsExportBatchAttr>(S, D, Attr);
+}
+
 static void handleAsmJSAttr(Sema &S, Decl *D, const ParsedAttr &Attr) {
   if (isa<CXXRecordDecl>(D)) {
     if (checkAttrMutualExclusion<JsExportAttr>(S, D, Attr))
@@ -6722,6 +6742,15 @@ static void handleGenericJSAttr(Sema &S, Decl *D, const ParsedAttr &Attr) {
   handleSimpleAttributeWithExclusions<GenericJSAttr, AsmJSAttr, ByteLayoutAttr>(S, D, Attr);
 }
 
+static void handleLazyAttr(Sema &S, Decl *D, const ParsedAttr &Attr) {
+  if (!isa<FunctionDecl>(D)) {
+    S.Diag(Attr.getLoc(), diag::err_cheerp_attribute_not_on_function);
+    return;
+  }
+  // Only linear memory code is split into separate modules
+  handleSimpleAttributeWithExclusions<LazyAttr, GenericJSAttr>(S, D, Attr);
+}
+
 static void handleByteLayoutAttr(Sema &S, Decl *D, const ParsedAttr &Attr) {
   if (!isa<RecordDecl>(D)) {
     S.Diag(Attr.getLoc(), diag::warn_attribute_ignored) << Attr.getName();
@@ -6730,6 +6759,33 @@ static void handleByteLayoutAttr(Sema &S, Decl *D, const ParsedAttr &Attr) {
   handleSimpleAttributeWithExclusions<ByteLayoutAttr, JsExportAttr>(S, D, Attr);
 }
 
+static void handleStructOfArraysAttr(Sema &S, Decl *D, const ParsedAttr &Attr) {
+  if (!isa<RecordDecl>(D)) {
+    S.Diag(Attr.getLoc(), diag::warn_attribute_ignored) << Attr.getName();
+    return;
+  }
+  // Only genericjs records are laid out as JS objects
+  handleSimpleAttributeWithExclusions<StructOfArraysAttr, AsmJSAttr, ByteLayoutAttr, JsExportAttr>(S, D, Attr);
+}
+
+static void handlePooledAttr(Sema &S, Decl *D, const ParsedAttr &Attr) {
+  if (!isa<CXXRecordDecl>(D)) {
+    S.Diag(Attr.getLoc(), diag::warn_attribute_ignored) << Attr.getName();
+    return;
+  }
+  // Objects in the linear memory are already recycled by malloc
+  handleSimpleAttributeWithExclusions<PooledAttr, AsmJSAttr, ByteLayoutAttr>(S, D, Attr);
+}
+
+static void handleCompleteObjectAttr(Sema &S, Decl *D, const ParsedAttr &Attr) {
+  const auto *PD = dyn_cast<ParmVarDecl>(D);
+  if (!PD || !PD->getType()->isPointerType()) {
+    S.Diag(Attr.getLoc(), diag::warn_attribute_ignored) << Attr.getName();
+    return;
+  }
+  handleSimpleAttribute<CompleteObjectAttr>(S, D, Attr);
+}
+
 static void handleDefaultNewAttr(Sema &S, Decl *D, const ParsedAttr &Attr) {
   D->addAttr(::new (S.Context) DefaultNewAttr(Attr.getRange(), S.Context, Attr.getAttributeSpellingListIndex()));
 }
@@ -7517,15 +7573,33 @@ static void ProcessDeclAttribute(Sema &S, Scope *scope, Decl *D,
     checkCheerpUnprefixedDeprecations(S, AL);
     handleJsExportAttr(S, D, AL);
     break;
+  case ParsedAttr::AT_LazyInit:
+    handleLazyInitAttr(S, D, AL);
+    break;
+  case ParsedAttr::AT_JsExportBatch:
+    handleJsExportBatchAttr(S, D, AL);
+    break;
   case ParsedAttr::AT_AsmJS:
     handleAsmJSAttr(S, D, AL);
     break;
   case ParsedAttr::AT_GenericJS:
     handleGenericJSAttr(S, D, AL);
     break;
+  case ParsedAttr::AT_Lazy:
+    handleLazyAttr(S, D, AL);
+    break;
   case ParsedAttr::AT_ByteLayout:
     handleByteLayoutAttr(S, D, AL);
     break;
+  case ParsedAttr::AT_StructOfArrays:
+    handleStructOfArraysAttr(S, D, AL);
+    break;
+  case ParsedAttr::AT_Pooled:
+    handlePooledAttr(S, D, AL);
+    break;
+  case ParsedAttr::AT_CompleteObject:
+    handleCompleteObjectAttr(S, D, AL);
+    break;
   case ParsedAttr::AT_DefaultNew:
     handleDefaultNewAttr(S, D, AL);
     break;
@@ -7798,6 +7872,21 @@ void Sema::MaybeInjectCheerpModeAttr(Decl* D) {
   }
 }
 
+/// Diagnose [[cheerp::lazy]] on a function that ends up in genericjs code,
+/// which is only known once the implicit asmjs/genericjs attribute is there.
+static void checkCheerpLazyAttr(Sema &S, Decl *D) {
+  const LazyAttr *Lazy = D->getAttr<LazyAttr>();
+  const GenericJSAttr *GenericJS = D->getAttr<GenericJSAttr>();
+  if (!Lazy || !GenericJS)
+    return;
+  if (GenericJS->isImplicit())
+    S.Diag(Lazy->getLocation(), diag::warn_cheerp_lazy_genericjs);
+  else
+    S.Diag(Lazy->getLocation(), diag::err_attributes_are_not_compatible)
+        << Lazy << GenericJS;
+  D->dropAttr<LazyAttr>();
+}
+
 /// ProcessDeclAttributes - Given a declarator (PD) with attributes indicated in
 /// it, apply them to D.  This is a bit tricky because PD can have attributes
 /// specified in many different places, and we need to find and apply them all.
@@ -7822,6 +7911,7 @@ void Sema::ProcessDeclAttributes(Scope *S, Decl *D, const Declarator &PD) {
 
   // CHEERP: Inject asmjs/genericjs attribute if required
   MaybeInjectCheerpModeAttr(D);
+  checkCheerpLazyAttr(*this, D);
 }
 
 /// Is the given declaration allowed to use a forbidden type?
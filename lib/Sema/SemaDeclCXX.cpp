@@ -6439,6 +6439,10 @@ void Sema::CheckCompletedCXXClass(CXXRecordDecl *Record) {
     MarkVTableUsed(Record->getInnerLocStart(), Record);
   }
 
+  //Verify that every field can be stored in a typed array
+  if (Record->hasAttr<StructOfArraysAttr>())
+    cheerp::checkCouldBeStructOfArrays(Record, *this);
+
   //Verify that this object is simple enough to have JS layout
   if (Record->hasAttr<JsExportAttr>())
   {
@@ -15311,6 +15311,11 @@ void Sema::MarkFunctionReferenced(SourceLocation Loc, FunctionDecl *Func,
         MarkVTableUsed(Loc, MethodDecl->getParent());
     }
 
+    // Inline methods whose parsing was delayed are parsed at the end of the
+    // translation unit once they are used.
+    if (Func->isLateTemplateParsed() && !Func->isDependentContext())
+      UsedLateParsedInlineMethods.insert(Func);
+
     // Implicit instantiation of function templates and member functions of
     // class templates.
     if (Func->isImplicitlyInstantiable()) {
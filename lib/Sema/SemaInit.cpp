@@ -1467,6 +1467,21 @@ void InitListChecker::CheckScalarType(const InitializedEntity &Entity,
     return;
   }
 
+  // An arithmetic prvalue of exactly the initialized type needs no
+  // conversion, so don't build an initialization sequence for it. This
+  // dominates the cost of checking very large tables of literals.
+  if (expr->isRValue() && DeclType->isArithmeticType() &&
+      SemaRef.Context.hasSameUnqualifiedType(expr->getType(), DeclType)) {
+    if (!VerifyOnly) {
+      if (hadError)
+        ++StructuredIndex;
+      else
+        UpdateStructuredListElement(StructuredList, StructuredIndex, expr);
+    }
+    ++Index;
+    return;
+  }
+
   if (VerifyOnly) {
     if (!SemaRef.CanPerformCopyInitialization(Entity,expr))
       hadError = true;
@@ -1989,6 +1989,12 @@ static bool LookupQualifiedNameInUsingDirectives(Sema &S, LookupResult &R,
       Queue.push_back(ND);
   }
 
+  // Most namespaces nominate nothing, and lookups that fail in them are
+  // common (e.g. when probing for members in SFINAE contexts); don't set up
+  // the local result for them.
+  if (Queue.empty())
+    return false;
+
   // The easiest way to implement the restriction in [namespace.qual]p5
   // is to check whether any of the individual results found a tag
   // and, if so, to declare an ambiguity if the final result is not
@@ -6050,9 +6050,11 @@ void Sema::AddOverloadCandidate(
   EnterExpressionEvaluationContext Unevaluated(
       *this, Sema::ExpressionEvaluationContext::Unevaluated);
 
-  // Add this candidate
+  // Add this candidate. Its conversion sequences are allocated once it has
+  // passed the arity checks; a candidate rejected before that never looks at
+  // them, and rejecting on arity is common in large overload sets.
   OverloadCandidate &Candidate =
-      CandidateSet.addCandidate(Args.size(), EarlyConversions);
+      CandidateSet.addCandidate(EarlyConversions.size(), EarlyConversions);
   Candidate.FoundDecl = FoundDecl;
   Candidate.Function = Function;
   Candidate.Viable = true;
@@ -6139,6 +6141,10 @@ void Sema::AddOverloadCandidate(
     return;
   }
 
+  if (Candidate.Conversions.empty())
+    Candidate.Conversions =
+        CandidateSet.allocateConversionSequences(Args.size());
+
   // (CUDA B.1): Check for invalid calls between targets.
   if (getLangOpts().CUDA)
     if (const FunctionDecl *Caller = dyn_cast<FunctionDecl>(CurContext))
@@ -6600,9 +6606,10 @@ Sema::AddMethodCandidate(CXXMethodDecl *Method, DeclAccessPair FoundDecl,
   EnterExpressionEvaluationContext Unevaluated(
       *this, Sema::ExpressionEvaluationContext::Unevaluated);
 
-  // Add this candidate
+  // Add this candidate. As in AddOverloadCandidate, its conversion sequences
+  // are allocated once it has passed the arity checks.
   OverloadCandidate &Candidate =
-      CandidateSet.addCandidate(Args.size() + 1, EarlyConversions);
+      CandidateSet.addCandidate(EarlyConversions.size(), EarlyConversions);
   Candidate.FoundDecl = FoundDecl;
   Candidate.Function = Method;
   Candidate.IsSurrogate = false;
@@ -6634,6 +6641,10 @@ Sema::AddMethodCandidate(CXXMethodDecl *Method, DeclAccessPair FoundDecl,
     return;
   }
 
+  if (Candidate.Conversions.empty())
+    Candidate.Conversions =
+        CandidateSet.allocateConversionSequences(Args.size() + 1);
+
   Candidate.Viable = true;
 
   if (Method->isStatic() || ObjectType.isNull())
@@ -12,7 +12,9 @@
 
 #include "clang/Sema/SemaInternal.h"
 #include "clang/AST/ASTContext.h"
+#include "clang/AST/ExprCXX.h"
 #include "clang/Basic/SourceManager.h"
+#include "clang/Basic/TargetInfo.h"
 #include "clang/Sema/DelayedDiagnostic.h"
 #include "clang/Sema/Lookup.h"
 #include "clang/Sema/ScopeInfo.h"
@@ -51,6 +53,58 @@ static Attr *handleFallThroughAttr(Sema &S, Stmt *St, const ParsedAttr &A,
   return ::new (S.Context) auto(Attr);
 }
 
+static Attr *handleMustTailAttr(Sema &S, Stmt *St, const ParsedAttr &A,
+                                SourceRange Range) {
+  ReturnStmt *R = dyn_cast<ReturnStmt>(St);
+  if (!R) {
+    S.Diag(A.getLoc(), diag::err_musttail_needs_return) << A.getName();
+    return nullptr;
+  }
+  // The call must be the whole return value, without conversions or
+  // temporaries to destroy after it
+  const CallExpr *CE =
+      R->getRetValue() ? dyn_cast<CallExpr>(R->getRetValue()->IgnoreParens())
+                       : nullptr;
+  if (!CE) {
+    S.Diag(A.getLoc(), diag::err_musttail_needs_call) << A.getName();
+    return nullptr;
+  }
+  const FunctionDecl *Caller = S.getCurFunctionDecl();
+  const auto *CallerMethod = dyn_cast_or_null<CXXMethodDecl>(Caller);
+  const auto *CalleeMethod = dyn_cast_or_null<CXXMethodDecl>(CE->getCalleeDecl());
+  if (isa<CXXMemberCallExpr>(CE) ||
+      (CallerMethod && CallerMethod->isInstance()) ||
+      (CalleeMethod && CalleeMethod->isInstance())) {
+    S.Diag(A.getLoc(), diag::err_musttail_member_call) << A.getName();
+    return nullptr;
+  }
+  if (!Caller || !CE->getCallee()->getType()->isFunctionPointerType()) {
+    S.Diag(A.getLoc(), diag::err_musttail_needs_call) << A.getName();
+    return nullptr;
+  }
+  QualType CalleeTy = CE->getCallee()->getType();
+  if (const PointerType *PT = CalleeTy->getAs<PointerType>())
+    CalleeTy = PT->getPointeeType();
+  if (!S.Context.hasSameType(Caller->getType(), CalleeTy)) {
+    S.Diag(A.getLoc(), diag::err_musttail_mismatch) << A.getName();
+    return nullptr;
+  }
+  // Cheerp: tail calls are only guaranteed by wasm return_call
+  if (S.Context.getTargetInfo().getTriple().getArch() == llvm::Triple::cheerp) {
+    if (!Caller->hasAttr<AsmJSAttr>()) {
+      S.Diag(A.getLoc(), diag::err_cheerp_musttail_genericjs) << A.getName();
+      return nullptr;
+    }
+    if (S.getLangOpts().getCheerpLinearOutput() != LangOptions::CHEERP_LINEAR_OUTPUT_Wasm ||
+        !S.getLangOpts().CheerpWasmReturnCalls) {
+      S.Diag(A.getLoc(), diag::err_cheerp_musttail_no_return_calls) << A.getName();
+      return nullptr;
+    }
+  }
+  return ::new (S.Context) MustTailAttr(A.getRange(), S.Context,
+                                        A.getAttributeSpellingListIndex());
+}
+
 static Attr *handleSuppressAttr(Sema &S, Stmt *St, const ParsedAttr &A,
                                 SourceRange Range) {
   if (A.getNumArgs() < 1) {
@@ -336,6 +390,8 @@ static Attr *ProcessStmtAttribute(Sema &S, Stmt *St, const ParsedAttr &A,
     return handleFallThroughAttr(S, St, A, Range);
   case ParsedAttr::AT_LoopHint:
     return handleLoopHintAttr(S, St, A, Range);
+  case ParsedAttr::AT_MustTail:
+    return handleMustTailAttr(S, St, A, Range);
   case ParsedAttr::AT_OpenCLUnrollHint:
     return handleOpenCLUnrollHint(S, St, A, Range);
   case ParsedAttr::AT_Suppress:
@@ -10305,6 +10305,23 @@ void Sema::UnmarkAsLateParsedTemplate(FunctionDecl *FD) {
   FD->setLateTemplateParsed(false);
 }
 
+void Sema::ParseUsedLateParsedInlineMethods() {
+  // Parsing a body can use more inline methods, which are appended to the
+  // set while it is being walked.
+  for (unsigned I = 0; I != UsedLateParsedInlineMethods.size(); ++I) {
+    FunctionDecl *FD = UsedLateParsedInlineMethods[I];
+    if (!FD->isLateTemplateParsed())
+      continue;
+    auto LPTIter = LateParsedTemplateMap.find(FD);
+    assert(LPTIter != LateParsedTemplateMap.end() &&
+           "missing LateParsedTemplate");
+    LateTemplateParser(OpaqueParser, *LPTIter->second);
+    // A function-try-block body does not unmark the function.
+    UnmarkAsLateParsedTemplate(FD);
+  }
+  UsedLateParsedInlineMethods.clear();
+}
+
 bool Sema::IsInsideALocalClassWithinATemplateFunction() {
   DeclContext *DC = CurContext;
 
@@ -13,6 +13,7 @@
 #include "ASTCommon.h"
 #include "clang/AST/DeclCXX.h"
 #include "clang/AST/DeclObjC.h"
+#include "clang/AST/DeclTemplate.h"
 #include "clang/Basic/IdentifierTable.h"
 #include "clang/Serialization/ASTDeserializationListener.h"
 #include "llvm/Support/DJB.h"
@@ -445,3 +446,17 @@ bool serialization::needsAnonymousDeclarationNumber(const NamedDecl *D) {
     return false;
   return isa<TagDecl>(D) || isa<FieldDecl>(D);
 }
+
+uint64_t serialization::getLazySpecializationInfo(const Decl *Spec) {
+  ArrayRef<TemplateArgument> Args;
+  if (auto *CTSD = dyn_cast<ClassTemplateSpecializationDecl>(Spec))
+    Args = CTSD->getTemplateArgs().asArray();
+  else if (auto *VTSD = dyn_cast<VarTemplateSpecializationDecl>(Spec))
+    Args = VTSD->getTemplateArgs().asArray();
+  else
+    Args = cast<FunctionDecl>(Spec)->getTemplateSpecializationArgs()->asArray();
+  bool IsPartial = isa<ClassTemplatePartialSpecializationDecl>(Spec) ||
+                   isa<VarTemplatePartialSpecializationDecl>(Spec);
+  unsigned Hash = RedeclarableTemplateDecl::computeSpecializationHash(Args);
+  return uint64_t(Hash) << 1 | IsPartial;
+}
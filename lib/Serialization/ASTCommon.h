@@ -91,6 +91,11 @@ bool isRedeclarableDeclKind(unsigned Kind);
 /// declaration number.
 bool needsAnonymousDeclarationNumber(const NamedDecl *D);
 
+/// Compute the value stored after the ID of a template specialization in the
+/// lazy specialization lists: the hash of its template arguments shifted left
+/// by one, with the low bit set for partial specializations.
+uint64_t getLazySpecializationInfo(const Decl *Spec);
+
 /// Visit each declaration within \c DC that needs an anonymous
 /// declaration number and call \p Visit with the declaration and its number.
 template<typename Fn> void numberAnonymousDeclsWithin(const DeclContext *DC,
@@ -924,6 +924,13 @@ IdentID ASTIdentifierLookupTrait::ReadIdentifierID(const unsigned char *d) {
   return Reader.getGlobalIdentifierID(F, RawID >> 1);
 }
 
+/// Return the key of \p Name in the set of deferred interesting identifiers.
+/// The hash is shifted to stay clear of the empty and tombstone keys of the
+/// set.
+static unsigned getDeferredIdentifierKey(StringRef Name) {
+  return ASTIdentifierLookupTrait::ComputeHash(Name) >> 1;
+}
+
 static void markIdentifierFromAST(ASTReader &Reader, IdentifierInfo &II) {
   if (!II.isFromAST()) {
     II.setIsFromAST();
@@ -4180,7 +4187,8 @@ ASTReader::ASTReadResult ASTReader::ReadAST(StringRef FileName,
     }
 
     // Preload all the pending interesting identifiers by marking them out of
-    // date.
+    // date.  The ones that don't exist yet are left in the mapped identifier
+    // table until get() is asked for them.
     for (auto Offset : F.PreloadIdentifierOffsets) {
       const unsigned char *Data = reinterpret_cast<const unsigned char *>(
           F.IdentifierTableData + Offset);
@@ -4188,7 +4196,14 @@ ASTReader::ASTReadResult ASTReader::ReadAST(StringRef FileName,
       ASTIdentifierLookupTrait Trait(*this, F);
       auto KeyDataLen = Trait.ReadKeyDataLength(Data);
       auto Key = Trait.ReadKey(Data, KeyDataLen.first);
-      auto &II = PP.getIdentifierTable().getOwn(Key);
+      IdentifierInfo *ExistingII = PP.getIdentifierTable().find(Key);
+      if (!ExistingII) {
+        if (DeferredInterestingIdentifiers.insert(
+                getDeferredIdentifierKey(Key)).second)
+          ++NumDeferredInterestingIdentifiers;
+        continue;
+      }
+      auto &II = *ExistingII;
       II.setOutOfDate(true);
 
       // Mark this identifier as being from an AST file so that we can track
@@ -7566,13 +7581,18 @@ void ASTReader::CompleteRedeclChain(const Decl *D) {
     }
   }
 
+  // Other declarations of a specialization can only be found among the
+  // lazy specializations with the same template arguments.
   if (auto *CTSD = dyn_cast<ClassTemplateSpecializationDecl>(D))
-    CTSD->getSpecializedTemplate()->LoadLazySpecializations();
+    CTSD->getSpecializedTemplate()->loadLazySpecializationsImpl(
+        CTSD->getTemplateArgs().asArray());
   if (auto *VTSD = dyn_cast<VarTemplateSpecializationDecl>(D))
-    VTSD->getSpecializedTemplate()->LoadLazySpecializations();
+    VTSD->getSpecializedTemplate()->loadLazySpecializationsImpl(
+        VTSD->getTemplateArgs().asArray());
   if (auto *FD = dyn_cast<FunctionDecl>(D)) {
     if (auto *Template = FD->getPrimaryTemplate())
-      Template->LoadLazySpecializations();
+      Template->loadLazySpecializationsImpl(
+          FD->getTemplateSpecializationArgs()->asArray());
   }
 }
 
@@ -8058,27 +8078,42 @@ void ASTReader::StartTranslationUnit(ASTConsumer *Consumer) {
     DeserializationListener->ReaderInitialized(this);
 }
 
+ASTReader::MaterializationStats ASTReader::getMaterializationStats() const {
+  MaterializationStats Stats;
+  Stats.TotalTypes = TypesLoaded.size();
+  Stats.TypesLoaded =
+      Stats.TotalTypes -
+      std::count(TypesLoaded.begin(), TypesLoaded.end(), QualType());
+  Stats.TotalDecls = DeclsLoaded.size();
+  Stats.DeclsLoaded =
+      Stats.TotalDecls -
+      std::count(DeclsLoaded.begin(), DeclsLoaded.end(), (Decl *)nullptr);
+  Stats.TotalIdentifiers = IdentifiersLoaded.size();
+  Stats.IdentifiersLoaded =
+      Stats.TotalIdentifiers - std::count(IdentifiersLoaded.begin(),
+                                          IdentifiersLoaded.end(),
+                                          (IdentifierInfo *)nullptr);
+  Stats.TotalMacros = MacrosLoaded.size();
+  Stats.MacrosLoaded =
+      Stats.TotalMacros -
+      std::count(MacrosLoaded.begin(), MacrosLoaded.end(), (MacroInfo *)nullptr);
+  Stats.TotalSelectors = SelectorsLoaded.size();
+  Stats.SelectorsLoaded =
+      Stats.TotalSelectors -
+      std::count(SelectorsLoaded.begin(), SelectorsLoaded.end(), Selector());
+  Stats.DeferredIdentifiers = NumDeferredInterestingIdentifiers;
+  return Stats;
+}
+
 void ASTReader::PrintStats() {
   std::fprintf(stderr, "*** AST File Statistics:\n");
 
-  unsigned NumTypesLoaded
-    = TypesLoaded.size() - std::count(TypesLoaded.begin(), TypesLoaded.end(),
-                                      QualType());
-  unsigned NumDeclsLoaded
-    = DeclsLoaded.size() - std::count(DeclsLoaded.begin(), DeclsLoaded.end(),
-                                      (Decl *)nullptr);
-  unsigned NumIdentifiersLoaded
-    = IdentifiersLoaded.size() - std::count(IdentifiersLoaded.begin(),
-                                            IdentifiersLoaded.end(),
-                                            (IdentifierInfo *)nullptr);
-  unsigned NumMacrosLoaded
-    = MacrosLoaded.size() - std::count(MacrosLoaded.begin(),
-                                       MacrosLoaded.end(),
-                                       (MacroInfo *)nullptr);
-  unsigned NumSelectorsLoaded
-    = SelectorsLoaded.size() - std::count(SelectorsLoaded.begin(),
-                                          SelectorsLoaded.end(),
-                                          Selector());
+  MaterializationStats Stats = getMaterializationStats();
+  unsigned NumTypesLoaded = Stats.TypesLoaded;
+  unsigned NumDeclsLoaded = Stats.DeclsLoaded;
+  unsigned NumIdentifiersLoaded = Stats.IdentifiersLoaded;
+  unsigned NumMacrosLoaded = Stats.MacrosLoaded;
+  unsigned NumSelectorsLoaded = Stats.SelectorsLoaded;
 
   if (unsigned TotalNumSLocEntries = getTotalNumSLocs())
     std::fprintf(stderr, "  %u/%u source location entries read (%f%%)\n",
@@ -8141,6 +8176,10 @@ void ASTReader::PrintStats() {
                  "  %u / %u identifier table lookups succeeded (%f%%)\n",
                  NumIdentifierLookupHits, NumIdentifierLookups,
                  (double)NumIdentifierLookupHits*100.0/NumIdentifierLookups);
+  if (NumDeferredInterestingIdentifiers)
+    std::fprintf(stderr,
+                 "  %u interesting identifiers deferred until first use\n",
+                 NumDeferredInterestingIdentifiers);
 
   if (GlobalIndex) {
     std::fprintf(stderr, "\n");
@@ -8306,6 +8345,15 @@ IdentifierInfo *ASTReader::get(StringRef Name) {
   // lookups). Perform the lookup in PCH files, though, since we don't build
   // a complete initial identifier table if we're carrying on from a PCH.
   if (PP.getLangOpts().CPlusPlus) {
+    // An interesting identifier that wasn't preloaded is created out of date,
+    // like the preloaded ones, so that its first use visits every module
+    // file, PCH files included.
+    if (DeferredInterestingIdentifiers.count(getDeferredIdentifierKey(Name))) {
+      IdentifierInfo &II = PP.getIdentifierTable().getOwn(Name);
+      II.setOutOfDate(true);
+      markIdentifierFromAST(*this, II);
+      return &II;
+    }
     for (auto F : ModuleMgr.pch_modules())
       if (Visitor(*F))
         break;
@@ -29,6 +29,7 @@
 #include "clang/AST/ExternalASTSource.h"
 #include "clang/AST/LambdaCapture.h"
 #include "clang/AST/NestedNameSpecifier.h"
+#include "clang/AST/ODRHash.h"
 #include "clang/AST/OpenMPClause.h"
 #include "clang/AST/Redeclarable.h"
 #include "clang/AST/Stmt.h"
@@ -136,6 +137,22 @@ namespace clang {
         IDs.push_back(ReadDeclID());
     }
 
+    using LazySpecializationInfo =
+        RedeclarableTemplateDecl::LazySpecializationInfo;
+
+    /// Read a template specialization's ID and the hash stored after it.
+    LazySpecializationInfo ReadLazySpecializationInfo() {
+      DeclID ID = ReadDeclID();
+      uint64_t Info = Record.readInt();
+      return {ID, unsigned(Info >> 1), bool(Info & 1)};
+    }
+
+    void
+    ReadLazySpecializations(SmallVectorImpl<LazySpecializationInfo> &Specs) {
+      for (unsigned I = 0, Size = Record.readInt(); I != Size; I += 2)
+        Specs.push_back(ReadLazySpecializationInfo());
+    }
+
     Decl *ReadDecl() {
       return Record.readDecl();
     }
@@ -262,8 +279,8 @@ namespace clang {
 
     template <typename T> static
     void AddLazySpecializations(T *D,
-                                SmallVectorImpl<serialization::DeclID>& IDs) {
-      if (IDs.empty())
+                               SmallVectorImpl<LazySpecializationInfo> &Specs) {
+      if (Specs.empty())
         return;
 
       // FIXME: We should avoid this pattern of getting the ASTContext.
@@ -272,14 +289,26 @@ namespace clang {
       auto *&LazySpecializations = D->getCommonPtr()->LazySpecializations;
 
       if (auto &Old = LazySpecializations) {
-        IDs.insert(IDs.end(), Old + 1, Old + 1 + Old[0]);
-        llvm::sort(IDs);
-        IDs.erase(std::unique(IDs.begin(), IDs.end()), IDs.end());
+        // Drop the entries that were loaded already.
+        for (auto &Spec : llvm::makeArrayRef(Old + 1, Old[0].DeclID))
+          if (Spec.DeclID)
+            Specs.push_back(Spec);
+        auto ByID = [](const LazySpecializationInfo &A,
+                       const LazySpecializationInfo &B) {
+          return A.DeclID < B.DeclID;
+        };
+        auto SameID = [](const LazySpecializationInfo &A,
+                         const LazySpecializationInfo &B) {
+          return A.DeclID == B.DeclID;
+        };
+        llvm::sort(Specs, ByID);
+        Specs.erase(std::unique(Specs.begin(), Specs.end(), SameID),
+                    Specs.end());
       }
 
-      auto *Result = new (C) serialization::DeclID[1 + IDs.size()];
-      *Result = IDs.size();
-      std::copy(IDs.begin(), IDs.end(), Result + 1);
+      auto *Result = new (C) LazySpecializationInfo[1 + Specs.size()];
+      Result[0] = {uint32_t(Specs.size()), 0, false};
+      std::copy(Specs.begin(), Specs.end(), Result + 1);
 
       LazySpecializations = Result;
     }
@@ -312,7 +341,7 @@ namespace clang {
     void ReadFunctionDefinition(FunctionDecl *FD);
     void Visit(Decl *D);
 
-    void UpdateDecl(Decl *D, SmallVectorImpl<serialization::DeclID> &);
+    void UpdateDecl(Decl *D, SmallVectorImpl<LazySpecializationInfo> &);
 
     static void setNextObjCCategory(ObjCCategoryDecl *Cat,
                                     ObjCCategoryDecl *Next) {
@@ -771,6 +800,8 @@ void ASTDeclReader::VisitEnumDecl(EnumDecl *ED) {
       Reader.mergeDefinitionVisibility(OldDef, ED);
       if (OldDef->getODRHash() != ED->getODRHash())
         Reader.PendingEnumOdrMergeFailures[OldDef].push_back(ED);
+      else
+        Reader.ODRHashMatchedDeclContexts.insert(ED);
     } else {
       OldDef = ED;
     }
@@ -1873,6 +1904,8 @@ void ASTDeclReader::MergeDefinitionData(
   if (DetectedOdrViolation)
     Reader.PendingOdrMergeFailures[DD.Definition].push_back(
         {MergeDD.Definition, &MergeDD});
+  else if (DD.Definition != MergeDD.Definition && !DD.IsLambda)
+    Reader.ODRHashMatchedDeclContexts.insert(MergeDD.Definition);
 }
 
 void ASTDeclReader::ReadCXXRecordDefinition(CXXRecordDecl *D, bool Update) {
@@ -2140,9 +2173,9 @@ void ASTDeclReader::VisitClassTemplateDecl(ClassTemplateDecl *D) {
   if (ThisDeclID == Redecl.getFirstID()) {
     // This ClassTemplateDecl owns a CommonPtr; read it to keep track of all of
     // the specializations.
-    SmallVector<serialization::DeclID, 32> SpecIDs;
-    ReadDeclIDList(SpecIDs);
-    ASTDeclReader::AddLazySpecializations(D, SpecIDs);
+    SmallVector<LazySpecializationInfo, 32> Specs;
+    ReadLazySpecializations(Specs);
+    ASTDeclReader::AddLazySpecializations(D, Specs);
   }
 
   if (D->getTemplatedDecl()->TemplateOrInstantiation) {
@@ -2167,9 +2200,9 @@ void ASTDeclReader::VisitVarTemplateDecl(VarTemplateDecl *D) {
   if (ThisDeclID == Redecl.getFirstID()) {
     // This VarTemplateDecl owns a CommonPtr; read it to keep track of all of
     // the specializations.
-    SmallVector<serialization::DeclID, 32> SpecIDs;
-    ReadDeclIDList(SpecIDs);
-    ASTDeclReader::AddLazySpecializations(D, SpecIDs);
+    SmallVector<LazySpecializationInfo, 32> Specs;
+    ReadLazySpecializations(Specs);
+    ASTDeclReader::AddLazySpecializations(D, Specs);
   }
 }
 
@@ -2274,9 +2307,9 @@ void ASTDeclReader::VisitFunctionTemplateDecl(FunctionTemplateDecl *D) {
 
   if (ThisDeclID == Redecl.getFirstID()) {
     // This FunctionTemplateDecl owns a CommonPtr; read it.
-    SmallVector<serialization::DeclID, 32> SpecIDs;
-    ReadDeclIDList(SpecIDs);
-    ASTDeclReader::AddLazySpecializations(D, SpecIDs);
+    SmallVector<LazySpecializationInfo, 32> Specs;
+    ReadLazySpecializations(Specs);
+    ASTDeclReader::AddLazySpecializations(D, Specs);
   }
 }
 
@@ -3431,12 +3464,16 @@ ASTDeclReader::FindExistingResult ASTDeclReader::findExisting(NamedDecl *D) {
 
   // If this declaration is from a merged context, make a note that we need to
   // check that the canonical definition of that context contains the decl.
+  // There is no need if the ODR hash of the context matched and covers the
+  // decl: the canonical definition then has the same members.
   //
   // FIXME: We should do something similar if we merge two definitions of the
   // same template specialization into the same CXXRecordDecl.
   auto MergedDCIt = Reader.MergedDeclContexts.find(D->getLexicalDeclContext());
   if (MergedDCIt != Reader.MergedDeclContexts.end() &&
-      MergedDCIt->second == D->getDeclContext())
+      MergedDCIt->second == D->getDeclContext() &&
+      !(Reader.ODRHashMatchedDeclContexts.count(MergedDCIt->first) &&
+        ODRHash::isWhitelistedDecl(D, D->getDeclContext())))
     Reader.PendingOdrMergeChecks.push_back(D);
 
   return FindExistingResult(Reader, D, /*Existing=*/nullptr,
@@ -4032,7 +4069,8 @@ void ASTReader::loadDeclUpdateRecords(PendingUpdateRecord &Record) {
   ProcessingUpdatesRAIIObj ProcessingUpdates(*this);
   DeclUpdateOffsetsMap::iterator UpdI = DeclUpdateOffsets.find(ID);
 
-  SmallVector<serialization::DeclID, 8> PendingLazySpecializationIDs;
+  SmallVector<RedeclarableTemplateDecl::LazySpecializationInfo, 8>
+      PendingLazySpecs;
 
   if (UpdI != DeclUpdateOffsets.end()) {
     auto UpdateOffsets = std::move(UpdI->second);
@@ -4071,7 +4109,7 @@ void ASTReader::loadDeclUpdateRecords(PendingUpdateRecord &Record) {
 
       ASTDeclReader Reader(*this, Record, RecordLocation(F, Offset), ID,
                            SourceLocation());
-      Reader.UpdateDecl(D, PendingLazySpecializationIDs);
+      Reader.UpdateDecl(D, PendingLazySpecs);
 
       // We might have made this declaration interesting. If so, remember that
       // we need to hand it off to the consumer.
@@ -4084,16 +4122,16 @@ void ASTReader::loadDeclUpdateRecords(PendingUpdateRecord &Record) {
     }
   }
   // Add the lazy specializations to the template.
-  assert((PendingLazySpecializationIDs.empty() || isa<ClassTemplateDecl>(D) ||
+  assert((PendingLazySpecs.empty() || isa<ClassTemplateDecl>(D) ||
           isa<FunctionTemplateDecl>(D) || isa<VarTemplateDecl>(D)) &&
          "Must not have pending specializations");
   if (auto *CTD = dyn_cast<ClassTemplateDecl>(D))
-    ASTDeclReader::AddLazySpecializations(CTD, PendingLazySpecializationIDs);
+    ASTDeclReader::AddLazySpecializations(CTD, PendingLazySpecs);
   else if (auto *FTD = dyn_cast<FunctionTemplateDecl>(D))
-    ASTDeclReader::AddLazySpecializations(FTD, PendingLazySpecializationIDs);
+    ASTDeclReader::AddLazySpecializations(FTD, PendingLazySpecs);
   else if (auto *VTD = dyn_cast<VarTemplateDecl>(D))
-    ASTDeclReader::AddLazySpecializations(VTD, PendingLazySpecializationIDs);
-  PendingLazySpecializationIDs.clear();
+    ASTDeclReader::AddLazySpecializations(VTD, PendingLazySpecs);
+  PendingLazySpecs.clear();
 
   // Load the pending visible updates for this decl context, if it has any.
   auto I = PendingVisibleUpdates.find(ID);
@@ -4303,7 +4341,7 @@ static void forAllLaterRedecls(DeclT *D, Fn F) {
 }
 
 void ASTDeclReader::UpdateDecl(Decl *D,
-   llvm::SmallVectorImpl<serialization::DeclID> &PendingLazySpecializationIDs) {
+   llvm::SmallVectorImpl<LazySpecializationInfo> &PendingLazySpecs) {
   while (Record.getIdx() < Record.size()) {
     switch ((DeclUpdateKind)Record.readInt()) {
     case UPD_CXX_ADDED_IMPLICIT_MEMBER: {
@@ -4320,7 +4358,7 @@ void ASTDeclReader::UpdateDecl(Decl *D,
 
     case UPD_CXX_ADDED_TEMPLATE_SPECIALIZATION:
       // It will be added to the template's lazy specialization set.
-      PendingLazySpecializationIDs.push_back(ReadDeclID());
+      PendingLazySpecs.push_back(ReadLazySpecializationInfo());
       break;
 
     case UPD_CXX_ADDED_ANONYMOUS_NAMESPACE: {
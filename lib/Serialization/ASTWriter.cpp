@@ -5225,12 +5225,17 @@ void ASTWriter::WriteDeclUpdatesBlocks(RecordDataImpl &OffsetsRecord) {
 
       switch (Kind) {
       case UPD_CXX_ADDED_IMPLICIT_MEMBER:
-      case UPD_CXX_ADDED_TEMPLATE_SPECIALIZATION:
       case UPD_CXX_ADDED_ANONYMOUS_NAMESPACE:
         assert(Update.getDecl() && "no decl to add?");
         Record.push_back(GetDeclRef(Update.getDecl()));
         break;
 
+      case UPD_CXX_ADDED_TEMPLATE_SPECIALIZATION:
+        assert(Update.getDecl() && "no decl to add?");
+        Record.push_back(GetDeclRef(Update.getDecl()));
+        Record.push_back(getLazySpecializationInfo(Update.getDecl()));
+        break;
+
       case UPD_CXX_ADDED_FUNCTION_DEFINITION:
         break;
 
@@ -170,7 +170,8 @@ namespace clang {
     /// Add to the record the first declaration from each module file that
     /// provides a declaration of D. The intent is to provide a sufficient
     /// set such that reloading this set will load all current redeclarations.
-    void AddFirstDeclFromEachModule(const Decl *D, bool IncludeLocal) {
+    llvm::MapVector<ModuleFile*, const Decl*>
+    getFirstDeclFromEachModule(const Decl *D, bool IncludeLocal) {
       llvm::MapVector<ModuleFile*, const Decl*> Firsts;
       // FIXME: We can skip entries that we know are implied by others.
       for (const Decl *R = D->getMostRecentDecl(); R; R = R->getPreviousDecl()) {
@@ -179,7 +180,11 @@ namespace clang {
         else if (IncludeLocal)
           Firsts[nullptr] = R;
       }
-      for (const auto &F : Firsts)
+      return Firsts;
+    }
+
+    void AddFirstDeclFromEachModule(const Decl *D, bool IncludeLocal) {
+      for (const auto &F : getFirstDeclFromEachModule(D, IncludeLocal))
         Record.AddDeclRef(F.second);
     }
 
@@ -212,9 +217,11 @@ namespace clang {
         assert(!Common->LazySpecializations);
       }
 
-      ArrayRef<DeclID> LazySpecializations;
+      using LazySpecializationInfo =
+          RedeclarableTemplateDecl::LazySpecializationInfo;
+      ArrayRef<LazySpecializationInfo> LazySpecializations;
       if (auto *LS = Common->LazySpecializations)
-        LazySpecializations = llvm::makeArrayRef(LS + 1, LS[0]);
+        LazySpecializations = llvm::makeArrayRef(LS + 1, LS[0].DeclID);
 
       // Add a slot to the record for the number of specializations.
       unsigned I = Record.size();
@@ -228,11 +235,24 @@ namespace clang {
       for (auto &Entry : getPartialSpecializations(Common))
         Specs.push_back(getSpecializationDecl(Entry));
 
+      // Each specialization is written as its ID followed by the hash of its
+      // template arguments, so that it can be loaded on its own.
       for (auto *D : Specs) {
         assert(D->isCanonicalDecl() && "non-canonical decl in set");
-        AddFirstDeclFromEachModule(D, /*IncludeLocal*/true);
+        uint64_t Info = getLazySpecializationInfo(D);
+        for (const auto &F :
+             getFirstDeclFromEachModule(D, /*IncludeLocal*/true)) {
+          Record.AddDeclRef(F.second);
+          Record.push_back(Info);
+        }
+      }
+      for (const LazySpecializationInfo &Spec : LazySpecializations) {
+        // Skip the specializations that were loaded since.
+        if (!Spec.DeclID)
+          continue;
+        Record.push_back(Spec.DeclID);
+        Record.push_back(uint64_t(Spec.ArgsHash) << 1 | Spec.IsPartial);
       }
-      Record.append(LazySpecializations.begin(), LazySpecializations.end());
 
       // Update the size entry we added earlier.
       Record[I] = Record.size() - I - 1;
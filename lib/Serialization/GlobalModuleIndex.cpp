@@ -21,8 +21,10 @@
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/MapVector.h"
 #include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/Bitstream/BitstreamReader.h"
 #include "llvm/Bitstream/BitstreamWriter.h"
+#include "llvm/Support/Chrono.h"
 #include "llvm/Support/DJB.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/LockFileManager.h"
@@ -34,6 +36,12 @@
 using namespace clang;
 using namespace serialization;
 
+#define DEBUG_TYPE "global-module-index"
+STATISTIC(NumModuleFilesLoaded,
+          "Number of module files read while writing the global index");
+STATISTIC(NumModuleFilesReused,
+          "Number of unchanged module files taken from the existing index");
+
 //----------------------------------------------------------------------------//
 // Shared constants
 //----------------------------------------------------------------------------//
@@ -457,6 +465,17 @@ namespace {
     /// Load the contents of the given module file into the builder.
     llvm::Error loadModuleFile(const FileEntry *File);
 
+    /// Add a module file that has not changed since the existing index was
+    /// written, using the dependencies recorded in that index rather than
+    /// reading the module file again.
+    void addIndexedModuleFile(const FileEntry *File,
+                              ArrayRef<const FileEntry *> Dependencies);
+
+    /// Add an identifier from the existing index, along with the indexed
+    /// module files that consider it to be interesting.
+    void addIndexedIdentifier(StringRef Name,
+                              ArrayRef<const FileEntry *> Files);
+
     /// Write the index to the given bitstream.
     /// \returns true if an error occurred, false otherwise.
     bool writeIndex(llvm::BitstreamWriter &Stream);
@@ -712,6 +731,28 @@ llvm::Error GlobalModuleIndexBuilder::loadModuleFile(const FileEntry *File) {
   return llvm::Error::success();
 }
 
+void GlobalModuleIndexBuilder::addIndexedModuleFile(
+    const FileEntry *File, ArrayRef<const FileEntry *> Dependencies) {
+  // Record this module file and assign it a unique ID (if it doesn't have
+  // one already).
+  (void)getModuleFileInfo(File);
+
+  for (const FileEntry *DependsOnFile : Dependencies) {
+    unsigned DependsOnID = getModuleFileInfo(DependsOnFile).ID;
+    getModuleFileInfo(File).Dependencies.push_back(DependsOnID);
+  }
+}
+
+void GlobalModuleIndexBuilder::addIndexedIdentifier(
+    StringRef Name, ArrayRef<const FileEntry *> Files) {
+  SmallVector<unsigned, 2> IDs;
+  for (const FileEntry *File : Files)
+    IDs.push_back(getModuleFileInfo(File).ID);
+
+  SmallVectorImpl<unsigned> &Known = InterestingIdentifiers[Name];
+  Known.append(IDs.begin(), IDs.end());
+}
+
 namespace {
 
 /// Trait used to generate the identifier index as an on-disk hash
@@ -876,7 +917,16 @@ GlobalModuleIndex::writeIndex(FileManager &FileMgr,
   // The module index builder.
   GlobalModuleIndexBuilder Builder(FileMgr, PCHContainerRdr);
 
-  // Load each of the module files.
+  // A module file in the cache, along with its size and modification time
+  // as currently found on disk.
+  struct CachedModuleFile {
+    const FileEntry *File;
+    uint64_t Size;
+    time_t ModTime;
+  };
+  SmallVector<CachedModuleFile, 16> CachedModuleFiles;
+
+  // Find each of the module files.
   std::error_code EC;
   for (llvm::sys::fs::directory_iterator D(Path, EC), DEnd;
        D != DEnd && !EC;
@@ -898,11 +948,126 @@ GlobalModuleIndex::writeIndex(FileManager &FileMgr,
     if (!ModuleFile)
       continue;
 
-    // Load this module file.
-    if (llvm::Error Err = Builder.loadModuleFile(ModuleFile))
-      return Err;
+    // Query the file system directly: the file manager may still have the
+    // status of a module file from before it was rebuilt.
+    llvm::ErrorOr<llvm::sys::fs::basic_file_status> Status = D->status();
+    if (!Status)
+      continue;
+
+    CachedModuleFiles.push_back(
+        {ModuleFile, Status->getSize(),
+         llvm::sys::toTimeT(Status->getLastModificationTime())});
+  }
+
+  // Look for module files that have not changed since the existing index
+  // was written, if there is one. Those don't need to be read again.
+  std::unique_ptr<GlobalModuleIndex> ExistingIndex;
+  {
+    std::pair<GlobalModuleIndex *, llvm::Error> Result = readIndex(Path);
+    ExistingIndex.reset(Result.first);
+    if (Result.second)
+      llvm::consumeError(std::move(Result.second));
+  }
+
+  // The module files of the existing index that can be reused, indexed by
+  // their ID in that index.
+  SmallVector<const FileEntry *, 16> IndexedFiles;
+  llvm::DenseMap<const FileEntry *, unsigned> IndexedIDs;
+  if (ExistingIndex) {
+    llvm::DenseMap<const FileEntry *, const CachedModuleFile *> OnDisk;
+    for (const CachedModuleFile &MF : CachedModuleFiles)
+      OnDisk[MF.File] = &MF;
+
+    IndexedFiles.resize(ExistingIndex->Modules.size());
+    for (unsigned ID = 0, N = IndexedFiles.size(); ID != N; ++ID) {
+      const ModuleInfo &Info = ExistingIndex->Modules[ID];
+      if (Info.FileName.empty())
+        continue;
+
+      const FileEntry *File = FileMgr.getFile(Info.FileName, /*OpenFile=*/false,
+                                              /*CacheFailure=*/false);
+      auto Known = OnDisk.find(File);
+      if (Known == OnDisk.end())
+        continue;
+
+      const CachedModuleFile &MF = *Known->second;
+      if (MF.Size == (uint64_t)Info.Size && MF.ModTime == Info.ModTime)
+        IndexedFiles[ID] = File;
+    }
+
+    // A module file can only be reused if everything it depends on can be
+    // reused too; otherwise its imports have to be validated again.
+    bool Changed = true;
+    while (Changed) {
+      Changed = false;
+      for (unsigned ID = 0, N = IndexedFiles.size(); ID != N; ++ID) {
+        if (!IndexedFiles[ID])
+          continue;
+        for (unsigned DependsOnID : ExistingIndex->Modules[ID].Dependencies) {
+          if (DependsOnID >= N || !IndexedFiles[DependsOnID]) {
+            IndexedFiles[ID] = nullptr;
+            Changed = true;
+            break;
+          }
+        }
+      }
+    }
+
+    for (unsigned ID = 0, N = IndexedFiles.size(); ID != N; ++ID)
+      if (IndexedFiles[ID])
+        IndexedIDs[IndexedFiles[ID]] = ID;
+  }
+
+  {
+    llvm::TimeTraceScope TimeScope("Module LoadIndexFiles", StringRef(""));
+
+    // Load each of the module files that changed, and take the others from
+    // the existing index.
+    for (const CachedModuleFile &MF : CachedModuleFiles) {
+      auto Known = IndexedIDs.find(MF.File);
+      if (Known != IndexedIDs.end()) {
+        SmallVector<const FileEntry *, 4> Dependencies;
+        for (unsigned DependsOnID :
+             ExistingIndex->Modules[Known->second].Dependencies)
+          Dependencies.push_back(IndexedFiles[DependsOnID]);
+        Builder.addIndexedModuleFile(MF.File, Dependencies);
+        ++NumModuleFilesReused;
+        continue;
+      }
+
+      // Load this module file.
+      if (llvm::Error Err = Builder.loadModuleFile(MF.File))
+        return Err;
+      ++NumModuleFilesLoaded;
+    }
+
+    // Carry over the identifiers of the reused module files. Identifiers
+    // that are only interesting to module files that changed are dropped;
+    // the changed module files have provided their own identifiers above.
+    if (!IndexedIDs.empty() && ExistingIndex->IdentifierIndex) {
+      IdentifierIndexTable &Table =
+          *static_cast<IdentifierIndexTable *>(ExistingIndex->IdentifierIndex);
+      for (IdentifierIndexTable::key_iterator Key = Table.key_begin(),
+                                              KeyEnd = Table.key_end();
+           Key != KeyEnd; ++Key) {
+        StringRef Name = *Key;
+        SmallVector<unsigned, 2> ModuleIDs = *Table.find(Name);
+        SmallVector<const FileEntry *, 2> Files;
+        for (unsigned ID : ModuleIDs)
+          if (ID < IndexedFiles.size() && IndexedFiles[ID])
+            Files.push_back(IndexedFiles[ID]);
+
+        if (Files.empty() && !ModuleIDs.empty())
+          continue;
+        Builder.addIndexedIdentifier(Name, Files);
+      }
+    }
   }
 
+  // Everything needed from the existing index has been copied into the
+  // builder; release it before the index file gets replaced.
+  ExistingIndex.reset();
+
   // The output buffer, into which the global index will be written.
   SmallVector<char, 16> OutputBuffer;
   {
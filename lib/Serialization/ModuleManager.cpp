@@ -183,9 +183,13 @@ ModuleManager::addModule(StringRef FileName, ModuleKind Type,
       Buf = llvm::MemoryBuffer::getSTDIN();
     } else {
       // Get a buffer of the file and close the file descriptor when done.
+      // The bitstream reader doesn't need a null terminator, and not asking
+      // for one lets every module file be mapped, so that concurrent
+      // compilations share its pages instead of each reading a copy.
       Buf = FileMgr.getBufferForFile(NewModule->File,
                                      /*isVolatile=*/false,
-                                     /*ShouldClose=*/true);
+                                     /*ShouldClose=*/true,
+                                     /*RequiresNullTerminator=*/false);
     }
 
     if (!Buf) {
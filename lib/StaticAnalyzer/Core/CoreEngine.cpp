@@ -45,6 +45,8 @@ STATISTIC(NumSteps,
             "The # of steps executed.");
 STATISTIC(NumReachedMaxSteps,
             "The # of times we reached the max number of steps.");
+STATISTIC(NumReachedMaxMemory,
+            "The # of times we reached the max exploded graph memory.");
 STATISTIC(NumPathsExplored,
             "The # of paths explored by the analyzer.");
 
@@ -74,7 +76,8 @@ static std::unique_ptr<WorkList> generateWorkList(AnalyzerOptions &Opts,
 CoreEngine::CoreEngine(SubEngine &subengine, FunctionSummariesTy *FS,
                        AnalyzerOptions &Opts)
     : SubEng(subengine), WList(generateWorkList(Opts, subengine)),
-      BCounterFactory(G.getAllocator()), FunctionSummaries(FS) {}
+      BCounterFactory(G.getAllocator()), FunctionSummaries(FS),
+      MaxGraphMemory(size_t(Opts.MaxExplodedGraphMemory) << 20) {}
 
 /// ExecuteWorkList - Run the worklist algorithm for a maximum number of steps.
 bool CoreEngine::ExecuteWorkList(const LocationContext *L, unsigned Steps,
@@ -126,6 +129,8 @@ bool CoreEngine::ExecuteWorkList(const LocationContext *L, unsigned Steps,
   if(!UnlimitedSteps)
     G.reserve(std::min(Steps,PreReservationCap));
 
+  unsigned StepsSinceMemoryCheck = 0;
+
   while (WList->hasWork()) {
     if (!UnlimitedSteps) {
       if (Steps == 0) {
@@ -135,6 +140,16 @@ bool CoreEngine::ExecuteWorkList(const LocationContext *L, unsigned Steps,
       --Steps;
     }
 
+    // The nodes, the program states and the stores all live in the graph's
+    // allocator. Only look at it now and then, since that walks its slabs.
+    if (MaxGraphMemory && ++StepsSinceMemoryCheck == 1024) {
+      StepsSinceMemoryCheck = 0;
+      if (G.getAllocator().getTotalMemory() > MaxGraphMemory) {
+        NumReachedMaxMemory++;
+        break;
+      }
+    }
+
     NumSteps++;
 
     const WorkListUnit& WU = WList->dequeue();
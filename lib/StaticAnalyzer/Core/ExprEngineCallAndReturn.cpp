@@ -980,6 +980,13 @@ bool ExprEngine::shouldInlineCall(const CallEvent &Call, const Decl *D,
     return false;
   }
 
+  // Do not re-analyze hot functions in every calling context, if requested.
+  if (Opts.MaxTimesInline &&
+      Engine.FunctionSummaries->getNumTimesInlined(D) >= Opts.MaxTimesInline) {
+    NumReachedInlineCountMax++;
+    return false;
+  }
+
   if (HowToInline == Inline_Minimal && (!isSmall(CalleeADC) || IsRecursive))
     return false;
 
@@ -18,11 +18,20 @@
 #include "clang/StaticAnalyzer/Core/PathSensitive/DynamicTypeMap.h"
 #include "clang/StaticAnalyzer/Core/PathSensitive/ProgramStateTrait.h"
 #include "clang/StaticAnalyzer/Core/PathSensitive/SubEngine.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/Support/raw_ostream.h"
 
 using namespace clang;
 using namespace ento;
 
+#define DEBUG_TYPE "ProgramState"
+
+STATISTIC(NumStatesCreated, "The # of unique program states created");
+STATISTIC(NumStatesReused,
+          "The # of transitions that found an existing program state");
+STATISTIC(NumGDMUpdatesSkipped,
+          "The # of GDM updates that did not change the stored value");
+
 namespace clang { namespace  ento {
 /// Increments the number of times this state is referenced.
 
@@ -406,8 +415,11 @@ ProgramStateRef ProgramStateManager::getPersistentState(ProgramState &State) {
   State.Profile(ID);
   void *InsertPos;
 
-  if (ProgramState *I = StateSet.FindNodeOrInsertPos(ID, InsertPos))
+  if (ProgramState *I = StateSet.FindNodeOrInsertPos(ID, InsertPos)) {
+    ++NumStatesReused;
     return I;
+  }
+  ++NumStatesCreated;
 
   ProgramState *newState = nullptr;
   if (!freeStates.empty()) {
@@ -505,6 +517,15 @@ ProgramStateManager::FindGDMContext(void *K,
 
 ProgramStateRef ProgramStateManager::addGDM(ProgramStateRef St, void *Key, void *Data){
   ProgramState::GenericDataMap M1 = St->getGDM();
+
+  // Checkers often store a value that is already there. Detect that before
+  // the factory builds (and canonicalizes) a new path of tree nodes.
+  if (void *const *Existing = M1.lookup(Key))
+    if (*Existing == Data) {
+      ++NumGDMUpdatesSkipped;
+      return St;
+    }
+
   ProgramState::GenericDataMap M2 = GDMFactory.add(M1, Key, Data);
 
   if (M1 == M2)
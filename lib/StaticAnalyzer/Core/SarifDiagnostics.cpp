@@ -41,6 +41,12 @@ public:
   bool supportsLogicalOpControlFlow() const override { return true; }
   bool supportsCrossFileDiagnostics() const override { return true; }
 };
+
+/// The "files" array of a run, along with the index of each file URI in it.
+struct FileArray {
+  json::Array Files;
+  StringMap<unsigned> Indices;
+};
 } // end anonymous namespace
 
 void ento::createSarifDiagnosticConsumer(
@@ -118,28 +124,17 @@ static json::Object createFile(const FileEntry &FE) {
 }
 
 static json::Object createFileLocation(const FileEntry &FE,
-                                       json::Array &Files) {
+                                       FileArray &Files) {
   std::string FileURI = fileNameToURI(getFileName(FE));
 
   // See if the Files array contains this URI already. If it does not, create
-  // a new file object to add to the array.
-  auto I = llvm::find_if(Files, [&](const json::Value &File) {
-    if (const json::Object *Obj = File.getAsObject()) {
-      if (const json::Object *FileLoc = Obj->getObject("fileLocation")) {
-        Optional<StringRef> URI = FileLoc->getString("uri");
-        return URI && URI->equals(FileURI);
-      }
-    }
-    return false;
-  });
-
-  // Calculate the index within the file location array so it can be stored in
-  // the JSON object.
-  auto Index = static_cast<unsigned>(std::distance(Files.begin(), I));
-  if (I == Files.end())
-    Files.push_back(createFile(FE));
+  // a new file object to add to the array. The index within the file location
+  // array is stored in the JSON object.
+  auto P = Files.Indices.try_emplace(FileURI, Files.Files.size());
+  if (P.second)
+    Files.Files.push_back(createFile(FE));
 
-  return json::Object{{"uri", FileURI}, {"fileIndex", Index}};
+  return json::Object{{"uri", FileURI}, {"fileIndex", P.first->second}};
 }
 
 static json::Object createTextRegion(SourceRange R, const SourceManager &SM) {
@@ -152,7 +147,7 @@ static json::Object createTextRegion(SourceRange R, const SourceManager &SM) {
 
 static json::Object createPhysicalLocation(SourceRange R, const FileEntry &FE,
                                            const SourceManager &SMgr,
-                                           json::Array &Files) {
+                                           FileArray &Files) {
   return json::Object{{{"fileLocation", createFileLocation(FE, Files)},
                        {"region", createTextRegion(R, SMgr)}}};
 }
@@ -207,7 +202,7 @@ static Importance calculateImportance(const PathDiagnosticPiece &Piece) {
 }
 
 static json::Object createThreadFlow(const PathPieces &Pieces,
-                                     json::Array &Files) {
+                                     FileArray &Files) {
   const SourceManager &SMgr = Pieces.front()->getLocation().getManager();
   json::Array Locations;
   for (const auto &Piece : Pieces) {
@@ -223,7 +218,7 @@ static json::Object createThreadFlow(const PathPieces &Pieces,
 }
 
 static json::Object createCodeFlow(const PathPieces &Pieces,
-                                   json::Array &Files) {
+                                   FileArray &Files) {
   return json::Object{
       {"threadFlows", json::Array{createThreadFlow(Pieces, Files)}}};
 }
@@ -235,7 +230,7 @@ static json::Object createTool() {
                       {"version", getClangFullVersion()}};
 }
 
-static json::Object createResult(const PathDiagnostic &Diag, json::Array &Files,
+static json::Object createResult(const PathDiagnostic &Diag, FileArray &Files,
                                  const StringMap<unsigned> &RuleMapping) {
   const PathPieces &Path = Diag.path.flatten(false);
   const SourceManager &SMgr = Path.front()->getLocation().getManager();
@@ -313,7 +308,8 @@ static json::Object createResources(std::vector<const PathDiagnostic *> &Diags,
 }
 
 static json::Object createRun(std::vector<const PathDiagnostic *> &Diags) {
-  json::Array Results, Files;
+  json::Array Results;
+  FileArray Files;
   StringMap<unsigned> RuleMapping;
   json::Object Resources = createResources(Diags, RuleMapping);
   
@@ -324,7 +320,7 @@ static json::Object createRun(std::vector<const PathDiagnostic *> &Diags) {
   return json::Object{{"tool", createTool()},
                       {"resources", std::move(Resources)},
                       {"results", std::move(Results)},
-                      {"files", std::move(Files)}};
+                      {"files", std::move(Files.Files)}};
 }
 
 void SarifDiagnostics::FlushDiagnosticsImpl(
@@ -14,10 +14,12 @@
 
 #include "clang/AST/RecursiveASTVisitor.h"
 #include "clang/Lex/Lexer.h"
+#include "llvm/ADT/Hashing.h"
 #include "llvm/ADT/PriorityQueue.h"
 
 #include <limits>
 #include <memory>
+#include <unordered_map>
 #include <unordered_set>
 
 using namespace llvm;
@@ -134,6 +136,9 @@ public:
   // Maps preorder indices to postorder ones.
   std::vector<int> PostorderIds;
   std::vector<NodeId> NodesBfs;
+  // Hashes of the kinds and values of the nodes in each subtree. Identical
+  // subtrees have the same hash.
+  std::vector<size_t> SubtreeHashes;
 
   int getSize() const { return Nodes.size(); }
   NodeId getRootId() const { return 0; }
@@ -305,9 +310,16 @@ void SyntaxTree::Impl::initTree() {
   setLeftMostDescendants();
   int PostorderId = 0;
   PostorderIds.resize(getSize());
+  SubtreeHashes.resize(getSize());
   std::function<void(NodeId)> PostorderTraverse = [&](NodeId Id) {
-    for (NodeId Child : getNode(Id).Children)
+    const Node &N = getNode(Id);
+    llvm::hash_code Hash =
+        llvm::hash_combine(N.getTypeLabel(), getNodeValue(N));
+    for (NodeId Child : N.Children) {
       PostorderTraverse(Child);
+      Hash = llvm::hash_combine(Hash, SubtreeHashes[Child]);
+    }
+    SubtreeHashes[Id] = Hash;
     PostorderIds[Id] = PostorderId;
     ++PostorderId;
   };
@@ -758,7 +770,8 @@ public:
 bool ASTDiff::Impl::identical(NodeId Id1, NodeId Id2) const {
   const Node &N1 = T1.getNode(Id1);
   const Node &N2 = T2.getNode(Id2);
-  if (N1.Children.size() != N2.Children.size() ||
+  if (T1.SubtreeHashes[Id1] != T2.SubtreeHashes[Id2] ||
+      N1.Children.size() != N2.Children.size() ||
       !isMatchingPossible(Id1, Id2) ||
       T1.getNodeValue(Id1) != T2.getNodeValue(Id2))
     return false;
@@ -881,8 +894,16 @@ Mapping ASTDiff::Impl::matchTopDown() const {
     std::vector<NodeId> H1, H2;
     H1 = L1.pop();
     H2 = L2.pop();
+    // Only compare the subtrees that have the same hash, which keeps this
+    // linear when there are many subtrees of the same height.
+    std::unordered_map<size_t, SmallVector<NodeId, 2>> H2ByHash;
+    for (NodeId Id2 : H2)
+      H2ByHash[T2.SubtreeHashes[Id2]].push_back(Id2);
     for (NodeId Id1 : H1) {
-      for (NodeId Id2 : H2) {
+      auto Candidates = H2ByHash.find(T1.SubtreeHashes[Id1]);
+      if (Candidates == H2ByHash.end())
+        continue;
+      for (NodeId Id2 : Candidates->second) {
         if (identical(Id1, Id2) && !M.hasSrc(Id1) && !M.hasDst(Id2)) {
           for (int I = 0, E = T1.getNumberOfDescendants(Id1); I < E; ++I)
             M.link(Id1 + I, Id2 + I);
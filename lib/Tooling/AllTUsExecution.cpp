@@ -8,8 +8,10 @@
 
 #include "clang/Tooling/AllTUsExecution.h"
 #include "clang/Tooling/ToolExecutorPluginRegistry.h"
+#include "llvm/Support/FileSystem.h"
 #include "llvm/Support/ThreadPool.h"
 #include "llvm/Support/VirtualFileSystem.h"
+#include <algorithm>
 
 namespace clang {
 namespace tooling {
@@ -102,6 +104,26 @@ llvm::Error AllTUsToolExecutor::execute(
     if (RegexFilter.match(File))
       Files.push_back(File);
   }
+  // Process the largest files first. The size of the main file is a rough
+  // estimate of the cost of a translation unit, and starting the expensive
+  // ones early keeps a single large file from running long after the others.
+  {
+    std::vector<std::pair<uint64_t, std::string>> SizedFiles;
+    SizedFiles.reserve(Files.size());
+    for (std::string &File : Files) {
+      uint64_t Size = 0;
+      if (llvm::sys::fs::file_size(File, Size))
+        Size = 0;
+      SizedFiles.emplace_back(Size, std::move(File));
+    }
+    std::stable_sort(SizedFiles.begin(), SizedFiles.end(),
+                     [](const std::pair<uint64_t, std::string> &LHS,
+                        const std::pair<uint64_t, std::string> &RHS) {
+                       return LHS.first > RHS.first;
+                     });
+    for (unsigned I = 0, E = SizedFiles.size(); I != E; ++I)
+      Files[I] = std::move(SizedFiles[I].second);
+  }
   // Add a counter to track the progress.
   const std::string TotalNumStr = std::to_string(Files.size());
   unsigned Counter = 0;
@@ -11,6 +11,7 @@
 #include "clang/Frontend/FrontendActions.h"
 #include "clang/Frontend/TextDiagnosticPrinter.h"
 #include "clang/Frontend/Utils.h"
+#include "clang/Tooling/DependencyScanning/DependencyScanningService.h"
 #include "clang/Tooling/Tooling.h"
 
 using namespace clang;
@@ -36,6 +37,29 @@ private:
   std::string &S;
 };
 
+/// Gathers the names of all of the dependencies into a list.
+class DependencyListCollector : public DependencyFileGenerator {
+public:
+  DependencyListCollector(std::unique_ptr<DependencyOutputOptions> Opts,
+                          std::vector<std::string> &Dependencies)
+      : DependencyFileGenerator(*Opts), Opts(std::move(Opts)),
+        Dependencies(Dependencies) {}
+
+  void finishedMainFile(DiagnosticsEngine &Diags) override {
+    ArrayRef<std::string> Deps = getDependencies();
+    Dependencies.assign(Deps.begin(), Deps.end());
+  }
+
+private:
+  std::unique_ptr<DependencyOutputOptions> Opts;
+  std::vector<std::string> &Dependencies;
+};
+
+/// Creates the dependency collector of a scan from the dependency output
+/// options of the invocation.
+using CollectorFactory = llvm::function_ref<std::shared_ptr<DependencyCollector>(
+    std::unique_ptr<DependencyOutputOptions>)>;
+
 /// A proxy file system that doesn't call `chdir` when changing the working
 /// directory of a clang tool.
 class ProxyFileSystemWithoutChdir : public llvm::vfs::ProxyFileSystem {
@@ -63,9 +87,8 @@ private:
 class DependencyScanningAction : public tooling::ToolAction {
 public:
   DependencyScanningAction(StringRef WorkingDirectory,
-                           std::string &DependencyFileContents)
-      : WorkingDirectory(WorkingDirectory),
-        DependencyFileContents(DependencyFileContents) {}
+                           CollectorFactory CreateCollector)
+      : WorkingDirectory(WorkingDirectory), CreateCollector(CreateCollector) {}
 
   bool runInvocation(std::shared_ptr<CompilerInvocation> Invocation,
                      FileManager *FileMgr,
@@ -98,8 +121,7 @@ public:
     // We need at least one -MT equivalent for the generator to work.
     if (Opts->Targets.empty())
       Opts->Targets = {"clang-scan-deps dependency"};
-    Compiler.addDependencyCollector(std::make_shared<DependencyPrinter>(
-        std::move(Opts), DependencyFileContents));
+    Compiler.addDependencyCollector(CreateCollector(std::move(Opts)));
 
     auto Action = llvm::make_unique<PreprocessOnlyAction>();
     const bool Result = Compiler.ExecuteAction(*Action);
@@ -109,41 +131,73 @@ public:
 
 private:
   StringRef WorkingDirectory;
-  /// The dependency file will be written to this string.
-  std::string &DependencyFileContents;
+  CollectorFactory CreateCollector;
 };
 
 } // end anonymous namespace
 
-DependencyScanningWorker::DependencyScanningWorker() {
+DependencyScanningWorker::DependencyScanningWorker(
+    DependencyScanningService &Service) {
   DiagOpts = new DiagnosticOptions();
   PCHContainerOps = std::make_shared<PCHContainerOperations>();
-  /// FIXME: Use the shared file system from the service for fast scanning
-  /// mode.
-  WorkerFS = new ProxyFileSystemWithoutChdir(llvm::vfs::getRealFileSystem());
+  RealFS = new ProxyFileSystemWithoutChdir(llvm::vfs::getRealFileSystem());
+  // In the fast scanning mode the files are read and minimized once through
+  // the cache shared by all of the workers.
+  if (Service.getMode() == ScanningMode::MinimizedSourcePreprocessing)
+    WorkerFS = new DependencyScanningWorkerFilesystem(Service.getSharedCache(),
+                                                      RealFS);
+  else
+    WorkerFS = RealFS;
 }
 
-llvm::Expected<std::string>
-DependencyScanningWorker::getDependencyFile(const std::string &Input,
-                                            StringRef WorkingDirectory,
-                                            const CompilationDatabase &CDB) {
+llvm::Error DependencyScanningWorker::runScan(
+    const std::string &Input, StringRef WorkingDirectory,
+    const CompilationDatabase &CDB, CollectorFactory CreateCollector) {
   // Capture the emitted diagnostics and report them to the client
   // in the case of a failure.
   std::string DiagnosticOutput;
   llvm::raw_string_ostream DiagnosticsOS(DiagnosticOutput);
   TextDiagnosticPrinter DiagPrinter(DiagnosticsOS, DiagOpts.get());
 
-  WorkerFS->setCurrentWorkingDirectory(WorkingDirectory);
+  RealFS->setCurrentWorkingDirectory(WorkingDirectory);
   tooling::ClangTool Tool(CDB, Input, PCHContainerOps, WorkerFS);
   Tool.clearArgumentsAdjusters();
   Tool.setRestoreWorkingDir(false);
   Tool.setPrintErrorMessage(false);
   Tool.setDiagnosticConsumer(&DiagPrinter);
-  std::string Output;
-  DependencyScanningAction Action(WorkingDirectory, Output);
+  DependencyScanningAction Action(WorkingDirectory, CreateCollector);
   if (Tool.run(&Action)) {
     return llvm::make_error<llvm::StringError>(DiagnosticsOS.str(),
                                                llvm::inconvertibleErrorCode());
   }
+  return llvm::Error::success();
+}
+
+llvm::Expected<std::string>
+DependencyScanningWorker::getDependencyFile(const std::string &Input,
+                                            StringRef WorkingDirectory,
+                                            const CompilationDatabase &CDB) {
+  std::string Output;
+  if (llvm::Error E = runScan(
+          Input, WorkingDirectory, CDB,
+          [&](std::unique_ptr<DependencyOutputOptions> Opts) {
+            return std::make_shared<DependencyPrinter>(std::move(Opts), Output);
+          }))
+    return std::move(E);
   return Output;
 }
+
+llvm::Expected<std::vector<std::string>>
+DependencyScanningWorker::getDependencies(const std::string &Input,
+                                          StringRef WorkingDirectory,
+                                          const CompilationDatabase &CDB) {
+  std::vector<std::string> Dependencies;
+  if (llvm::Error E = runScan(
+          Input, WorkingDirectory, CDB,
+          [&](std::unique_ptr<DependencyOutputOptions> Opts) {
+            return std::make_shared<DependencyListCollector>(std::move(Opts),
+                                                             Dependencies);
+          }))
+    return std::move(E);
+  return Dependencies;
+}
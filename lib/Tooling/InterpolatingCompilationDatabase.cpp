@@ -57,6 +57,7 @@
 #include "llvm/Support/StringSaver.h"
 #include "llvm/Support/raw_ostream.h"
 #include <memory>
+#include <mutex>
 
 namespace clang {
 namespace tooling {
@@ -509,12 +510,15 @@ private:
 class InterpolatingCompilationDatabase : public CompilationDatabase {
 public:
   InterpolatingCompilationDatabase(std::unique_ptr<CompilationDatabase> Inner)
-      : Inner(std::move(Inner)), Index(this->Inner->getAllFiles()) {}
+      : Inner(std::move(Inner)) {}
 
   std::vector<CompileCommand>
   getCompileCommands(StringRef Filename) const override {
     auto Known = Inner->getCompileCommands(Filename);
-    if (Index.empty() || !Known.empty())
+    if (!Known.empty())
+      return Known;
+    const FileIndex &Index = getIndex();
+    if (Index.empty())
       return Known;
     bool TypeCertain;
     auto Lang = guessType(Filename, &TypeCertain);
@@ -536,8 +540,18 @@ public:
   }
 
 private:
+  // Builds the index of all files on the first lookup that misses. Tools that
+  // only ask for files listed in the database never pay for it.
+  const FileIndex &getIndex() const {
+    std::call_once(IndexBuilt, [this] {
+      Index = llvm::make_unique<FileIndex>(Inner->getAllFiles());
+    });
+    return *Index;
+  }
+
   std::unique_ptr<CompilationDatabase> Inner;
-  FileIndex Index;
+  mutable std::once_flag IndexBuilt;
+  mutable std::unique_ptr<FileIndex> Index;
 };
 
 } // namespace
@@ -14,6 +14,7 @@
 #include "clang/Tooling/Refactoring/Rename/RenamingAction.h"
 #include "clang/AST/ASTConsumer.h"
 #include "clang/AST/ASTContext.h"
+#include "clang/Basic/CharInfo.h"
 #include "clang/Basic/FileManager.h"
 #include "clang/Frontend/CompilerInstance.h"
 #include "clang/Frontend/FrontendAction.h"
@@ -196,10 +197,24 @@ public:
       if (PrevNames[I].empty())
         continue;
 
+      // Every occurrence is spelled with the previous name, so a translation
+      // unit that never lexed it has nothing to rename and needn't be walked.
+      if (!mayReferenceName(Context, PrevNames[I]))
+        continue;
+
       HandleOneRename(Context, NewNames[I], PrevNames[I], USRList[I]);
     }
   }
 
+  static bool mayReferenceName(ASTContext &Context, StringRef Name) {
+    // Names such as 'operator+' are not identifiers, and identifiers from AST
+    // files are only added to the table when they are looked up.
+    if (!isValidIdentifier(Name) ||
+        Context.Idents.getExternalIdentifierLookup())
+      return true;
+    return Context.Idents.find(Name) != nullptr;
+  }
+
   void HandleOneRename(ASTContext &Context, const std::string &NewName,
                        const std::string &PrevName,
                        const std::vector<std::string> &USRs) {
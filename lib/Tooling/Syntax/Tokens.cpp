@@ -14,6 +14,7 @@
 #include "clang/Basic/SourceLocation.h"
 #include "clang/Basic/SourceManager.h"
 #include "clang/Basic/TokenKinds.h"
+#include "clang/Frontend/CompilerInstance.h"
 #include "clang/Lex/PPCallbacks.h"
 #include "clang/Lex/Preprocessor.h"
 #include "clang/Lex/Token.h"
@@ -542,6 +543,18 @@ TokenBuffer TokenCollector::consume() && {
       .build();
 }
 
+bool TokenCollectingAction::BeginSourceFileAction(CompilerInstance &CI) {
+  assert(!Collector && "expected only a single call to BeginSourceFile");
+  Collector.emplace(CI.getPreprocessor());
+  return true;
+}
+
+void TokenCollectingAction::EndSourceFileAction() {
+  assert(Collector && "BeginSourceFileAction was never called");
+  Result = std::move(*Collector).consume();
+  Collector.reset();
+}
+
 std::string syntax::Token::str() const {
   return llvm::formatv("Token({0}, length = {1})", tok::getTokenName(kind()),
                        length());
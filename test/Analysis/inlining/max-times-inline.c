@@ -0,0 +1,12 @@
+// RUN: %clang_analyze_cc1 -analyzer-checker=core,debug.ExprInspection -analyzer-config max-times-inline=2 -verify %s
+
+void clang_analyzer_eval(int);
+
+int identity(int X) { return X; }
+
+void test() {
+  clang_analyzer_eval(identity(1) == 1); // expected-warning{{TRUE}}
+  clang_analyzer_eval(identity(2) == 2); // expected-warning{{TRUE}}
+  // The limit is reached; the call is evaluated conservatively.
+  clang_analyzer_eval(identity(3) == 3); // expected-warning{{UNKNOWN}}
+}
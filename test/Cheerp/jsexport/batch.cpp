@@ -0,0 +1,46 @@
+// RUN: %clang_cc1 -triple cheerp-leaningtech-webbrowser-wasm -emit-llvm -o - %s | FileCheck %s
+// RUN: not %clang_cc1 -triple cheerp-leaningtech-webbrowser-wasm -DERRORS -fsyntax-only %s 2>&1 | FileCheck -check-prefix=ERR %s
+
+#ifndef ERRORS
+// CHECK: define {{.*}}void @_Z11updatePointiff(i32 %{{.*}}, float %{{.*}}, float %{{.*}})
+[[cheerp::jsexport]] [[cheerp::jsexport_batch]] void updatePoint(int index, float x, float y)
+{
+}
+
+// CHECK: define {{.*}}void @_Z8setFlagsbd(
+[[cheerp::jsexport]] [[cheerp::jsexport_batch]] void setFlags(bool b, double d)
+{
+}
+
+// Only batched functions are listed in the batch metadata
+// CHECK: define {{.*}}void @_Z6singlei(
+[[cheerp::jsexport]] void single(int i)
+{
+}
+
+// CHECK: !jsexported_batch_functions = !{![[BATCH1:[0-9]+]], ![[BATCH2:[0-9]+]]}
+// CHECK: ![[BATCH1]] = !{void (i32, float, float)* @_Z11updatePointiff}
+// CHECK: ![[BATCH2]] = !{void (i1, double)* @_Z8setFlagsbd}
+#else
+// ERR-DAG: error: Cheerp: {{\[\[}}cheerp::jsexport_batch{{\]\]}} functions must also be tagged {{\[\[}}cheerp::jsexport{{\]\]}}
+[[cheerp::jsexport_batch]] void notExported(int i)
+{
+}
+
+// ERR-DAG: error: Cheerp: {{\[\[}}cheerp::jsexport_batch{{\]\]}} functions must return void
+[[cheerp::jsexport]] [[cheerp::jsexport_batch]] int returnsValue(int i)
+{
+	return i;
+}
+
+// ERR-DAG: error: Cheerp: Parameters of {{\[\[}}cheerp::jsexport_batch{{\]\]}} functions must be numbers, 'int *' is not supported
+[[cheerp::jsexport]] [[cheerp::jsexport_batch]] void takesPointer(int* p)
+{
+}
+
+struct [[cheerp::jsexport]] Foo
+{
+	// ERR-DAG: error: Cheerp: {{\[\[}}cheerp::jsexport_batch{{\]\]}} attribute is only allowed on free functions
+	[[cheerp::jsexport_batch]] static void method(int i);
+};
+#endif
@@ -0,0 +1,19 @@
+// REQUIRES: shell
+// RUN: %clang_cc1 -triple cheerp-leaningtech-webbrowser-genericjs -emit-llvm -ftime-trace -ftime-trace-granularity=0 -o %t.ll %s
+// RUN: cat %t.json \
+// RUN:   | %python -c 'import json, sys; json.dump(json.loads(sys.stdin.read()), sys.stdout, sort_keys=True, indent=2)' \
+// RUN:   | FileCheck %s
+
+// The checks of [[cheerp::jsexport]] classes appear in -ftime-trace.
+
+// CHECK: "detail": "Exported"
+// CHECK: "name": "CheerpCheckRecord"
+
+class [[cheerp::jsexport]] Exported
+{
+public:
+	Exported() : y(234)
+	{
+	}
+	int y;
+};
@@ -0,0 +1,50 @@
+// RUN: %clang_cc1 -triple cheerp-leaningtech-webbrowser-genericjs -emit-llvm -o - %s | FileCheck %s
+
+namespace client
+{
+	class String;
+}
+
+class [[cheerp::jsexport]] Point
+{
+public:
+	Point(double x, double y);
+	double distance(Point* other);
+	static bool isOrigin(const Point& p);
+};
+
+// The first entry is the return type, followed by one entry per parameter
+// CHECK: define {{.*}}@_Z5scaleP5Pointi{{.*}} !cheerp.jsexport.types ![[SCALE:[0-9]+]]
+[[cheerp::jsexport]] Point* scale(Point* p, int factor)
+{
+	return p;
+}
+
+// CHECK: define {{.*}}@_Z4nameb{{.*}} !cheerp.jsexport.types ![[NAME:[0-9]+]]
+[[cheerp::jsexport]] client::String* name(bool upper)
+{
+	return nullptr;
+}
+
+// CHECK: define {{.*}}@_ZN5PointC1Edd{{.*}} !cheerp.jsexport.types ![[CTOR:[0-9]+]]
+Point::Point(double x, double y)
+{
+}
+
+// CHECK: define {{.*}}@_ZN5Point8distanceEPS_{{.*}} !cheerp.jsexport.types ![[DISTANCE:[0-9]+]]
+double Point::distance(Point* other)
+{
+	return 0;
+}
+
+// CHECK: define {{.*}}@_ZN5Point8isOriginERKS_{{.*}} !cheerp.jsexport.types ![[ISORIGIN:[0-9]+]]
+bool Point::isOrigin(const Point& p)
+{
+	return true;
+}
+
+// CHECK-DAG: ![[SCALE]] = !{!"Point", !"Point", !"number"}
+// CHECK-DAG: ![[NAME]] = !{!"String", !"boolean"}
+// CHECK-DAG: ![[CTOR]] = !{!"void", !"number", !"number"}
+// CHECK-DAG: ![[DISTANCE]] = !{!"number", !"Point"}
+// CHECK-DAG: ![[ISORIGIN]] = !{!"boolean", !"Point"}
@@ -0,0 +1,31 @@
+// RUN: %clang_cc1 -triple cheerp-leaningtech-webbrowser-wasm -cheerp-wasm-externref -emit-llvm -o - %s | FileCheck %s
+// RUN: not %clang_cc1 -triple cheerp-leaningtech-webbrowser-wasm %s 2>&1 | FileCheck -check-prefix=NO-EXTERNREF %s
+
+// With externref, wasm code can receive and return JS strings as opaque
+// references, without copying them into linear memory
+namespace client
+{
+	class [[cheerp::genericjs]] String
+	{
+	public:
+		int get_length();
+		int charCodeAt(int index);
+		String* substring(int start, int end);
+	};
+}
+
+// CHECK: define {{.*}}@_Z11countSpacesPN6client6StringE(%{{.*}}String{{.*}}* %{{.*}}) {{.*}}section "asmjs"
+// NO-EXTERNREF: error: Cheerp: Attribute 'wasm' of function 'countSpaces' is incompatible with attribute 'genericjs' of parameter 'str'
+[[cheerp::jsexport]] int countSpaces(client::String* str)
+{
+	int ret = 0;
+	for (int i = 0; i < str->get_length(); i++)
+		ret += str->charCodeAt(i) == ' ';
+	return ret;
+}
+
+// CHECK: define {{.*}}@_Z4headPN6client6StringE(%{{.*}}String{{.*}}* %{{.*}}) {{.*}}section "asmjs"
+[[cheerp::jsexport]] client::String* head(client::String* str)
+{
+	return str->substring(0, 16);
+}
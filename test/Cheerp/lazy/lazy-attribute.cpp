@@ -0,0 +1,37 @@
+// RUN: %clang_cc1 -triple cheerp-leaningtech-webbrowser-wasm -emit-llvm -o - %s | FileCheck %s
+// RUN: not %clang_cc1 -triple cheerp-leaningtech-webbrowser-wasm -DERRORS %s 2>&1 | FileCheck -check-prefix=ERRORS %s
+// RUN: %clang_cc1 -triple cheerp-leaningtech-webbrowser-genericjs -emit-llvm -o - %s 2>&1 | FileCheck -check-prefix=GENERICJS %s
+
+// CHECK: define {{.*}}@_Z10loadEditorv() [[LAZY:#[0-9]+]] section "asmjs"
+// CHECK: define {{.*}}@_Z4mainv()
+// CHECK-NOT: "cheerp-lazy"
+// CHECK: attributes [[LAZY]] = { {{.*}}"cheerp-lazy"
+
+// GENERICJS: warning: Cheerp: {{.*}}lazy{{.*}} is ignored on genericjs functions
+// GENERICJS-NOT: "cheerp-lazy"
+
+[[cheerp::lazy]] int loadEditor()
+{
+	return 42;
+}
+
+int main()
+{
+	return loadEditor();
+}
+
+#ifdef ERRORS
+// ERRORS: error: Cheerp: This attribute can only be used on functions
+[[cheerp::lazy]] int notAFunction;
+
+// ERRORS: error: 'lazy' and 'genericjs' attributes are not compatible
+[[cheerp::genericjs]][[cheerp::lazy]] void notLinear();
+
+// ERRORS: error: 'lazy' and 'genericjs' attributes are not compatible
+[[cheerp::lazy]][[cheerp::genericjs]] void notLinearEither();
+
+// ERRORS: warning: Cheerp: {{.*}}lazy{{.*}} is ignored on genericjs functions
+struct [[cheerp::genericjs]] Client {
+	[[cheerp::lazy]] void method();
+};
+#endif
@@ -0,0 +1,45 @@
+// RUN: %clang_cc1 -triple cheerp-leaningtech-webbrowser-genericjs -emit-llvm -o - %s | FileCheck --implicit-check-not=llvm.global_ctors %s
+// RUN: not %clang_cc1 -triple cheerp-leaningtech-webbrowser-genericjs -DERRORS %s 2>&1 | FileCheck -check-prefix=ERRORS %s
+
+int compute();
+
+// CHECK: @_ZGV{{.*}}lazyValue = internal global i8 0
+[[cheerp::lazy_init]] static int lazyValue = compute();
+
+// The initializer is guarded and only runs when called by a use
+// CHECK: define internal void @[[INIT:__cxx_global_var_init[.0-9]*]]()
+// CHECK: load {{.*}}@_ZGV{{.*}}lazyValue
+// CHECK: call {{.*}}@_Z7computev()
+// CHECK: store i8 1, {{.*}}@_ZGV{{.*}}lazyValue
+
+// Variables without a dynamic initialization get an empty one
+[[cheerp::lazy_init]] static int constantValue = 42;
+
+// Namespace scope const variables have internal linkage too
+[[cheerp::lazy_init]] const int constValue = compute();
+
+// CHECK-LABEL: define {{.*}}@_Z3usev()
+// CHECK: call void @[[INIT]]()
+// CHECK: load {{.*}}@_ZL9lazyValue
+// CHECK: call void @[[CONSTINIT:__cxx_global_var_init[.0-9]*]]()
+// CHECK: load {{.*}}@_ZL13constantValue
+// CHECK: call void @__cxx_global_var_init
+// CHECK: load {{.*}}@_ZL10constValue
+int use()
+{
+	return lazyValue + constantValue + constValue;
+}
+
+// CHECK: define internal void @[[CONSTINIT]]()
+// CHECK-NEXT: ret void
+
+#ifdef ERRORS
+// ERRORS: error: Cheerp: {{.*}}lazy_init{{.*}} is only allowed on namespace scope variables with internal linkage
+[[cheerp::lazy_init]] int externalValue = compute();
+
+void function()
+{
+// ERRORS: error: Cheerp: {{.*}}lazy_init{{.*}} is only allowed on namespace scope variables with internal linkage
+	[[cheerp::lazy_init]] static int localValue = compute();
+}
+#endif
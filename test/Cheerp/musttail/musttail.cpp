@@ -0,0 +1,54 @@
+// RUN: %clang_cc1 -triple cheerp-leaningtech-webbrowser-wasm -cheerp-wasm-return-calls -emit-llvm -o - %s | FileCheck %s
+// RUN: not %clang_cc1 -triple cheerp-leaningtech-webbrowser-wasm %s 2>&1 | FileCheck -check-prefix=NO-RETURN-CALLS %s
+// RUN: not %clang_cc1 -triple cheerp-leaningtech-webbrowser-wasm -cheerp-wasm-return-calls -DERRORS %s 2>&1 | FileCheck -check-prefix=ERRORS %s
+
+typedef int (*Handler)(const unsigned char* pc, int acc);
+extern Handler dispatch[256];
+
+// CHECK-LABEL: define {{.*}}@_Z6opIncrPKhi
+// CHECK: musttail call {{.*}} %{{.*}}(i8* %{{.*}}, i32 %{{.*}})
+// CHECK-NEXT: ret i32
+int opIncr(const unsigned char* pc, int acc)
+{
+	// NO-RETURN-CALLS: error: Cheerp: 'musttail' attribute requires -cheerp-wasm-enable=returncalls
+	[[clang::musttail]] return dispatch[pc[1]](pc + 1, acc + 1);
+}
+
+#ifdef ERRORS
+int other(int a);
+
+int wrongType(const unsigned char* pc, int acc)
+{
+	// ERRORS: error: 'musttail' attribute requires that caller and callee have identical parameter types and return types
+	[[clang::musttail]] return other(acc);
+}
+
+int notACall(const unsigned char* pc, int acc)
+{
+	// ERRORS: error: 'musttail' attribute requires that the return value is the result of a function call
+	[[clang::musttail]] return acc;
+}
+
+int notAReturn(const unsigned char* pc, int acc)
+{
+	// ERRORS: error: 'musttail' attribute is only allowed on return statements
+	[[clang::musttail]] opIncr(pc, acc);
+	return 0;
+}
+
+struct S
+{
+	int f(int a);
+	int g(int a)
+	{
+		// ERRORS: error: 'musttail' attribute is not supported on calls to or from non-static member functions
+		[[clang::musttail]] return f(a);
+	}
+};
+
+[[cheerp::genericjs]] int jsSide(const unsigned char* pc, int acc)
+{
+	// ERRORS: error: Cheerp: 'musttail' attribute is only supported in {{\[\[}}cheerp::wasm{{\]\]}} functions
+	[[clang::musttail]] return jsSide(pc, acc);
+}
+#endif
@@ -0,0 +1,53 @@
+// RUN: %clang_cc1 -triple cheerp-leaningtech-webbrowser-genericjs -emit-llvm -o - %s | FileCheck %s
+// RUN: not %clang_cc1 -triple cheerp-leaningtech-webbrowser-genericjs -DERRORS %s 2>&1 | FileCheck -check-prefix=ERRORS %s
+
+// CHECK: !cheerp_soa_types = !{[[PARTICLE:![0-9]+]]}
+// CHECK: [[PARTICLE]] = !{!"{{.*}}Particle{{.*}}"}
+
+struct [[cheerp::soa]] Particle
+{
+	float x;
+	float y;
+	int id;
+};
+
+Particle particles[64];
+
+float sumX()
+{
+	float ret = 0;
+	for (int i = 0; i < 64; i++)
+		ret += particles[i].x;
+	return ret;
+}
+
+#ifdef ERRORS
+struct Base
+{
+	int a;
+};
+
+// ERRORS: error: Cheerp: Inherited classes can not be tagged with {{\[\[}}cheerp::soa{{\]\]}}
+struct [[cheerp::soa]] Derived : Base
+{
+	int b;
+};
+
+// ERRORS: error: Cheerp: A virtual class cannot have the 'soa' attribute
+struct [[cheerp::soa]] Virtual
+{
+	virtual void f();
+};
+
+struct [[cheerp::soa]] WithPointer
+{
+	// ERRORS: error: Cheerp: Fields of a {{\[\[}}cheerp::soa{{\]\]}} class/struct must have arithmetic type, 'int *' is not supported
+	int* p;
+};
+
+// ERRORS: error: 'soa' and 'bytelayout' attributes are not compatible
+struct [[cheerp::bytelayout]] [[cheerp::soa]] Both
+{
+	int a;
+};
+#endif
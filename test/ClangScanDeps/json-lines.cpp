@@ -0,0 +1,18 @@
+// RUN: rm -rf %t.dir
+// RUN: rm -rf %t.cdb
+// RUN: mkdir -p %t.dir
+// RUN: cp %s %t.dir/regular_cdb.cpp
+// RUN: cp %s %t.dir/regular_cdb2.cpp
+// RUN: mkdir %t.dir/Inputs
+// RUN: cp %S/Inputs/header.h %t.dir/Inputs/header.h
+// RUN: cp %S/Inputs/header2.h %t.dir/Inputs/header2.h
+// RUN: sed -e "s|DIR|%/t.dir|g" %S/Inputs/regular_cdb.json > %t.cdb
+//
+// RUN: clang-scan-deps -compilation-database %t.cdb -j 1 -format json-lines | \
+// RUN:   FileCheck %s
+
+#include "header.h"
+
+// CHECK-NOT: Running clang-scan-deps
+// CHECK: {"dependencies":["{{.*}}regular_cdb2.cpp","{{.*}}Inputs{{/|\\\\}}header.h","{{.*}}Inputs{{/|\\\\}}header2.h"],"directory":"{{.*}}","file":"{{.*}}regular_cdb2.cpp"}
+// CHECK-NEXT: {"dependencies":["{{.*}}regular_cdb.cpp","{{.*}}Inputs{{/|\\\\}}header.h"],"directory":"{{.*}}","file":"{{.*}}regular_cdb.cpp"}
@@ -0,0 +1,24 @@
+target triple = "cheerp-leaningtech-webbrowser-wasm"
+
+@llvm.compiler.used = appending global [1 x i8*] [i8* bitcast (i8* (i32)* @malloc to i8*)], section "llvm.metadata"
+
+define i32 @main() section "asmjs" {
+  %1 = call i32 @wasmHelper()
+  ret i32 %1
+}
+
+define i32 @wasmHelper() section "asmjs" {
+  ret i32 1
+}
+
+define i8* @malloc(i32 %size) section "asmjs" {
+  ret i8* null
+}
+
+define i32 @wasmUnused() section "asmjs" {
+  ret i32 2
+}
+
+define i8* @calloc(i32 %n, i32 %size) section "asmjs" {
+  ret i8* null
+}
@@ -0,0 +1,30 @@
+// RUN: %clang_cc1 -triple cheerp-leaningtech-webbrowser-genericjs -emit-llvm -o - %s | FileCheck %s
+// RUN: %clang_cc1 -triple x86_64-unknown-linux-gnu -emit-llvm -o - %s | FileCheck -check-prefix=NATIVE %s
+
+int table[256];
+
+// CHECK-LABEL: define {{.*}}@byIndex(
+// CHECK: getelementptr {{.*}}, !cheerp.array.extent ![[EXTENT:[0-9]+]]{{$}}
+int byIndex(int i) {
+  return table[i];
+}
+
+// CHECK-LABEL: define {{.*}}@byByte(
+// CHECK: getelementptr {{.*}}, !cheerp.array.extent ![[EXTENT]], !cheerp.inbounds ![[INBOUNDS:[0-9]+]]
+int byByte(unsigned char c) {
+  return table[c];
+}
+
+// CHECK-LABEL: define {{.*}}@local(
+// CHECK: getelementptr {{.*}}, !cheerp.array.extent ![[SMALL:[0-9]+]]{{$}}
+// CHECK: getelementptr {{.*}}, !cheerp.array.extent ![[SMALL]], !cheerp.inbounds ![[INBOUNDS]]
+int local(int i) {
+  int a[4] = {1, 2, 3, 4};
+  return a[i] + a[3];
+}
+
+// CHECK-DAG: ![[EXTENT]] = !{i32 256}
+// CHECK-DAG: ![[SMALL]] = !{i32 4}
+// CHECK-DAG: ![[INBOUNDS]] = !{}
+
+// NATIVE-NOT: cheerp.array.extent
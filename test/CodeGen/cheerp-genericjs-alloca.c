@@ -0,0 +1,33 @@
+// RUN: %clang_cc1 -triple cheerp-leaningtech-webbrowser-genericjs -emit-llvm -o - %s | FileCheck %s
+
+int use(int *p);
+
+// Constant size allocas outside of loops become local arrays
+// CHECK-LABEL: @scratch
+// CHECK: alloca [4 x i32]
+// CHECK-NOT: llvm.cheerp.allocate
+// CHECK: ret
+int scratch() {
+  int *p = (int*)__builtin_alloca(4 * sizeof(int));
+  return use(p);
+}
+
+// Allocas in loops must return new memory on every iteration
+// CHECK-LABEL: @inLoop
+// CHECK: call {{.*}}@llvm.cheerp.allocate
+int inLoop(int n) {
+  int ret = 0;
+  for (int i = 0; i < n; i++) {
+    int *p = (int*)__builtin_alloca(4 * sizeof(int));
+    ret += use(p);
+  }
+  return ret;
+}
+
+// Allocas with an unknown size are still heap allocated
+// CHECK-LABEL: @dynamic
+// CHECK: call {{.*}}@llvm.cheerp.allocate
+int dynamic(int n) {
+  int *p = (int*)__builtin_alloca(n * sizeof(int));
+  return use(p);
+}
@@ -0,0 +1,28 @@
+// RUN: %clang_cc1 -triple cheerp-leaningtech-webbrowser-genericjs -emit-llvm -o - %s | FileCheck %s
+
+struct point { int x; float y; };
+
+// Small constant copies of struct arrays are unrolled field by field
+// CHECK-LABEL: define {{.*}}void @copy_points(
+// CHECK-NOT: call {{.*}}memcpy
+// CHECK-COUNT-4: store
+// CHECK-NOT: call {{.*}}memcpy
+// CHECK: ret void
+// CHECK-NEXT: }
+void copy_points(struct point *dst, struct point *src) {
+  __builtin_memcpy((void*)dst, (void*)src, 2 * sizeof(struct point));
+}
+
+// Copies with an unknown size are still left to the backend
+// CHECK-LABEL: define {{.*}}void @copy_points_n(
+// CHECK: call {{.*}}memcpy
+void copy_points_n(struct point *dst, struct point *src, unsigned n) {
+  __builtin_memcpy((void*)dst, (void*)src, n * sizeof(struct point));
+}
+
+// Arrays of primitive types are copied as a whole
+// CHECK-LABEL: define {{.*}}void @copy_floats(
+// CHECK: call {{.*}}memcpy
+void copy_floats(float *dst, float *src) {
+  __builtin_memcpy((void*)dst, (void*)src, 4 * sizeof(float));
+}
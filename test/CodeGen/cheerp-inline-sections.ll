@@ -0,0 +1,46 @@
+; RUN: %clang_cc1 -triple cheerp-leaningtech-webbrowser-wasm -O2 -emit-llvm \
+; RUN:     -o - -x ir %s | FileCheck %s
+; RUN: %clang_cc1 -triple cheerp-leaningtech-webbrowser-wasm -O2 -emit-llvm \
+; RUN:     -mllvm -print-after=cheerp-inline -o /dev/null -x ir %s 2>&1 \
+; RUN:     | FileCheck -check-prefix=PRINT %s
+
+; PRINT: IR Dump After Cheerp Function Inlining
+
+@counter = global i32 0
+
+define i32 @wasmAdd(i32 %a, i32 %b) section "asmjs" {
+  %r = add i32 %a, %b
+  ret i32 %r
+}
+
+define i32 @jsAdd(i32 %a, i32 %b) {
+  %r = add i32 %a, %b
+  ret i32 %r
+}
+
+define i32 @jsCounter(i32 %a) {
+  %c = load i32, i32* @counter
+  %r = add i32 %c, %a
+  ret i32 %r
+}
+
+; wasm code is never inlined into genericjs code
+; CHECK-LABEL: define {{.*}}@jsCaller(
+; CHECK: call {{.*}}@wasmAdd(
+define i32 @jsCaller(i32 %a, i32 %b) {
+  %r = call i32 @wasmAdd(i32 %a, i32 %b)
+  ret i32 %r
+}
+
+; genericjs code that only computes on scalars is inlined into wasm code,
+; genericjs code using JS objects is not
+; CHECK-LABEL: define {{.*}}@wasmCaller(
+; CHECK-NOT: call {{.*}}@jsAdd(
+; CHECK: call {{.*}}@jsCounter(
+; CHECK-NOT: call {{.*}}@jsAdd(
+; CHECK: ret
+define i32 @wasmCaller(i32 %a, i32 %b) section "asmjs" {
+  %x = call i32 @jsAdd(i32 %a, i32 %b)
+  %y = call i32 @jsCounter(i32 %x)
+  ret i32 %y
+}
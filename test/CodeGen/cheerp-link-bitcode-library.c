@@ -0,0 +1,41 @@
+// RUN: %clang_cc1 -triple i386-pc-linux-gnu -emit-llvm-bc -DLIB1 -o %t.lib1.bc %s
+// RUN: %clang_cc1 -triple i386-pc-linux-gnu -emit-llvm-bc -DLIB2 -o %t.lib2.bc %s
+// RUN: %clang_cc1 -triple i386-pc-linux-gnu -emit-llvm-bc -o %t.main.bc %s
+// RUN: %clang_cc1 -triple i386-pc-linux-gnu -emit-llvm -x ir %t.main.bc \
+// RUN:     -cheerp-link-bitcode-library %t.lib2.bc \
+// RUN:     -cheerp-link-bitcode-library %t.lib1.bc -o %t.ll
+// RUN: FileCheck %s < %t.ll
+// RUN: FileCheck -check-prefix=UNUSED %s < %t.ll
+
+// The same libraries in an archive, given twice: each member is linked at
+// most once over all the searches of the archive.
+// RUN: rm -f %t.a
+// RUN: llvm-ar rc %t.a %t.lib1.bc %t.lib2.bc
+// RUN: %clang_cc1 -triple i386-pc-linux-gnu -emit-llvm -x ir %t.main.bc \
+// RUN:     -cheerp-link-bitcode-library %t.a \
+// RUN:     -cheerp-link-bitcode-library %t.a -o %t.archive.ll
+// RUN: FileCheck %s < %t.archive.ll
+
+// Only the needed library symbols are linked, and a library can need symbols
+// from one given before it. Global constructors are linked exactly once.
+
+// CHECK: @llvm.global_ctors = appending global [1 x
+// CHECK-DAG: define i32 @g(
+// CHECK-DAG: define i32 @h(
+// CHECK-DAG: define i32 @k(
+// CHECK-DAG: define void @init(
+// UNUSED-NOT: @unused
+
+#if defined(LIB1)
+int k(int);
+int x;
+__attribute__((constructor)) void init(void) { x = 1; }
+int h(int a) { return k(a) + x; }
+int unused1(void) { return 1; }
+#elif defined(LIB2)
+int k(int a) { return a + 1; }
+int unused2(void) { return 2; }
+#else
+int h(int);
+int g(void) { return h(41); }
+#endif
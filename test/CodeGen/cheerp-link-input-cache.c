@@ -0,0 +1,37 @@
+// RUN: rm -rf %t.cache
+// RUN: %clang_cc1 -triple i386-pc-linux-gnu -emit-llvm-bc -DLIB -o %t.lib.bc %s
+// RUN: %clang_cc1 -triple i386-pc-linux-gnu -emit-llvm-bc -o %t.main.bc %s
+// RUN: %clang_cc1 -triple i386-pc-linux-gnu -O2 -cheerp-lto-cache-dir %t.cache \
+// RUN:     -cheerp-cache-link-inputs -emit-llvm -o %t1.ll -x ir %t.main.bc \
+// RUN:     -mlink-bitcode-file %t.lib.bc
+// RUN: ls %t.cache | grep -c '^input-' | grep 2
+// RUN: ls %t.cache | grep -c '^lto-' | grep 1
+// RUN: FileCheck %s < %t1.ll
+
+// A second run reuses every entry and produces the same output.
+// RUN: %clang_cc1 -triple i386-pc-linux-gnu -O2 -cheerp-lto-cache-dir %t.cache \
+// RUN:     -cheerp-cache-link-inputs -emit-llvm -o %t2.ll -x ir %t.main.bc \
+// RUN:     -mlink-bitcode-file %t.lib.bc
+// RUN: ls %t.cache | count 3
+// RUN: diff %t1.ll %t2.ll
+
+// Changing one input only adds an entry for that input.
+// RUN: %clang_cc1 -triple i386-pc-linux-gnu -emit-llvm-bc -DOTHER -o %t.main.bc %s
+// RUN: %clang_cc1 -triple i386-pc-linux-gnu -O2 -cheerp-lto-cache-dir %t.cache \
+// RUN:     -cheerp-cache-link-inputs -emit-llvm -o %t3.ll -x ir %t.main.bc \
+// RUN:     -mlink-bitcode-file %t.lib.bc
+// RUN: ls %t.cache | grep -c '^input-' | grep 3
+
+#ifdef LIB
+int f(int x) { return x * 2; }
+#else
+int f(int x);
+
+// CHECK-LABEL: define i32 @g
+// CHECK: ret i32 42
+#ifdef OTHER
+int g(void) { return f(20) + 2; }
+#else
+int g(void) { return f(21); }
+#endif
+#endif
@@ -0,0 +1,84 @@
+; RUN: %clang_cc1 -triple cheerp-leaningtech-webbrowser-genericjs -emit-llvm \
+; RUN:     -cheerp-link-roots-only -o %t.ll -x ir %s
+; RUN: FileCheck %s < %t.ll
+; RUN: FileCheck -check-prefix=UNUSED %s < %t.ll
+; RUN: %clang_cc1 -triple i386-pc-linux-gnu -emit-llvm -cheerp-link-roots-only \
+; RUN:     -o - -x ir %s 2>/dev/null | FileCheck -check-prefix=OTHER %s
+; RUN: %clang_cc1 -triple cheerp-leaningtech-webbrowser-wasm -emit-llvm \
+; RUN:     -cheerp-link-roots-only -o %t.wasm.ll -x ir \
+; RUN:     %S/Inputs/cheerp-link-roots-wasm.ll
+; RUN: FileCheck -check-prefix=WASM %s < %t.wasm.ll
+; RUN: FileCheck -check-prefix=WASM-UNUSED %s < %t.wasm.ll
+
+; Only what is reachable from webMain, the jsexport metadata and the used
+; globals is kept.
+
+target triple = "cheerp-leaningtech-webbrowser-genericjs"
+
+%class._Z3Foo = type { i32 }
+
+@llvm.used = appending global [1 x i8*] [i8* bitcast (i32 ()* @kept to i8*)], section "llvm.metadata"
+
+; CHECK-DAG: define void @webMain()
+; CHECK-DAG: define internal i32 @helper()
+; CHECK-DAG: define i32 @exported()
+; CHECK-DAG: define i32 @batch()
+; CHECK-DAG: define void @_ZN3Foo3barEv(
+; CHECK-DAG: define i32 @kept()
+; UNUSED-NOT: @unused
+
+; A wasm only program is entered through main, runtime functions are only
+; kept when they are used
+; WASM-DAG: define i32 @main()
+; WASM-DAG: define internal i32 @wasmHelper()
+; WASM-DAG: define i8* @malloc(
+; WASM-UNUSED-NOT: @wasmUnused
+; WASM-UNUSED-NOT: @calloc
+
+; Other targets keep everything
+; OTHER-DAG: define i32 @unused()
+; OTHER-DAG: define i32 @unused_methods()
+
+define void @webMain() {
+  %1 = call i32 @helper()
+  ret void
+}
+
+define i32 @helper() {
+  ret i32 1
+}
+
+define i32 @exported() {
+  ret i32 2
+}
+
+define i32 @batch() {
+  ret i32 2
+}
+
+define void @_ZN3Foo3barEv(%class._Z3Foo* %this) {
+  ret void
+}
+
+define i32 @kept() {
+  ret i32 4
+}
+
+define i32 @unused() {
+  ret i32 3
+}
+
+define i32 @unused_methods() {
+  ret i32 5
+}
+
+!jsexported_free_functions = !{!0}
+!jsexported_batch_functions = !{!2}
+!class._Z3Foo_methods = !{!1}
+; Not the methods of a record, the prefix does not name a struct type
+!unrelated_methods = !{!3}
+
+!0 = !{i32 ()* @exported}
+!1 = !{void (%class._Z3Foo*)* @_ZN3Foo3barEv, i32 0}
+!2 = !{i32 ()* @batch}
+!3 = !{i32 ()* @unused_methods, i32 0}
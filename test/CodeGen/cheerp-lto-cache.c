@@ -0,0 +1,23 @@
+// RUN: rm -rf %t.cache
+// RUN: %clang_cc1 -triple i386-pc-linux-gnu -emit-llvm-bc -o %t.bc %s
+// RUN: %clang_cc1 -triple i386-pc-linux-gnu -O2 -cheerp-lto-cache-dir %t.cache \
+// RUN:     -emit-llvm -o %t1.ll -x ir %t.bc
+// RUN: ls %t.cache | count 1
+// RUN: FileCheck %s < %t1.ll
+
+// A second run reuses the cached module and produces the same output.
+// RUN: %clang_cc1 -triple i386-pc-linux-gnu -O2 -cheerp-lto-cache-dir %t.cache \
+// RUN:     -emit-llvm -o %t2.ll -x ir %t.bc
+// RUN: ls %t.cache | count 1
+// RUN: diff %t1.ll %t2.ll
+
+// Different optimization options use a different entry.
+// RUN: %clang_cc1 -triple i386-pc-linux-gnu -O1 -cheerp-lto-cache-dir %t.cache \
+// RUN:     -emit-llvm -o %t3.ll -x ir %t.bc
+// RUN: ls %t.cache | count 2
+
+static int f(int x) { return x * 2; }
+
+// CHECK-LABEL: define i32 @g
+// CHECK: ret i32 42
+int g(void) { return f(21); }
@@ -0,0 +1,25 @@
+// RUN: %clang_cc1 -triple cheerp-leaningtech-webbrowser-wasm -O1 -emit-llvm -o - %s | FileCheck -check-prefix=LOWERED %s
+// RUN: %clang_cc1 -triple cheerp-leaningtech-webbrowser-wasm -cheerp-wasm-shared-memory -O1 -emit-llvm -o - %s | FileCheck -check-prefix=SHARED %s
+// RUN: %clang_cc1 -triple cheerp-leaningtech-webbrowser-genericjs -cheerp-wasm-shared-memory -O1 -emit-llvm -o - %s | FileCheck -check-prefix=LOWERED %s
+// RUN: %clang_cc1 -triple cheerp-leaningtech-webbrowser-wasm -cheerp-wasm-shared-memory -E -dM %s | FileCheck -check-prefix=LOCK-FREE %s
+
+// Without shared memory Cheerp is single threaded and atomics become regular
+// memory operations. genericjs code never shares memory, so its atomics are
+// always lowered.
+
+// LOWERED-LABEL: @increment(
+// LOWERED-NOT: atomicrmw
+// SHARED-LABEL: @increment(
+// SHARED: atomicrmw add i32* {{.*}} seq_cst
+int increment(_Atomic int *counter) {
+  return __c11_atomic_fetch_add(counter, 1, __ATOMIC_SEQ_CST);
+}
+
+// SHARED-LABEL: @publish(
+// SHARED: store atomic i32 {{.*}} release
+void publish(_Atomic int *flag) {
+  __c11_atomic_store(flag, 1, __ATOMIC_RELEASE);
+}
+
+// LOCK-FREE: #define __GCC_ATOMIC_INT_LOCK_FREE 2
+// LOCK-FREE: #define __GCC_ATOMIC_LLONG_LOCK_FREE 2
@@ -0,0 +1,33 @@
+// RUN: %clang_cc1 -triple x86_64-apple-darwin -O1 -disable-llvm-passes \
+// RUN:     -emit-llvm -o - %s | FileCheck %s
+//
+// A copy through a may_alias typedef only gets char field tags, even after a
+// copy of the same struct without the attribute.
+
+struct S {
+  int i;
+  float f;
+};
+
+typedef struct S __attribute__((may_alias)) AS;
+
+void copy(struct S *a, struct S *b) {
+// CHECK-LABEL: @copy(
+// CHECK: call void @llvm.memcpy{{.*}}, !tbaa.struct [[TS:![0-9]+]]
+  *a = *b;
+}
+
+void copyMayAlias(AS *a, AS *b) {
+// CHECK-LABEL: @copyMayAlias(
+// CHECK: call void @llvm.memcpy{{.*}}, !tbaa.struct [[TS_ALIAS:![0-9]+]]
+  *a = *b;
+}
+
+// CHECK-DAG: [[TS]] = !{i64 0, i64 4, [[TAG_INT:![0-9]+]], i64 4, i64 4, [[TAG_FLOAT:![0-9]+]]}
+// CHECK-DAG: [[TS_ALIAS]] = !{i64 0, i64 4, [[TAG_CHAR:![0-9]+]], i64 4, i64 4, [[TAG_CHAR]]}
+// CHECK-DAG: [[TAG_INT]] = !{[[INT:![0-9]+]], [[INT]], i64 0}
+// CHECK-DAG: [[INT]] = !{!"int",
+// CHECK-DAG: [[TAG_FLOAT]] = !{[[FLOAT:![0-9]+]], [[FLOAT]], i64 0}
+// CHECK-DAG: [[FLOAT]] = !{!"float",
+// CHECK-DAG: [[TAG_CHAR]] = !{[[CHAR:![0-9]+]], [[CHAR]], i64 0}
+// CHECK-DAG: [[CHAR]] = !{!"omnipotent char",
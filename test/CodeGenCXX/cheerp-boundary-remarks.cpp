@@ -0,0 +1,23 @@
+// RUN: %clang_cc1 -triple cheerp-leaningtech-webbrowser-wasm -emit-llvm -o /dev/null -Rcheerp-boundary -verify %s
+// RUN: %clang_cc1 -triple cheerp-leaningtech-webbrowser-wasm -emit-llvm -o /dev/null -Werror %s
+
+[[cheerp::genericjs]] int jsHelper(int x);
+int wasmHelper(int x);
+
+int wasmCaller(int n) {
+  int sum = jsHelper(n); // expected-remark {{call from wasm function 'wasmCaller' to genericjs function 'jsHelper' crosses the section boundary at loop depth 0}}
+  for (int i = 0; i < n; ++i) {
+    while (sum > i)
+      sum -= jsHelper(i); // expected-remark {{call from wasm function 'wasmCaller' to genericjs function 'jsHelper' crosses the section boundary at loop depth 2}}
+    sum += wasmHelper(i);
+  }
+  return sum;
+}
+
+[[cheerp::genericjs]] int jsCaller(int n) {
+  int sum = 0;
+  do {
+    sum += wasmHelper(n); // expected-remark {{call from genericjs function 'jsCaller' to wasm function 'wasmHelper' crosses the section boundary at loop depth 1}}
+  } while (--n);
+  return sum + jsHelper(sum);
+}
@@ -0,0 +1,34 @@
+// RUN: %clang_cc1 -triple cheerp-leaningtech-webbrowser-genericjs -std=c++11 -emit-llvm -o - %s | FileCheck %s
+
+namespace [[cheerp::genericjs]] client
+{
+	class [[cheerp::client_layout]] Object
+	{
+	};
+
+	class Point : public Object
+	{
+	public:
+		double x;
+		double y;
+		Object* label;
+	};
+}
+
+// Regular records don't get a shape
+struct Plain
+{
+	int a;
+	int b;
+};
+
+double norm1(client::Point* p, Plain* q)
+{
+	return p->x + p->y + q->a;
+}
+
+// Properties are listed in layout order
+// CHECK-NOT: Plain{{.*}}_shape
+// CHECK: Point{{.*}}_shape = !{![[SHAPE:[0-9]+]]}
+// CHECK-NOT: Plain{{.*}}_shape
+// CHECK: ![[SHAPE]] = !{!"x", !"y", !"label"}
@@ -0,0 +1,32 @@
+// RUN: %clang_cc1 -triple cheerp-leaningtech-webbrowser-genericjs -std=c++11 -emit-llvm -o - %s | FileCheck %s
+// RUN: %clang_cc1 -triple cheerp-leaningtech-webbrowser-genericjs -std=c++11 -fsyntax-only -verify %s
+
+struct Node {
+  int value;
+  Node *next;
+};
+
+void visit(Node *n [[cheerp::complete_object]], int *counter);
+struct Visitor {
+  void visit(Node *n [[cheerp::complete_object]]);
+};
+
+// expected-warning@+1 {{'complete_object' attribute ignored}}
+void byValue(int n [[cheerp::complete_object]]);
+
+// Only the arguments bound to a complete_object parameter are converted
+// CHECK-LABEL: define {{.*}}@_Z4walkP4NodePi(
+// CHECK: %[[C:.*]] = call %struct.{{.*}}Node* @llvm.cheerp.make.complete.object.{{.*}}(%struct.{{.*}}Node* %{{.*}})
+// CHECK-NOT: make.complete.object
+// CHECK: call void @_Z5visitP4NodePi(%struct.{{.*}}Node* %[[C]], i32* %{{.*}})
+void walk(Node *n, int *counter) {
+  visit(n, counter);
+}
+
+// CHECK-LABEL: define {{.*}}@_Z9walkArrayP4NodeP7Visitor(
+// CHECK: %[[E:.*]] = call %struct.{{.*}}Node* @llvm.cheerp.make.complete.object.{{.*}}(%struct.{{.*}}Node* %{{.*}})
+// CHECK: call void @_ZN7Visitor5visitEP4Node(%struct.{{.*}}Visitor* %{{.*}}, %struct.{{.*}}Node* %[[E]])
+void walkArray(Node *nodes, Visitor *v) {
+  v->visit(&nodes[1]);
+}
+
@@ -0,0 +1,43 @@
+// RUN: %clang_cc1 -triple cheerp-leaningtech-webbrowser-genericjs -std=c++11 -emit-llvm -o - %s | FileCheck %s
+
+struct Shape {
+  virtual ~Shape();
+};
+
+struct Circle final : Shape {
+  int radius;
+};
+
+struct Polygon : Shape {
+  int sides;
+};
+
+// The compared vtable is emitted even though nothing constructs a Circle
+// CHECK: @_ZTV6Circle = linkonce_odr
+
+// A final destination only needs a vtable comparison
+// CHECK-LABEL: define {{.*}}@_Z8asCircleP5Shape(
+// CHECK-NOT: __dynamic_cast
+// CHECK: icmp eq {{.*}}@_ZTV6Circle
+// CHECK: select i1
+// CHECK-NOT: __dynamic_cast
+// CHECK: ret
+Circle *asCircle(Shape *s) {
+  return dynamic_cast<Circle *>(s);
+}
+
+// CHECK-LABEL: define {{.*}}@_Z11asCircleRefR5Shape(
+// CHECK-NOT: __dynamic_cast
+// CHECK: icmp eq {{.*}}@_ZTV6Circle
+// CHECK: call void @__cxa_bad_cast()
+Circle &asCircleRef(Shape &s) {
+  return dynamic_cast<Circle &>(s);
+}
+
+// Other classes still use the runtime
+// CHECK-LABEL: define {{.*}}@_Z9asPolygonP5Shape(
+// CHECK: call {{.*}}@__dynamic_cast(
+// CHECK: cheerp_downcast_end:
+Polygon *asPolygon(Shape *s) {
+  return dynamic_cast<Polygon *>(s);
+}
@@ -0,0 +1,48 @@
+// RUN: %clang_cc1 -triple cheerp-leaningtech-webbrowser-genericjs -std=c++11 -emit-llvm -o - %s | FileCheck %s
+// RUN: %clang_cc1 -triple cheerp-leaningtech-webbrowser-wasm -std=c++11 -emit-llvm -o - %s | FileCheck %s
+
+struct Pair {
+  int first;
+  int *second;
+};
+
+struct Triple {
+  int a, b, c;
+};
+
+struct Base {
+  int a;
+};
+struct Derived : Base {
+  int b;
+};
+
+struct NonTrivial {
+  int a;
+  NonTrivial(const NonTrivial &);
+};
+
+// Records of up to two scalars are passed as their fields
+// CHECK-LABEL: define {{.*}}@_Z4take4Pair(i32 %{{.*}}, i32* %{{.*}})
+int take(Pair p) { return p.first + *p.second; }
+
+// CHECK-LABEL: define {{.*}}@_Z4callPi(
+// CHECK: call {{.*}}@_Z4take4Pair(i32 %{{.*}}, i32* %{{.*}})
+int call(int *x) { return take(Pair{1, x}); }
+
+// Everything else keeps the byval pointer
+// CHECK-LABEL: define {{.*}}@_Z4take6Triple(%struct.{{.*}}Triple* {{.*}}byval
+int take(Triple t) { return t.a; }
+
+// CHECK-LABEL: define {{.*}}@_Z4take7Derived(%struct.{{.*}}Derived* {{.*}}byval
+int take(Derived d) { return d.b; }
+
+// CHECK-LABEL: define {{.*}}@_Z4take10NonTrivial(%struct.{{.*}}NonTrivial*
+// CHECK-NOT: i32 %
+int take(NonTrivial n) { return n.a; }
+
+// Variadic arguments are not expanded
+void variadic(int n, ...);
+// CHECK-LABEL: define {{.*}}@_Z11callVariadicPi(
+// CHECK: call void (i32, ...) @_Z8variadiciz(i32 1, %struct.{{.*}}Pair* {{.*}}byval
+void callVariadic(int *x) { variadic(1, Pair{1, x}); }
@@ -0,0 +1,25 @@
+// RUN: %clang_cc1 -triple cheerp-leaningtech-webbrowser-genericjs -O2 -emit-llvm -o - %s | FileCheck %s
+
+[[cheerp::wasm]] int wasmAdd(int a, int b) {
+  return a + b;
+}
+
+int jsAdd(int a, int b) {
+  return a + b;
+}
+
+// Calls to the other section are never inlined, calls in the same section are
+// CHECK-LABEL: define {{.*}}@_Z6callerii(
+// CHECK: call {{.*}}@_Z7wasmAddii(
+// CHECK-NOT: call {{.*}}@_Z5jsAddii(
+// CHECK: ret
+int caller(int a, int b) {
+  return wasmAdd(a, b) + jsAdd(a, b);
+}
+
+// CHECK-LABEL: define {{.*}}@_Z10wasmCallerii(
+// CHECK-NOT: call {{.*}}@_Z7wasmAddii(
+// CHECK: ret
+[[cheerp::wasm]] int wasmCaller(int a, int b) {
+  return wasmAdd(a, b) * 2;
+}
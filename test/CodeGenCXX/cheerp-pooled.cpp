@@ -0,0 +1,77 @@
+// RUN: %clang_cc1 -triple cheerp-leaningtech-webbrowser-genericjs -std=c++11 -emit-llvm -o - %s | FileCheck %s
+// RUN: not %clang_cc1 -triple cheerp-leaningtech-webbrowser-genericjs -std=c++11 -DERRORS -fsyntax-only %s 2>&1 | FileCheck -check-prefix=ERR %s
+
+#ifndef ERRORS
+struct [[cheerp::pooled]] Iterator {
+  int *pos;
+  int step;
+  Iterator(int *p, int s) : pos(p), step(s) {}
+};
+
+struct Plain {
+  int value;
+};
+
+namespace {
+struct [[cheerp::pooled]] Local {
+  int value;
+};
+}
+
+// CHECK: @[[POOL:cheerp.pool.[^ ]*Iterator]] = linkonce_odr global [32 x %[[ITER:[^ ]*Iterator]]*] zeroinitializer
+// CHECK: @[[POOL]].count = linkonce_odr global i32 0
+// Types local to this translation unit get their own pool
+// CHECK: @[[LOCALPOOL:cheerp.pool.[^ ]*Local]] = internal global [32 x
+// CHECK: @[[LOCALPOOL]].count = internal global i32 0
+
+// A released object is reused before allocating a new one
+// CHECK-LABEL: define {{.*}}@_Z6createPi(
+// CHECK: %[[N:.*]] = load i32, i32* @[[POOL]].count
+// CHECK: icmp eq i32 %[[N]], 0
+// CHECK: pool.reuse:
+// CHECK: getelementptr inbounds [32 x %[[ITER]]*], [32 x %[[ITER]]*]* @[[POOL]]
+// CHECK: pool.alloc:
+// CHECK: call %[[ITER]]* @llvm.cheerp.allocate
+// CHECK: pool.cont:
+// CHECK: phi %[[ITER]]*
+// CHECK: call void @_ZN8IteratorC1EPii(
+Iterator *create(int *p) {
+  return new Iterator(p, 1);
+}
+
+// CHECK-LABEL: define {{.*}}@_Z7destroyP8Iterator(
+// CHECK: icmp uge i32 %{{.*}}, 32
+// CHECK: pool.keep:
+// CHECK: store %[[ITER]]* %{{.*}}, %[[ITER]]** %{{.*}}
+// CHECK: pool.drop:
+// CHECK: call void @llvm.cheerp.deallocate
+void destroy(Iterator *it) {
+  delete it;
+}
+
+// Other types and arrays keep the regular allocator
+// CHECK-LABEL: define {{.*}}@_Z11createPlainv(
+// CHECK-NOT: cheerp.pool
+// CHECK: call {{.*}}@llvm.cheerp.allocate
+Plain *createPlain() {
+  return new Plain();
+}
+
+// CHECK-LABEL: define {{.*}}@_Z11createArrayPi(
+// CHECK-NOT: cheerp.pool
+// CHECK: ret
+Iterator *createArray(int *p) {
+  return new Iterator[2]{{p, 1}, {p, 2}};
+}
+// CHECK-LABEL: define {{.*}}@_Z11createLocalv(
+// CHECK: load i32, i32* @[[LOCALPOOL]].count
+void *createLocal() {
+  return new Local();
+}
+
+#else
+// ERR: error: 'pooled' and 'asmjs' attributes are not compatible
+struct [[cheerp::asmjs]] [[cheerp::pooled]] Linear {
+  int x;
+};
+#endif
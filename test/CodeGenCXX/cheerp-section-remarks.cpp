@@ -0,0 +1,24 @@
+// RUN: %clang_cc1 -triple cheerp-leaningtech-webbrowser-wasm -emit-llvm -o /dev/null -Rcheerp-section -verify %s
+// RUN: %clang_cc1 -triple cheerp-leaningtech-webbrowser-wasm -emit-llvm -o /dev/null -Werror %s
+
+// Inline functions and templates get the wasm section of the translation unit
+inline int twice(int x) { return x * 2; }
+
+template<class T>
+T square(T x) { return x * x; }
+
+[[cheerp::wasm]] inline int explicitTwice(int x) { return x * 2; }
+
+int notInline(int x);
+
+[[cheerp::genericjs]] int jsCaller(int x) {
+  return twice(x) + // expected-remark {{call from genericjs function 'jsCaller' to 'twice', which is placed in the wasm section by default; annotating 'twice' with [[cheerp::genericjs]] avoids the boundary crossing}}
+         square(x) + // expected-remark {{call from genericjs function 'jsCaller' to 'square<int>', which is placed in the wasm section by default}}
+         explicitTwice(x) +
+         notInline(x);
+}
+
+// Calls in the same section are fine
+int wasmCaller(int x) {
+  return twice(x) + square(x);
+}
@@ -0,0 +1,34 @@
+// RUN: %clang_cc1 -triple cheerp-leaningtech-webbrowser-genericjs -std=c++11 -emit-llvm -o - %s | FileCheck %s
+
+// Non-constexpr constructors and functions without side effects outside the
+// initialized object are folded into a constant initializer.
+struct Point {
+  int x, y;
+  Point(int a, int b) : x(a), y(b * 2) {}
+};
+
+static int square(int v) { return v * v; }
+
+// CHECK-DAG: @p = {{.*}}global {{.*}} { i32 1, i32 4 }
+Point p(1, 2);
+// CHECK-DAG: @sq = {{.*}}global i32 9
+int sq = square(3);
+
+// Initializers with side effects on other objects stay dynamic.
+int counter;
+static int next() { return ++counter; }
+// CHECK-DAG: @n = {{.*}}global i32 0
+int n = next();
+
+// Calls to functions without an available body stay dynamic.
+int external();
+// CHECK-DAG: @e = {{.*}}global i32 0
+int e = external();
+
+// CHECK: define internal void @__cxx_global_var_init
+// CHECK-NOT: @p
+// CHECK-NOT: @sq
+// CHECK: call i32 @_ZL4nextv()
+// CHECK: store i32 {{.*}}, i32* @n
+// CHECK: call i32 @_Z8externalv()
+// CHECK: store i32 {{.*}}, i32* @e
@@ -0,0 +1,22 @@
+// RUN: %clang_cc1 -triple cheerp-leaningtech-webbrowser-genericjs -emit-llvm -o - %s | FileCheck %s
+
+struct A { int a; };
+struct B : A { int b; };
+struct C : B { int c; };
+struct Empty { int get() const { return 0; } };
+struct D : Empty { int d; };
+
+// Single inheritance first bases are in the directbase chain, the upcast is
+// folded to a bitcast
+// CHECK-LABEL: @_Z6toBaseP1C
+// CHECK-NOT: cheerp.upcast.collapsed
+// CHECK: bitcast %struct.{{.*}}1C* %{{.*}} to %struct.{{.*}}1A*
+// CHECK-NOT: cheerp.upcast.collapsed
+// CHECK: ret
+A *toBase(C *c) { return c; }
+
+// Empty bases have no storage in the derived object and still need the
+// intrinsic
+// CHECK-LABEL: @_Z7toEmptyP1D
+// CHECK: call {{.*}}@llvm.cheerp.upcast.collapsed
+Empty *toEmpty(D *d) { return d; }
@@ -0,0 +1,31 @@
+// RUN: %clang_cc1 -triple cheerp-leaningtech-webbrowser-genericjs -fwhole-program-vtables -emit-llvm -o - %s | FileCheck %s
+// RUN: %clang_cc1 -triple cheerp-leaningtech-webbrowser-genericjs -emit-llvm -o - %s | FileCheck -check-prefix=NO-WPV %s
+
+// Genericjs vtables describe the class of each vtable of the group by index
+// CHECK: @_ZTV1B = {{.*}} !cheerp.vtable.type [[B0A:![0-9]+]] !cheerp.vtable.type [[B0B:![0-9]+]] !cheerp.vtable.type [[B1C:![0-9]+]]
+// CHECK-NOT: llvm.type.test
+// CHECK-DAG: [[B0A]] = !{i32 0, !"_ZTS1A"}
+// CHECK-DAG: [[B0B]] = !{i32 0, !"_ZTS1B"}
+// CHECK-DAG: [[B1C]] = !{i32 1, !"_ZTS1C"}
+
+// NO-WPV-NOT: !cheerp.vtable.type
+
+struct A {
+  virtual int f();
+};
+
+struct C {
+  virtual int g();
+};
+
+struct B : A, C {
+  int f() override;
+  int g() override;
+};
+
+int B::f() { return 1; }
+int B::g() { return 2; }
+
+int call(A *a) {
+  return a->f();
+}
@@ -0,0 +1,42 @@
+// RUN: %clang_cc1 -triple cheerp-leaningtech-webbrowser-wasm -fcxx-exceptions -fexceptions -cheerp-wasm-exceptions -emit-llvm -o - %s | FileCheck %s
+// RUN: %clang_cc1 -triple cheerp-leaningtech-webbrowser-wasm -fcxx-exceptions -fexceptions -emit-llvm -o - %s | FileCheck -check-prefix=LOWERED %s
+// RUN: %clang_cc1 -triple cheerp-leaningtech-webbrowser-wasm -fcxx-exceptions -fexceptions -emit-llvm -disable-llvm-passes -o - %s | FileCheck -check-prefix=NOEH %s
+// RUN: %clang_cc1 -triple cheerp-leaningtech-webbrowser-genericjs -fcxx-exceptions -fexceptions -cheerp-wasm-exceptions -emit-llvm -o - %s | FileCheck -check-prefix=LOWERED %s
+
+void mayThrow();
+
+// CHECK-LABEL: define {{.*}}@_Z6caughtv
+// CHECK: invoke void @_Z8mayThrowv()
+// CHECK: landingpad
+// genericjs code has no wasm try/catch, its invokes are always lowered.
+// LOWERED-LABEL: define {{.*}}@_Z6caughtv
+// LOWERED-NOT: invoke
+// LOWERED: call void @_Z8mayThrowv()
+int caught() {
+  try {
+    mayThrow();
+  } catch (int e) {
+    return e;
+  }
+  return 0;
+}
+
+struct Guard {
+  ~Guard();
+};
+
+// Without wasm exceptions no landing pads are emitted at all, and the
+// destructors only run on the normal path.
+// NOEH-LABEL: define {{.*}}@_Z7guardedv
+// NOEH-NOT: invoke
+// NOEH-NOT: landingpad
+// NOEH: call void @_Z8mayThrowv()
+// NOEH: call void @_ZN5GuardD{{[12]}}Ev(
+// NOEH: call void @_ZN5GuardD{{[12]}}Ev(
+// NOEH-NOT: landingpad
+// NOEH: ret void
+void guarded() {
+  Guard A;
+  Guard B;
+  mayThrow();
+}
@@ -0,0 +1,28 @@
+// RUN: %clang_cc1 -triple x86_64-unknown-linux-gnu -std=c++11 -emit-llvm -o - %s | FileCheck %s
+// RUN: %clang_cc1 -triple cheerp-leaningtech-webbrowser-genericjs -std=c++11 -emit-llvm -o - %s | FileCheck --check-prefix=CHEERP %s
+
+// Integer tables are emitted directly as data arrays.
+
+// CHECK: @bytes = constant [4 x i8] c"\01\02\03\04"
+extern const unsigned char bytes[4] = {1, 2, 3, 4};
+
+// CHECK: @words = constant [3 x i16] [i16 1, i16 -1, i16 3]
+extern const short words[3] = {1, -1, 3};
+
+// CHECK: @quads = constant [2 x i64] [i64 -1, i64 4294967296]
+extern const long long quads[2] = {-1, 4294967296LL};
+
+// CHECK: @zeroes = constant [16 x i32] zeroinitializer
+extern const int zeroes[16] = {0, 0};
+
+// Trailing zeroes still become a zeroinitializer filler.
+// CHECK: @padded = constant <{ [8 x i32], [24 x i32] }> <{ [8 x i32] [i32 1, i32 2, i32 3, i32 4, i32 5, i32 6, i32 7, i32 8], [24 x i32] zeroinitializer }>
+// CHEERP: @padded = constant [32 x i32] [i32 1, i32 2, i32 3, i32 4, i32 5, i32 6, i32 7, i32 8, i32 0,
+extern const int padded[32] = {1, 2, 3, 4, 5, 6, 7, 8};
+
+
+#ifndef __CHEERP__
+// A large bound with few initializers does not allocate the whole array.
+// CHECK: @sparse = constant <{ i32, [268435455 x i32] }> <{ i32 1, [268435455 x i32] zeroinitializer }>
+extern const int sparse[1 << 28] = {1};
+#endif
@@ -0,0 +1,35 @@
+// RUN: %clang_cc1 -triple x86_64-linux-gnu -fdelayed-inline-method-parsing -emit-llvm %s -o - | FileCheck %s
+// RUN: %clang_cc1 -triple x86_64-linux-gnu -fdelayed-inline-method-parsing -emit-llvm %s -o - | FileCheck %s --check-prefix=UNUSED
+// RUN: %clang_cc1 -triple cheerp-leaningtech-webbrowser-wasm -fdelayed-inline-method-parsing -emit-llvm %s -o - | FileCheck %s --check-prefix=CHEERP
+
+// Bodies of inline methods that are never used are not parsed, so the error
+// in S::unused is not diagnosed and no definition is emitted for it.
+
+struct S {
+  S() {}
+  int unused() { return undeclared_name; }
+  int helper() { return 42; }
+  int used() { return helper() + 1; }
+  virtual int virt() { return 2; }
+  static int viaTemplate() { return 3; }
+};
+
+template <typename T> int callUsed(T &t) { return t.used() + T::viaTemplate(); }
+
+int test() {
+  S s;
+  return callUsed(s);
+}
+
+// CHECK-DAG: define linkonce_odr {{.*}}@_ZN1SC2Ev(
+// CHECK-DAG: define linkonce_odr {{.*}}@_ZN1S4usedEv(
+// CHECK-DAG: define linkonce_odr {{.*}}@_ZN1S6helperEv(
+// CHECK-DAG: define linkonce_odr {{.*}}@_ZN1S4virtEv(
+// CHECK-DAG: define linkonce_odr {{.*}}@_ZN1S11viaTemplateEv(
+
+// UNUSED-NOT: _ZN1S6unusedEv
+
+// Cheerp adds implicit section attributes to every method and class, which
+// must not keep the bodies from being delayed.
+// CHEERP: define linkonce_odr {{.*}}@_ZN1S4usedEv(
+// CHEERP-NOT: _ZN1S6unusedEv
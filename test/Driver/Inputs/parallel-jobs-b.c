@@ -0,0 +1 @@
+int second = undeclared_in_b;
@@ -0,0 +1,15 @@
+// RUN: %clang -### -fintegrated-cc1 -c %s 2>&1 | FileCheck %s
+// CHECK: (in-process)
+// CHECK-NOT: "-disable-free"
+
+// RUN: %clang -### -c %s 2>&1 | FileCheck %s --check-prefix=NO-IN-PROCESS
+// RUN: %clang -### -fintegrated-cc1 -fno-integrated-cc1 -c %s 2>&1 \
+// RUN:   | FileCheck %s --check-prefix=NO-IN-PROCESS
+// NO-IN-PROCESS-NOT: (in-process)
+// NO-IN-PROCESS: "-disable-free"
+
+// Several in-process jobs given the same -mllvm options all succeed.
+// RUN: %clang -fintegrated-cc1 -fsyntax-only -mllvm -inline-threshold=100 \
+// RUN:   %s %s %s
+
+int f(void) { return 0; }
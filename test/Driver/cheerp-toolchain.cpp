@@ -0,0 +1,199 @@
+// Check the commands generated by the Cheerp toolchain for a full link:
+// llvm-link, then opt and finally llc.
+
+// A symbol-indexed archive of the runtime is preferred over the monolithic
+// bitcode library when the toolchain ships one.
+
+// RUN: %clangxx -### -no-canonical-prefixes \
+// RUN:   -target cheerp-leaningtech-webbrowser-genericjs \
+// RUN:   -ccc-install-dir %S/Inputs/cheerp_tree/bin %s 2>&1 \
+// RUN:   | FileCheck -check-prefix=STDLIBS-ARCHIVE %s
+// STDLIBS-ARCHIVE: llvm-link{{.*}}" "-o" "[[temp:[^"]*]]" {{.*}} "{{.*}}genericjs{{/|\\\\}}libstdlibs.a"
+// STDLIBS-ARCHIVE-NOT: libstdlibs.bc
+
+// RUN: %clangxx -### -no-canonical-prefixes \
+// RUN:   -target cheerp-leaningtech-webbrowser-wasm \
+// RUN:   -ccc-install-dir %S/Inputs/cheerp_tree/bin %s 2>&1 \
+// RUN:   | FileCheck -check-prefix=WASM-ARCHIVE %s
+// WASM-ARCHIVE: llvm-link{{.*}} "{{.*}}asmjs{{/|\\\\}}libstdlibs.a" "{{.*}}asmjs{{/|\\\\}}libwasm.a"
+
+// RUN: %clangxx -### -no-canonical-prefixes \
+// RUN:   -target cheerp-leaningtech-webbrowser-genericjs \
+// RUN:   -ccc-install-dir %S/Inputs/cheerp_bc_tree/bin %s 2>&1 \
+// RUN:   | FileCheck -check-prefix=STDLIBS-BC %s
+// STDLIBS-BC: llvm-link{{.*}} "{{.*}}genericjs{{/|\\\\}}libstdlibs.bc"
+
+// RUN: %clangxx -### -no-canonical-prefixes \
+// RUN:   -target cheerp-leaningtech-webbrowser-wasm -cheerp-wasm-enable=simd \
+// RUN:   -ccc-install-dir %S/Inputs/cheerp_tree/bin %s 2>&1 \
+// RUN:   | FileCheck -check-prefix=SIMD %s
+// SIMD: "-cc1" {{.*}} "-cheerp-wasm-simd"
+// SIMD-NOT: llc{{.*}}"-cheerp-wasm-simd"
+
+// RUN: %clangxx -### -no-canonical-prefixes \
+// RUN:   -target cheerp-leaningtech-webbrowser-wasm -cheerp-wasm-enable=bulkmemory \
+// RUN:   -ccc-install-dir %S/Inputs/cheerp_tree/bin %s 2>&1 \
+// RUN:   | FileCheck -check-prefix=BULKMEMORY %s
+// BULKMEMORY: "-cc1" {{.*}} "-cheerp-wasm-bulk-memory"
+// BULKMEMORY-NOT: llc{{.*}}"-cheerp-wasm-bulk-memory"
+
+// RUN: %clangxx -### -no-canonical-prefixes \
+// RUN:   -target cheerp-leaningtech-webbrowser-wasm -cheerp-wasm-enable=returncalls \
+// RUN:   -ccc-install-dir %S/Inputs/cheerp_tree/bin %s 2>&1 \
+// RUN:   | FileCheck -check-prefix=RETURNCALLS %s
+// RETURNCALLS: "-cc1" {{.*}} "-cheerp-wasm-return-calls"
+// RETURNCALLS: llc{{.*}}" "-march=cheerp" {{.*}} "-cheerp-wasm-return-calls"
+
+// RUN: %clangxx -### -no-canonical-prefixes \
+// RUN:   -target cheerp-leaningtech-webbrowser-wasm -cheerp-linear-heap-size=8192 \
+// RUN:   -ccc-install-dir %S/Inputs/cheerp_tree/bin %s 2>&1 \
+// RUN:   | FileCheck -check-prefix=HEAP-TOO-LARGE %s
+// HEAP-TOO-LARGE: error: '-cheerp-linear-heap-size=8192' exceeds the 4096 MB addressable by a 32-bit wasm memory
+
+// RUN: %clangxx -### -no-canonical-prefixes \
+// RUN:   -target cheerp-leaningtech-webbrowser-wasm -cheerp-wasm-enable=exceptions \
+// RUN:   -ccc-install-dir %S/Inputs/cheerp_tree/bin %s 2>&1 \
+// RUN:   | FileCheck -check-prefix=EXCEPTIONS %s
+// EXCEPTIONS: "-cc1" {{.*}} "-cheerp-wasm-exceptions"
+// EXCEPTIONS-SAME: "-fcxx-exceptions" "-fexceptions"
+// EXCEPTIONS-NOT: llc{{.*}}"-cheerp-wasm-exceptions"
+// RUN: %clangxx -### -no-canonical-prefixes \
+// RUN:   -target cheerp-leaningtech-webbrowser-wasm \
+// RUN:   -ccc-install-dir %S/Inputs/cheerp_tree/bin %s 2>&1 \
+// RUN:   | FileCheck -check-prefix=NO-EXCEPTIONS %s
+// NO-EXCEPTIONS: "-cc1"
+// NO-EXCEPTIONS-NOT: "-fcxx-exceptions"
+
+// RUN: %clangxx -### -no-canonical-prefixes -g \
+// RUN:   -target cheerp-leaningtech-webbrowser-genericjs \
+// RUN:   -ccc-install-dir %S/Inputs/cheerp_tree/bin %s 2>&1 \
+// RUN:   | FileCheck -check-prefix=NO-COLUMN-INFO %s
+// NO-COLUMN-INFO: "-cc1"
+// NO-COLUMN-INFO-NOT: "-dwarf-column-info"
+// RUN: %clangxx -### -no-canonical-prefixes -g -gcolumn-info \
+// RUN:   -target cheerp-leaningtech-webbrowser-genericjs \
+// RUN:   -ccc-install-dir %S/Inputs/cheerp_tree/bin %s 2>&1 \
+// RUN:   | FileCheck -check-prefix=COLUMN-INFO %s
+// COLUMN-INFO: "-cc1" {{.*}} "-dwarf-column-info"
+
+// RUN: %clangxx -### -no-canonical-prefixes -cheerp-sourcemap=out.map \
+// RUN:   -target cheerp-leaningtech-webbrowser-genericjs \
+// RUN:   -ccc-install-dir %S/Inputs/cheerp_tree/bin %s 2>&1 \
+// RUN:   | FileCheck -check-prefix=LINE-TABLES-ONLY %s
+// LINE-TABLES-ONLY: "-cc1" {{.*}} "-debug-info-kind=line-tables-only"
+// RUN: %clangxx -### -no-canonical-prefixes -g -cheerp-sourcemap=out.map \
+// RUN:   -target cheerp-leaningtech-webbrowser-genericjs \
+// RUN:   -ccc-install-dir %S/Inputs/cheerp_tree/bin %s 2>&1 \
+// RUN:   | FileCheck -check-prefix=LIMITED-DEBUG %s
+// LIMITED-DEBUG: "-cc1" {{.*}} "-debug-info-kind=limited"
+// RUN: %clangxx -### -no-canonical-prefixes -g -fstandalone-debug \
+// RUN:   -target cheerp-leaningtech-webbrowser-genericjs \
+// RUN:   -ccc-install-dir %S/Inputs/cheerp_tree/bin %s 2>&1 \
+// RUN:   | FileCheck -check-prefix=STANDALONE-DEBUG %s
+// STANDALONE-DEBUG: "-cc1" {{.*}} "-debug-info-kind=standalone"
+
+// RUN: %clangxx -### -no-canonical-prefixes -pthread \
+// RUN:   -target cheerp-leaningtech-webbrowser-wasm -cheerp-wasm-enable=sharedmem \
+// RUN:   -ccc-install-dir %S/Inputs/cheerp_tree/bin %s 2>&1 \
+// RUN:   | FileCheck -check-prefix=SHAREDMEM %s
+// SHAREDMEM: "-cc1" {{.*}} "-cheerp-wasm-shared-memory"
+// SHAREDMEM-NOT: libpthread
+// SHAREDMEM: llc{{.*}}" "-march=cheerp" {{.*}} "-cheerp-wasm-shared-memory"
+
+// RUN: %clangxx -### -no-canonical-prefixes \
+// RUN:   -target cheerp-leaningtech-webbrowser-genericjs -cheerp-make-module=amd \
+// RUN:   -ccc-install-dir %S/Inputs/cheerp_tree/bin %s 2>&1 \
+// RUN:   | FileCheck -check-prefix=MODULE-INVALID %s
+// MODULE-INVALID: error: invalid value 'amd' in '-cheerp-make-module=amd'
+
+// RUN: %clangxx -### -no-canonical-prefixes \
+// RUN:   -target cheerp-leaningtech-webbrowser-genericjs -cheerp-time-report \
+// RUN:   -ccc-install-dir %S/Inputs/cheerp_tree/bin %s 2>&1 \
+// RUN:   | FileCheck -check-prefix=TIME-REPORT %s
+// TIME-REPORT: clang{{.*}}" "-cc1" {{.*}} "-ftime-trace" "-ftime-trace-file" "{{.*}}time-trace{{.*}}.json"
+// TIME-REPORT: llvm-link
+
+// With -flto=thin the linked program is optimized at the user's -O level.
+// Nothing else of ThinLTO is implemented, which the driver warns about.
+
+// RUN: %clangxx -### -no-canonical-prefixes -flto=thin -O2 \
+// RUN:   -target cheerp-leaningtech-webbrowser-genericjs \
+// RUN:   -ccc-install-dir %S/Inputs/cheerp_tree/bin %s 2>&1 \
+// RUN:   | FileCheck -check-prefix=THINLTO %s
+// THINLTO: warning: ThinLTO is not implemented for Cheerp
+// THINLTO: clang{{.*}}" "-cc1" {{.*}} "-flto=thin"
+// THINLTO: opt{{.*}}" "-march=cheerp" {{.*}} "-FreeAndDeleteRemoval" "-O2" "-simplifycfg"
+// THINLTO-NOT: "-Os"
+
+// RUN: %clangxx -### -no-canonical-prefixes -flto=thin \
+// RUN:   -target cheerp-leaningtech-webbrowser-genericjs \
+// RUN:   -ccc-install-dir %S/Inputs/cheerp_tree/bin %s 2>&1 \
+// RUN:   | FileCheck -check-prefix=THINLTO-DEFAULT %s
+// THINLTO-DEFAULT: opt{{.*}}" "-march=cheerp" {{.*}} "-FreeAndDeleteRemoval" "-Os" "-simplifycfg"
+
+// With -cheerp-integrated-link the link, optimizer and writer steps run in a
+// single cc1 process.
+
+// RUN: %clangxx -### -no-canonical-prefixes \
+// RUN:   -target cheerp-leaningtech-webbrowser-genericjs -cheerp-integrated-link \
+// RUN:   -ccc-install-dir %S/Inputs/cheerp_tree/bin %s 2>&1 \
+// RUN:   | FileCheck -check-prefix=INTEGRATED %s
+// INTEGRATED: clang{{.*}}" "-cc1" {{.*}} "-o" "[[temp:[^"]*]]" "-x" "c++"
+// INTEGRATED-NEXT: clang{{.*}}" "-cc1" "-triple" "cheerp-leaningtech-webbrowser-genericjs" "-emit-obj" "-Os"
+// INTEGRATED-SAME: "-cheerp-link-time-pass" "GlobalDepsAnalyzer"
+// INTEGRATED-SAME: "-cheerp-link-time-pass" "FreeAndDeleteRemoval"
+// INTEGRATED-SAME: "-mllvm" "-cheerp-lto"
+// INTEGRATED-SAME: "-x" "ir" "[[temp]]" "-cheerp-link-bitcode-library" "{{.*}}libstdlibs.a"
+// INTEGRATED-NOT: llvm-link
+
+// RUN: %clangxx -### -no-canonical-prefixes \
+// RUN:   -target cheerp-leaningtech-webbrowser-genericjs -cheerp-integrated-link \
+// RUN:   -cheerp-link-roots-only \
+// RUN:   -ccc-install-dir %S/Inputs/cheerp_tree/bin %s 2>&1 \
+// RUN:   | FileCheck -check-prefix=ROOTS-ONLY %s
+// ROOTS-ONLY: "-cc1" "-triple" "cheerp-leaningtech-webbrowser-genericjs" {{.*}} "-cheerp-link-roots-only"
+
+// RUN: %clangxx -### -no-canonical-prefixes \
+// RUN:   -target cheerp-leaningtech-webbrowser-genericjs -cheerp-integrated-link \
+// RUN:   -cheerp-lto-cache-dir=/tmp/cache \
+// RUN:   -ccc-install-dir %S/Inputs/cheerp_tree/bin %s 2>&1 \
+// RUN:   | FileCheck -check-prefix=LTO-CACHE %s
+// LTO-CACHE: "-cc1" "-triple" "cheerp-leaningtech-webbrowser-genericjs" {{.*}} "-cheerp-lto-cache-dir" "/tmp/cache"
+
+// RUN: %clangxx -### -no-canonical-prefixes \
+// RUN:   -target cheerp-leaningtech-webbrowser-genericjs -cheerp-integrated-link \
+// RUN:   -cheerp-lto-cache-dir=/tmp/cache -cheerp-incremental-link \
+// RUN:   -ccc-install-dir %S/Inputs/cheerp_tree/bin %s 2>&1 \
+// RUN:   | FileCheck -check-prefix=INCREMENTAL %s
+// INCREMENTAL: "-cheerp-lto-cache-dir" "/tmp/cache" "-cheerp-cache-link-inputs"
+
+// RUN: %clangxx -### -no-canonical-prefixes \
+// RUN:   -target cheerp-leaningtech-webbrowser-genericjs -cheerp-integrated-link \
+// RUN:   -cheerp-incremental-link \
+// RUN:   -ccc-install-dir %S/Inputs/cheerp_tree/bin %s 2>&1 \
+// RUN:   | FileCheck -check-prefix=INCREMENTAL-NO-CACHE %s
+// INCREMENTAL-NO-CACHE: error: invalid argument '-cheerp-incremental-link' only allowed with '-cheerp-lto-cache-dir='
+
+// RUN: %clangxx -### -no-canonical-prefixes \
+// RUN:   -target cheerp-leaningtech-webbrowser-genericjs -cheerp-integrated-link \
+// RUN:   -cheerp-dump-bc -ccc-install-dir %S/Inputs/cheerp_tree/bin %s 2>&1 \
+// RUN:   | FileCheck -check-prefix=INTEGRATED-DUMP-BC %s
+// INTEGRATED-DUMP-BC: llvm-link
+// INTEGRATED-DUMP-BC: opt
+
+// RUN: %clangxx -### -no-canonical-prefixes \
+// RUN:   -target cheerp-leaningtech-webbrowser-wasm -fprofile-instr-generate \
+// RUN:   -ccc-install-dir %S/Inputs/cheerp_tree/bin %s 2>&1 \
+// RUN:   | FileCheck -check-prefix=PROFILE-GENERATE %s
+// PROFILE-GENERATE: error: unsupported option '-fprofile-instr-generate' for target '{{.*}}cheerp{{.*}}'
+
+// RUN: %clangxx -### -no-canonical-prefixes \
+// RUN:   -target cheerp-leaningtech-webbrowser-wasm -fprofile-instr-use=%t.profdata \
+// RUN:   -ccc-install-dir %S/Inputs/cheerp_tree/bin %s 2>&1 \
+// RUN:   | FileCheck -check-prefix=PROFILE-USE %s
+// PROFILE-USE: "-cc1" {{.*}} "-fprofile-instrument-use-path={{.*}}.profdata"
+
+int main()
+{
+	return 0;
+}
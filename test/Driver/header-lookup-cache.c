@@ -0,0 +1,6 @@
+// RUN: %clang -### -c -fheader-lookup-cache=%t.cache %s 2>&1 | FileCheck %s
+// CHECK: "-cc1"
+// CHECK-SAME: "-fheader-lookup-cache={{.*}}.cache"
+
+// RUN: %clang -### -c %s 2>&1 | FileCheck --check-prefix=NONE %s
+// NONE-NOT: -fheader-lookup-cache
@@ -0,0 +1,15 @@
+// Independent compile jobs run at the same time, but their diagnostics are
+// still reported in the order of the inputs.
+// RUN: not %clang -fparallel-jobs=2 -fsyntax-only %s %S/Inputs/parallel-jobs-b.c 2>&1 \
+// RUN:   | FileCheck %s
+// CHECK: parallel-jobs.c:{{.*}}error: use of undeclared identifier 'undeclared_in_a'
+// CHECK: parallel-jobs-b.c:{{.*}}error: use of undeclared identifier 'undeclared_in_b'
+
+// RUN: not %clang -fparallel-jobs=many -fsyntax-only %s 2>&1 \
+// RUN:   | FileCheck -check-prefix=INVALID %s
+// INVALID: error: invalid integral value 'many' in '-fparallel-jobs=many'
+
+// RUN: %clang -### -fparallel-jobs=4 -c %s 2>&1 | FileCheck -check-prefix=UNUSED %s
+// UNUSED-NOT: argument unused
+
+int first = undeclared_in_a;
@@ -9,3 +9,8 @@
 // RUN: %clang -target x86_64-unknown-linux -fwhole-program-vtables -fno-whole-program-vtables -flto -### %s 2>&1 | FileCheck --check-prefix=LTO-DISABLE %s
 // RUN: %clang_cl --target=x86_64-pc-win32 -fwhole-program-vtables -fno-whole-program-vtables -flto -### -- %s 2>&1 | FileCheck --check-prefix=LTO-DISABLE %s
 // LTO-DISABLE-NOT: "-fwhole-program-vtables"
+
+// Cheerp always links the whole program, so -flto is not required
+// RUN: %clang -target cheerp-leaningtech-webbrowser-genericjs -fwhole-program-vtables -### %s 2>&1 | FileCheck --check-prefix=CHEERP %s
+// CHEERP-NOT: only allowed with '-flto'
+// CHEERP: "-fwhole-program-vtables"
@@ -0,0 +1,39 @@
+// RUN: %clang_cc1 -triple cheerp-leaningtech-webbrowser-wasm -ffreestanding -emit-llvm -o - %s | FileCheck %s
+// RUN: %clang_cc1 -triple cheerp-leaningtech-webbrowser-wasm -ffreestanding -x c -emit-llvm -o - %s | FileCheck -check-prefix=C %s
+// RUN: not %clang_cc1 -triple cheerp-leaningtech-webbrowser-genericjs -ffreestanding -fsyntax-only %s 2>&1 | FileCheck -check-prefix=GENERICJS %s
+
+// GENERICJS: error: "cheerp_arena.h needs linear memory, compile with the wasm target"
+
+#include <cheerp_arena.h>
+
+static char buffer[4096];
+
+// C-LABEL: define {{.*}}@alloc_int(
+// C: and i32 {{.*}}, -4
+// C: icmp ugt i32
+int *alloc_int(cheerp_arena_t *a) {
+  cheerp_arena_init(a, buffer, sizeof(buffer));
+  return (int *)cheerp_arena_alloc(a, sizeof(int), 4);
+}
+
+#ifdef __cplusplus
+struct Node {
+  Node *next;
+  int value;
+};
+
+// The scope restores the bump pointer on exit
+// CHECK-LABEL: define {{.*}}@_Z9sumValuesR14cheerp_arena_ti(
+// CHECK: call {{.*}}@_ZnwjR14cheerp_arena_t(
+// CHECK: call {{.*}}@_ZN18cheerp_arena_scopeD1Ev(
+int sumValues(cheerp_arena_t &a, int n) {
+  cheerp_arena_scope scope(a);
+  Node *head = nullptr;
+  for (int i = 0; i < n; i++)
+    head = new (a) Node{head, i};
+  int sum = 0;
+  for (Node *it = head; it; it = it->next)
+    sum += it->value;
+  return sum;
+}
+#endif
@@ -0,0 +1,51 @@
+// RUN: %clang_cc1 -triple cheerp-leaningtech-webbrowser-wasm -cheerp-wasm-simd -ffreestanding -emit-llvm -o - %s | FileCheck %s
+// RUN: not %clang_cc1 -triple cheerp-leaningtech-webbrowser-wasm -ffreestanding -fsyntax-only %s 2>&1 | FileCheck -check-prefix=NO-SIMD %s
+// RUN: not %clang_cc1 -triple cheerp-leaningtech-webbrowser-wasm -cheerp-wasm-simd -cheerp-linear-output=asmjs -ffreestanding -fsyntax-only %s 2>&1 | FileCheck -check-prefix=NO-SIMD %s
+
+// NO-SIMD: error: "wasm_simd128.h needs -cheerp-wasm-enable=simd and wasm linear output"
+
+#include <wasm_simd128.h>
+
+// CHECK-LABEL: @madd(
+// CHECK: mul <4 x i32>
+// CHECK: add <4 x i32>
+v128_t madd(v128_t a, v128_t b, v128_t c) {
+  return wasm_i32x4_add(wasm_i32x4_mul(a, b), c);
+}
+
+// CHECK-LABEL: @scale(
+// CHECK: fmul <4 x float>
+v128_t scale(v128_t a, float s) {
+  return wasm_f32x4_mul(a, wasm_f32x4_splat(s));
+}
+
+// CHECK-LABEL: @reverse(
+// CHECK: shufflevector <4 x i32> {{.*}}, <4 x i32> <i32 3, i32 2, i32 1, i32 0>
+v128_t reverse(v128_t a) {
+  return wasm_i32x4_shuffle(a, a, 3, 2, 1, 0);
+}
+
+// Shift counts are taken modulo the lane width
+// CHECK-LABEL: @shift(
+// CHECK: and i32 %{{.*}}, 31
+// CHECK: shl <4 x i32>
+v128_t shift(v128_t a, unsigned int n) {
+  return wasm_i32x4_shl(a, n);
+}
+
+// min propagates NaN and orders -0 before +0, pmin does neither
+// CHECK-LABEL: @fmin(
+// CHECK: fcmp olt <4 x float>
+// CHECK: fcmp oeq <4 x float>
+// CHECK: fcmp une <4 x float>
+v128_t fmin(v128_t a, v128_t b) {
+  return wasm_f32x4_min(a, b);
+}
+
+// CHECK-LABEL: @fpmin(
+// CHECK: fcmp olt <4 x float>
+// CHECK-NOT: fcmp
+// CHECK: ret
+v128_t fpmin(v128_t a, v128_t b) {
+  return wasm_f32x4_pmin(a, b);
+}
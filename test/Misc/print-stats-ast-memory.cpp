@@ -0,0 +1,12 @@
+// RUN: %clang_cc1 -fsyntax-only -print-stats %s 2>&1 | FileCheck %s
+
+struct S { int X; };
+[[deprecated]] int f(S s) { return s.X; }
+
+// CHECK: *** AST Context Stats:
+// CHECK: *** AST Context Memory:
+// CHECK-NEXT: {{[0-9]+}} bytes allocated for AST nodes
+// CHECK-NEXT: {{[0-9]+}} bytes in side tables
+// CHECK-NEXT: {{[0-9]+}} declarations with attributes
+// CHECK: *** Decl Stats:
+// CHECK: *** Stmt/Expr Stats:
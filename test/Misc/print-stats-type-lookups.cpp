@@ -0,0 +1,12 @@
+// RUN: %clang_cc1 -fsyntax-only -print-stats %s 2>&1 | FileCheck %s
+
+// Every use of 'int *' after the first finds the uniqued PointerType.
+int *A;
+int *B;
+int *C;
+int &D = *A;
+
+// CHECK: *** AST Context Stats:
+// CHECK: Total bytes =
+// CHECK: {{[0-9]+}} Pointer type lookups, {{[1-9][0-9]*}} found an existing type
+// CHECK: {{[0-9]+}} LValueReference type lookups, {{[0-9]+}} found an existing type
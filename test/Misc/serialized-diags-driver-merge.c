@@ -0,0 +1,24 @@
+// Test that merging the serialized diagnostics of the cc1 process into those
+// of the driver keeps the files and flags of the child records apart.
+
+// RUN: rm -f %t.diag
+// RUN: %clang -Wx-typoed-warning -Wall -fsyntax-only --serialize-diagnostics %t.diag %s
+// RUN: c-index-test -read-diagnostics %t.diag 2>&1 | FileCheck %s
+
+// CHECK: warning: unknown warning option '-Wx-typoed-warning' [-Wunknown-warning-option] []
+// CHECK: {{.*[/\\]}}serialized-diags-driver-merge.c:17:12: warning: variable 'voodoo' is uninitialized when used here [-Wuninitialized]
+// CHECK: {{.*[/\\]}}serialized-diags.h:5:7: warning: incompatible integer to pointer conversion initializing 'char *' with an expression of type 'int' [-Wint-conversion]
+// CHECK: +-{{.*[/\\]}}serialized-diags-driver-merge.c:20:10: note: in file included from {{.*[/\\]}}serialized-diags-driver-merge.c:20: []
+// CHECK: {{.*[/\\]}}serialized-diags-driver-merge.c:23:12: warning: unused variable 'x' [-Wunused-variable]
+// CHECK: Number of diagnostics: 4
+
+void foo() {
+  int voodoo;
+  voodoo = voodoo + 1;
+}
+
+#include "serialized-diags.h"
+
+void bar() {
+  unsigned x;
+}
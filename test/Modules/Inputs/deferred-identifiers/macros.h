@@ -0,0 +1,4 @@
+#define USED_MACRO 1
+#define UNUSED_MACRO_1 2
+#define UNUSED_MACRO_2 3
+#define UNUSED_MACRO_3 4
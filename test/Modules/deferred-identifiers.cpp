@@ -0,0 +1,17 @@
+// RUN: rm -rf %t
+// RUN: %clang_cc1 -x c++ -fmodules -fimplicit-module-maps -fmodules-cache-path=%t \
+// RUN:   -I %S/Inputs/deferred-identifiers %s -verify -print-stats 2>&1 | FileCheck %s
+
+// The macros of a C++ module are only turned into identifiers when they are
+// first used.
+
+// expected-no-diagnostics
+#include "macros.h"
+
+static_assert(USED_MACRO == 1, "macro from the module");
+#ifdef UNUSED_MACRO_2
+int defined_in_module;
+#endif
+
+// CHECK: *** AST File Statistics:
+// CHECK: {{[0-9]+}} interesting identifiers deferred until first use
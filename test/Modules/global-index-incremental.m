@@ -0,0 +1,22 @@
+// REQUIRES: asserts
+// RUN: rm -rf %t
+// Build module A and a global module index covering it.
+// RUN: %clang_cc1 -fmodules -fimplicit-module-maps -fmodules-cache-path=%t -fdisable-module-hash -I %S/Inputs/global-index-incremental %s -verify -print-stats 2>&1 | FileCheck --check-prefix=CHECK-INITIAL %s
+// RUN: ls %t | grep modules.idx
+// Build module B; A is unchanged, so the updated index reuses its entry.
+// RUN: %clang_cc1 -fmodules -fimplicit-module-maps -fmodules-cache-path=%t -fdisable-module-hash -I %S/Inputs/global-index-incremental %s -verify -DIMPORT_B -print-stats 2>&1 | FileCheck --check-prefix=CHECK-UPDATE %s
+
+// expected-no-diagnostics
+#ifdef IMPORT_B
+@import B;
+int use_b(void) { return a_value() + b_value(); }
+#else
+@import A;
+int use_a(void) { return a_value(); }
+#endif
+
+// CHECK-INITIAL: 1 global-module-index - Number of module files read while writing the global index
+// CHECK-INITIAL-NOT: Number of unchanged module files
+
+// CHECK-UPDATE-DAG: 1 global-module-index - Number of module files read while writing the global index
+// CHECK-UPDATE-DAG: 1 global-module-index - Number of unchanged module files taken from the existing index
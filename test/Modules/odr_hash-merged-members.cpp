@@ -0,0 +1,68 @@
+// Clear and create directories
+// RUN: rm -rf %t
+// RUN: mkdir %t
+// RUN: mkdir %t/cache
+// RUN: mkdir %t/Inputs
+
+// Build the header files, which all contain the same definitions
+// RUN: echo "#define FIRST"  >> %t/Inputs/first.h
+// RUN: cat %s                >> %t/Inputs/first.h
+// RUN: echo "#define SECOND" >> %t/Inputs/second.h
+// RUN: cat %s                >> %t/Inputs/second.h
+// RUN: echo "#define THIRD"  >> %t/Inputs/third.h
+// RUN: cat %s                >> %t/Inputs/third.h
+
+// Build module map file
+// RUN: echo "module FirstModule {"     >> %t/Inputs/module.map
+// RUN: echo "    header \"first.h\""   >> %t/Inputs/module.map
+// RUN: echo "}"                        >> %t/Inputs/module.map
+// RUN: echo "module SecondModule {"    >> %t/Inputs/module.map
+// RUN: echo "    header \"second.h\""  >> %t/Inputs/module.map
+// RUN: echo "}"                        >> %t/Inputs/module.map
+// RUN: echo "module ThirdModule {"     >> %t/Inputs/module.map
+// RUN: echo "    header \"third.h\""   >> %t/Inputs/module.map
+// RUN: echo "}"                        >> %t/Inputs/module.map
+
+// Run test
+// RUN: %clang_cc1 -fmodules -fimplicit-module-maps -fmodules-cache-path=%t/cache -x c++ -I%t/Inputs -verify %s -std=c++11
+
+// Definitions with the same ODR hash are merged without checking each of
+// their members against the canonical definition. All members must still be
+// usable after the merge.
+
+#if !defined(FIRST) && !defined(SECOND) && !defined(THIRD)
+#include "first.h"
+#include "second.h"
+#include "third.h"
+#endif
+
+#if defined(FIRST) || defined(SECOND) || defined(THIRD)
+struct S {
+  typedef int Int;
+  using Ptr = Int *;
+  S() : X(0) {}
+  Int get() const { return X; }
+  template <typename T> T as() const { return T(X); }
+  static_assert(sizeof(Int) == sizeof(int), "");
+  static const int Max = 16;
+
+private:
+  Int X;
+  friend int peek(const S &);
+};
+
+enum E { A, B, C };
+
+template <typename T> struct Box {
+  T Value;
+  T get() const { return Value; }
+};
+inline int useBox() { return Box<int>{3}.get(); }
+#else
+S::Int I = S().get() + S().as<long>() + S::Max;
+S::Ptr P = &I;
+int peek(const S &s) { return s.X; }
+E Last = C;
+int Boxed = useBox() + Box<int>{4}.get();
+// expected-no-diagnostics
+#endif
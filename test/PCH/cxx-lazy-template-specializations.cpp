@@ -0,0 +1,46 @@
+// Test that looking up a specialization of a template from a PCH only
+// deserializes the specializations with the same template arguments, and the
+// partial specializations when they are needed for matching.
+
+// RUN: %clang_cc1 -std=c++14 -x c++-header -emit-pch -o %t %s
+// RUN: %clang_cc1 -std=c++14 -include-pch %t -fsyntax-only -verify %s \
+// RUN:   -error-on-deserialized-decl OnlyInClass \
+// RUN:   -error-on-deserialized-decl OnlyInFunction \
+// RUN:   -error-on-deserialized-decl OnlyInVariable
+
+// Without the PCH the same code must be accepted.
+// RUN: %clang_cc1 -std=c++14 -include %s -fsyntax-only -verify %s
+
+#ifndef HEADER
+#define HEADER
+
+struct OnlyInClass {};
+struct OnlyInFunction {};
+struct OnlyInVariable {};
+
+template <typename T> struct Traits { static const int Value = 0; };
+template <> struct Traits<int> { static const int Value = 1; };
+template <> struct Traits<OnlyInClass> { static const int Value = 2; };
+template <typename T> struct Traits<T *> { static const int Value = 3; };
+
+template <typename T> constexpr int rank(T) { return 0; }
+template <> constexpr int rank<long>(long) { return 4; }
+template <> constexpr int rank<OnlyInFunction>(OnlyInFunction) { return 5; }
+
+template <typename T> constexpr int width = 0;
+template <> constexpr int width<char> = 8;
+template <> constexpr int width<OnlyInVariable> = 9;
+template <typename T> constexpr int width<T *> = 64;
+
+#else
+
+static_assert(Traits<int>::Value == 1, "");
+static_assert(Traits<char>::Value == 0, "");
+static_assert(Traits<int *>::Value == 3, "");
+static_assert(rank(1L) == 4, "");
+static_assert(rank('a') == 0, "");
+static_assert(width<char> == 8, "");
+static_assert(width<int *> == 64, "");
+
+// expected-no-diagnostics
+#endif
@@ -0,0 +1,44 @@
+// Test that -fpch-instantiate-templates performs the implicit instantiations
+// used by a PCH while building it.
+
+// The instantiation of pick<S> calls the best choose() visible where it is
+// instantiated: the one of the header when it is done in the PCH, the one of
+// the TU when it is left to the TU.
+
+// RUN: %clang_cc1 -emit-pch -fpch-instantiate-templates %s -o %t
+// RUN: %clang_cc1 -include-pch %t -emit-llvm %s -o - | FileCheck %s
+// RUN: %clang_cc1 -emit-pch %s -o %t.tu
+// RUN: %clang_cc1 -include-pch %t.tu -emit-llvm %s -o - \
+// RUN:   | FileCheck %s --check-prefix=IN-TU
+
+// Without the flag, errors in the instantiations are only found when the PCH
+// is used.
+// RUN: %clang_cc1 -emit-pch -DERROR %s -o %t.err
+// RUN: not %clang_cc1 -emit-pch -DERROR -fpch-instantiate-templates %s -o %t.err 2>&1 \
+// RUN:   | FileCheck %s --check-prefix=ERROR
+
+#ifndef HEADER_INCLUDED
+
+#define HEADER_INCLUDED
+
+struct S {};
+inline int choose(S, long) { return 1; }
+template <typename T> int pick(T X) { return choose(X, 0); }
+inline int usePick() { return pick(S()); }
+
+#ifdef ERROR
+template <typename T> void bad() { T::error; }
+inline void useBad() { bad<int>(); }
+// ERROR: error: type 'int' cannot be used prior to '::'
+#endif
+
+#else
+
+inline int choose(S, int) { return 2; }
+int main() { return usePick(); }
+// CHECK-LABEL: define {{.*}}@_Z4pickI1SEiT_(
+// CHECK: call {{.*}}@_Z6choose1Sl(
+// IN-TU-LABEL: define {{.*}}@_Z4pickI1SEiT_(
+// IN-TU: call {{.*}}@_Z6choose1Si(
+
+#endif
@@ -0,0 +1,30 @@
+// RUN: %clang -E -dM %s -o - 2>&1 \
+// RUN:     -target cheerp-leaningtech-webbrowser-wasm -cheerp-wasm-enable=simd \
+// RUN:   | FileCheck %s -check-prefix=SIMD
+//
+// SIMD:#define __wasm_simd128__ 1{{$}}
+
+// RUN: %clang -E -dM %s -o - 2>&1 \
+// RUN:     -target cheerp-leaningtech-webbrowser-wasm -cheerp-wasm-enable=bulkmemory \
+// RUN:   | FileCheck %s -check-prefix=BULK-MEMORY
+//
+// BULK-MEMORY:#define __wasm_bulk_memory__ 1{{$}}
+
+// The features only apply to wasm linear output
+// RUN: %clang -E -dM %s -o - 2>&1 \
+// RUN:     -target cheerp-leaningtech-webbrowser-wasm -cheerp-linear-output=asmjs \
+// RUN:     -cheerp-wasm-enable=simd,bulkmemory \
+// RUN:   | FileCheck %s -check-prefix=ASMJS
+//
+// ASMJS-NOT:#define __wasm_simd128__
+// ASMJS-NOT:#define __wasm_bulk_memory__
+
+// RUN: %clang -E -dM %s -o - 2>&1 \
+// RUN:     -target cheerp-leaningtech-webbrowser-genericjs -cheerp-use-bigints \
+// RUN:   | FileCheck %s -check-prefix=BIGINTS
+// RUN: %clang -E -dM %s -o - 2>&1 \
+// RUN:     -target cheerp-leaningtech-webbrowser-genericjs \
+// RUN:   | FileCheck %s -check-prefix=NO-BIGINTS
+//
+// BIGINTS:#define __CHEERP_BIGINTS__ 1{{$}}
+// NO-BIGINTS-NOT:#define __CHEERP_BIGINTS__
@@ -0,0 +1,23 @@
+// REQUIRES: shell
+// RUN: rm -rf %t && mkdir -p %t/a %t/b
+// RUN: echo '#define FOUND 1' > %t/b/found.h
+// The entries of recently modified directories are not cached.
+// RUN: touch -t 201901010000 %t/a %t/b
+//
+// RUN: %clang_cc1 -E -I %t/a -I %t/b -fheader-lookup-cache=%t/cache %s | FileCheck %s
+// RUN: FileCheck --check-prefix=CACHE %s < %t/cache
+// RUN: %clang_cc1 -E -I %t/a -I %t/b -fheader-lookup-cache=%t/cache %s | FileCheck %s
+//
+// Adding the header to a directory invalidates the entries cached for it.
+// RUN: echo '#define FOUND 2' > %t/a/found.h
+// RUN: %clang_cc1 -E -I %t/a -I %t/b -fheader-lookup-cache=%t/cache %s | FileCheck --check-prefix=CHANGED %s
+
+#include "found.h"
+int x = FOUND;
+
+// CHECK: int x = 1;
+// CHANGED: int x = 2;
+
+// CACHE: clang-stat-cache-v1
+// CACHE: D {{[0-9]+}} {{.*}}{{/|\\}}a{{$}}
+// CACHE-NEXT: F found.h
@@ -0,0 +1,21 @@
+// RUN: %clang_cc1 -fsyntax-only -fmacro-expansion-stats %s 2>&1 | FileCheck %s
+// RUN: %clang_cc1 -fsyntax-only %s 2>&1 | FileCheck %s --check-prefix=NOSTATS --allow-empty
+
+#define ONE 1
+#define TWICE(X) ((X) + (X))
+#define UNUSED 0
+#define X_LIST(F) F(ONE) F(ONE)
+
+int a = TWICE(ONE);
+int b = TWICE(TWICE(ONE));
+#define DECLARE(V) int v##V = V;
+X_LIST(DECLARE)
+
+// CHECK: *** Macro Expansion Stats:
+// CHECK-NEXT: {{^}}  4{{\t}}ONE{{$}}
+// CHECK-NEXT: {{^}}  3{{\t}}TWICE{{$}}
+// CHECK-NEXT: {{^}}  2{{\t}}DECLARE{{$}}
+// CHECK-NEXT: {{^}}  1{{\t}}X_LIST{{$}}
+// CHECK-NOT: UNUSED
+
+// NOSTATS-NOT: Macro Expansion Stats
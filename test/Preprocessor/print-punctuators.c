@@ -0,0 +1,11 @@
+// RUN: %clang_cc1 -E %s | FileCheck --strict-whitespace %s
+
+// Punctuators keep their spelling, including digraphs and line splices.
+#define CAT(a, b) a %:%: b
+// CHECK: a[0] <: 1 :> <% %> x <<= y -> z ...
+a[0] <: 1 :> <% %> x <<= y -> z ...
+// CHECK: p -> q
+p -\
+> q
+// CHECK: ab
+CAT(a, b)
@@ -0,0 +1,42 @@
+// RUN: %clang_cc1 -E %s | FileCheck %s
+// RUN: %clang_cc1 -E -x c++ -std=c++14 %s | FileCheck %s
+// RUN: %clang_cc1 -E -trigraphs %s | FileCheck %s
+
+// Directive-looking text inside comments, literals and continued lines of a
+// skipped block must not end the block.
+#if 0
+/*
+#endif
+*/
+// a line comment \
+#endif
+const char *s = "\
+#endif";
+int x = 1; /* spans
+#endif
+lines */
+foo \
+#endif
+don't
+#endif
+int after_first;
+// CHECK: int after_first;
+
+#if 0
+  /* leading comment */ # endif
+int after_second;
+// CHECK: int after_second;
+
+#if 0
+%:endif
+int after_digraph;
+// CHECK: int after_digraph;
+
+#if 0
+#define X 'a
+#if 1
+#else
+#endif
+  #	endif
+int after_nested;
+// CHECK: int after_nested;
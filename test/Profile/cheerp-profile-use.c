@@ -0,0 +1,15 @@
+// Test that instrumentation profiles are used for the cheerp triple.
+
+// RUN: llvm-profdata merge %S/Inputs/cheerp-profile-use.proftext -o %t.profdata
+// RUN: %clang_cc1 -triple cheerp-leaningtech-webbrowser-genericjs -main-file-name cheerp-profile-use.c %s -o - -emit-llvm -fprofile-instrument-use-path=%t.profdata | FileCheck %s
+// RUN: %clang_cc1 -triple cheerp-leaningtech-webbrowser-wasm -main-file-name cheerp-profile-use.c %s -o - -emit-llvm -fprofile-instrument-use-path=%t.profdata | FileCheck %s
+
+// CHECK: define {{.*}}@loop(i32 %n){{.*}} !prof ![[ENTRY:[0-9]+]]
+void loop(int n) {
+  // CHECK: br i1 %{{.*}}, label %{{.*}}, label %{{.*}}, !prof ![[WEIGHTS:[0-9]+]]
+  while (n > 0)
+    n--;
+}
+
+// CHECK: ![[ENTRY]] = !{!"function_entry_count", i64 1}
+// CHECK: ![[WEIGHTS]] = !{!"branch_weights", i32 101, i32 2}
@@ -4,6 +4,7 @@
 // RUN: %clang_cc1 -xc++ -triple x86_64-apple-macosx10.14.0 %s -verify
 // RUN: %clang_cc1 -xc++ -triple x86_64-apple-macosx10.14.0 %s -verify -DUSE_PASS_OBJECT_SIZE
 // RUN: %clang_cc1 -xc++ -triple x86_64-apple-macosx10.14.0 %s -verify -DUSE_BUILTINS
+// RUN: %clang_cc1 -triple x86_64-apple-macosx10.14.0 %s -verify=nofortify -Wno-fortify-source
 
 typedef unsigned long size_t;
 
@@ -117,3 +118,21 @@ void call_call_memcpy() {
   call_memcpy_dep<9, 10>(); // expected-note {{in instantiation of function template specialization 'call_memcpy_dep<9, 10>' requested here}}
 }
 #endif
+
+// With -Wno-fortify-source the sizes are not checked, the other checks of the
+// call still are.
+void call_snprintf_no_fortify() {
+  char buf[10];
+  __builtin_snprintf(buf, 11, "%d", 1.0); // expected-warning {{'snprintf' size argument is too large; destination buffer has size 10, but size argument is 11}} expected-warning {{format specifies type 'int' but the argument has type 'double'}} nofortify-warning {{format specifies type 'int' but the argument has type 'double'}}
+  char dst[10];
+  char src[20];
+  __builtin___memcpy_chk(dst, src, 20, 10); // expected-warning {{'memcpy' will always overflow; destination buffer has size 10, but size argument is 20}} nofortify-warning {{'memcpy' will always overflow; destination buffer has size 10, but size argument is 20}}
+}
+
+// Calls in system headers are not checked.
+# 1 "fortify-system-header.h" 1 3
+void call_memcpy_in_system_header() {
+  char dst[10];
+  char src[20];
+  memcpy(dst, src, 20);
+}
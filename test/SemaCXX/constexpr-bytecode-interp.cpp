@@ -0,0 +1,88 @@
+// RUN: %clang_cc1 -std=c++14 -fsyntax-only -verify %s -fconstexpr-steps 1000
+// RUN: %clang_cc1 -std=c++14 -fsyntax-only -verify %s -fconstexpr-steps 1000 -fexperimental-new-constant-interpreter
+
+// Both evaluators must agree on the values of integer constexpr functions.
+
+constexpr unsigned crc32(const unsigned char Byte, unsigned Crc) {
+  Crc ^= Byte;
+  for (int K = 0; K < 8; ++K)
+    Crc = Crc & 1 ? (Crc >> 1) ^ 0xEDB88320u : Crc >> 1;
+  return Crc;
+}
+constexpr unsigned crc32OfRange(unsigned char First, unsigned char Last) {
+  unsigned Crc = 0xFFFFFFFFu;
+  for (unsigned char C = First; C <= Last; C++)
+    Crc = crc32(C, Crc);
+  return ~Crc;
+}
+// crc32("0123456789")
+static_assert(crc32OfRange('0', '9') == 0xA684C7C6u, "");
+
+enum E : short { A = -2, B = 3 };
+constexpr int scale(int X, E Factor = B) { return X * Factor; }
+static_assert(scale(7) == 21 && scale(7, A) == -14, "");
+
+constexpr long long fib(int N) {
+  long long Prev = 0, Cur = 1;
+  while (--N > 0) {
+    long long Next = Prev + Cur;
+    Prev = Cur;
+    Cur = Next;
+  }
+  return N < 0 ? 0 : Cur;
+}
+static_assert(fib(0) == 0 && fib(1) == 1 && fib(50) == 12586269025LL, "");
+
+constexpr int gcd(int X, int Y) { return Y ? gcd(Y, X % Y) : X; }
+static_assert(gcd(1071, 462) == 21, "");
+
+constexpr bool isPowerOfTwo(unsigned X) { return X && !(X & (X - 1)); }
+static_assert(isPowerOfTwo(64) && !isPowerOfTwo(96) && !isPowerOfTwo(0), "");
+
+constexpr int firstMultiple(int Step, int Limit) {
+  int I = 0;
+  do {
+    I += Step;
+    if (I % 7)
+      continue;
+    break;
+  } while (I < Limit);
+  return I;
+}
+static_assert(firstMultiple(3, 100) == 21, "");
+
+constexpr signed char narrow(int X) { return X; }
+static_assert(narrow(300) == 44, "");
+
+// Evaluations that are not constant expressions produce the same notes in
+// both evaluators.
+
+constexpr int add(int X, int Y) { return X + Y; } // expected-note {{value 2147483648 is outside the range of representable values of type 'int'}}
+static_assert(add(0x7fffffff, 1), ""); // expected-error {{static_assert expression is not an integral constant expression}} expected-note {{in call to 'add(2147483647, 1)'}}
+
+constexpr int divide(int X, int Y) { return X / Y; } // expected-note {{division by zero}}
+static_assert(divide(1, 0), ""); // expected-error {{static_assert expression is not an integral constant expression}} expected-note {{in call to 'divide(1, 0)'}}
+
+// Functions the interpreter cannot compile are walked, including when they
+// are called from one it could otherwise compile.
+
+constexpr int first(int X) {
+  int Values[2] = {X, 0};
+  return Values[0];
+}
+constexpr int firstPlusOne(int X) { return first(X) + 1; }
+static_assert(firstPlusOne(41) == 42, "");
+
+// Both evaluators take one step per statement, so they hit the step limit at
+// the same point.
+
+constexpr int sum(int N) {
+  int S = 0;
+  for (int I = 0; I < N; ++I) { // expected-note {{constexpr evaluation hit maximum step limit}}
+    S += I;
+    S -= I / 2;
+  }
+  return S;
+}
+static_assert(sum(300) == 22500, "");
+static_assert(sum(400) == 40000, ""); // expected-error {{static_assert expression is not an integral constant expression}} expected-note {{in call to 'sum(400)'}}
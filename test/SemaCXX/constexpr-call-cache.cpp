@@ -0,0 +1,43 @@
+// RUN: %clang_cc1 -std=c++14 -fsyntax-only -verify %s -fconstexpr-steps 1000
+// RUN: %clang_cc1 -std=c++14 -fsyntax-only %s -fconstexpr-steps 1000 -DSTATS -print-stats 2>&1 | FileCheck %s
+
+// Repeated constexpr calls with scalar arguments reuse the first result.
+
+constexpr int sum(int N) {
+  int S = 0;
+  for (int I = 0; I < N; ++I) {
+    S += I;
+    S -= I / 2;
+  }
+  return S;
+}
+static_assert(sum(250) == 15625, "");
+static_assert(sum(250) == 15625, "");
+
+// The body may modify its parameters.
+constexpr int countDown(int N) {
+  int Steps = 0;
+  while (N > 0) {
+    --N;
+    ++Steps;
+  }
+  return Steps;
+}
+static_assert(countDown(5) == 5, "");
+static_assert(countDown(5) == 5, "");
+
+constexpr double half(double D) { return D / 2; }
+static_assert(half(1.0) == 0.5 && half(-1.0) == -0.5, "");
+static_assert(half(1.0) == 0.5, "");
+
+#ifndef STATS
+// A cached result still takes the steps of the original evaluation.
+static_assert(sum(250) + sum(250) == 31250, ""); // expected-error {{static_assert expression is not an integral constant expression}} expected-note@* {{constexpr evaluation hit maximum step limit}} expected-note {{in call to 'sum(250)'}}
+
+// Calls that fail are diagnosed every time.
+constexpr int add(int X, int Y) { return X + Y; } // expected-note 2{{value 2147483648 is outside the range of representable values of type 'int'}}
+static_assert(add(0x7fffffff, 1), ""); // expected-error {{static_assert expression is not an integral constant expression}} expected-note {{in call to 'add(2147483647, 1)'}}
+static_assert(add(0x7fffffff, 1), ""); // expected-error {{static_assert expression is not an integral constant expression}} expected-note {{in call to 'add(2147483647, 1)'}}
+#endif
+
+// CHECK: constexpr call results cached, {{[1-9][0-9]*}} hits
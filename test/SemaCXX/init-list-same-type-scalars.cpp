@@ -0,0 +1,32 @@
+// RUN: %clang_cc1 -std=c++11 -fsyntax-only -verify %s
+// RUN: %clang_cc1 -std=c++11 -ast-dump %s | FileCheck %s
+
+// Elements that already have the element type are used as they are.
+int Table[] = {1, 2, 3};
+// CHECK: VarDecl {{.*}} Table 'int [3]' cinit
+// CHECK-NEXT: InitListExpr {{.*}} 'int [3]'
+// CHECK-NEXT: IntegerLiteral {{.*}} 'int' 1
+// CHECK-NEXT: IntegerLiteral {{.*}} 'int' 2
+// CHECK-NEXT: IntegerLiteral {{.*}} 'int' 3
+
+const double Weights[2][2] = {{0.5, 1.5}, {2.5}};
+// CHECK: VarDecl {{.*}} Weights 'const double [2][2]' cinit
+// CHECK-NEXT: InitListExpr {{.*}} 'const double [2][2]'
+// CHECK-NEXT: InitListExpr {{.*}} 'const double [2]'
+// CHECK-NEXT: FloatingLiteral {{.*}} 'double' 5.000000e-01
+// CHECK-NEXT: FloatingLiteral {{.*}} 'double' 1.500000e+00
+
+// Others are still converted and checked for narrowing.
+long Mixed[] = {1L, 2};
+// CHECK: VarDecl {{.*}} Mixed 'long [2]' cinit
+// CHECK-NEXT: InitListExpr {{.*}} 'long [2]'
+// CHECK-NEXT: IntegerLiteral {{.*}} 'long' 1
+// CHECK-NEXT: ImplicitCastExpr {{.*}} 'long' <IntegralCast>
+
+void f(int X, double Y) {
+  int Values[] = {X, 2}; // lvalues still need an lvalue-to-rvalue conversion
+  // CHECK: VarDecl {{.*}} Values 'int [2]' cinit
+  // CHECK-NEXT: InitListExpr {{.*}} 'int [2]'
+  // CHECK-NEXT: ImplicitCastExpr {{.*}} 'int' <LValueToRValue>
+  int Narrowed[] = {1, Y}; // expected-error {{cannot be narrowed}} expected-note {{silence}}
+}
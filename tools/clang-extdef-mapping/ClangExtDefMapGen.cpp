@@ -18,11 +18,15 @@
 #include "clang/Frontend/CompilerInstance.h"
 #include "clang/Frontend/FrontendActions.h"
 #include "clang/Tooling/CommonOptionsParser.h"
+#include "clang/Tooling/Execution.h"
 #include "clang/Tooling/Tooling.h"
+#include "llvm/ADT/STLExtras.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Signals.h"
-#include <sstream>
+#include <algorithm>
 #include <string>
+#include <utility>
+#include <vector>
 
 using namespace llvm;
 using namespace clang;
@@ -33,12 +37,14 @@ static cl::OptionCategory ClangExtDefMapGenCategory("clang-extdefmapgen options"
 
 class MapExtDefNamesConsumer : public ASTConsumer {
 public:
-  MapExtDefNamesConsumer(ASTContext &Context)
-      : Ctx(Context), SM(Context.getSourceManager()) {}
+  MapExtDefNamesConsumer(ASTContext &Context, ExecutionContext &ECtx)
+      : Ctx(Context), SM(Context.getSourceManager()), ECtx(ECtx) {}
 
   ~MapExtDefNamesConsumer() {
-    // Flush results to standard output.
-    llvm::outs() << createCrossTUIndexString(Index);
+    // Hand the results to the executor, which may be running other TUs on
+    // other threads.
+    for (const auto &E : Index)
+      ECtx.reportResult(E.getKey(), E.getValue());
   }
 
   void HandleTranslationUnit(ASTContext &Context) override {
@@ -51,6 +57,7 @@ private:
 
   ASTContext &Ctx;
   SourceManager &SM;
+  ExecutionContext &ECtx;
   llvm::StringMap<std::string> Index;
   std::string CurrentFileName;
 };
@@ -97,11 +104,28 @@ void MapExtDefNamesConsumer::addIfInMain(const DeclaratorDecl *DD,
 }
 
 class MapExtDefNamesAction : public ASTFrontendAction {
+public:
+  explicit MapExtDefNamesAction(ExecutionContext &ECtx) : ECtx(ECtx) {}
+
 protected:
   std::unique_ptr<ASTConsumer> CreateASTConsumer(CompilerInstance &CI,
                                                  llvm::StringRef) {
-    return llvm::make_unique<MapExtDefNamesConsumer>(CI.getASTContext());
+    return llvm::make_unique<MapExtDefNamesConsumer>(CI.getASTContext(),
+                                                     ECtx);
   }
+
+private:
+  ExecutionContext &ECtx;
+};
+
+class MapExtDefNamesActionFactory : public FrontendActionFactory {
+public:
+  explicit MapExtDefNamesActionFactory(ExecutionContext &ECtx) : ECtx(ECtx) {}
+
+  FrontendAction *create() override { return new MapExtDefNamesAction(ECtx); }
+
+private:
+  ExecutionContext &ECtx;
 };
 
 static cl::extrahelp CommonHelp(CommonOptionsParser::HelpMessage);
@@ -114,11 +138,33 @@ int main(int argc, const char **argv) {
   const char *Overview = "\nThis tool collects the USR name and location "
                          "of external definitions in the source files "
                          "(excluding headers).\n";
-  CommonOptionsParser OptionsParser(argc, argv, ClangExtDefMapGenCategory,
-                                    cl::ZeroOrMore, Overview);
+  // With --executor=all-TUs, every file of the compilation database is
+  // processed, in parallel.
+  auto Executor = createExecutorFromCommandLineArgs(
+      argc, argv, ClangExtDefMapGenCategory, Overview);
+  if (!Executor) {
+    llvm::errs() << llvm::toString(Executor.takeError()) << "\n";
+    return 1;
+  }
 
-  ClangTool Tool(OptionsParser.getCompilations(),
-                 OptionsParser.getSourcePathList());
+  int Result = 0;
+  if (llvm::Error Err = (*Executor)->execute(
+          llvm::make_unique<MapExtDefNamesActionFactory>(
+              *(*Executor)->getExecutionContext()))) {
+    llvm::errs() << llvm::toString(std::move(Err)) << "\n";
+    Result = 1;
+  }
 
-  return Tool.run(newFrontendActionFactory<MapExtDefNamesAction>().get());
+  // Print the results of the TUs that succeeded, sorted so that the output
+  // does not depend on the order in which the TUs finished.
+  std::vector<std::pair<std::string, std::string>> Lines;
+  (*Executor)->getToolResults()->forEachResult(
+      [&Lines](StringRef LookupName, StringRef FileName) {
+        Lines.emplace_back(LookupName, FileName);
+      });
+  llvm::sort(Lines);
+  for (const auto &Line : Lines)
+    llvm::outs() << Line.first << " " << Line.second << '\n';
+
+  return Result;
 }
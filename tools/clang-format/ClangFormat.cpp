@@ -22,7 +22,9 @@
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/InitLLVM.h"
+#include "llvm/Support/Path.h"
 #include "llvm/Support/Process.h"
+#include <map>
 
 using namespace llvm;
 using clang::tooling::Replacements;
@@ -239,6 +241,27 @@ static void outputReplacementsXML(const Replacements &Replaces) {
   }
 }
 
+// Returns the style for FileName. The style only depends on the directory of
+// the file and on its language, so when many files are formatted each
+// configuration file is only searched for and parsed once.
+static llvm::Expected<FormatStyle> getCachedStyle(StringRef FileName,
+                                                  StringRef Code) {
+  static std::map<std::pair<std::string, unsigned>, FormatStyle> Cache;
+  SmallString<128> Path(FileName);
+  if (llvm::sys::fs::make_absolute(Path))
+    return getStyle(Style, FileName, FallbackStyle, Code);
+  auto Key = std::make_pair(llvm::sys::path::parent_path(Path).str(),
+                            unsigned(guessLanguage(FileName, Code)));
+  auto I = Cache.find(Key);
+  if (I != Cache.end())
+    return I->second;
+  llvm::Expected<FormatStyle> Result =
+      getStyle(Style, FileName, FallbackStyle, Code);
+  if (Result)
+    Cache.insert(std::make_pair(Key, *Result));
+  return Result;
+}
+
 // Returns true on error.
 static bool format(StringRef FileName) {
   if (!OutputXML && Inplace && FileName == "-") {
@@ -293,7 +316,7 @@ static bool format(StringRef FileName) {
   StringRef AssumedFileName = (FileName == "-") ? AssumeFileName : FileName;
 
   llvm::Expected<FormatStyle> FormatStyle =
-      getStyle(Style, AssumedFileName, FallbackStyle, Code->getBuffer());
+      getCachedStyle(AssumedFileName, Code->getBuffer());
   if (!FormatStyle) {
     llvm::errs() << llvm::toString(FormatStyle.takeError()) << "\n";
     return true;
@@ -775,10 +775,14 @@ static bool BundleFiles() {
   std::vector<std::unique_ptr<MemoryBuffer>> InputBuffers(
       InputFileNames.size());
 
+  // None of the handlers needs a null terminator. Not asking for one lets
+  // large inputs always be mapped rather than read into a heap copy, even
+  // when their size is a multiple of the page size.
   unsigned Idx = 0;
   for (auto &I : InputFileNames) {
     ErrorOr<std::unique_ptr<MemoryBuffer>> CodeOrErr =
-        MemoryBuffer::getFileOrSTDIN(I);
+        MemoryBuffer::getFileOrSTDIN(I, /*FileSize=*/-1,
+                                     /*RequiresNullTerminator=*/false);
     if (std::error_code EC = CodeOrErr.getError()) {
       errs() << "error: Can't open file " << I << ": " << EC.message() << "\n";
       return true;
@@ -813,9 +817,10 @@ static bool BundleFiles() {
 
 // Unbundle the files. Return true if an error was found.
 static bool UnbundleFiles() {
-  // Open Input file.
+  // Open Input file. As when bundling, it needn't be null-terminated.
   ErrorOr<std::unique_ptr<MemoryBuffer>> CodeOrErr =
-      MemoryBuffer::getFileOrSTDIN(InputFileNames.front());
+      MemoryBuffer::getFileOrSTDIN(InputFileNames.front(), /*FileSize=*/-1,
+                                   /*RequiresNullTerminator=*/false);
   if (std::error_code EC = CodeOrErr.getError()) {
     errs() << "error: Can't open file " << InputFileNames.front() << ": "
            << EC.message() << "\n";
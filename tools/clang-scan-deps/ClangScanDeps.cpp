@@ -8,9 +8,12 @@
 
 #include "clang/Frontend/CompilerInstance.h"
 #include "clang/Tooling/CommonOptionsParser.h"
+#include "clang/Tooling/DependencyScanning/DependencyScanningService.h"
 #include "clang/Tooling/DependencyScanning/DependencyScanningWorker.h"
 #include "clang/Tooling/JSONCompilationDatabase.h"
+#include "llvm/Support/FormatVariadic.h"
 #include "llvm/Support/InitLLVM.h"
+#include "llvm/Support/JSON.h"
 #include "llvm/Support/Options.h"
 #include "llvm/Support/Program.h"
 #include "llvm/Support/Signals.h"
@@ -23,6 +26,27 @@ using namespace tooling::dependencies;
 
 namespace {
 
+/// The format in which the dependencies of each input are printed.
+enum class ScanningOutputFormat {
+  /// A Makefile compatible dependency file, as with -MD.
+  Make,
+  /// One JSON object per line, listing the dependencies of one input.
+  JSONLines,
+};
+
+llvm::cl::OptionCategory DependencyScannerCategory("Tool options");
+
+llvm::cl::opt<ScanningOutputFormat> Format(
+    "format", llvm::cl::desc("The output format for the dependencies"),
+    llvm::cl::values(
+        clEnumValN(ScanningOutputFormat::Make, "make",
+                   "Makefile compatible dependency files"),
+        clEnumValN(ScanningOutputFormat::JSONLines, "json-lines",
+                   "One JSON object per line for each input, printed as soon "
+                   "as the input has been scanned")),
+    llvm::cl::init(ScanningOutputFormat::Make),
+    llvm::cl::cat(DependencyScannerCategory));
+
 class SharedStream {
 public:
   SharedStream(raw_ostream &OS) : OS(OS) {}
@@ -43,32 +67,53 @@ class DependencyScanningTool {
 public:
   /// Construct a dependency scanning tool.
   ///
+  /// \param Service          The shared state of all of the worker threads.
   /// \param Compilations     The reference to the compilation database that's
   /// used by the clang tool.
-  DependencyScanningTool(const tooling::CompilationDatabase &Compilations,
+  DependencyScanningTool(DependencyScanningService &Service,
+                         const tooling::CompilationDatabase &Compilations,
                          SharedStream &OS, SharedStream &Errs)
-      : Compilations(Compilations), OS(OS), Errs(Errs) {}
+      : Worker(Service), Compilations(Compilations), OS(OS), Errs(Errs) {}
 
   /// Computes the dependencies for the given file and prints them out.
   ///
   /// \returns True on error.
   bool runOnFile(const std::string &Input, StringRef CWD) {
-    auto MaybeFile = Worker.getDependencyFile(Input, CWD, Compilations);
-    if (!MaybeFile) {
-      llvm::handleAllErrors(
-          MaybeFile.takeError(), [this, &Input](llvm::StringError &Err) {
-            Errs.applyLocked([&](raw_ostream &OS) {
-              OS << "Error while scanning dependencies for " << Input << ":\n";
-              OS << Err.getMessage();
-            });
-          });
-      return true;
+    if (Format == ScanningOutputFormat::JSONLines) {
+      auto MaybeDeps = Worker.getDependencies(Input, CWD, Compilations);
+      if (!MaybeDeps)
+        return reportError(Input, MaybeDeps.takeError());
+      llvm::json::Object Result{
+          {"file", Input},
+          {"directory", CWD},
+          {"dependencies", llvm::json::Array(*MaybeDeps)}};
+      OS.applyLocked([&](raw_ostream &OS) {
+        OS << llvm::formatv("{0}", llvm::json::Value(std::move(Result)))
+           << "\n";
+      });
+      return false;
     }
+    auto MaybeFile = Worker.getDependencyFile(Input, CWD, Compilations);
+    if (!MaybeFile)
+      return reportError(Input, MaybeFile.takeError());
     OS.applyLocked([&](raw_ostream &OS) { OS << *MaybeFile; });
     return false;
   }
 
 private:
+  /// Prints the error of a failed scan of \p Input.
+  ///
+  /// \returns True.
+  bool reportError(const std::string &Input, llvm::Error E) {
+    llvm::handleAllErrors(std::move(E), [this, &Input](llvm::StringError &Err) {
+      Errs.applyLocked([&](raw_ostream &OS) {
+        OS << "Error while scanning dependencies for " << Input << ":\n";
+        OS << Err.getMessage();
+      });
+    });
+    return true;
+  }
+
   DependencyScanningWorker Worker;
   const tooling::CompilationDatabase &Compilations;
   SharedStream &OS;
@@ -78,7 +123,20 @@ private:
 llvm::cl::opt<bool> Help("h", llvm::cl::desc("Alias for -help"),
                          llvm::cl::Hidden);
 
-llvm::cl::OptionCategory DependencyScannerCategory("Tool options");
+llvm::cl::opt<ScanningMode> ScanMode(
+    "mode",
+    llvm::cl::desc("The preprocessing mode used to compute the dependencies"),
+    llvm::cl::values(
+        clEnumValN(ScanningMode::MinimizedSourcePreprocessing,
+                   "preprocess-minimized-sources",
+                   "The set of dependencies is computed by preprocessing the "
+                   "source files that were minimized to only include the "
+                   "contents that might affect the dependencies"),
+        clEnumValN(ScanningMode::CanonicalPreprocessing, "preprocess",
+                   "The set of dependencies is computed by preprocessing the "
+                   "unmodified source files")),
+    llvm::cl::init(ScanningMode::MinimizedSourcePreprocessing),
+    llvm::cl::cat(DependencyScannerCategory));
 
 llvm::cl::opt<unsigned>
     NumThreads("j", llvm::cl::Optional,
@@ -133,6 +191,8 @@ int main(int argc, const char **argv) {
         return AdjustedArgs;
       });
 
+  // The service owns the filesystem cache shared by the workers.
+  DependencyScanningService Service(ScanMode);
   SharedStream Errs(llvm::errs());
   // Print out the dependency results to STDOUT by default.
   SharedStream DependencyOS(llvm::outs());
@@ -141,15 +201,17 @@ int main(int argc, const char **argv) {
   std::vector<std::unique_ptr<DependencyScanningTool>> WorkerTools;
   for (unsigned I = 0; I < NumWorkers; ++I)
     WorkerTools.push_back(llvm::make_unique<DependencyScanningTool>(
-        *AdjustingCompilations, DependencyOS, Errs));
+        Service, *AdjustingCompilations, DependencyOS, Errs));
 
   std::vector<std::thread> WorkerThreads;
   std::atomic<bool> HadErrors(false);
   std::mutex Lock;
   size_t Index = 0;
 
-  llvm::outs() << "Running clang-scan-deps on " << Inputs.size()
-               << " files using " << NumWorkers << " workers\n";
+  // Keep the output machine readable in the JSON lines mode.
+  if (Format == ScanningOutputFormat::Make)
+    llvm::outs() << "Running clang-scan-deps on " << Inputs.size()
+                 << " files using " << NumWorkers << " workers\n";
   for (unsigned I = 0; I < NumWorkers; ++I) {
     WorkerThreads.emplace_back(
         [I, &Lock, &Index, &Inputs, &HadErrors, &WorkerTools]() {
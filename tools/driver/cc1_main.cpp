@@ -14,6 +14,7 @@
 
 #include "clang/Basic/Stack.h"
 #include "clang/Basic/TargetOptions.h"
+#include "clang/CodeGen/BackendUtil.h"
 #include "clang/CodeGen/ObjectFilePCHContainerOperations.h"
 #include "clang/Config/config.h"
 #include "clang/Driver/DriverDiagnostic.h"
@@ -203,6 +204,8 @@ int cc1_main(ArrayRef<const char *> Argv, const char *Argv0, void *MainAddr) {
   llvm::InitializeAllAsmPrinters();
   llvm::InitializeAllAsmParsers();
 
+  initializeCheerpPasses(*llvm::PassRegistry::getPassRegistry());
+
 #ifdef LINK_POLLY_INTO_TOOLS
   llvm::PassRegistry &Registry = *llvm::PassRegistry::getPassRegistry();
   polly::initializePollyPasses(Registry);
@@ -221,8 +224,11 @@ int cc1_main(ArrayRef<const char *> Argv, const char *Argv0, void *MainAddr) {
         Clang->getFrontendOpts().TimeTraceGranularity);
   }
   // --print-supported-cpus takes priority over the actual compilation.
-  if (Clang->getFrontendOpts().PrintSupportedCPUs)
+  if (Clang->getFrontendOpts().PrintSupportedCPUs) {
+    if (llvm::timeTraceProfilerEnabled())
+      llvm::timeTraceProfilerCleanup();
     return PrintSupportedCPUs(Clang->getTargetOpts().Triple);
+  }
 
   // Infer the builtin include path if unspecified.
   if (Clang->getHeaderSearchOpts().UseBuiltinIncludes &&
@@ -232,8 +238,11 @@ int cc1_main(ArrayRef<const char *> Argv, const char *Argv0, void *MainAddr) {
 
   // Create the actual diagnostics engine.
   Clang->createDiagnostics();
-  if (!Clang->hasDiagnostics())
+  if (!Clang->hasDiagnostics()) {
+    if (llvm::timeTraceProfilerEnabled())
+      llvm::timeTraceProfilerCleanup();
     return 1;
+  }
 
   // Set an error handler, so that any LLVM backend diagnostics go through our
   // error handler.
@@ -241,8 +250,13 @@ int cc1_main(ArrayRef<const char *> Argv, const char *Argv0, void *MainAddr) {
                                   static_cast<void*>(&Clang->getDiagnostics()));
 
   DiagsBuffer->FlushDiagnostics(Clang->getDiagnostics());
-  if (!Success)
+  if (!Success) {
+    // The profiler is per process, leave it off for the next in-process job
+    if (llvm::timeTraceProfilerEnabled())
+      llvm::timeTraceProfilerCleanup();
+    llvm::remove_fatal_error_handler();
     return 1;
+  }
 
   // Execute the frontend actions.
   {
@@ -255,8 +269,11 @@ int cc1_main(ArrayRef<const char *> Argv, const char *Argv0, void *MainAddr) {
   llvm::TimerGroup::printAll(llvm::errs());
 
   if (llvm::timeTraceProfilerEnabled()) {
-    SmallString<128> Path(Clang->getFrontendOpts().OutputFile);
-    llvm::sys::path::replace_extension(Path, "json");
+    SmallString<128> Path(Clang->getFrontendOpts().TimeTraceFile);
+    if (Path.empty()) {
+      Path = Clang->getFrontendOpts().OutputFile;
+      llvm::sys::path::replace_extension(Path, "json");
+    }
     auto profilerOutput =
         Clang->createOutputFile(Path.str(),
                                 /*Binary=*/false,
@@ -1274,5 +1274,43 @@ TEST_F(
   EXPECT_FALSE(testStructuralMatch(t));
 }
 
+struct StructuralEquivalenceCacheTest : StructuralEquivalenceTest {};
+
+TEST_F(StructuralEquivalenceCacheTest, CompleteDeclsAreRemembered) {
+  auto Decls = makeNamedDecls("struct A { int i; }; void foo(A);",
+                              "struct A { int i; }; void foo(A);", Lang_CXX);
+  Decl *D0 = get<0>(Decls), *D1 = get<1>(Decls);
+  llvm::DenseSet<std::pair<Decl *, Decl *>> NonEquivalentDecls;
+  llvm::DenseSet<std::pair<Decl *, Decl *>> EquivalentDecls;
+  StructuralEquivalenceContext Ctx(
+      D0->getASTContext(), D1->getASTContext(), NonEquivalentDecls,
+      StructuralEquivalenceKind::Default, false, false);
+  Ctx.EquivalentDecls = &EquivalentDecls;
+  EXPECT_TRUE(Ctx.IsEquivalent(D0, D1));
+  EXPECT_TRUE(EquivalentDecls.count(
+      std::make_pair(D0->getCanonicalDecl(), D1->getCanonicalDecl())));
+  auto *A0 = FirstDeclMatcher<RecordDecl>().match(
+      D0->getASTContext().getTranslationUnitDecl(), recordDecl(hasName("A")));
+  auto *A1 = FirstDeclMatcher<RecordDecl>().match(
+      D1->getASTContext().getTranslationUnitDecl(), recordDecl(hasName("A")));
+  EXPECT_TRUE(EquivalentDecls.count(
+      std::make_pair(A0->getCanonicalDecl(), A1->getCanonicalDecl())));
+}
+
+TEST_F(StructuralEquivalenceCacheTest, IncompleteDeclsAreNotRemembered) {
+  auto Decls = makeNamedDecls("struct A; void foo(A *);",
+                              "struct A; void foo(A *);", Lang_CXX);
+  Decl *D0 = get<0>(Decls), *D1 = get<1>(Decls);
+  llvm::DenseSet<std::pair<Decl *, Decl *>> NonEquivalentDecls;
+  llvm::DenseSet<std::pair<Decl *, Decl *>> EquivalentDecls;
+  StructuralEquivalenceContext Ctx(
+      D0->getASTContext(), D1->getASTContext(), NonEquivalentDecls,
+      StructuralEquivalenceKind::Default, false, false);
+  Ctx.EquivalentDecls = &EquivalentDecls;
+  EXPECT_TRUE(Ctx.IsEquivalent(D0, D1));
+  for (const auto &P : EquivalentDecls)
+    EXPECT_FALSE(isa<RecordDecl>(P.first));
+}
+
 } // end namespace ast_matchers
 } // end namespace clang
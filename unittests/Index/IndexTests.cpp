@@ -292,6 +292,24 @@ TEST(IndexTest, Constructors) {
                 WrittenAt(Position(4, 8)))));
 }
 
+TEST(IndexTest, ShouldIndexFile) {
+  std::string Code = "class X {}; void f() {}";
+  auto Index = std::make_shared<Indexer>();
+  IndexingOptions Opts;
+  unsigned NumQueries = 0;
+  Opts.ShouldIndexFile = [&](FileID) {
+    ++NumQueries;
+    return false;
+  };
+  tooling::runToolOnCode(new IndexAction(Index, Opts), Code);
+  EXPECT_THAT(Index->Symbols, testing::IsEmpty());
+  EXPECT_EQ(NumQueries, 1u);
+
+  Opts.ShouldIndexFile = [](FileID) { return true; };
+  tooling::runToolOnCode(new IndexAction(Index, Opts), Code);
+  EXPECT_THAT(Index->Symbols, UnorderedElementsAre(QName("X"), QName("f")));
+}
+
 } // namespace
 } // namespace index
 } // namespace clang
@@ -179,6 +179,33 @@ TEST(HeaderMapTest, lookupFilename) {
   ASSERT_EQ("bc", Map.lookupFilename("a", DestPath));
 }
 
+TEST(HeaderMapTest, lookupFilenameCollisions) {
+  typedef MapFile<4, 16> FileTy;
+  FileTy File;
+  File.init();
+
+  // "ab" and "ba" have the same hash, so looking up the latter probes past
+  // the former.
+  FileMaker<FileTy> Maker(File);
+  auto ab = Maker.addString("ab");
+  auto ba = Maker.addString("ba");
+  auto x = Maker.addString("x");
+  auto y = Maker.addString("y");
+  Maker.addBucket(getHash("ab"), ab, x, x);
+  Maker.addBucket(getHash("ba"), ba, y, y);
+
+  bool NeedsSwap;
+  ASSERT_TRUE(HeaderMapImpl::checkHeader(*File.getBuffer(), NeedsSwap));
+  ASSERT_FALSE(NeedsSwap);
+  HeaderMapImpl Map(File.getBuffer(), NeedsSwap);
+
+  SmallString<8> DestPath;
+  ASSERT_EQ("xx", Map.lookupFilename("aB", DestPath));
+  ASSERT_EQ("yy", Map.lookupFilename("BA", DestPath));
+  ASSERT_EQ("", Map.lookupFilename(StringRef("ba\0", 3), DestPath));
+  ASSERT_EQ("", Map.lookupFilename("abc", DestPath));
+}
+
 template <class FileTy, class PaddingTy> struct PaddedFile {
   FileTy File;
   PaddingTy Padding;
@@ -47,4 +47,34 @@ TEST(RewriteBuffer, TagRanges) {
   EXPECT_EQ(Output, Result);
 }
 
+static std::string contents(const RewriteBuffer &Buf) {
+  std::string Result;
+  raw_string_ostream OS(Result);
+  Buf.write(OS);
+  return OS.str();
+}
+
+TEST(RewriteBuffer, ReplaceTexts) {
+  StringRef Input = "int a = b + c;";
+  RewriteBuffer::TextEdit Edits[] = {
+      {4, 1, "alpha"}, {8, 1, ""}, {9, 0, "beta"}, {12, 1, "gamma"}};
+
+  RewriteBuffer Batch, Sequential;
+  Batch.Initialize(Input);
+  Sequential.Initialize(Input);
+  Batch.InsertTextBefore(0, "static ");
+  Sequential.InsertTextBefore(0, "static ");
+  Batch.ReplaceTexts(Edits);
+  for (const RewriteBuffer::TextEdit &Edit : Edits)
+    Sequential.ReplaceText(Edit.OrigOffset, Edit.OrigLength, Edit.NewStr);
+
+  EXPECT_EQ("static int alpha = beta + gamma;", contents(Batch));
+  EXPECT_EQ(contents(Sequential), contents(Batch));
+
+  // Later edits are mapped through the ones of the batch.
+  Batch.InsertTextAfter(13, ";");
+  Sequential.InsertTextAfter(13, ";");
+  EXPECT_EQ(contents(Sequential), contents(Batch));
+}
+
 } // anonymous namespace
@@ -508,6 +508,27 @@ TEST_F(ReplacementTest, InvalidSourceLocationFailsApplyAll) {
   EXPECT_FALSE(applyAllReplacements(Replaces, Context.Rewrite));
 }
 
+TEST(ApplyReplacementsToCode, InsertsBeforeReplacementAtSameOffset) {
+  Replacements Replaces = toReplacements({Replacement("x.cc", 2, 2, "cd"),
+                                          Replacement("x.cc", 2, 0, "ab"),
+                                          Replacement("x.cc", 5, 1, "")});
+  auto Result = applyAllReplacements("01234567", Replaces);
+  EXPECT_TRUE(static_cast<bool>(Result));
+  EXPECT_EQ("01abcd467", *Result);
+}
+
+TEST(ApplyReplacementsToCode, FailsOutOfRange) {
+  Replacements Replaces = toReplacements({Replacement("x.cc", 6, 3, "x")});
+  auto Result = applyAllReplacements("01234567", Replaces);
+  EXPECT_FALSE(static_cast<bool>(Result));
+  llvm::consumeError(Result.takeError());
+
+  Replaces = toReplacements({Replacement("x.cc", 8, 0, "x")});
+  Result = applyAllReplacements("01234567", Replaces);
+  EXPECT_TRUE(static_cast<bool>(Result));
+  EXPECT_EQ("01234567x", *Result);
+}
+
 TEST_F(ReplacementTest, MultipleFilesReplaceAndFormat) {
   // Column limit is 20.
   std::string Code1 = "Long *a =\n"
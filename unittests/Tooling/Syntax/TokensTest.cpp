@@ -89,7 +89,8 @@ public:
   /// Run the clang frontend, collect the preprocessed tokens from the frontend
   /// invocation and store them in this->Buffer.
   /// This also clears SourceManager before running the compiler.
-  void recordTokens(llvm::StringRef Code) {
+  /// With \p PreprocessOnly, the code is not parsed.
+  void recordTokens(llvm::StringRef Code, bool PreprocessOnly = false) {
     class RecordTokens : public ASTFrontendAction {
     public:
       explicit RecordTokens(TokenBuffer &Result) : Result(Result) {}
@@ -133,14 +134,19 @@ public:
     Compiler.setSourceManager(SourceMgr.get());
 
     this->Buffer = TokenBuffer(*SourceMgr);
-    RecordTokens Recorder(this->Buffer);
-    ASSERT_TRUE(Compiler.ExecuteAction(Recorder))
+    std::unique_ptr<FrontendAction> Recorder;
+    if (PreprocessOnly)
+      Recorder = llvm::make_unique<TokenCollectingAction>(this->Buffer);
+    else
+      Recorder = llvm::make_unique<RecordTokens>(this->Buffer);
+    ASSERT_TRUE(Compiler.ExecuteAction(*Recorder))
         << "failed to run the frontend";
   }
 
   /// Record the tokens and return a test dump of the resulting buffer.
-  std::string collectAndDump(llvm::StringRef Code) {
-    recordTokens(Code);
+  std::string collectAndDump(llvm::StringRef Code,
+                             bool PreprocessOnly = false) {
+    recordTokens(Code, PreprocessOnly);
     return Buffer.dumpForTests();
   }
 
@@ -557,6 +563,8 @@ file './bar.h'
 
   EXPECT_EQ(Expected, collectAndDump(Code))
       << "input: " << Code << "\nresults: " << collectAndDump(Code);
+  // Without parsing, the preprocessor sees the same tokens.
+  EXPECT_EQ(Expected, collectAndDump(Code, /*PreprocessOnly=*/true));
 }
 
 class TokenBufferTest : public TokenCollectorTest {};